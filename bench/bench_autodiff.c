@@ -0,0 +1,115 @@
+/*
+    FILE: bench_autodiff.c
+    DESCRIPTION:
+        Custo das Jacobianas do uniciclo por diferenciação automática
+        (autodiff.h): um ponto isolado e lotes SoA de mil e dez mil pontos
+        escritos em matrizes pré-alocadas, comparados com diferenças
+        finitas centrais sobre o mesmo modelo (duas avaliações por
+        variável).
+        Uso: bench_autodiff [opções do harness]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "autodiff.h"
+#include "harness.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static const int batch_sizes[] = { 1000, 10000 };
+#define MAX_POINTS 10000
+#define R_FRONT 0.3
+
+// Pontos de operação em SoA e Jacobianas empilhadas
+typedef struct {
+    int n;
+    double x1[MAX_POINTS], x2[MAX_POINTS], x3[MAX_POINTS], u1[MAX_POINTS], u2[MAX_POINTS];
+    Matrix *A, *B, *C;
+} AdCase;
+
+static AdCase ac;
+
+static void setup(AdCase *c) {
+    for (int i = 0; i < MAX_POINTS; i++) {
+        double t = (double)i / MAX_POINTS;
+        c->x1[i] = cos(7.0 * t);
+        c->x2[i] = sin(5.0 * t);
+        c->x3[i] = 2.0 * M_PI * t - M_PI;
+        c->u1[i] = 0.5 + 0.5 * sin(11.0 * t);
+        c->u2[i] = cos(13.0 * t);
+    }
+}
+
+/* Modelo em double para as diferenças finitas: f (3) e h (2) empilhados */
+static void model(const double v[5], double out[5]) {
+    double s = sin(v[2]), c = cos(v[2]);
+    out[0] = v[3] * c;
+    out[1] = v[3] * s;
+    out[2] = v[4];
+    out[3] = v[0] + R_FRONT * c;
+    out[4] = v[1] + R_FRONT * s;
+}
+
+static void run_point(void *ctx, long iters) {
+    const AdCase *c = ctx;
+    UnicycleJacobians J;
+    for (long i = 0; i < iters; i++) {
+        int k = (int)(i % MAX_POINTS);
+        const double x[3] = { c->x1[k], c->x2[k], c->x3[k] }, u[2] = { c->u1[k], c->u2[k] };
+        ad_unicycle(x, u, R_FRONT, &J);
+        bench_sink += J.A[0][2] + J.B[1][0] + J.C[1][2];
+    }
+}
+
+static void run_finite(void *ctx, long iters) {
+    const AdCase *c = ctx;
+    double jac[5][5];
+    for (long i = 0; i < iters; i++) {
+        int k = (int)(i % MAX_POINTS);
+        double v[5] = { c->x1[k], c->x2[k], c->x3[k], c->u1[k], c->u2[k] };
+        for (int j = 0; j < 5; j++) {
+            double h = 1e-6 * fmax(1.0, fabs(v[j])), fp[5], fm[5], keep = v[j];
+            v[j] = keep + h;
+            model(v, fp);
+            v[j] = keep - h;
+            model(v, fm);
+            v[j] = keep;
+            for (int r = 0; r < 5; r++) jac[r][j] = (fp[r] - fm[r]) / (2.0 * h);
+        }
+        bench_sink += jac[0][2] + jac[1][3] + jac[4][2];
+    }
+}
+
+static void run_batch(void *ctx, long iters) {
+    AdCase *c = ctx;
+    for (long i = 0; i < iters; i++)
+        ad_unicycle_batch(c->n, c->x1, c->x2, c->x3, c->u1, c->u2, R_FRONT, c->A, c->B, c->C);
+    bench_sink += c->A->data[2][2];
+}
+
+int main(int argc, char **argv) {
+    if (bench_init("autodiff", argc, argv) != 0) return EXIT_FAILURE;
+    setup(&ac);
+
+    bench_run("ad_unicycle_ponto", run_point, &ac, 1.0, "pontos/s");
+    bench_run("diferencas_finitas_ponto", run_finite, &ac, 1.0, "pontos/s");
+    for (size_t k = 0; k < sizeof(batch_sizes) / sizeof(batch_sizes[0]); k++) {
+        ac.n = batch_sizes[k];
+        ac.A = create_matrix(3 * ac.n, 3);
+        ac.B = create_matrix(3 * ac.n, 2);
+        ac.C = create_matrix(2 * ac.n, 3);
+        char name[64];
+        snprintf(name, sizeof(name), "ad_unicycle_batch_n%d", ac.n);
+        bench_run(name, run_batch, &ac, ac.n, "pontos/s");
+        destroy_matrix(ac.A);
+        destroy_matrix(ac.B);
+        destroy_matrix(ac.C);
+    }
+    return bench_finish();
+}
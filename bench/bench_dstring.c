@@ -0,0 +1,101 @@
+/*
+    FILE: bench_dstring.c
+    DESCRIPTION:
+        Benchmark da criação de Dstrings curtas (rótulos e campos de log):
+        heap com armazenamento embutido, cabeçalho na pilha e arena; e da
+        concatenação e formatação de campos.
+        Uso: bench_dstring [opções do harness]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "dstring.h"
+#include "harness.h"
+
+#define ARENA_BATCH 1000  // Dstrings criadas antes de cada reset da arena
+#define CONCAT_RESET 4096 // Concatenações antes de recomeçar o acumulador
+
+static void run_heap(void *ctx, long iters) {
+    (void)ctx;
+    size_t sink = 0;
+    for (long i = 0; i < iters; i++) {
+        Dstring *d = dstring_new_from_int((int)i);
+        sink += dstring_length(d);
+        dstring_free(d);
+    }
+    bench_sink += sink;
+}
+
+static void run_stack(void *ctx, long iters) {
+    (void)ctx;
+    size_t sink = 0;
+    for (long i = 0; i < iters; i++) {
+        Dstring d;
+        dstring_init_from_char(&d, "label");
+        dstring_append_double(&d, i * 0.001, 4);
+        sink += dstring_length(&d);
+        dstring_release(&d);
+    }
+    bench_sink += sink;
+}
+
+static void run_arena(void *ctx, long iters) {
+    DstringArena *arena = ctx;
+    size_t sink = 0;
+    for (long i = 0; i < iters; i++) {
+        if (i % ARENA_BATCH == 0) dstring_arena_reset(arena);
+        Dstring *d = dstring_arena_new_from_int(arena, (int)i);
+        sink += dstring_length(d);
+    }
+    bench_sink += sink;
+}
+
+/* Concatenação crescente (buffer externo com crescimento geométrico) */
+static void run_concat(void *ctx, long iters) {
+    const Dstring *piece = ctx;
+    Dstring *acc = dstring_new_from_char("");
+    size_t sink = 0;
+    for (long i = 0; i < iters; i++) {
+        if (i % CONCAT_RESET == CONCAT_RESET - 1) {
+            sink += dstring_length(acc);
+            dstring_free(acc);
+            acc = dstring_new_from_char("");
+        }
+        dstring_concat(acc, piece);
+    }
+    sink += dstring_length(acc);
+    dstring_free(acc);
+    bench_sink += sink;
+}
+
+static void run_new_double(void *ctx, long iters) {
+    (void)ctx;
+    size_t sink = 0;
+    for (long i = 0; i < iters; i++) {
+        Dstring *d = dstring_new_from_double_prec(i * 0.001, 4);
+        sink += dstring_length(d);
+        dstring_free(d);
+    }
+    bench_sink += sink;
+}
+
+int main(int argc, char **argv) {
+    if (bench_init("dstring", argc, argv) != 0) return EXIT_FAILURE;
+
+    bench_run("new_from_int_free", run_heap, NULL, 0, NULL);
+    bench_run("init_append_release", run_stack, NULL, 0, NULL);
+
+    DstringArena *arena = dstring_arena_create(ARENA_BATCH * (sizeof(Dstring) + 32));
+    bench_run("arena_new_from_int", run_arena, arena, 0, NULL);
+    dstring_arena_destroy(arena);
+
+    Dstring *piece = dstring_new_from_char("0.1234,");
+    bench_run("concat_7_bytes", run_concat, piece, 7, "B/s");
+    dstring_free(piece);
+
+    bench_run("new_from_double_prec4", run_new_double, NULL, 0, NULL);
+    return bench_finish();
+}
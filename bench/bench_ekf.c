@@ -0,0 +1,98 @@
+/*
+    FILE: bench_ekf.c
+    DESCRIPTION:
+        Custo do estágio de estimação (estimator.h) por passo do robô:
+        predição e correção do EKF isoladas, o ciclo completo do filtro e
+        o passo completo com a geração do ruído dos sensores. As entradas
+        variam a cada operação para que a trigonometria e a covariância
+        não se repitam.
+        Uso: bench_ekf [opções do harness]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "estimator.h"
+#include "harness.h"
+
+#define N_INPUTS 256  // Potência de 2
+
+typedef struct {
+    ScenarioConfig cfg;
+    Estimator est;
+    RobotState truth[N_INPUTS];   // Trajetória real em círculo
+    Odometry odo[N_INPUTS];
+    double z[N_INPUTS][3];
+    double dt, q_v, q_w, r[3];
+} EkfCase;
+
+static EkfCase ec;
+
+static void setup(EkfCase *c) {
+    scenario_set_defaults(&c->cfg);
+    scenario_apply(&c->cfg, "estimator=ekf");
+    c->dt = c->cfg.sim_period_ms / 1000.0;
+    for (int i = 0; i < N_INPUTS; i++) {
+        double th = 2.0 * M_PI * i / N_INPUTS;
+        c->truth[i] = (RobotState){ cos(th), sin(th), th + M_PI / 2, 0, 0 };
+        c->odo[i] = (Odometry){ 0.5 + 0.1 * sin(3 * th), 0.5 + 0.2 * cos(5 * th) };
+        c->z[i][0] = c->truth[i].x1 + 0.01 * sin(7 * th);
+        c->z[i][1] = c->truth[i].x2 + 0.01 * cos(11 * th);
+        c->z[i][2] = c->truth[i].x3 + 0.01 * sin(13 * th);
+    }
+    c->q_v = c->q_w = 1e-3;
+    c->r[0] = c->r[1] = c->r[2] = 4e-4;
+    estimator_init(&c->est, &c->cfg, &c->truth[0]);
+}
+
+static void run_predict(void *ctx, long iters) {
+    EkfCase *c = ctx;
+    Ekf f = c->est.ekf;
+    for (long i = 0; i < iters; i++) {
+        ekf_predict(&f, &c->odo[i & (N_INPUTS - 1)], c->dt, c->q_v, c->q_w);
+        // Mantém a covariância limitada sem correção
+        if ((i & 1023) == 1023) f = c->est.ekf;
+    }
+    bench_sink += f.x[0] + f.P[0][0];
+}
+
+static void run_update(void *ctx, long iters) {
+    EkfCase *c = ctx;
+    Ekf f = c->est.ekf;
+    for (long i = 0; i < iters; i++) ekf_update(&f, c->z[i & (N_INPUTS - 1)], c->r);
+    bench_sink += f.x[0] + f.P[0][0];
+}
+
+static void run_cycle(void *ctx, long iters) {
+    EkfCase *c = ctx;
+    Ekf f = c->est.ekf;
+    for (long i = 0; i < iters; i++) {
+        long k = i & (N_INPUTS - 1);
+        ekf_predict(&f, &c->odo[k], c->dt, c->q_v, c->q_w);
+        ekf_update(&f, c->z[k], c->r);
+    }
+    bench_sink += f.x[0] + f.P[0][0];
+}
+
+static void run_step(void *ctx, long iters) {
+    EkfCase *c = ctx;
+    for (long i = 0; i < iters; i++) {
+        long k = i & (N_INPUTS - 1);
+        estimator_step(&c->est, &c->cfg, &c->truth[k], c->odo[k].v, c->odo[k].w, c->dt);
+    }
+    bench_sink += c->est.pose.y1;
+}
+
+int main(int argc, char **argv) {
+    if (bench_init("ekf", argc, argv) != 0) return EXIT_FAILURE;
+    setup(&ec);
+
+    bench_run("ekf_predict", run_predict, &ec, 1.0, "atualiz/s");
+    bench_run("ekf_update", run_update, &ec, 1.0, "atualiz/s");
+    bench_run("ekf_predict_update", run_cycle, &ec, 1.0, "atualiz/s");
+    bench_run("estimator_step_ruido", run_step, &ec, 1.0, "passos/s");
+    return bench_finish();
+}
@@ -0,0 +1,64 @@
+/*
+    FILE: bench_fleet.c
+    DESCRIPTION:
+        Vazão do modo frota (fleet.h) com 10 mil robôs: passos por segundo
+        com e sem as consultas de vizinhança, e o custo isolado de uma
+        consulta completa. Todas as tarefas usam o período do robô, de
+        modo que cada passo executa modelos, controle, linearização,
+        planta e atualização do índice para a frota inteira.
+        Uso: bench_fleet [opções do harness]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "fleet.h"
+#include "harness.h"
+
+#define FLEET_ROBOTS 10000
+
+typedef struct {
+    ScenarioConfig cfg;
+    Trajectory traj;
+    Fleet fleet;
+} FleetCase;
+
+static FleetCase fc;
+
+/* Um passo do robô por operação; reinicia a frota ao fim do cenário */
+static void run_step(void *ctx, long iters) {
+    FleetCase *c = ctx;
+    for (long i = 0; i < iters; i++) {
+        if (!fleet_step(&c->fleet)) fleet_reset(&c->fleet);
+    }
+    bench_sink += c->fleet.y1[0];
+}
+
+static void run_query(void *ctx, long iters) {
+    FleetCase *c = ctx;
+    for (long i = 0; i < iters; i++) fleet_query(&c->fleet);
+    bench_sink += c->fleet.nearest[0];
+}
+
+int main(int argc, char **argv) {
+    if (bench_init("fleet", argc, argv) != 0) return EXIT_FAILURE;
+
+    scenario_set_defaults(&fc.cfg);
+    fc.cfg.fleet_size = FLEET_ROBOTS;
+    fc.cfg.sim_period_ms = fc.cfg.lin_period_ms = fc.cfg.ctrl_period_ms = 30;
+    fc.cfg.model_period_ms = fc.cfg.ref_period_ms = fc.cfg.timer_interval_ms = 30;
+    if (scenario_validate(&fc.cfg) != 0 || trajectory_load(&fc.traj, &fc.cfg) != 0) return EXIT_FAILURE;
+    if (fleet_init(&fc.fleet, &fc.cfg, &fc.traj) != 0) return EXIT_FAILURE;
+
+    fc.fleet.check_neighbors = 1;
+    bench_run("fleet_step_10k_vizinhos", run_step, &fc, 1.0, "passos/s");
+    fc.fleet.check_neighbors = 0;
+    bench_run("fleet_step_10k", run_step, &fc, 1.0, "passos/s");
+    bench_run("fleet_query_10k", run_query, &fc, FLEET_ROBOTS, "robôs/s");
+
+    fleet_destroy(&fc.fleet);
+    trajectory_free(&fc.traj);
+    return bench_finish();
+}
@@ -0,0 +1,60 @@
+/*
+    FILE: bench_headless.c
+    DESCRIPTION:
+        Macro-benchmark do sistema completo: executa o cenário padrão na
+        simulação headless (headless.h) e reporta segundos simulados por
+        segundo de parede, além do custo de um tick da base de tempo.
+        Uso: bench_headless [opções do harness]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "headless.h"
+#include "harness.h"
+
+// Cenário e trajetória compartilhados pelas execuções
+typedef struct {
+    ScenarioConfig cfg;
+    Trajectory traj;
+    HeadlessSim sim;
+} HeadlessCase;
+
+static HeadlessCase hc;
+
+static void run_scenario(void *ctx, long iters) {
+    HeadlessCase *c = ctx;
+    HeadlessResult r;
+    for (long i = 0; i < iters; i++) {
+        headless_run(&c->cfg, &c->traj, &r);
+        bench_sink += r.ise;
+    }
+}
+
+/* Um tick por operação; reinicia a simulação ao fim do cenário */
+static void run_tick(void *ctx, long iters) {
+    HeadlessCase *c = ctx;
+    for (long i = 0; i < iters; i++) {
+        if (!headless_step(&c->sim)) headless_init(&c->sim, &c->cfg, &c->traj);
+    }
+    bench_sink += c->sim.state.robot.y1;
+}
+
+int main(int argc, char **argv) {
+    if (bench_init("headless", argc, argv) != 0) return EXIT_FAILURE;
+
+    scenario_set_defaults(&hc.cfg);
+    if (scenario_validate(&hc.cfg) != 0 || trajectory_load(&hc.traj, &hc.cfg) != 0) return EXIT_FAILURE;
+
+    char name[64];
+    snprintf(name, sizeof(name), "headless_run_%gs", hc.cfg.sim_time_s);
+    bench_run(name, run_scenario, &hc, hc.cfg.sim_time_s, "sim-s/s");
+
+    headless_init(&hc.sim, &hc.cfg, &hc.traj);
+    bench_run("headless_tick", run_tick, &hc, hc.sim.model.base_ms / 1000.0, "sim-s/s");
+
+    trajectory_free(&hc.traj);
+    return bench_finish();
+}
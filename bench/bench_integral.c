@@ -0,0 +1,161 @@
+/*
+    FILE: bench_integral.c
+    DESCRIPTION:
+        Benchmark das regras de integração numérica de integral.h (ponto
+        médio e trapézios compostos) em função do número de subintervalos
+        e, para os integradores em fluxo, o custo por amostra, que não
+        depende do tamanho da história (compare com a reintegração de
+        [0, t] a cada passo, que custa o caso composto de n = t / dt).
+        Para as séries amostradas (t[], y[] com espaçamento irregular),
+        compara as versões escalares com as escolhidas em tempo de
+        execução (AVX2 quando disponível) em um milhão de amostras.
+        Uso: bench_integral [opções do harness]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "integral.h"
+#include "harness.h"
+
+static const int counts[] = { 10, 100, 1000, 10000, 100000 };
+
+// Integrando típico (componente da trajetória em oito)
+static double integrand(double t) {
+    return sin(0.5 * t) * cos(0.25 * t);
+}
+
+static void run_midpoint(void *ctx, long iters) {
+    int n = *(const int *)ctx;
+    for (long i = 0; i < iters; i++) bench_sink += midpoint_rule(integrand, 0.0, 10.0, n);
+}
+
+static void run_trapezoidal(void *ctx, long iters) {
+    int n = *(const int *)ctx;
+    for (long i = 0; i < iters; i++) bench_sink += composite_trapezoidal(integrand, 0.0, 10.0, n);
+}
+
+#define N_SAMPLES 1024  // Potência de 2
+
+static double samples[N_SAMPLES];
+
+// Integrador em fluxo com a sua regra
+typedef struct {
+    IntegralRule rule;
+} StreamCase;
+
+static void run_running(void *ctx, long iters) {
+    const StreamCase *c = ctx;
+    RunningIntegral ri;
+    running_integral_init(&ri, c->rule);
+    for (long i = 0; i < iters; i++)
+        running_integral_add(&ri, 0.01 * (double)i, samples[i & (N_SAMPLES - 1)]);
+    bench_sink += running_integral_value(&ri);
+}
+
+static void run_sliding(void *ctx, long iters) {
+    const StreamCase *c = ctx;
+    static SlidingIntegral si;
+    sliding_integral_init(&si, c->rule, 2.0);
+    for (long i = 0; i < iters; i++)
+        sliding_integral_add(&si, 0.01 * (double)i, samples[i & (N_SAMPLES - 1)]);
+    bench_sink += sliding_integral_value(&si);
+}
+
+#define N_SERIES_SAMPLES 1000000
+
+// Série amostrada com espaçamento irregular (como o registro das threads)
+typedef struct {
+    double *t, *y, *out;
+    size_t n;
+} SeriesCase;
+
+typedef double (*SeriesRule)(const double *, const double *, size_t);
+typedef void (*SeriesCumulative)(const double *, const double *, size_t, double *restrict);
+
+typedef struct {
+    SeriesCase *data;
+    SeriesRule rule;
+    SeriesCumulative cumulative;
+} SeriesRun;
+
+static void run_series(void *ctx, long iters) {
+    const SeriesRun *r = ctx;
+    const SeriesCase *d = r->data;
+    for (long i = 0; i < iters; i++) {
+        if (r->rule) {
+            bench_sink += r->rule(d->t, d->y, d->n);
+        } else {
+            r->cumulative(d->t, d->y, d->n, d->out);
+            bench_sink += d->out[d->n - 1];
+        }
+    }
+}
+
+static int series_setup(SeriesCase *d) {
+    d->n = N_SERIES_SAMPLES;
+    d->t = malloc(d->n * sizeof(double));
+    d->y = malloc(d->n * sizeof(double));
+    d->out = malloc(d->n * sizeof(double));
+    if (!d->t || !d->y || !d->out) return -1;
+    double t = 0.0;
+    for (size_t i = 0; i < d->n; i++) {
+        d->t[i] = t;
+        d->y[i] = integrand(t);
+        t += 0.01 * (1.0 + 0.3 * sin(1.7 * (double)i));  // Período com variação de ±30%
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (bench_init("integral", argc, argv) != 0) return EXIT_FAILURE;
+
+    for (size_t k = 0; k < sizeof(counts) / sizeof(counts[0]); k++) {
+        int n = counts[k];
+        char name[64];
+        snprintf(name, sizeof(name), "midpoint_rule_n%d", n);
+        bench_run(name, run_midpoint, &n, n, "aval/s");
+        snprintf(name, sizeof(name), "composite_trapezoidal_n%d", n);
+        bench_run(name, run_trapezoidal, &n, n + 1, "aval/s");
+    }
+
+    // Integradores em fluxo: amostras do mesmo integrando a cada 10 ms
+    for (int i = 0; i < N_SAMPLES; i++) samples[i] = integrand(0.01 * i);
+    static const struct { const char *name; StreamCase c; } streams[] = {
+        { "rect", { INTEGRAL_RECT } },
+        { "trapezoid", { INTEGRAL_TRAPEZOID } },
+        { "simpson", { INTEGRAL_SIMPSON } },
+    };
+    for (size_t k = 0; k < sizeof(streams) / sizeof(streams[0]); k++) {
+        char name[64];
+        snprintf(name, sizeof(name), "running_%s", streams[k].name);
+        bench_run(name, run_running, (void *)&streams[k].c, 1.0, "amostras/s");
+        snprintf(name, sizeof(name), "sliding_%s_2s", streams[k].name);
+        bench_run(name, run_sliding, (void *)&streams[k].c, 1.0, "amostras/s");
+    }
+
+    // Séries amostradas: escalar e despacho em tempo de execução
+    static SeriesCase series;
+    if (series_setup(&series) != 0) return EXIT_FAILURE;
+    const char *isa = samples_isa_name(samples_isa());
+    const struct { const char *name; SeriesRun scalar, best; } rules[] = {
+        { "trapezoid", { &series, samples_trapezoid_scalar, NULL }, { &series, samples_trapezoid, NULL } },
+        { "simpson", { &series, samples_simpson_scalar, NULL }, { &series, samples_simpson, NULL } },
+        { "cumulative", { &series, NULL, samples_cumulative_trapezoid_scalar },
+                        { &series, NULL, samples_cumulative_trapezoid } },
+    };
+    for (size_t k = 0; k < sizeof(rules) / sizeof(rules[0]); k++) {
+        char name[64];
+        snprintf(name, sizeof(name), "samples_%s_scalar_1m", rules[k].name);
+        bench_run(name, run_series, (void *)&rules[k].scalar, (double)series.n, "amostras/s");
+        snprintf(name, sizeof(name), "samples_%s_%s_1m", rules[k].name, isa);
+        bench_run(name, run_series, (void *)&rules[k].best, (double)series.n, "amostras/s");
+    }
+    free(series.t);
+    free(series.y);
+    free(series.out);
+    return bench_finish();
+}
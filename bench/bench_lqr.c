@@ -0,0 +1,115 @@
+/*
+    FILE: bench_lqr.c
+    DESCRIPTION:
+        Custo por ativação do LQR com ganhos escalonados (lqr.h) em
+        relação à lei por modelo de referência: a consulta interpolada da
+        tabela isolada, a lei completa do LQR (pose de referência, erro,
+        ganho e v equivalente) e a lei atual, além da montagem da tabela
+        inteira (Riccati em todos os pontos da grade), que fica fora do
+        período do controle. As entradas percorrem orientações e
+        velocidades variadas para que a consulta não caia sempre na mesma
+        célula.
+        Uso: bench_lqr [opções do harness]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "lqr.h"
+#include "control_law.h"
+#include "harness.h"
+
+#define N_INPUTS 256  // Potência de 2
+
+typedef struct {
+    ScenarioConfig cfg;
+    Lqr lqr;
+    double y1[N_INPUTS], y2[N_INPUTS], theta[N_INPUTS];
+    RefPreviewSample now[N_INPUTS], next[N_INPUTS];
+    double ymx[N_INPUTS], ymy[N_INPUTS];   // Modelos de referência (lei atual)
+} LqrCase;
+
+static LqrCase lc;
+
+static int setup(LqrCase *c) {
+    scenario_set_defaults(&c->cfg);
+    if (lqr_init(&c->lqr, &c->cfg) != 0) return -1;
+    double dt = c->lqr.dt;
+    for (int i = 0; i < N_INPUTS; i++) {
+        double ph = 2.0 * M_PI * i / N_INPUTS;
+        double v = 0.2 + 0.7 * (0.5 + 0.5 * sin(3 * ph));  // Velocidade de referência
+        double w = 0.6;                                       // Giro de referência
+        c->now[i] = (RefPreviewSample){ .t = 0.0, .x = 1.6 * cos(ph), .y = 1.6 * sin(ph),
+                                        .dx = -v * sin(ph), .dy = v * cos(ph) };
+        c->next[i] = (RefPreviewSample){ .t = dt, .x = 1.6 * cos(ph + w * dt), .y = 1.6 * sin(ph + w * dt),
+                                         .dx = -v * sin(ph + w * dt), .dy = v * cos(ph + w * dt) };
+        c->y1[i] = c->now[i].x + 0.05 * sin(7 * ph);
+        c->y2[i] = c->now[i].y + 0.05 * cos(11 * ph);
+        c->theta[i] = ph + M_PI / 2 + 0.1 * sin(5 * ph);
+        c->ymx[i] = c->now[i].x + 0.02 * cos(13 * ph);
+        c->ymy[i] = c->now[i].y + 0.02 * sin(13 * ph);
+    }
+    return 0;
+}
+
+static void run_gain(void *ctx, long iters) {
+    LqrCase *c = ctx;
+    float K[6], acc = 0.0f;
+    for (long i = 0; i < iters; i++) {
+        long k = i & (N_INPUTS - 1);
+        lqr_gain(&c->lqr, c->theta[k], c->now[k].dy, K);
+        acc += K[0] + K[5];
+    }
+    bench_sink += acc;
+}
+
+static void run_lqr(void *ctx, long iters) {
+    LqrCase *c = ctx;
+    double u1, u2, v1, v2, acc = 0.0;
+    for (long i = 0; i < iters; i++) {
+        long k = i & (N_INPUTS - 1);
+        lqr_control(&c->lqr, c->y1[k], c->y2[k], c->theta[k], &c->now[k], &c->next[k],
+                    &u1, &u2, &v1, &v2);
+        acc += v1 + v2;
+    }
+    bench_sink += acc;
+}
+
+static void run_mrac(void *ctx, long iters) {
+    LqrCase *c = ctx;
+    double v1, v2, acc = 0.0;
+    for (long i = 0; i < iters; i++) {
+        long k = i & (N_INPUTS - 1);
+        control_law(&c->cfg, c->ymx[k], c->now[k].dx, c->ymy[k], c->now[k].dy,
+                    c->y1[k], c->y2[k], c->cfg.alpha1, c->cfg.alpha2, &v1, &v2);
+        acc += v1 + v2;
+    }
+    bench_sink += acc;
+}
+
+static void run_build(void *ctx, long iters) {
+    LqrCase *c = ctx;
+    for (long i = 0; i < iters; i++) {
+        Lqr t;
+        if (lqr_init(&t, &c->cfg) != 0) continue;
+        bench_sink += t.gains[0].k[0];
+        lqr_destroy(&t);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (bench_init("lqr", argc, argv) != 0) return EXIT_FAILURE;
+    if (setup(&lc) != 0) return EXIT_FAILURE;
+
+    bench_run("lqr_gain_lookup", run_gain, &lc, 1.0, "consultas/s");
+    bench_run("lqr_control", run_lqr, &lc, 1.0, "ativ/s");
+    bench_run("mrac_control_law", run_mrac, &lc, 1.0, "ativ/s");
+    bench_run("lqr_table_build", run_build, &lc,
+              (double)lc.cfg.lqr_heading_bins * lc.cfg.lqr_speed_bins, "pontos/s");
+
+    lqr_destroy(&lc.lqr);
+    return bench_finish();
+}
@@ -0,0 +1,90 @@
+/*
+    FILE: bench_matrix.c
+    DESCRIPTION:
+        Benchmark das operações de matrix.h por tamanho (criação/destruição,
+        soma, subtração e multiplicação). Cada operação inclui a alocação da
+        matriz resultado, como no uso real da biblioteca.
+        Uso: bench_matrix [opções do harness]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "matrix.h"
+#include "harness.h"
+
+static const int sizes[] = { 2, 3, 4, 8, 16, 32, 64 };
+
+// Operandos de um tamanho
+typedef struct {
+    int n;
+    Matrix *a, *b;
+} MatrixCase;
+
+static void run_create(void *ctx, long iters) {
+    const MatrixCase *c = ctx;
+    for (long i = 0; i < iters; i++) {
+        Matrix *m = create_matrix_zeros(c->n, c->n);
+        bench_sink += m->data[0][0];
+        destroy_matrix(m);
+    }
+}
+
+static void run_add(void *ctx, long iters) {
+    const MatrixCase *c = ctx;
+    for (long i = 0; i < iters; i++) {
+        Matrix *m = add_matrices(c->a, c->b);
+        bench_sink += m->data[0][0];
+        destroy_matrix(m);
+    }
+}
+
+static void run_subtract(void *ctx, long iters) {
+    const MatrixCase *c = ctx;
+    for (long i = 0; i < iters; i++) {
+        Matrix *m = subtract_matrices(c->a, c->b);
+        bench_sink += m->data[0][0];
+        destroy_matrix(m);
+    }
+}
+
+static void run_multiply(void *ctx, long iters) {
+    const MatrixCase *c = ctx;
+    for (long i = 0; i < iters; i++) {
+        Matrix *m = multiply_matrices(c->a, c->b);
+        bench_sink += m->data[0][0];
+        destroy_matrix(m);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (bench_init("matrix", argc, argv) != 0) return EXIT_FAILURE;
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int n = sizes[s];
+        MatrixCase c = { n, create_matrix(n, n), create_matrix(n, n) };
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                c.a->data[i][j] = (float)(i + j) / n;
+                c.b->data[i][j] = (float)(i - j) / n;
+            }
+        }
+
+        double elems = (double)n * n;
+        char name[64];
+        snprintf(name, sizeof(name), "create_destroy_%dx%d", n, n);
+        bench_run(name, run_create, &c, 0, NULL);
+        snprintf(name, sizeof(name), "add_%dx%d", n, n);
+        bench_run(name, run_add, &c, elems, "elem/s");
+        snprintf(name, sizeof(name), "subtract_%dx%d", n, n);
+        bench_run(name, run_subtract, &c, elems, "elem/s");
+        snprintf(name, sizeof(name), "multiply_%dx%d", n, n);
+        bench_run(name, run_multiply, &c, 2.0 * elems * n, "FLOP/s");
+
+        destroy_matrix(c.a);
+        destroy_matrix(c.b);
+    }
+    return bench_finish();
+}
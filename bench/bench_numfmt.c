@@ -0,0 +1,176 @@
+/*
+    FILE: bench_numfmt.c
+    DESCRIPTION:
+        Benchmark da formatação de doubles: compara snprintf com as rotinas
+        de numfmt.h (precisão fixa e mínima exata). Antes de medir, verifica
+        a ida e volta de valores aleatórios contra strtod, se a saída mínima
+        é de fato a mais curta e se a precisão fixa reproduz "%.*f".
+        Uso: bench_numfmt [opções do harness]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "numfmt.h"
+#include "harness.h"
+
+#define N_VALUES 4096
+#define N_VERIFY 1000000
+#define N_VERIFY_SLOW 200000  // Verificações que chamam snprintf várias vezes por valor
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ull;
+static double values[N_VALUES];
+
+/* Gerador xorshift64 (determinístico entre execuções) */
+static uint64_t xorshift64(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+/* Verifica numfmt_double_shortest contra strtod em padrões de bits aleatórios */
+static long verify_round_trip(long count) {
+    char buf[NUMFMT_DOUBLE_BUFSZ];
+    long failures = 0;
+    for (long i = 0; i < count; i++) {
+        uint64_t bits = xorshift64();
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (value != value || value - value != 0) continue;  // NaN ou infinito
+
+        numfmt_double_shortest(buf, value);
+        if (strtod(buf, NULL) != value) {
+            if (failures < 10) fprintf(stderr, "Falha: %a -> %s\n", value, buf);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+/* Número de dígitos significativos de uma saída de numfmt_double_shortest */
+static int significant_digits(const char *s) {
+    char d[NUMFMT_DOUBLE_BUFSZ];
+    int n = 0;
+    for (; *s && *s != 'e'; s++) {
+        if (*s >= '0' && *s <= '9' && (n > 0 || *s != '0')) d[n++] = *s;
+    }
+    while (n > 1 && d[n - 1] == '0') n--;
+    return n;
+}
+
+/* Verifica se numfmt_double_shortest usa o menor número de dígitos: a
+   menor precisão de "%.*e" que strtod lê de volta */
+static long verify_shortest(long count) {
+    char buf[NUMFMT_DOUBLE_BUFSZ], ref[40];
+    long failures = 0;
+    for (long i = 0; i < count; i++) {
+        uint64_t bits = xorshift64();
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (value != value || value - value != 0 || value == 0) continue;
+
+        int p = 1;
+        for (; p < 17; p++) {
+            snprintf(ref, sizeof(ref), "%.*e", p - 1, value);
+            if (strtod(ref, NULL) == value) break;
+        }
+        numfmt_double_shortest(buf, value);
+        if (significant_digits(buf) > p) {
+            if (failures < 10) fprintf(stderr, "Não mínima: %a -> %s (%d dígitos bastam)\n", value, buf, p);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+/* Verifica numfmt_double_fixed contra snprintf("%.*f") em todas as precisões,
+   com padrões de bits aleatórios e magnitudes em torno de 2^53 */
+static long verify_fixed(long count) {
+    static char buf[NUMFMT_DOUBLE_BUFSZ], ref[NUMFMT_DOUBLE_BUFSZ];
+    long failures = 0;
+    for (long i = 0; i < count; i++) {
+        uint64_t bits = xorshift64();
+        double value;
+        if (i & 1) {
+            value = ldexp((double)(bits >> 11), (int)(bits % 80) - 60);
+            if (bits & 1024) value = -value;
+        } else {
+            memcpy(&value, &bits, sizeof(value));
+            if (value != value || value - value != 0) continue;
+        }
+
+        int precision = (int)(i / 2 % (NUMFMT_MAX_PRECISION + 1));
+        numfmt_double_fixed(buf, value, precision);
+        snprintf(ref, sizeof(ref), "%.*f", precision, value);
+        if (strcmp(buf, ref) != 0) {
+            if (failures < 10) fprintf(stderr, "Falha: %a (%d casas) -> %s, esperado %s\n", value, precision, buf, ref);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+static void run_printf_fixed(void *ctx, long iters) {
+    (void)ctx;
+    char buf[NUMFMT_DOUBLE_BUFSZ];
+    size_t sink = 0;
+    for (long i = 0; i < iters; i++)
+        sink += (size_t)snprintf(buf, sizeof(buf), "%.4f", values[i & (N_VALUES - 1)]);
+    bench_sink += sink;
+}
+
+static void run_numfmt_fixed(void *ctx, long iters) {
+    (void)ctx;
+    char buf[NUMFMT_DOUBLE_BUFSZ];
+    size_t sink = 0;
+    for (long i = 0; i < iters; i++) sink += numfmt_double_fixed(buf, values[i & (N_VALUES - 1)], 4);
+    bench_sink += sink;
+}
+
+static void run_printf_g(void *ctx, long iters) {
+    (void)ctx;
+    char buf[NUMFMT_DOUBLE_BUFSZ];
+    size_t sink = 0;
+    for (long i = 0; i < iters; i++)
+        sink += (size_t)snprintf(buf, sizeof(buf), "%.17g", values[i & (N_VALUES - 1)]);
+    bench_sink += sink;
+}
+
+static void run_numfmt_shortest(void *ctx, long iters) {
+    (void)ctx;
+    char buf[NUMFMT_DOUBLE_BUFSZ];
+    size_t sink = 0;
+    for (long i = 0; i < iters; i++) sink += numfmt_double_shortest(buf, values[i & (N_VALUES - 1)]);
+    bench_sink += sink;
+}
+
+int main(int argc, char **argv) {
+    if (bench_init("numfmt", argc, argv) != 0) return EXIT_FAILURE;
+
+    long failures = verify_round_trip(N_VERIFY);
+    printf("   round-trip: %d valores, %ld falhas\n", N_VERIFY, failures);
+    if (failures) return EXIT_FAILURE;
+    failures = verify_shortest(N_VERIFY_SLOW);
+    printf("   mais curta: %d valores, %ld falhas\n", N_VERIFY_SLOW, failures);
+    if (failures) return EXIT_FAILURE;
+    failures = verify_fixed(N_VERIFY_SLOW);
+    printf("   precisão fixa x %%.*f: %d valores, %ld falhas\n", N_VERIFY_SLOW, failures);
+    if (failures) return EXIT_FAILURE;
+
+    // Valores típicos de telemetria: magnitudes entre 1e-3 e 1e2
+    for (int i = 0; i < N_VALUES; i++) {
+        values[i] = ((double)(xorshift64() % 2000000) - 1000000.0) / 10000.0;
+    }
+
+    bench_run("snprintf_fixed4", run_printf_fixed, NULL, 0, NULL);
+    bench_run("numfmt_double_fixed4", run_numfmt_fixed, NULL, 0, NULL);
+    bench_run("snprintf_g17", run_printf_g, NULL, 0, NULL);
+    bench_run("numfmt_double_shortest", run_numfmt_shortest, NULL, 0, NULL);
+    return bench_finish();
+}
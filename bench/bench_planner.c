@@ -0,0 +1,139 @@
+/*
+    FILE: bench_planner.c
+    DESCRIPTION:
+        Custo das buscas de planner.h numa grade aleatória de 4096 x 4096
+        células (~10% ocupada por retângulos, semente fixa), de um canto ao
+        oposto: A*, JPS, o planejamento inicial do D* Lite e o
+        replanejamento incremental quando um bloco surge no caminho e
+        depois some (dois replanejamentos por operação). Também mede a
+        suavização do caminho em amostras de trajetória (plan_to_samples).
+        Uso: bench_planner [opções do harness]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "planner.h"
+#include "harness.h"
+
+#define GRID_SIZE 4096
+#define BLOCK 6       // Lado do bloco que surge no caminho (células)
+#define AHEAD 200     // Posição do bloco no caminho (células a partir da partida)
+
+typedef struct {
+    OccupancyGrid grid;
+    Planner planner;
+    DStarLite dstar;
+    PlanPath path;
+    int32_t block[BLOCK * BLOCK];
+    int n_block;
+    int sx, sy, gx, gy;
+} PlannerCase;
+
+static PlannerCase pc;
+
+static int setup(PlannerCase *c) {
+    const int n = GRID_SIZE, span = n / 32;
+    if (grid_init(&c->grid, n, n, 0.1) != 0) return -1;
+    srand(1);
+    for (long k = 0; k < (long)n * n / (span * span * 3); k++) {
+        int x = rand() % n, y = rand() % n;
+        grid_fill_rect(&c->grid, x, y, x + 1 + rand() % span, y + 1 + rand() % span, 1);
+    }
+    grid_fill_rect(&c->grid, 0, 0, n / 16, n / 16, 0);
+    grid_fill_rect(&c->grid, n - 1 - n / 16, n - 1 - n / 16, n - 1, n - 1, 0);
+    c->sx = c->sy = 2;
+    c->gx = c->gy = n - 3;
+    if (planner_init(&c->planner, &c->grid) != 0 || dstar_init(&c->dstar, &c->grid) != 0) return -1;
+    if (planner_search(&c->planner, PLANNER_JPS, c->sx, c->sy, c->gx, c->gy, &c->path) != 0 ||
+        c->path.count <= AHEAD) {
+        fprintf(stderr, "[ERRO] Grade de teste sem caminho\n");
+        return -1;
+    }
+
+    // Bloco livre centrado numa célula do caminho, longe da partida e do destino
+    int32_t mid = c->path.cells[AHEAD];
+    int bx = mid % n - BLOCK / 2, by = mid / n - BLOCK / 2;
+    for (int y = by; y < by + BLOCK; y++)
+        for (int x = bx; x < bx + BLOCK; x++)
+            if (!grid_occupied(&c->grid, x, y)) c->block[c->n_block++] = y * n + x;
+
+    dstar_reset(&c->dstar, c->sx, c->sy, c->gx, c->gy);
+    return dstar_replan(&c->dstar, &c->path);
+}
+
+static void set_block(PlannerCase *c, int occupied) {
+    for (int i = 0; i < c->n_block; i++)
+        grid_set(&c->grid, c->block[i] % GRID_SIZE, c->block[i] / GRID_SIZE, occupied);
+}
+
+static void run_astar(void *ctx, long iters) {
+    PlannerCase *c = ctx;
+    for (long i = 0; i < iters; i++) {
+        planner_search(&c->planner, PLANNER_ASTAR, c->sx, c->sy, c->gx, c->gy, &c->path);
+        bench_sink += c->path.cost;
+    }
+}
+
+static void run_jps(void *ctx, long iters) {
+    PlannerCase *c = ctx;
+    for (long i = 0; i < iters; i++) {
+        planner_search(&c->planner, PLANNER_JPS, c->sx, c->sy, c->gx, c->gy, &c->path);
+        bench_sink += c->path.cost;
+    }
+}
+
+static void run_dstar_initial(void *ctx, long iters) {
+    PlannerCase *c = ctx;
+    for (long i = 0; i < iters; i++) {
+        dstar_reset(&c->dstar, c->sx, c->sy, c->gx, c->gy);
+        dstar_replan(&c->dstar, &c->path);
+        bench_sink += c->path.cost;
+    }
+}
+
+static void run_dstar_replan(void *ctx, long iters) {
+    PlannerCase *c = ctx;
+    for (long i = 0; i < iters; i++) {
+        for (int occupied = 1; occupied >= 0; occupied--) {
+            set_block(c, occupied);
+            dstar_cells_changed(&c->dstar, c->block, c->n_block);
+            dstar_replan(&c->dstar, &c->path);
+            bench_sink += c->path.cost;
+        }
+    }
+}
+
+static void run_smooth(void *ctx, long iters) {
+    PlannerCase *c = ctx;
+    const PlanProfile prof = { 0.5, 0.5, 0.3, 0.01 };
+    for (long i = 0; i < iters; i++) {
+        TrajSample *samples;
+        size_t count;
+        if (plan_to_samples(&c->grid, &c->path, &prof, &samples, &count) != 0) continue;
+        bench_sink += samples[count / 2].x;
+        free(samples);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (bench_init("planner", argc, argv) != 0) return EXIT_FAILURE;
+    if (setup(&pc) != 0) return EXIT_FAILURE;
+
+    bench_run("planner_astar_4096", run_astar, &pc, 1.0, "buscas/s");
+    bench_run("planner_jps_4096", run_jps, &pc, 1.0, "buscas/s");
+    bench_run("dstar_initial_4096", run_dstar_initial, &pc, 1.0, "buscas/s");
+    bench_run("dstar_replan_4096", run_dstar_replan, &pc, 2.0, "replan/s");
+
+    // A suavização parte do caminho atual (o do D* Lite, igual ao ótimo)
+    dstar_replan(&pc.dstar, &pc.path);
+    bench_run("plan_to_samples", run_smooth, &pc, 1.0, "caminhos/s");
+
+    plan_path_free(&pc.path);
+    dstar_destroy(&pc.dstar);
+    planner_destroy(&pc.planner);
+    grid_free(&pc.grid);
+    return bench_finish();
+}
@@ -0,0 +1,140 @@
+/*
+    FILE: bench_telemetry.c
+    DESCRIPTION:
+        Vazão sustentada do registro em disco, em linhas por segundo: cada
+        operação abre o arquivo, grava ROWS linhas de CSV no formato do
+        registro e o fecha (incluindo o esvaziamento dos buffers). Compara
+        o registro antigo (fwrite + fflush a cada linha, na própria thread)
+        com telemetry.h em cada política. Ao final, mede a latência de
+        cada chamada de escrita vista pela thread que amostra (p99 e
+        máximo), que é o que atrasa a amostra seguinte; como as linhas
+        chegam sem intervalo, o anel enche e o máximo inclui as esperas
+        pelo disco que, no ritmo do registro, não ocorrem.
+        O arquivo é gravado em build/ (disco, não tmpfs) e removido no fim.
+        Uso: bench_telemetry [opções do harness]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include "telemetry.h"
+#include "logger_thread.h"
+#include "harness.h"
+
+#define ROWS 16384              // Linhas por operação (~1,4 MB)
+#define TABLE 1024              // Linhas distintas pré-formatadas
+#define OUT_FILE "build/bench_telemetry.csv"
+#define HEADER "t,xref,yref,x1,x2,x3,y1,y2,v1,v2,u1,u2\n"
+
+typedef struct {
+    char text[TABLE][LOGGER_LINE_MAX];
+    size_t len[TABLE];
+    ScenarioConfig cfg;  // Política, buffers e entrega do caso corrente
+} TelemetryCase;
+
+static TelemetryCase tc;
+
+/* Linhas com a mesma formatação do registro (t com 2 casas, demais com 4) */
+static void make_rows(TelemetryCase *c) {
+    for (int i = 0; i < TABLE; i++) {
+        double t = i * 0.05;
+        size_t n = numfmt_double_fixed(c->text[i], t, 2);
+        for (int k = 1; k < CSV_COLUMNS; k++) {
+            c->text[i][n++] = ',';
+            n += numfmt_double_fixed(c->text[i] + n, 1.5 * sin(0.7 * t + k) - 0.01 * k, 4);
+        }
+        c->text[i][n++] = '\n';
+        c->len[i] = n;
+    }
+}
+
+static void run_fflush(void *ctx, long iters) {
+    TelemetryCase *c = ctx;
+    for (long it = 0; it < iters; it++) {
+        FILE *file = fopen(OUT_FILE, "w");
+        if (!file) return;
+        fputs(HEADER, file);
+        for (int i = 0; i < ROWS; i++) {
+            fwrite(c->text[i % TABLE], 1, c->len[i % TABLE], file);
+            fflush(file);
+        }
+        fclose(file);
+    }
+}
+
+static void run_telemetry(void *ctx, long iters) {
+    TelemetryCase *c = ctx;
+    static TelemetryWriter w;
+    for (long it = 0; it < iters; it++) {
+        if (telemetry_open(&w, OUT_FILE, &c->cfg, HEADER) != 0) return;
+        for (int i = 0; i < ROWS; i++) telemetry_write(&w, c->text[i % TABLE], c->len[i % TABLE]);
+        bench_sink += telemetry_close(&w);
+    }
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Latência de cada escrita vista pela amostragem numa operação completa */
+static void row_latency(const char *name, TelemetryCase *c, int old) {
+    static double lat[ROWS];
+    static TelemetryWriter w;
+    FILE *file = NULL;
+    if (old ? !(file = fopen(OUT_FILE, "w")) : telemetry_open(&w, OUT_FILE, &c->cfg, HEADER) != 0) return;
+    for (int i = 0; i < ROWS; i++) {
+        double t0 = now_ns();
+        if (old) {
+            fwrite(c->text[i % TABLE], 1, c->len[i % TABLE], file);
+            fflush(file);
+        } else {
+            telemetry_write(&w, c->text[i % TABLE], c->len[i % TABLE]);
+        }
+        lat[i] = now_ns() - t0;
+    }
+    if (old) fclose(file);
+    else telemetry_close(&w);
+    qsort(lat, ROWS, sizeof(double), compare_double);
+    printf("   %-34s %10.1f %10.1f %10.1f\n", name, lat[ROWS / 2], lat[(int)(0.99 * ROWS)], lat[ROWS - 1]);
+}
+
+int main(int argc, char **argv) {
+    if (bench_init("telemetry", argc, argv) != 0) return EXIT_FAILURE;
+    make_rows(&tc);
+    scenario_set_defaults(&tc.cfg);
+    tc.cfg.telemetry_flush_ms = 0;  // Só buffers cheios: vazão do caminho em regime
+
+    static const char *POLICIES[] = { "buffered", "fdatasync", "direct" };
+    char name[64];
+    bench_run("fflush_por_linha", run_fflush, &tc, ROWS, "linhas/s");
+    for (int p = 0; p < 3; p++) {
+        strcpy(tc.cfg.telemetry_io, POLICIES[p]);
+        snprintf(name, sizeof(name), "telemetry_%s", POLICIES[p]);
+        bench_run(name, run_telemetry, &tc, ROWS, "linhas/s");
+    }
+
+    printf("   %-34s %10s %10s %10s\n", "escrita de uma linha (ns)", "p50", "p99", "máx");
+    row_latency("fflush_por_linha", &tc, 1);
+    for (int p = 0; p < 3; p++) {
+        strcpy(tc.cfg.telemetry_io, POLICIES[p]);
+        snprintf(name, sizeof(name), "telemetry_%s", POLICIES[p]);
+        row_latency(name, &tc, 0);
+    }
+
+    unlink(OUT_FILE);
+    return bench_finish();
+}
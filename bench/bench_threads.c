@@ -0,0 +1,161 @@
+/*
+    FILE: bench_threads.c
+    DESCRIPTION:
+        Benchmark do corpo de uma ativação de cada thread periódica
+        (threads.h), isolado da espera pelo próximo período: leitura dos
+        monitores, cálculo e publicação. Os monitores são inicializados como
+        em main; o gerador de referências avança o relógio a cada ativação,
+        como em regime. O registro e a interface formatam em um buffer.
+        Uso: bench_threads [opções do harness]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "threads.h"
+#include "harness.h"
+
+// Sistema completo (monitores e argumentos de todas as threads)
+typedef struct {
+    ScenarioConfig cfg;
+    Trajectory traj;
+    MonitorEstado estado;
+    MonitorComando comando;
+    MonitorLinearizacao linearizacao;
+    MonitorReferencia referencia;
+    MonitorModeloRef modeloX, modeloY;
+    MonitorParametros parametros;
+    MonitorTempo tempo;
+    MonitorMetricas metricas;
+    MonitorIdades idades;
+    SnapshotHub global;
+    Metrics metrics;
+
+    ArgsSim sim;
+    ArgsLin lin;
+    ArgsCtrl ctrl;
+    ArgsModel modelx, modely, ref;
+    ArgsInterface intf;
+    ArgsLogger logger;
+    ArgsMetrics met;
+} System;
+
+static System sys;
+
+static int system_init(System *s) {
+    scenario_set_defaults(&s->cfg);
+    if (scenario_validate(&s->cfg) != 0 || trajectory_load(&s->traj, &s->cfg) != 0) return -1;
+    const ScenarioConfig *cfg = &s->cfg;
+
+    pthread_mutex_init(&s->estado.mutex, NULL);
+    pthread_mutex_init(&s->comando.mutex, NULL);
+    pthread_mutex_init(&s->linearizacao.mutex, NULL);
+    pthread_mutex_init(&s->referencia.mutex, NULL);
+    pthread_mutex_init(&s->modeloX.mutex, NULL);
+    pthread_mutex_init(&s->modeloY.mutex, NULL);
+    pthread_mutex_init(&s->parametros.mutex, NULL);
+    pthread_mutex_init(&s->tempo.mutex, NULL);
+    pthread_mutex_init(&s->metricas.mutex, NULL);
+    pthread_mutex_init(&s->idades.mutex, NULL);
+    snapshot_init(&s->global);
+
+    ref_preview_init(&s->referencia.preview, cfg->preview_dt);
+    ref_preview_fill(&s->referencia.preview, &s->traj, cfg->preview_horizon_s, data_age_now());
+    s->parametros.alpha1 = cfg->alpha1;
+    s->parametros.alpha2 = cfg->alpha2;
+    s->tempo.intervalo = cfg->timer_interval_ms / 1000.0;
+    clock_gettime(CLOCK_MONOTONIC, &s->tempo.marca);
+    metrics_init(&s->metrics, cfg);
+
+    s->sim    = (ArgsSim){ &s->estado, &s->linearizacao, &s->tempo, cfg, &s->idades, &s->global, &s->referencia, NULL };
+    s->lin    = (ArgsLin){ &s->estado, &s->comando, &s->linearizacao, &s->tempo, cfg, NULL, &s->idades };
+    s->ctrl   = (ArgsCtrl){ &s->estado, &s->modeloX, &s->modeloY, &s->parametros, &s->comando,
+                            &s->tempo, cfg, &s->referencia, NULL, &s->idades, &s->global, NULL, NULL, NULL };
+    s->modelx = (ArgsModel){ &s->referencia, &s->modeloX, &s->parametros, &s->tempo, cfg, NULL, &s->global, NULL };
+    s->modely = (ArgsModel){ &s->referencia, &s->modeloY, &s->parametros, &s->tempo, cfg, NULL, &s->global, NULL };
+    s->ref    = (ArgsModel){ &s->referencia, NULL, NULL, &s->tempo, cfg, &s->traj, &s->global, NULL };
+    s->intf   = (ArgsInterface){ &s->parametros, &s->estado, &s->referencia, &s->tempo, cfg, &s->metricas, &s->global };
+    s->logger = (ArgsLogger){ &s->estado, &s->referencia, &s->comando, &s->linearizacao, &s->tempo, cfg,
+                              &s->global, NULL };
+    s->met    = (ArgsMetrics){ &s->estado, &s->referencia, &s->modeloX, &s->modeloY, &s->comando,
+                               &s->linearizacao, &s->metricas, &s->tempo, cfg, &s->global };
+    return 0;
+}
+
+static void run_ref_generator(void *ctx, long iters) {
+    System *s = ctx;
+    double dt = s->cfg.ref_period_ms / 1000.0;
+    for (long i = 0; i < iters; i++) {
+        s->tempo.tempo_atual += dt;  // Regime: cada ativação estende o horizonte
+        ref_generator_step(&s->ref);
+    }
+}
+
+static void run_model_ref_x(void *ctx, long iters) {
+    System *s = ctx;
+    for (long i = 0; i < iters; i++) model_ref_x_step(&s->modelx);
+}
+
+static void run_model_ref_y(void *ctx, long iters) {
+    System *s = ctx;
+    for (long i = 0; i < iters; i++) model_ref_y_step(&s->modely);
+}
+
+static void run_control(void *ctx, long iters) {
+    System *s = ctx;
+    for (long i = 0; i < iters; i++) control_step(&s->ctrl);
+}
+
+static void run_linearization(void *ctx, long iters) {
+    System *s = ctx;
+    for (long i = 0; i < iters; i++) linearization_step(&s->lin);
+}
+
+static void run_sim(void *ctx, long iters) {
+    System *s = ctx;
+    for (long i = 0; i < iters; i++) sim_step(&s->sim);
+}
+
+static void run_metrics(void *ctx, long iters) {
+    System *s = ctx;
+    for (long i = 0; i < iters; i++) metrics_step(&s->met, &s->metrics);
+}
+
+static void run_logger(void *ctx, long iters) {
+    System *s = ctx;
+    char line[LOGGER_LINE_MAX];
+    size_t sink = 0;
+    for (long i = 0; i < iters; i++) sink += logger_step(&s->logger, line);
+    bench_sink += sink;
+}
+
+static void run_interface(void *ctx, long iters) {
+    System *s = ctx;
+    char line[INTERFACE_LINE_MAX];
+    size_t sink = 0;
+    for (long i = 0; i < iters; i++) sink += interface_step(&s->intf, s->tempo.tempo_atual, line);
+    bench_sink += sink;
+}
+
+int main(int argc, char **argv) {
+    if (bench_init("threads", argc, argv) != 0) return EXIT_FAILURE;
+    if (system_init(&sys) != 0) return EXIT_FAILURE;
+
+    // Ordem causal do sistema: o gerador roda primeiro e deixa o horizonte preenchido
+    bench_run("ref_generator_step", run_ref_generator, &sys, 0, NULL);
+    bench_run("model_ref_x_step", run_model_ref_x, &sys, 0, NULL);
+    bench_run("model_ref_y_step", run_model_ref_y, &sys, 0, NULL);
+    bench_run("control_step", run_control, &sys, 0, NULL);
+    bench_run("linearization_step", run_linearization, &sys, 0, NULL);
+    bench_run("sim_step", run_sim, &sys, 0, NULL);
+    bench_run("metrics_step", run_metrics, &sys, 0, NULL);
+    bench_run("logger_step", run_logger, &sys, 0, NULL);
+    bench_run("interface_step", run_interface, &sys, 0, NULL);
+
+    trajectory_free(&sys.traj);
+    return bench_finish();
+}
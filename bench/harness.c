@@ -0,0 +1,222 @@
+/*
+    FILE: harness.c
+    DESCRIPTION:
+        Implementa a infraestrutura comum dos benchmarks (harness.h).
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "harness.h"
+
+#ifndef LOG_ENABLED
+#define LOG_ENABLED 1
+#endif
+
+#define MAX_RESULTS 64
+#define MAX_REPS 1000
+#define NAME_MAX_LEN 64
+#define WARMUP_NS 20e6  // Aquecimento mínimo por caso
+
+// Resultado de um caso
+typedef struct {
+    char name[NAME_MAX_LEN];
+    long iters;                 // Operações por lote
+    double min_ns, median_ns, p99_ns, mean_ns;
+    double rate;                // Unidades por segundo (0 se não houver unidade)
+    char unit[16];
+    double baseline_ns;         // Mediana da linha de base (0 se ausente)
+} BenchResult;
+
+// Mediana de um caso na linha de base
+typedef struct {
+    char name[NAME_MAX_LEN];
+    double median_ns;
+} BaselineEntry;
+
+volatile double bench_sink;
+
+static const char *suite_name;
+static const char *json_path;
+static const char *filter;
+static double threshold = 0.10;
+static int reps = 25;
+static double min_batch_ns = 5e6;
+
+static BenchResult results[MAX_RESULTS];
+static int n_results;
+static BaselineEntry baseline[MAX_RESULTS];
+static int n_baseline = -1;  // -1: sem linha de base
+static int regressions;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double time_batch(BenchFn fn, void *ctx, long iters) {
+    double t0 = now_ns();
+    fn(ctx, iters);
+    return now_ns() - t0;
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Lê as medianas de um JSON gravado por bench_finish (um resultado por linha) */
+static int load_baseline(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "[ERRO] Linha de base '%s' não encontrada (rode 'make bench-baseline')\n", path);
+        return -1;
+    }
+    char line[512];
+    n_baseline = 0;
+    while (fgets(line, sizeof(line), f) && n_baseline < MAX_RESULTS) {
+        char *name = strstr(line, "\"name\": \"");
+        char *median = strstr(line, "\"median_ns\": ");
+        if (!name || !median) continue;
+        BaselineEntry *b = &baseline[n_baseline];
+        if (sscanf(name + 9, "%63[^\"]", b->name) == 1 &&
+            sscanf(median + 13, "%lf", &b->median_ns) == 1)
+            n_baseline++;
+    }
+    fclose(f);
+    return 0;
+}
+
+static double baseline_median(const char *name) {
+    for (int i = 0; i < n_baseline; i++)
+        if (strcmp(baseline[i].name, name) == 0) return baseline[i].median_ns;
+    return 0.0;
+}
+
+int bench_init(const char *suite, int argc, char **argv) {
+    suite_name = suite;
+    for (int i = 1; i < argc; i++) {
+        const char *opt = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (!val) {
+            fprintf(stderr, "[ERRO] Opção sem valor: %s\n", opt);
+            return -1;
+        }
+        if (strcmp(opt, "--json") == 0) json_path = val;
+        else if (strcmp(opt, "--filter") == 0) filter = val;
+        else if (strcmp(opt, "--threshold") == 0) threshold = atof(val);
+        else if (strcmp(opt, "--reps") == 0) reps = atoi(val);
+        else if (strcmp(opt, "--min-time") == 0) min_batch_ns = atof(val) * 1e6;
+        else if (strcmp(opt, "--baseline") == 0) {
+            if (load_baseline(val) != 0) return -1;
+        } else {
+            fprintf(stderr, "[ERRO] Opção desconhecida: %s\n", opt);
+            fprintf(stderr, "Uso: %s [--json arq] [--baseline arq] [--threshold x] [--reps n] "
+                            "[--min-time ms] [--filter texto]\n", argv[0]);
+            return -1;
+        }
+        i++;
+    }
+    if (reps < 1) reps = 1;
+    if (reps > MAX_REPS) reps = MAX_REPS;
+
+    printf("== %s (LOG_ENABLED=%d, %d repetições, lote >= %.1f ms)\n",
+           suite, LOG_ENABLED, reps, min_batch_ns / 1e6);
+    if (LOG_ENABLED)
+        printf("   aviso: LOG_DEBUG incluído nas medições; use 'make bench LOG_ENABLED=0'\n");
+    printf("   %-34s %10s %10s %10s %10s\n", "caso (ns/op)", "min", "mediana", "p99", "média");
+    return 0;
+}
+
+void bench_run(const char *name, BenchFn fn, void *ctx, double units_per_op, const char *unit) {
+    if (filter && !strstr(name, filter)) return;
+    if (n_results == MAX_RESULTS) {
+        fprintf(stderr, "[ERRO] Excesso de casos na suíte %s\n", suite_name);
+        return;
+    }
+
+    // Calibração: dobra o lote até atingir o tempo mínimo (também aquece caches e preditores)
+    long iters = 1;
+    double elapsed = time_batch(fn, ctx, iters);
+    while (elapsed < min_batch_ns && iters < (1L << 40)) {
+        double scale = elapsed > 0 ? min_batch_ns / elapsed : 2.0;
+        iters = (long)(iters * (scale > 10.0 ? 10.0 : (scale < 2.0 ? 2.0 : scale)));
+        elapsed = time_batch(fn, ctx, iters);
+    }
+
+    // Aquecimento
+    double warm = 0;
+    for (int k = 0; k < 2 || warm < WARMUP_NS; k++) warm += time_batch(fn, ctx, iters);
+
+    // Repetições
+    static double samples[MAX_REPS];
+    double sum = 0;
+    for (int k = 0; k < reps; k++) {
+        samples[k] = time_batch(fn, ctx, iters) / iters;
+        sum += samples[k];
+    }
+    qsort(samples, reps, sizeof(double), compare_double);
+
+    BenchResult *r = &results[n_results++];
+    snprintf(r->name, sizeof(r->name), "%s", name);
+    r->iters = iters;
+    r->min_ns = samples[0];
+    r->median_ns = (reps % 2) ? samples[reps / 2] : 0.5 * (samples[reps / 2 - 1] + samples[reps / 2]);
+    r->p99_ns = samples[(int)ceil(0.99 * reps) - 1];
+    r->mean_ns = sum / reps;
+    r->rate = unit ? units_per_op * 1e9 / r->median_ns : 0.0;
+    snprintf(r->unit, sizeof(r->unit), "%s", unit ? unit : "");
+
+    printf("   %-34s %10.1f %10.1f %10.1f %10.1f", r->name, r->min_ns, r->median_ns, r->p99_ns, r->mean_ns);
+    if (unit) printf("  (%.4g %s)", r->rate, unit);
+
+    // Comparação com a linha de base pela mediana
+    if (n_baseline >= 0) {
+        r->baseline_ns = baseline_median(name);
+        if (r->baseline_ns > 0) {
+            double ratio = r->median_ns / r->baseline_ns;
+            int regression = ratio > 1.0 + threshold;
+            regressions += regression;
+            printf("  %+.1f%%%s", (ratio - 1.0) * 100.0, regression ? " REGRESSÃO" : "");
+        } else {
+            printf("  (sem linha de base)");
+        }
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+int bench_finish(void) {
+    if (json_path) {
+        FILE *f = fopen(json_path, "w");
+        if (!f) {
+            fprintf(stderr, "[ERRO] Não foi possível criar '%s'\n", json_path);
+            return EXIT_FAILURE;
+        }
+        fprintf(f, "{\n  \"suite\": \"%s\",\n  \"log_enabled\": %d,\n  \"reps\": %d,\n  \"results\": [\n",
+                suite_name, LOG_ENABLED, reps);
+        for (int i = 0; i < n_results; i++) {
+            const BenchResult *r = &results[i];
+            fprintf(f, "    {\"name\": \"%s\", \"iters\": %ld, \"min_ns\": %.3f, \"median_ns\": %.3f, "
+                       "\"p99_ns\": %.3f, \"mean_ns\": %.3f",
+                    r->name, r->iters, r->min_ns, r->median_ns, r->p99_ns, r->mean_ns);
+            if (r->unit[0]) fprintf(f, ", \"rate\": %.6g, \"unit\": \"%s\"", r->rate, r->unit);
+            fprintf(f, "}%s\n", i + 1 < n_results ? "," : "");
+        }
+        fprintf(f, "  ]\n}\n");
+        fclose(f);
+    }
+
+    if (n_baseline >= 0) {
+        printf("   %s: %d regressão(ões) acima de %.0f%% na mediana\n",
+               regressions ? "FALHA" : "OK", regressions, threshold * 100.0);
+    }
+    return regressions ? EXIT_FAILURE : EXIT_SUCCESS;
+}
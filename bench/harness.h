@@ -0,0 +1,37 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+/*
+    FILE: harness.h
+    DESCRIPTION:
+        Infraestrutura comum dos benchmarks. Cada caso é uma função que
+        executa 'iters' operações; o harness calibra o tamanho do lote pelo
+        tempo mínimo, aquece, repete e reporta min/mediana/p99/média em
+        ns por operação (e, opcionalmente, uma taxa em unidades por
+        segundo). Os resultados podem ser gravados em JSON e comparados
+        com uma linha de base gravada anteriormente.
+        Opções comuns: --json arq  --baseline arq  --threshold x
+                       --reps n  --min-time ms  --filter texto
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stddef.h>  // Para size_t
+
+// Caso de benchmark: executa 'iters' operações sobre o contexto
+typedef void (*BenchFn)(void *ctx, long iters);
+
+// Destino dos resultados (impede que o compilador elimine o trabalho medido)
+extern volatile double bench_sink;
+
+/* Lê as opções comuns da linha de comando; retorna -1 em opção inválida */
+int bench_init(const char *suite, int argc, char **argv);
+
+/* Mede um caso. Se unit != NULL, reporta também units_per_op * ops/s na unidade dada */
+void bench_run(const char *name, BenchFn fn, void *ctx, double units_per_op, const char *unit);
+
+/* Grava o JSON e compara com a linha de base; retorna o código de saída do programa */
+int bench_finish(void);
+
+#endif // BENCH_HARNESS_H
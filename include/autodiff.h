@@ -0,0 +1,138 @@
+#ifndef AUTODIFF_H
+#define AUTODIFF_H
+
+/*
+    FILE: autodiff.h
+    DESCRIPTION:
+        Diferenciação automática em modo direto com números duais: cada
+        Dual carrega o valor e as derivadas em relação às AD_DIRS
+        variáveis do uniciclo (x1, x2, θ, u1, u2). O modelo é escrito uma
+        única vez sobre Dual (ad_unicycle_model) e a mesma avaliação
+        entrega o valor e as Jacobianas exatas, sem derivação à mão nem
+        diferenças finitas:
+
+            A = ∂f/∂x (3x3),  B = ∂f/∂u (3x2)   de ẋ = f(x, u) (robot_step)
+            C = ∂h/∂x (2x3)                      de y = h(x) = x + R [cos θ, sin θ]
+
+        As operações são inline: com as sementes constantes, o compilador
+        elimina as componentes estruturalmente nulas. A versão em lote lê
+        os pontos de operação em SoA (um vetor por variável) e escreve as
+        Jacobianas empilhadas em matrizes pré-alocadas (matrix.h).
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <math.h>       // Para sin/cos
+#include "matrix.h"     // Para as Jacobianas em lote
+
+// Direções de derivação (índices de Dual.d)
+enum {
+    AD_X1, AD_X2, AD_X3,  // Estado
+    AD_U1, AD_U2,         // Entradas
+    AD_DIRS
+};
+
+// Número dual com AD_DIRS derivadas parciais
+typedef struct {
+    double v;
+    double d[AD_DIRS];
+} Dual;
+
+// Valor e Jacobianas do uniciclo num ponto de operação
+typedef struct {
+    double f[3];      // ẋ = f(x, u)
+    double y[2];      // y = h(x)
+    double A[3][3];   // ∂f/∂x
+    double B[3][2];   // ∂f/∂u
+    double C[2][3];   // ∂h/∂x
+} UnicycleJacobians;
+
+// ==========================
+// Aritmética dual
+// ==========================
+
+/* Constante (derivadas nulas) */
+static inline Dual ad_const(double v) {
+    Dual r = { v, { 0 } };
+    return r;
+}
+
+/* Variável independente na direção dir */
+static inline Dual ad_var(double v, int dir) {
+    Dual r = ad_const(v);
+    r.d[dir] = 1.0;
+    return r;
+}
+
+static inline Dual ad_add(Dual a, Dual b) {
+    Dual r = { a.v + b.v, { 0 } };
+    for (int i = 0; i < AD_DIRS; i++) r.d[i] = a.d[i] + b.d[i];
+    return r;
+}
+
+static inline Dual ad_sub(Dual a, Dual b) {
+    Dual r = { a.v - b.v, { 0 } };
+    for (int i = 0; i < AD_DIRS; i++) r.d[i] = a.d[i] - b.d[i];
+    return r;
+}
+
+/* Produto: (ab)' = a'b + ab' */
+static inline Dual ad_mul(Dual a, Dual b) {
+    Dual r = { a.v * b.v, { 0 } };
+    for (int i = 0; i < AD_DIRS; i++) r.d[i] = a.d[i] * b.v + a.v * b.d[i];
+    return r;
+}
+
+/* Produto por constante */
+static inline Dual ad_scale(Dual a, double k) {
+    Dual r = { a.v * k, { 0 } };
+    for (int i = 0; i < AD_DIRS; i++) r.d[i] = a.d[i] * k;
+    return r;
+}
+
+/* Seno e cosseno do mesmo argumento numa só avaliação */
+static inline void ad_sincos(Dual a, Dual *s, Dual *c) {
+    double sv = sin(a.v), cv = cos(a.v);
+    s->v = sv;
+    c->v = cv;
+    for (int i = 0; i < AD_DIRS; i++) {
+        s->d[i] = cv * a.d[i];
+        c->d[i] = -sv * a.d[i];
+    }
+}
+
+// ==========================
+// Modelo do uniciclo sobre Dual
+// ==========================
+
+/* Dinâmica ẋ = f(x, u) = (u1 cos θ, u1 sin θ, u2) e saída deslocada
+   y = h(x) = (x1 + R cos θ, x2 + R sin θ), com uma única avaliação de
+   seno e cosseno; quem usa só f tem as contas de y eliminadas pelo
+   compilador */
+static inline void ad_unicycle_model(const Dual x[3], const Dual u[2], double R, Dual f[3], Dual y[2]) {
+    Dual s, c;
+    ad_sincos(x[2], &s, &c);
+    f[0] = ad_mul(u[0], c);
+    f[1] = ad_mul(u[0], s);
+    f[2] = u[1];
+    y[0] = ad_add(x[0], ad_scale(c, R));
+    y[1] = ad_add(x[1], ad_scale(s, R));
+}
+
+// ==========================
+// Jacobianas
+// ==========================
+
+/* Avalia f, h e as Jacobianas A, B e C no ponto (x, u) */
+void ad_unicycle(const double x[3], const double u[2], double R, UnicycleJacobians *out);
+
+/* Jacobianas de n pontos de operação em SoA (x1[i], ..., u2[i]), empilhadas
+   por ponto: A (3n x 3), B (3n x 2) e C (2n x 3), já alocadas; qualquer uma
+   pode ser NULL para não ser escrita. Retorna 0, ou -1 se as dimensões
+   não corresponderem a n. */
+int ad_unicycle_batch(int n, const double *x1, const double *x2, const double *x3,
+                      const double *u1, const double *u2, double R,
+                      Matrix *A, Matrix *B, Matrix *C);
+
+#endif // AUTODIFF_H
@@ -0,0 +1,106 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+/*
+    FILE: checkpoint.h
+    DESCRIPTION:
+        Checkpoint e restauração do estado completo da simulação com
+        threads: valores de todos os monitores (inclusive os modelos de
+        referência), estado local das tarefas (ação integral, estimador com
+        o gerador do ruído dos sensores, acumuladores das métricas) e
+        relógio de simulação.
+        A captura pausa as tarefas entre ativações (supervisor_pause) só
+        pelo tempo de copiar o estado para a memória; a gravação acontece
+        depois, fora da pausa, num arquivo temporário sincronizado em disco
+        e renomeado sobre o destino (o arquivo é sempre um checkpoint
+        inteiro). A restauração prepara os monitores antes da partida das
+        tarefas, e a execução continua do instante capturado: com outras
+        chaves de cenário, vira um ramo "e se" a partir do meio da execução.
+        Não são guardados os carimbos e histogramas de idade dos dados nem
+        os contadores do supervisor (dependem do relógio de parede), nem a
+        partida a quente do MPC (a primeira resolução após restaurar parte
+        do zero).
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>      // Para o relatório
+#include <stdint.h>     // Para a soma de verificação
+#include "monitors.h"   // Para os monitores e o estado das tarefas
+
+#define CHECKPOINT_MAGIC 0x54504B43u  // "CKPT"
+#define CHECKPOINT_VERSION 1u
+
+// Estado do sistema num instante (tamanho fixo, gravado como está)
+typedef struct {
+    double tempo;                     // Relógio de simulação (s)
+    double x1, x2, x3, y1, y2;        // Estado e saída do robô
+    double xe3, ye1, ye2;             // Pose vista pelo controle
+    double v1, v2;                    // Saída do controle
+    double u1, u2;                    // Saída da linearização
+    double xref, yref, dxref, dyref;  // Referência publicada
+    double ymx, dymx, ymy, dymy;      // Modelos de referência
+    double alpha1, alpha2;            // Parâmetros (informativos: a restauração usa os do cenário)
+    Estimator estimador;              // Estimador e gerador do ruído dos sensores
+    IntegralAction integral;          // Integrais da ação integral
+    Metrics metricas;                 // Acumuladores dos indicadores
+} SystemCheckpoint;
+
+// Cabeçalho do arquivo (seguido do SystemCheckpoint)
+typedef struct {
+    unsigned magic;
+    unsigned version;
+    uint64_t size;       // sizeof(SystemCheckpoint)
+    uint64_t checksum;   // FNV-1a do conteúdo
+    double reserved[2];
+} CheckpointFileHeader;
+
+// Custos das capturas feitas durante a execução
+typedef struct {
+    unsigned long capturas;      // Checkpoints gravados
+    unsigned long falhas;        // Gravações que falharam
+    double pausa_total, pausa_max;       // Tarefas retidas (s)
+    double gravacao_total, gravacao_max; // Gravação atômica, fora da pausa (s)
+    double ultimo;               // Tempo de simulação do último checkpoint (s)
+} CheckpointStats;
+
+// Argumentos da thread de checkpoint (e fontes da captura e da restauração)
+typedef struct {
+    MonitorEstado *e;  // Estado do robô
+    MonitorComando *c;  // Comandos de controle
+    MonitorLinearizacao *l;  // Comandos de linearização
+    MonitorReferencia *r;  // Referências e horizonte
+    MonitorModeloRef *mx;  // Modelo de referência na direção X
+    MonitorModeloRef *my;  // Modelo de referência na direção Y
+    MonitorParametros *p;  // Parâmetros de controle
+    MonitorTempo *t;  // Tempo de simulação
+    MonitorMetricas *m;  // Acumuladores e resumo das métricas
+    const ScenarioConfig *cfg;  // Configuração do cenário (somente leitura)
+    Estimator *est;  // Sensores e estimador (da thread do robô)
+    IntegralAction *pi;  // Ação integral (da thread de controle)
+    Supervisor *sv;  // Pausa das tarefas durante a captura
+    CheckpointStats stats;  // Só a thread de checkpoint altera
+} ArgsCheckpoint;
+
+/* Copia o estado de todas as fontes. Sem supervisor_pause, cada monitor é
+   lido de forma consistente, mas não necessariamente no mesmo instante. */
+void checkpoint_capture(const ArgsCheckpoint *a, SystemCheckpoint *ck);
+
+/* Grava de forma atômica (temporário + fsync + rename). Retorna 0 ou -1. */
+int checkpoint_save(const SystemCheckpoint *ck, const char *path);
+
+/* Lê e valida (versão, tamanho e soma de verificação). Retorna 0 ou -1. */
+int checkpoint_load(SystemCheckpoint *ck, const char *path);
+
+/* Restaura o estado antes da partida das tarefas: monitores, estado local,
+   relógio, horizonte de referências (refeito a partir de traj) e o
+   instantâneo global. Os parâmetros α, o modo do estimador e os limites
+   das métricas seguem o cenário atual (é o que muda num ramo "e se"). */
+void checkpoint_restore(const ArgsCheckpoint *a, const SystemCheckpoint *ck,
+                        const Trajectory *traj, SnapshotHub *g);
+
+/* Imprime capturas, pausas e tempos de gravação */
+void checkpoint_print(const CheckpointStats *s, const char *path, FILE *out);
+
+#endif // CHECKPOINT_H
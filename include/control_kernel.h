@@ -0,0 +1,117 @@
+#ifndef CONTROL_KERNEL_H
+#define CONTROL_KERNEL_H
+
+/*
+    FILE: control_kernel.h
+    DESCRIPTION:
+        Backends numéricos das leis do controlador (modelo de referência,
+        controle e linearização) para alvos embarcados: double, float32 e
+        ponto fixo Q16.16 com seno/cosseno por tabela. O backend usado
+        pelas threads e pelo passo puro é escolhido na compilação
+        (make CONTROL_BACKEND=DOUBLE|FLOAT32|Q16); os três são sempre
+        compilados para que a ferramenta build/backends os compare no
+        mesmo cenário. A planta (robot_step) continua em double.
+
+        Cada backend tem:
+          - núcleos nativos (kernel_f32_*, kernel_q16_*), com parâmetros
+            já convertidos, como rodariam no alvo;
+          - a mesma interface em double de control_law.h (sufixos _f64,
+            _f32 e _q16), que converte entradas e saídas na fronteira.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include "scenario.h"     // Para R e limites de saturação
+#include "fixed_point.h"  // Para q16_t
+
+#define CONTROL_BACKEND_DOUBLE 0
+#define CONTROL_BACKEND_FLOAT32 1
+#define CONTROL_BACKEND_Q16 2
+
+#ifndef CONTROL_BACKEND
+#define CONTROL_BACKEND CONTROL_BACKEND_DOUBLE
+#endif
+
+// Parâmetros do controlador em float32
+typedef struct {
+    float v_max, w_max;
+    float u1_max, u2_max;
+    float R;
+} KernelParamsF32;
+
+// Parâmetros do controlador em Q16.16 (1/R pré-calculado: sem divisão no laço)
+typedef struct {
+    q16_t v_max, w_max;
+    q16_t u1_max, u2_max;
+    q16_t inv_R;
+} KernelParamsQ16;
+
+// Leis com a interface em double de control_law.h
+typedef struct {
+    const char *nome;
+    void (*model_ref)(double ref, double alpha, double dt, double *y_m, double *dy_m);
+    void (*control)(const ScenarioConfig *cfg,
+                    double ymx, double dymx, double ymy, double dymy,
+                    double y1, double y2, double alpha1, double alpha2,
+                    double *v1, double *v2);
+    void (*linearization)(const ScenarioConfig *cfg, double theta, double v1, double v2,
+                          double *u1, double *u2);
+} ControlKernel;
+
+extern const ControlKernel control_kernel_double;
+extern const ControlKernel control_kernel_float32;
+extern const ControlKernel control_kernel_q16;
+
+/* Backend escolhido na compilação (CONTROL_BACKEND) */
+extern const ControlKernel *const control_kernel_compiled;
+
+/* ---- float32 ---- */
+
+void kernel_f32_params(const ScenarioConfig *cfg, KernelParamsF32 *p);
+void kernel_f32_model_ref(float ref, float alpha, float dt, float *y_m, float *dy_m);
+void kernel_f32_control(const KernelParamsF32 *p,
+                        float ymx, float dymx, float ymy, float dymy,
+                        float y1, float y2, float alpha1, float alpha2,
+                        float *v1, float *v2);
+void kernel_f32_linearization(const KernelParamsF32 *p, float theta, float v1, float v2,
+                              float *u1, float *u2);
+
+/* ---- Q16.16 ---- */
+
+void kernel_q16_params(const ScenarioConfig *cfg, KernelParamsQ16 *p);
+void kernel_q16_model_ref(q16_t ref, q16_t alpha, q16_t dt, q16_t *y_m, q16_t *dy_m);
+void kernel_q16_control(const KernelParamsQ16 *p,
+                        q16_t ymx, q16_t dymx, q16_t ymy, q16_t dymy,
+                        q16_t y1, q16_t y2, q16_t alpha1, q16_t alpha2,
+                        q16_t *v1, q16_t *v2);
+void kernel_q16_linearization(const KernelParamsQ16 *p, q16_t theta, q16_t v1, q16_t v2,
+                              q16_t *u1, q16_t *u2);
+
+/* ---- Interface em double por backend ---- */
+
+void model_ref_step_f64(double ref, double alpha, double dt, double *y_m, double *dy_m);
+void control_law_f64(const ScenarioConfig *cfg,
+                     double ymx, double dymx, double ymy, double dymy,
+                     double y1, double y2, double alpha1, double alpha2,
+                     double *v1, double *v2);
+void linearization_law_f64(const ScenarioConfig *cfg, double theta, double v1, double v2,
+                           double *u1, double *u2);
+
+void model_ref_step_f32(double ref, double alpha, double dt, double *y_m, double *dy_m);
+void control_law_f32(const ScenarioConfig *cfg,
+                     double ymx, double dymx, double ymy, double dymy,
+                     double y1, double y2, double alpha1, double alpha2,
+                     double *v1, double *v2);
+void linearization_law_f32(const ScenarioConfig *cfg, double theta, double v1, double v2,
+                           double *u1, double *u2);
+
+void model_ref_step_q16(double ref, double alpha, double dt, double *y_m, double *dy_m);
+void control_law_q16(const ScenarioConfig *cfg,
+                     double ymx, double dymx, double ymy, double dymy,
+                     double y1, double y2, double alpha1, double alpha2,
+                     double *v1, double *v2);
+void linearization_law_q16(const ScenarioConfig *cfg, double theta, double v1, double v2,
+                           double *u1, double *u2);
+
+#endif // CONTROL_KERNEL_H
@@ -0,0 +1,74 @@
+#ifndef CONTROL_LAW_H
+#define CONTROL_LAW_H
+
+/*
+    FILE: control_law.h
+    DESCRIPTION:
+        Leis puras (sem estado compartilhado) do robô diferencial:
+        referência em forma de oito, modelo de referência de 1ª ordem,
+        controle por modelo de referência, linearização por realimentação
+        e dinâmica do uniciclo. São usadas pelas threads e pela simulação
+        sem threads (headless), garantindo a mesma matemática em ambos.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include "scenario.h"  // Para R e limites de saturação
+#include "integral.h"  // Para a ação integral em fluxo
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846  // Define M_PI se não estiver definido
+#endif
+
+// Estado do uniciclo e saída deslocada de R à frente
+typedef struct {
+    double x1, x2, x3;  // Posição e orientação
+    double y1, y2;      // Ponto de controle à frente do robô
+} RobotState;
+
+/* Limita value ao intervalo [-limit, limit] */
+static inline double saturate(double value, double limit) {
+    if (value > limit) return limit;
+    if (value < -limit) return -limit;
+    return value;
+}
+
+/* Referência em oito: xref(t), yref(t) com inversão de sentido em t = 10 s */
+void reference_figure8(double t, double *xref, double *yref);
+
+// Leis do controlador: calculadas no backend numérico escolhido na
+// compilação (make CONTROL_BACKEND=DOUBLE|FLOAT32|Q16, ver control_kernel.h)
+
+/* Um passo de Euler do modelo de referência dy_m = alpha (ref - y_m) */
+void model_ref_step(double ref, double alpha, double dt, double *y_m, double *dy_m);
+
+/* Lei de controle v = dy_m + alpha (y_m - y), saturada em v_max/w_max */
+void control_law(const ScenarioConfig *cfg,
+                 double ymx, double dymx, double ymy, double dymy,
+                 double y1, double y2, double alpha1, double alpha2,
+                 double *v1, double *v2);
+
+// Ação integral sobre o erro de rastreamento (ctrl_ki > 0): um integrador
+// em fluxo por direção, O(1) por ativação e sem alocação
+typedef struct {
+    RunningIntegral ex, ey;  // ∫ (ref - y) dt por trapézios
+} IntegralAction;
+
+/* Integrais vazias (início da execução) */
+void integral_action_init(IntegralAction *ia);
+
+/* Incorpora o erro (ex, ey) = ref - y no instante t e soma ctrl_ki ∫e dt
+   ao v da lei (PI). A integral é limitada para que a parcela não passe de
+   ctrl_ki_limit (anti-windup) e v volta a ser saturado em v_max/w_max. */
+void integral_action_apply(IntegralAction *ia, const ScenarioConfig *cfg, double t,
+                           double ex, double ey, double *v1, double *v2);
+
+/* Linearização inversa u = T(theta)^-1 v, saturada em u1_max/u2_max */
+void linearization_law(const ScenarioConfig *cfg, double theta, double v1, double v2,
+                       double *u1, double *u2);
+
+/* Integra o uniciclo por Euler durante dt e recalcula a saída y */
+void robot_step(RobotState *s, double R, double u1, double u2, double dt);
+
+#endif // CONTROL_LAW_H
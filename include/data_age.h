@@ -0,0 +1,92 @@
+#ifndef DATA_AGE_H
+#define DATA_AGE_H
+
+/*
+    FILE: data_age.h
+    DESCRIPTION:
+        Rastreamento da idade dos dados ao longo da cadeia de monitores.
+        Cada publicação em um monitor leva um número de sequência, o
+        instante monotônico da publicação e, para cada fonte (sensor do
+        robô e gerador de referências), o instante da entrada mais antiga
+        daquela fonte que originou o dado. Os consumidores acumulam a idade
+        do que leem em histogramas por caminho; na atuação (robô aplicando
+        u), a idade em relação à origem é a latência sensor→atuação.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>  // Para impressão do relatório
+
+// Fontes de dados da cadeia
+enum {
+    DATA_SRC_ESTADO,      // Estado medido do robô (sim_thread)
+    DATA_SRC_REFERENCIA,  // Referência (gerador / horizonte)
+    DATA_SOURCES
+};
+
+// Caminhos cuja idade é medida
+typedef enum {
+    AGE_ESTADO_CONTROLE,        // Estado lido pelo controle
+    AGE_MODELO_CONTROLE,        // Modelos de referência lidos pelo controle
+    AGE_ESTADO_LINEARIZACAO,    // θ lido pela linearização
+    AGE_COMANDO_LINEARIZACAO,   // v(t) lido pela linearização
+    AGE_LINEARIZACAO_ROBO,      // u(t) aplicado ao robô
+    AGE_SENSOR_ATUACAO,         // Estado medido → u(t) aplicado (ponta a ponta)
+    AGE_REFERENCIA_ATUACAO,     // Referência → u(t) aplicado (ponta a ponta)
+    AGE_PATHS
+} AgePath;
+
+#define AGE_BIN_MS 0.25   // Largura de cada faixa do histograma (ms)
+#define AGE_BINS 1024     // Faixas (até 256 ms; acima disso conta como excesso)
+
+// Carimbo de uma publicação
+typedef struct {
+    unsigned long seq;              // Número da publicação (0: nada publicado)
+    double publicado;               // Instante monotônico da publicação (s)
+    double origem[DATA_SOURCES];    // Entrada mais antiga de cada fonte (s; INFINITY se não depende dela)
+} DataStamp;
+
+// Distribuição das idades observadas em um caminho
+typedef struct {
+    unsigned long counts[AGE_BINS];
+    unsigned long n;           // Leituras registradas
+    unsigned long overflow;    // Leituras acima da última faixa
+    unsigned long repeated;    // Leituras de uma publicação já lida (mesmo seq)
+    unsigned long last_seq;    // Última publicação lida
+    double sum, max;           // Soma e máximo das idades (s)
+} AgeHistogram;
+
+// Resumo de um histograma
+typedef struct {
+    unsigned long n;
+    double mean, p50, p90, p99, max;  // Idades (s)
+    double repeated_ratio;            // Fração de leituras repetidas
+    double overflow_ratio;            // Fração acima da última faixa (os percentis nela valem max)
+} AgeSummary;
+
+/* Instante monotônico atual (s) */
+double data_age_now(void);
+
+/* Publica um dado da fonte src medido no instante now */
+void data_stamp_source(DataStamp *s, int src, double now);
+
+/* Inicia as origens de um dado derivado (nenhuma entrada ainda) */
+void data_stamp_begin(double origem[DATA_SOURCES]);
+
+/* Incorpora uma entrada: cada origem passa a ser a mais antiga */
+void data_stamp_merge(double origem[DATA_SOURCES], const DataStamp *in);
+
+/* Publica um dado derivado com as origens acumuladas */
+void data_stamp_publish(DataStamp *s, const double origem[DATA_SOURCES], double now);
+
+/* Registra a leitura de uma publicação com idade 'age' (s); ignora idades não finitas */
+void age_histogram_add(AgeHistogram *h, double age, unsigned long seq);
+
+/* Resume um histograma (percentis pela borda superior da faixa) */
+void age_histogram_summary(const AgeHistogram *h, AgeSummary *out);
+
+/* Imprime a tabela de idades de todos os caminhos */
+void age_report_print(const AgeHistogram h[AGE_PATHS], FILE *out);
+
+#endif // DATA_AGE_H
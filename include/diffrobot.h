@@ -0,0 +1,122 @@
+#ifndef DIFFROBOT_H
+#define DIFFROBOT_H
+
+/*
+    FILE: diffrobot.h
+    DESCRIPTION:
+        Interface pública da biblioteca libdiffrobot (make lib): simulação
+        reentrante do sistema completo para embutir muitas instâncias
+        independentes num mesmo processo, sem threads e sem estado global.
+
+        Duas camadas:
+          - Passo puro: diffrobot_step lê um DiffRobotState e escreve o
+            próximo, sem efeitos colaterais. O modelo (cenário, tabela e
+            base de tempo) é imutável e pode ser compartilhado entre
+            threads e instâncias; o estado é um valor que pode ser
+            copiado, salvo ou ramificado livremente.
+          - Contexto opaco robot_ctx: dono do cenário, da tabela e dos
+            indicadores, com criação, passo, execução e destruição.
+
+        O escalonamento é o da simulação headless (base de tempo igual ao
+        mdc dos períodos, ordem causal fixa) e os resultados são idênticos
+        bit a bit aos de headless_run. Com controller = mpc, o contexto
+        cria o seu próprio controlador preditivo; o passo continua sem
+        estado global, mas passa a depender da partida a quente do MPC.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include "scenario.h"        // Para períodos, limites e ganhos
+#include "control_law.h"     // Para o estado e as leis do robô
+#include "control_kernel.h"  // Para o backend numérico das leis do controlador
+#include "trajectory.h"      // Para a tabela de referências
+#include "metrics.h"         // Para o resumo dos indicadores
+#include "mpc.h"             // Para o controlador preditivo opcional
+#include "lqr.h"             // Para o LQR com ganhos escalonados opcional
+#include "estimator.h"       // Para a pose estimada vista pelo controle
+
+// Tarefas executadas em um tick (DiffRobotState.ativadas)
+enum {
+    DIFFROBOT_TIMER = 1 << 0,
+    DIFFROBOT_REFERENCIA = 1 << 1,
+    DIFFROBOT_MODELO = 1 << 2,
+    DIFFROBOT_CONTROLE = 1 << 3,
+    DIFFROBOT_LINEARIZACAO = 1 << 4,
+    DIFFROBOT_ROBO = 1 << 5
+};
+
+// Parâmetros imutáveis de uma simulação (compartilháveis entre instâncias)
+typedef struct {
+    const ScenarioConfig *cfg;
+    const Trajectory *traj;
+    const ControlKernel *kernel;  // Leis do controlador (padrão: backend da compilação)
+    Mpc *mpc;             // Controlador preditivo no lugar da lei de controle (NULL por padrão).
+                          // Guarda a partida a quente: um por instância, não compartilhável
+    const Lqr *lqr;       // LQR no lugar da lei de controle (NULL por padrão); tabela
+                          // somente leitura, compartilhável entre instâncias
+    int base_ms;          // Base de tempo (mdc dos períodos)
+    long total_ticks;     // Ticks até o fim do cenário
+} DiffRobotModel;
+
+// Estado dinâmico completo de uma simulação (tipo valor)
+typedef struct {
+    long tick;                      // Ticks da base de tempo já executados
+    double tempo_atual;             // Relógio quantizado (equivalente ao timer_thread)
+    double alpha1, alpha2;          // Ganhos usados nesta execução
+    RobotState robot;               // Estado do robô
+    Estimator est;                  // Sensores e estimador (pose vista pelo controle)
+    double xref, yref;              // Referências publicadas
+    double dxref, dyref;            // Velocidades de feedforward publicadas
+    double ymx, dymx, ymy, dymy;    // Modelos de referência
+    double v1, v2;                  // Saída do controle
+    IntegralAction pi;              // Integrais do erro do modelo (ctrl_ki > 0)
+    double u1, u2;                  // Saída da linearização
+    unsigned long preview_head;     // Amostras do horizonte já publicadas pelo gerador
+    unsigned ativadas;              // Tarefas executadas no último tick (DIFFROBOT_*)
+} DiffRobotState;
+
+// Contexto opaco de uma instância
+typedef struct robot_ctx robot_ctx;
+
+/* Prepara o modelo; cfg e traj devem permanecer válidos enquanto ele for usado */
+void diffrobot_model_init(DiffRobotModel *m, const ScenarioConfig *cfg, const Trajectory *traj);
+
+/* Estado inicial (ganhos do cenário, robô parado e horizonte inicial publicado) */
+void diffrobot_state_init(const DiffRobotModel *m, DiffRobotState *s);
+
+/* Passo puro: executa o tick in->tick e escreve o resultado em out (in e
+   out podem ser o mesmo objeto). Retorna 0, sem alterar out, quando o
+   cenário já terminou. */
+int diffrobot_step(const DiffRobotModel *m, const DiffRobotState *in, DiffRobotState *out);
+
+/* Sinais do tick já executado para o motor de indicadores, com a
+   referência interpolada no instante exato (como a vê o sim_thread) */
+void diffrobot_sample(const DiffRobotModel *m, const DiffRobotState *s, MetricsSample *out);
+
+/* Cria uma instância com cópia do cenário e tabela própria; NULL em caso de erro */
+robot_ctx *robot_ctx_create(const ScenarioConfig *cfg);
+
+/* Cria uma instância que compartilha uma tabela já carregada (somente leitura);
+   traj deve sobreviver à instância */
+robot_ctx *robot_ctx_create_shared(const ScenarioConfig *cfg, const Trajectory *traj);
+
+/* Sobrescreve os ganhos dos modelos de referência antes ou durante a execução */
+void robot_ctx_set_gains(robot_ctx *ctx, double alpha1, double alpha2);
+
+/* Executa um tick; retorna 0 quando o cenário terminou */
+int robot_ctx_step(robot_ctx *ctx);
+
+/* Executa até o fim do cenário e preenche out (opcional) */
+void robot_ctx_run(robot_ctx *ctx, MetricsSummary *out);
+
+/* Estado atual (válido até o próximo passo) */
+const DiffRobotState *robot_ctx_state(const robot_ctx *ctx);
+
+/* Resumo dos indicadores acumulados até o momento */
+void robot_ctx_summary(const robot_ctx *ctx, MetricsSummary *out);
+
+/* Libera a instância (NULL é aceito) */
+void robot_ctx_destroy(robot_ctx *ctx);
+
+#endif // DIFFROBOT_H
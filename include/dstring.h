@@ -14,10 +14,25 @@
 #include "logs.h"     // Para logging de eventos ou erros
 #include <stddef.h>    // Para size_t (tipo de dados para o tamanho da string)
 
+// Capacidade do armazenamento embutido (strings curtas não alocam buffer)
+#define DSTRING_SSO_CAPACITY 23
+
+// Arena de alocação: todas as Dstrings criadas nela são liberadas de uma vez
+typedef struct DstringArena {
+    char *base;        // Início da região de memória
+    size_t size;       // Tamanho total da região
+    size_t used;       // Bytes já entregues
+    int owns_memory;   // 1 se a região foi alocada por dstring_arena_create
+} DstringArena;
+
 // Estrutura de uma string dinâmica
+// Obs.: strings curtas apontam para o próprio cabeçalho; não copie Dstrings por valor.
 typedef struct Dstring {
-    char *buffer;      // Ponteiro para o conteúdo da string
+    char *buffer;      // Ponteiro para o conteúdo (inline_buf ou bloco externo)
     size_t length;     // Tamanho da string (sem o '\0')
+    size_t capacity;   // Capacidade útil do buffer (sem o '\0')
+    DstringArena *arena;  // Arena de origem (NULL: heap)
+    char inline_buf[DSTRING_SSO_CAPACITY + 1];  // Armazenamento de strings curtas
 } Dstring;
 
 // Funções para criação de Dstrings a partir de diferentes tipos de dados
@@ -27,14 +42,30 @@ Dstring *dstring_new_from_int(int value);               // Cria Dstring de um in
 Dstring *dstring_new_from_long(long value);             // Cria Dstring de um long
 Dstring *dstring_new_from_float(float value);           // Cria Dstring de um float
 Dstring *dstring_new_from_double(double value);         // Cria Dstring de um double
+Dstring *dstring_new_from_double_prec(double value, int precision); // Double com 'precision' casas
+Dstring *dstring_new_from_double_shortest(double value); // Double com o mínimo de dígitos exatos
 Dstring *dstring_new_from_dstring(const Dstring *src);  // Cria Dstring a partir de outra Dstring
 
+// Funções para Dstrings em memória do chamador (pilha ou struct), sem alocar o cabeçalho
+void dstring_init_from_char(Dstring *dstr, const char *str); // Inicializa dstr com uma string C
+void dstring_release(Dstring *dstr);                         // Libera apenas o buffer externo
+
+// Funções para arenas de Dstrings
+DstringArena *dstring_arena_create(size_t size);                       // Cria arena com região própria
+void dstring_arena_init(DstringArena *arena, void *memory, size_t size); // Usa região do chamador
+void dstring_arena_reset(DstringArena *arena);                         // Libera todas as Dstrings da arena
+void dstring_arena_destroy(DstringArena *arena);                       // Destroi arena criada por _create
+Dstring *dstring_arena_new_from_char(DstringArena *arena, const char *str);   // Cria Dstring na arena
+Dstring *dstring_arena_new_from_int(DstringArena *arena, int value);          // Inteiro na arena
+Dstring *dstring_arena_new_from_double(DstringArena *arena, double value, int precision); // Double na arena
+
 // Funções para manipulação de Dstrings
 void dstring_concat(Dstring *dest, const Dstring *src);    // Concatena src a dest
+void dstring_append_double(Dstring *dest, double value, int precision); // Anexa um double (precision < 0: mínimo exato)
 size_t dstring_length(const Dstring *dstr);               // Retorna o tamanho da Dstring
 const char *dstring_c_str(const Dstring *dstr);           // Retorna a string C correspondente
 
-// Função para liberar a memória da Dstring
+// Função para liberar a memória da Dstring (sem efeito para Dstrings de arena)
 void dstring_free(Dstring *dstr);
 
 #endif // DSTRING_H
@@ -0,0 +1,75 @@
+#ifndef ESTIMATOR_H
+#define ESTIMATOR_H
+
+/*
+    FILE: estimator.h
+    DESCRIPTION:
+        Estágio de estimação de estado entre o robô e o controlador. Uma
+        camada de sensores gera, a cada passo do robô, a odometria (u
+        aplicado com erro de escala, viés de giro e ruído) e uma medição
+        absoluta ruidosa da pose (x1, x2, θ). O controle e a linearização
+        passam a ler a pose estimada em vez do estado real:
+          - none: estado real (sem sensores, comportamento original);
+          - raw:  a medição ruidosa diretamente;
+          - ekf:  filtro de Kalman estendido de 3 estados, com predição
+                  pela odometria e correção pela medição.
+
+        Todo o estado (pose, covariância 3x3 e gerador de ruído) é de
+        tamanho fixo e cabe num valor copiável: nenhuma alocação por passo.
+        O ruído é determinístico a partir de sensor_seed.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdint.h>         // Para o estado do gerador de ruído
+#include "scenario.h"       // Para o modo e os parâmetros dos sensores
+#include "control_law.h"    // Para RobotState
+
+// Modos do estimador (chave estimator)
+enum {
+    ESTIMATOR_NONE,
+    ESTIMATOR_RAW,
+    ESTIMATOR_EKF
+};
+
+// Filtro de Kalman estendido da pose do uniciclo
+typedef struct {
+    double x[3];        // Estimativa (x1, x2, θ)
+    double P[3][3];     // Covariância do erro
+} Ekf;
+
+// Odometria de um passo: velocidades medidas
+typedef struct {
+    double v, w;
+} Odometry;
+
+// Estado completo do estágio de estimação (tipo valor)
+typedef struct {
+    int mode;           // ESTIMATOR_*
+    uint64_t rng;       // Gerador xorshift64* do ruído dos sensores
+    Ekf ekf;
+    RobotState pose;    // Pose publicada para o controle (com a saída y à frente)
+} Estimator;
+
+/* Prepara o estimador conforme o cenário, a partir da pose real inicial */
+void estimator_init(Estimator *e, const ScenarioConfig *cfg, const RobotState *truth);
+
+/* Um passo do robô: gera odometria e medição a partir do estado real já
+   integrado e dos comandos aplicados durante dt, e atualiza e->pose */
+void estimator_step(Estimator *e, const ScenarioConfig *cfg, const RobotState *truth,
+                    double u1, double u2, double dt);
+
+/* Pose vista pelo controle: a estimada, ou a real com estimator = none */
+static inline const RobotState *estimator_view(const Estimator *e, const RobotState *truth) {
+    return e->mode == ESTIMATOR_NONE ? truth : &e->pose;
+}
+
+/* Predição do EKF pela odometria durante dt; q_v e q_w são as variâncias
+   das velocidades medidas */
+void ekf_predict(Ekf *f, const Odometry *odo, double dt, double q_v, double q_w);
+
+/* Correção do EKF com a medição z = (x1, x2, θ) de variâncias r[3] */
+void ekf_update(Ekf *f, const double z[3], const double r[3]);
+
+#endif // ESTIMATOR_H
@@ -0,0 +1,67 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+/*
+    FILE: fixed_point.h
+    DESCRIPTION:
+        Aritmética em ponto fixo Q16.16 (16 bits inteiros com sinal e 16
+        fracionários) para controladores sem FPU: conversões com saturação,
+        produto com arredondamento em 64 bits e seno/cosseno por tabela de
+        um quarto de onda (257 entradas) com interpolação linear. Faixa
+        representável: [-32768, 32768), resolução 2^-16 ≈ 1.5e-5.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdint.h>  // Para int32_t/int64_t
+
+typedef int32_t q16_t;
+
+#define Q16_ONE ((q16_t)1 << 16)
+
+/* Limita um valor de 64 bits à faixa de q16_t */
+static inline q16_t q16_clamp(int64_t v) {
+    if (v > INT32_MAX) return INT32_MAX;
+    if (v < INT32_MIN) return INT32_MIN;
+    return (q16_t)v;
+}
+
+/* Converte de double (arredonda ao mais próximo e satura fora da faixa) */
+static inline q16_t q16_from_double(double v) {
+    double s = v * Q16_ONE;
+    if (s >= 2147483647.0) return INT32_MAX;
+    if (s <= -2147483648.0) return INT32_MIN;
+    return (q16_t)(s < 0 ? s - 0.5 : s + 0.5);
+}
+
+static inline double q16_to_double(q16_t v) {
+    return v / (double)Q16_ONE;
+}
+
+static inline q16_t q16_add(q16_t a, q16_t b) {
+    return q16_clamp((int64_t)a + b);
+}
+
+static inline q16_t q16_sub(q16_t a, q16_t b) {
+    return q16_clamp((int64_t)a - b);
+}
+
+/* Produto a * b com arredondamento e saturação */
+static inline q16_t q16_mul(q16_t a, q16_t b) {
+    int64_t p = (int64_t)a * b;
+    return q16_clamp((p + (1 << 15)) >> 16);
+}
+
+/* Limita value ao intervalo [-limit, limit] (limit >= 0) */
+static inline q16_t q16_saturate(q16_t value, q16_t limit) {
+    if (value > limit) return limit;
+    if (value < -limit) return -limit;
+    return value;
+}
+
+/* Seno e cosseno de um ângulo em radianos (qualquer faixa representável) */
+q16_t q16_sin(q16_t theta);
+q16_t q16_cos(q16_t theta);
+
+#endif // FIXED_POINT_H
@@ -0,0 +1,138 @@
+#ifndef FLEET_H
+#define FLEET_H
+
+/*
+    FILE: fleet.h
+    DESCRIPTION:
+        Simulação de frotas (1k–100k robôs diferenciais) num mesmo espaço,
+        sem threads por tarefa. Cada robô segue a sua própria referência
+        com as leis de control_law.h, no escalonamento multitaxa da
+        simulação headless. O estado é guardado em SoA (um vetor por
+        grandeza) e a vizinhança é indexada por uma grade uniforme com
+        hash espacial (célula de lado fleet_radius), atualizada de forma
+        incremental: só os robôs que trocaram de célula são movidos.
+
+        A cada passo do robô, as leis e a planta rodam em paralelo por
+        faixas de robôs, o índice é atualizado e as consultas de
+        vizinhança rodam em paralelo por faixas de células (baldes do
+        hash), cada robô examinando as 3x3 células ao seu redor.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <pthread.h>      // Para o grupo de trabalhadores
+#include <stdint.h>       // Para os índices do hash
+#include <stdalign.h>     // Para separar os contadores por thread
+#include "scenario.h"     // Para períodos, leis e parâmetros da frota
+#include "trajectory.h"   // Para a tabela de referências compartilhada
+
+#define FLEET_MAX_SIZE 1000000  // Maior frota aceita (índices e buckets do hash em 32 bits)
+
+struct Fleet;
+typedef void (*FleetJob)(struct Fleet *f, int part, int parts);
+
+// Argumento de cada trabalhador
+typedef struct {
+    struct Fleet *f;
+    int part;
+} FleetWorker;
+
+// Grupo fixo de trabalhadores: o chamador executa a parte 0
+typedef struct {
+    pthread_t *threads;
+    FleetWorker *workers;
+    int n_threads;            // Trabalhadores além do chamador
+    pthread_mutex_t mutex;
+    pthread_cond_t start, done;
+    unsigned long generation; // Incrementado a cada tarefa distribuída
+    int pending;              // Trabalhadores ainda ocupados
+    int stop;
+    FleetJob job;
+} FleetPool;
+
+// Grade uniforme com hash espacial e listas duplamente encadeadas intrusivas
+typedef struct {
+    double cell;              // Lado da célula (m)
+    double inv_cell;
+    uint32_t mask;            // Baldes - 1 (potência de 2)
+    int32_t *head;            // Primeiro robô de cada balde (-1 vazio)
+    int32_t *next, *prev;     // Encadeamento por robô
+    int32_t *cx, *cy;         // Célula atual de cada robô
+    uint32_t *bucket;         // Balde atual de cada robô
+} FleetGrid;
+
+// Contadores de uma parte das consultas (linha de cache própria)
+typedef struct {
+    alignas(64) long checks;
+    long collisions;
+    double min_d2;            // Menor distância² observada
+} FleetPart;
+
+// Indicadores acumulados da frota
+typedef struct {
+    long steps;               // Passos do robô executados
+    long moves;               // Trocas de célula aplicadas ao índice
+    long pair_checks;         // Pares examinados nas consultas
+    long collisions;          // Pares-passo abaixo de fleet_collision
+    long collisions_now;      // Pares em colisão no último passo
+    double min_distance;      // Menor distância entre dois robôs observada (m)
+    double rms_error;         // RMS de |ref - y| sobre todos os robôs e passos
+} FleetStats;
+
+// Frota completa (estado em SoA)
+typedef struct Fleet {
+    const ScenarioConfig *cfg;
+    const Trajectory *traj;
+    int n;                    // Robôs
+    int base_ms;              // Base de tempo (mdc dos períodos)
+    long tick, total_ticks;
+    int check_neighbors;      // Consultas de vizinhança a cada passo (1 por padrão)
+
+    // Referência própria: deslocamento e atraso da trajetória
+    double *ox, *oy, *delay;
+
+    // Estado do robô, modelos e comandos
+    double *x1, *x2, *x3, *y1, *y2;
+    double *ymx, *dymx, *ymy, *dymy;
+    double *v1, *v2, *u1, *u2;
+    double *ise;              // ∫ |ref - y|² dt por robô
+
+    // Resultado da última consulta por robô
+    double *nearest;          // Distância ao vizinho mais próximo no raio (INFINITY se nenhum)
+    int32_t *neighbors;       // Vizinhos no raio
+
+    int32_t *new_cx, *new_cy; // Célula após o passo (calculada em paralelo)
+    uint8_t *moved;           // Robô trocou de célula no passo
+
+    FleetGrid grid;
+    FleetPool pool;
+    unsigned tasks;           // Tarefas ativas no tick corrente (DIFFROBOT_*)
+    double t;                 // Instante do tick corrente (s)
+
+    FleetPart *parts;         // Contadores das consultas por parte (um por thread)
+
+    FleetStats stats;
+    void *memory;             // Bloco único com todos os vetores
+} Fleet;
+
+/* Aloca a frota de cfg->fleet_size robôs e o grupo de trabalhadores;
+   cfg e traj devem sobreviver à frota. Retorna 0 ou -1. */
+int fleet_init(Fleet *f, const ScenarioConfig *cfg, const Trajectory *traj);
+
+/* Volta ao estado inicial (mesmas alocações e trabalhadores) */
+void fleet_reset(Fleet *f);
+
+/* Executa um tick da base de tempo; retorna 0 quando o cenário terminou */
+int fleet_step(Fleet *f);
+
+/* Consulta os vizinhos de todos os robôs com o índice atual */
+void fleet_query(Fleet *f);
+
+/* Indicadores acumulados até o momento */
+void fleet_stats(const Fleet *f, FleetStats *out);
+
+/* Encerra os trabalhadores e libera a frota */
+void fleet_destroy(Fleet *f);
+
+#endif // FLEET_H
@@ -0,0 +1,62 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+/*
+    FILE: headless.h
+    DESCRIPTION:
+        Simulação sem threads e sem relógio de parede do sistema completo
+        (referência, modelos, controle, linearização e robô). Cada tarefa é
+        disparada em tempo simulado com o mesmo período do cenário, numa
+        ordem causal fixa, de modo que a execução é determinística e roda
+        tão rápido quanto a CPU permite. Usada em varreduras e sintonia.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include "diffrobot.h"    // Para o passo puro (cenário, leis, tabela e indicadores)
+#include "replay.h"       // Para a gravação opcional das leis
+
+// Indicadores de desempenho de uma execução
+typedef struct {
+    double ise;          // ∫ |e|² dt  (e = ref - y)
+    double iae;          // ∫ |e| dt
+    double itae;         // ∫ t |e| dt
+    double rms_error;    // sqrt(ISE / T)
+    double max_error;    // max |e|
+    double effort;       // ∫ (u1² + u2²) dt
+    double sat_ratio;    // Fração das ativações da linearização com saturação
+    double sim_time;     // Tempo simulado (s)
+    double est_rms;      // RMS de |ŷ - y| da pose estimada (0 com estimator = none)
+    MetricsSummary metrics;  // Resumo completo do motor de indicadores
+} HeadlessResult;
+
+// Estado completo de uma simulação headless
+typedef struct {
+    DiffRobotModel model;           // Cenário, tabela e base de tempo (imutáveis)
+    DiffRobotState state;           // Estado avançado pelo passo puro (ganhos inclusos)
+
+    long lin_ticks, sat_ticks;      // Contadores para sat_ratio
+    double est_sq;                  // Σ |ŷ - y|² nos passos do robô (para est_rms)
+    long est_n;
+    Metrics metrics;                // Motor de indicadores (amostrado no período do robô)
+    HeadlessResult result;          // Indicadores derivados
+
+    ReplayRecorder *rec;            // Gravação das leis (NULL por padrão; definir após headless_init)
+} HeadlessSim;
+
+/* Inicializa a simulação com os ganhos alpha1/alpha2 do cenário */
+void headless_init(HeadlessSim *sim, const ScenarioConfig *cfg, const Trajectory *traj);
+
+/* Executa um tick da base de tempo; retorna 0 quando o cenário terminou */
+int headless_step(HeadlessSim *sim);
+
+/* Conclui os indicadores derivados a partir do motor de métricas */
+void headless_finish(HeadlessSim *sim);
+
+/* Executa o cenário inteiro e preenche out (com controller = mpc ou lqr,
+   cria o controlador preditivo ou a tabela de ganhos; em headless_init
+   eles ficam a cargo do chamador, que os liga em sim->model.mpc/lqr) */
+void headless_run(const ScenarioConfig *cfg, const Trajectory *traj, HeadlessResult *out);
+
+#endif // HEADLESS_H
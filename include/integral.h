@@ -5,14 +5,16 @@
     FILE: integral.h
     DESCRIPTION:
         Cabeçalho com funções auxiliares para integração numérica
-        (ex.: regras de soma) utilizadas no controle e simulação do robô.
+        (ex.: regras de soma) utilizadas no controle e simulação do robô,
+        integradores em fluxo, alimentados amostra a amostra, e regras
+        vetorizadas sobre séries amostradas (colunas do registro).
     AUTHOR: Darlysson Lima
-    LAST UPDATE: Julho, 2025
+    LAST UPDATE: Outubro, 2026
     LICENSE: CC BY-SA
 */
 
 #include "logs.h"     // Para registro de logs de integração
-#include <stdlib.h>   // Para alocação de memória
+#include <stdlib.h>   // Para alocação de memória e size_t
 #include <stdio.h>    // Para entrada e saída de dados
 #include <math.h>     // Para funções matemáticas como o cálculo de potências e funções trigonométricas
 
@@ -29,4 +31,132 @@ double midpoint_rule(function_ptr f, double a, double b, int n);
 /* Regra trapezoidal composta para integração numérica */
 double composite_trapezoidal(function_ptr f, double a, double b, int n);
 
+// ==========================
+// Integração em fluxo
+// ==========================
+// As regras acima reintegram [a, b] inteiro a cada chamada: acumular uma
+// grandeza ao longo da simulação (integral do erro, energia, esforço)
+// custaria O(t) por passo. Os integradores abaixo recebem as amostras
+// (t, valor) à medida que chegam e atualizam a soma em O(1), sem alocar.
+
+// Regras da integração em fluxo (amostras com espaçamento livre)
+typedef enum {
+    INTEGRAL_RECT,       // Retângulo à esquerda: a amostra vale até a próxima
+    INTEGRAL_TRAPEZOID,  // Trapézio entre amostras consecutivas
+    INTEGRAL_SIMPSON     // Simpson em pares de intervalos (o intervalo ímpar
+                         // final entra como trapézio provisório)
+} IntegralRule;
+
+// Soma compensada (Neumaier): o erro de arredondamento não cresce com o
+// número de parcelas
+typedef struct {
+    double sum, comp;
+} CompensatedSum;
+
+static inline void compensated_add(CompensatedSum *s, double x) {
+    double t = s->sum + x;
+    if (fabs(s->sum) >= fabs(x)) s->comp += (s->sum - t) + x;
+    else s->comp += (x - t) + s->sum;
+    s->sum = t;
+}
+
+static inline double compensated_value(const CompensatedSum *s) {
+    return s->sum + s->comp;
+}
+
+// Integral acumulada desde a primeira amostra (tipo valor, copiável)
+typedef struct {
+    IntegralRule rule;
+    long samples;           // Amostras aceitas
+    double t0, f0;          // Penúltima amostra (par aberto do Simpson)
+    double t1, f1;          // Última amostra
+    int open;               // Simpson: há um intervalo aguardando o par
+    double pending;         // Parcela provisória do intervalo aberto
+    CompensatedSum total;   // Parcelas fechadas
+} RunningIntegral;
+
+/* Prepara a integral vazia com a regra escolhida */
+void running_integral_init(RunningIntegral *ri, IntegralRule rule);
+
+/* Incorpora a amostra (t, value). Amostras com t não crescente são
+   ignoradas. Retorna a parcela fechada por esta amostra. */
+double running_integral_add(RunningIntegral *ri, double t, double value);
+
+/* Integral da primeira à última amostra */
+static inline double running_integral_value(const RunningIntegral *ri) {
+    return compensated_value(&ri->total) + ri->pending;
+}
+
+/* Limita a integral a [-limit, limit] (anti-windup da ação integral) */
+void running_integral_clamp(RunningIntegral *ri, double limit);
+
+#define SLIDING_INTEGRAL_CAPACITY 256  // Parcelas guardadas na janela
+
+// Integral sobre a janela deslizante [t - window, t]: as parcelas fechadas
+// ficam num anel e saem da soma ao deixar a janela
+typedef struct {
+    RunningIntegral acc;                        // Regra e amostras recentes
+    double window;                              // Largura da janela (s)
+    double start[SLIDING_INTEGRAL_CAPACITY];    // Início de cada parcela
+    double part[SLIDING_INTEGRAL_CAPACITY];     // Valor de cada parcela
+    int head, count;                            // Parcela mais antiga e ocupação
+    CompensatedSum sum;                         // Soma das parcelas no anel
+    long dropped;                               // Parcelas descartadas com o anel cheio
+} SlidingIntegral;
+
+/* Prepara a janela vazia de largura window (s) com a regra escolhida */
+void sliding_integral_init(SlidingIntegral *si, IntegralRule rule, double window);
+
+/* Incorpora a amostra (t, value) e descarta as parcelas que começam antes
+   de t - window (ou a mais antiga, se o anel estiver cheio) */
+void sliding_integral_add(SlidingIntegral *si, double t, double value);
+
+/* Integral sobre as parcelas da janela (com a provisória do Simpson) */
+static inline double sliding_integral_value(const SlidingIntegral *si) {
+    return compensated_value(&si->sum) + si->acc.pending;
+}
+
+/* Intervalo de tempo coberto pela janela atual (s) */
+double sliding_integral_span(const SlidingIntegral *si);
+
+// ==========================
+// Integração de séries amostradas
+// ==========================
+// Integram séries já gravadas (t[i], y[i]), com t crescente e espaçamento
+// livre, como as colunas do registro da simulação. Quando a CPU tem AVX2
+// (verificado em tempo de execução) os laços avançam quatro intervalos por
+// instrução; sem AVX2 usam as versões escalares, que dão o mesmo resultado
+// a menos da ordem das somas.
+
+// Conjunto de instruções usado pelas funções abaixo
+typedef enum {
+    SAMPLES_ISA_SCALAR,
+    SAMPLES_ISA_AVX2
+} SamplesIsa;
+
+/* Melhor conjunto de instruções disponível nesta CPU */
+SamplesIsa samples_isa(void);
+
+/* Nome do conjunto de instruções (para relatórios) */
+const char *samples_isa_name(SamplesIsa isa);
+
+/* ∫ y dt pela regra do trapézio (0 com menos de duas amostras) */
+double samples_trapezoid(const double *t, const double *y, size_t n);
+
+/* ∫ y dt por Simpson em pares de intervalos (t estritamente crescente).
+   Com número ímpar de intervalos, o último usa a parábola pelas três
+   últimas amostras; com duas amostras, o trapézio. */
+double samples_simpson(const double *t, const double *y, size_t n);
+
+/* Integral acumulada pelo trapézio: out[0] = 0 e out[i] = ∫ y dt de t[0]
+   a t[i]. out não pode coincidir com t nem com y. */
+void samples_cumulative_trapezoid(const double *t, const double *y, size_t n,
+                                  double *restrict out);
+
+/* Versões escalares (referência para as versões vetoriais) */
+double samples_trapezoid_scalar(const double *t, const double *y, size_t n);
+double samples_simpson_scalar(const double *t, const double *y, size_t n);
+void samples_cumulative_trapezoid_scalar(const double *t, const double *y, size_t n,
+                                         double *restrict out);
+
 #endif // INTEGRAL_H
@@ -11,7 +11,15 @@
     LICENSE: CC BY-SA
 */
 
+#include <stddef.h>    // Para size_t
 #include "monitors.h"  // Para uso de monitores e sincronização entre threads
+#include "numfmt.h"    // Para o tamanho máximo de cada campo
+
+#define CSV_COLUMNS 12 // Número de colunas de cada linha do CSV
+#define LOGGER_LINE_MAX (CSV_COLUMNS * NUMFMT_DOUBLE_BUFSZ)  // Tamanho máximo de uma linha
+
+/* Monta a linha do CSV com o tick mais recente do instantâneo global; retorna o comprimento */
+size_t logger_step(ArgsLogger *args, char *line);
 
 /* Declara a função da thread de logging */
 void *logger_thread(void *arg);
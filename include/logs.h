@@ -13,6 +13,7 @@
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdlib.h>  // Para exit em LOG_ERROR_AND_EXIT
 
 // Controle de ativação do log
 #ifndef LOG_ENABLED
@@ -49,10 +50,11 @@ static inline void log_internal(const char* level,
 } while (0)
 
 #else
-// Se log estiver desativado, as macros não fazem nada
+// Se log estiver desativado, as macros não escrevem nada; o erro fatal
+// continua encerrando o programa
 #define LOG_DEBUG(...) do {} while (0)
 #define LOG_ERROR(...) do {} while (0)
-#define LOG_ERROR_AND_EXIT(...) do {} while (0)
+#define LOG_ERROR_AND_EXIT(...) exit(EXIT_FAILURE)
 #endif
 
 #endif // LOGS_H
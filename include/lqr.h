@@ -0,0 +1,78 @@
+#ifndef LQR_H
+#define LQR_H
+
+/*
+    FILE: lqr.h
+    DESCRIPTION:
+        Regulador linear quadrático com ganhos escalonados (controller = lqr
+        no cenário). O erro da pose do uniciclo em relação à pose de
+        referência (x1r, x2r, θr), derivada da posição e da velocidade de
+        referência da saída, evolui, linearizado no ponto de operação
+        (θr, vr), como
+
+            e[k+1] = (I + dt A) e[k] + dt B δu[k],   A = ∂f/∂x, B = ∂f/∂u
+
+        (Jacobianas por diferenciação automática, autodiff.h), e o comando
+        é u = (vr, ωr) - K(θr, vr) e. Fora da vizinhança em que a
+        linearização vale, o erro de posição realimentado é limitado a
+        lqr_error_max.
+
+        A equação de Riccati discreta não é resolvida no período do
+        controle: lqr_init a resolve uma vez, com o módulo de matrizes,
+        numa grade de lqr_heading_bins orientações x lqr_speed_bins
+        velocidades (de lqr_speed_min a u1_max) e guarda os ganhos numa
+        tabela compacta, com uma entrada de 32 bytes por ponto. Em cada
+        ativação, lqr_control interpola bilinearmente os quatro vizinhos
+        em O(1), sem alocar nem iterar.
+
+        Como no preditivo, o comando publicado é v = T(θ) u, que a
+        linearização converte de volta exatamente em u.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdalign.h>       // Para o alinhamento das entradas da tabela
+#include "scenario.h"       // Para pesos, grade e limites
+#include "ref_preview.h"    // Para as amostras de referência
+
+#define LQR_MAX_BINS 1024   // Pontos máximos por eixo da grade
+
+// Ganhos de um ponto da grade: K (2x3) por linhas, completado até 32 bytes
+typedef struct {
+    alignas(32) float k[8];
+} LqrGain;
+
+// Tabela de ganhos (somente leitura após lqr_init; compartilhável entre instâncias)
+typedef struct {
+    int n_heading, n_speed;     // Pontos da grade em θ (periódico) e em v
+    double v_min, v_max;        // Faixa de velocidades da grade (m/s)
+    double heading_scale;       // n_heading / 2π
+    double speed_scale;         // (n_speed - 1) / (v_max - v_min)
+    double dt;                  // Período do controle (s)
+    double R;
+    double error_max;           // Maior erro de posição realimentado (m)
+    LqrGain *gains;             // n_speed x n_heading entradas, θ varia mais rápido
+    int max_iter;               // Maior número de iterações de Riccati na grade
+    double build_s;             // Tempo de montagem da tabela (s)
+} Lqr;
+
+/* Resolve a equação de Riccati em toda a grade do cenário e monta a
+   tabela. Retorna 0, ou -1 se a alocação falhar ou a iteração não
+   convergir em algum ponto. */
+int lqr_init(Lqr *lqr, const ScenarioConfig *cfg);
+
+/* Ganho K(θ, v) interpolado na tabela (v limitado à faixa da grade) */
+void lqr_gain(const Lqr *lqr, double theta, double v, float K[6]);
+
+/* Comando a partir da saída (y1, y2) e da orientação theta, com as
+   referências da saída no instante atual (now) e um período depois (next),
+   de onde saem θr, vr e ωr. Escreve u e o v equivalente. */
+void lqr_control(const Lqr *lqr, double y1, double y2, double theta,
+                 const RefPreviewSample *now, const RefPreviewSample *next,
+                 double *u1, double *u2, double *v1, double *v2);
+
+/* Libera a tabela */
+void lqr_destroy(Lqr *lqr);
+
+#endif // LQR_H
@@ -79,6 +79,30 @@ Matrix* subtract_scalar_from_matrix(const Matrix* matrix, float scalar);
 /* Transposta de uma matriz */
 Matrix* transpose_matrix(const Matrix* matrix);
 
+// ==========================
+// Operações sem Alocação
+// ==========================
+// Escrevem num destino já alocado com as dimensões corretas, sem logs de
+// depuração: destinadas a laços de tempo real com áreas de trabalho
+// preparadas na inicialização (ex.: controle preditivo, mpc.h)
+
+/* out = m1 * m2 (out não pode ser m1 nem m2) */
+void multiply_matrices_into(const Matrix* m1, const Matrix* m2, Matrix* out);
+
+/* out = matrixᵀ (out não pode ser matrix) */
+void transpose_matrix_into(const Matrix* matrix, Matrix* out);
+
+/* y = matrix * x (x com cols elementos, y com rows elementos) */
+void multiply_matrix_vector(const Matrix* matrix, const float* x, float* y);
+
+/* Fatoração de Cholesky no próprio lugar: o triângulo inferior passa a
+   conter L (matrix = L Lᵀ). Retorna 0, ou -1 se a matriz não for
+   simétrica definida positiva. */
+int cholesky_decompose(Matrix* matrix);
+
+/* Resolve L Lᵀ x = b com o fator de cholesky_decompose (x pode ser b) */
+void cholesky_solve(const Matrix* L, const float* b, float* x);
+
 // ==========================
 // Funções Auxiliares
 // ==========================
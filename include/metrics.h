@@ -0,0 +1,79 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+/*
+    FILE: metrics.h
+    DESCRIPTION:
+        Motor de indicadores em fluxo (online): cada amostra é incorporada
+        em O(1), sem alocação, a acumuladores de erro de rastreamento
+        (ref - y), erro do modelo de referência (y_m - y), esforço de
+        controle, ciclo de saturação de v(t)/u(t), tempo de acomodação e
+        RMS do erro na janela deslizante dos últimos metrics_window_s.
+        Usado pela thread de métricas (resumo ao vivo e no encerramento)
+        e pela simulação headless (sintonia sem gravar log).
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>     // Para impressão do resumo
+#include "scenario.h"  // Para limites de saturação e faixa de acomodação
+#include "integral.h"  // Para a janela deslizante do erro recente
+
+// Sinais observados em um instante
+typedef struct {
+    double t;             // Tempo de simulação (s)
+    double xref, yref;    // Referência
+    double y1, y2;        // Saída do robô
+    double ymx, ymy;      // Modelos de referência
+    double v1, v2;        // Saída do controle
+    double u1, u2;        // Saída da linearização
+} MetricsSample;
+
+// Indicadores derivados (prontos para exibição)
+typedef struct {
+    double duration;               // Tempo acumulado (s)
+    long samples;                  // Amostras incorporadas
+    double ise, iae, itae;         // Integrais de |ref - y|
+    double rms_error, max_error;   // RMS e máximo de |ref - y|
+    double recent_rms;             // RMS de |ref - y| na janela deslizante
+    double recent_span;            // Intervalo coberto pela janela (s)
+    double model_rms, model_max;   // RMS e máximo de |y_m - y|
+    double effort_v, effort_u;     // ∫ |v|² dt e ∫ |u|² dt
+    double duty_v1, duty_v2;       // Fração do tempo com v1/v2 saturados
+    double duty_u1, duty_u2;       // Fração do tempo com u1/u2 saturados
+    double duty_v, duty_u;         // Fração do tempo com algum canal saturado
+    double settling_time;          // Último instante fora da faixa (-1 se não acomodou)
+    double final_error;            // |ref - y| na última amostra
+} MetricsSummary;
+
+// Acumuladores (estado do motor)
+typedef struct {
+    double v_lim[2], u_lim[2];     // Limites de saturação (com tolerância)
+    double settle_band;            // Faixa de acomodação de |ref - y| (m)
+
+    long samples;
+    double duration;
+    double ise, iae, itae, max_error;
+    double model_ise, model_max;
+    double effort_v, effort_u;
+    double sat_time[6];            // v1, v2, u1, u2, algum v, algum u
+    double last_outside;           // Último instante com erro fora da faixa
+    int ever_outside;
+    double final_error;
+    SlidingIntegral recent_ise;    // ∫|ref - y|² na janela deslizante
+} Metrics;
+
+/* Zera os acumuladores e lê limites e faixa de acomodação do cenário */
+void metrics_init(Metrics *m, const ScenarioConfig *cfg);
+
+/* Incorpora uma amostra que vale durante dt segundos (regra do retângulo) */
+void metrics_update(Metrics *m, const MetricsSample *s, double dt);
+
+/* Calcula os indicadores derivados */
+void metrics_summary(const Metrics *m, MetricsSummary *out);
+
+/* Imprime o resumo em formato legível */
+void metrics_print(const MetricsSummary *s, FILE *out);
+
+#endif // METRICS_H
@@ -12,6 +12,20 @@
 */
 
 #include <pthread.h>  // Para uso de mutexes e sincronização entre threads
+#include <time.h>     // Para a marca de tempo do relógio de simulação
+#include "scenario.h" // Para a configuração imutável do cenário
+#include "trajectory.h" // Para a tabela de referências pré-calculada
+#include "ref_preview.h" // Para o horizonte de referências sem travas
+#include "metrics.h"     // Para o resumo de indicadores online
+#include "replay.h"      // Para a gravação das ativações das leis
+#include "data_age.h"    // Para os carimbos de idade das publicações
+#include "snapshot.h"    // Para o instantâneo global com buffer triplo
+#include "supervisor.h"  // Para a partida, o cão de guarda e o encerramento das tarefas
+#include "mpc.h"         // Para o controlador preditivo opcional
+#include "lqr.h"         // Para o LQR com ganhos escalonados opcional
+#include "estimator.h"   // Para a pose estimada publicada ao controle
+#include "telemetry.h"   // Para a gravação assíncrona do registro
+#include "replan.h"      // Para o replanejamento em execução do segmento plan
 
 // ==========================
 // Estruturas de Monitoramento
@@ -21,30 +35,38 @@
 typedef struct {
     double x1, x2, x3;  // Posições e orientações do robô
     double y1, y2;
+    double xe3, ye1, ye2;  // Pose estimada lida pelo controle e pela linearização (= real sem estimador)
+    DataStamp carimbo;  // Sequência e instante da última publicação
     pthread_mutex_t mutex;  // Mutex para sincronização
 } MonitorEstado;
 
 // Monitor para os comandos v(t) (velocidades)
 typedef struct {
     double v1, v2;  // Velocidades em duas direções
+    DataStamp carimbo;  // Sequência, instante e origens da última publicação
     pthread_mutex_t mutex;  // Mutex para sincronização
 } MonitorComando;
 
 // Monitor para os comandos u(t) (entrada de controle)
 typedef struct {
     double u1, u2;  // Comandos de controle
+    DataStamp carimbo;  // Sequência, instante e origens da última publicação
     pthread_mutex_t mutex;  // Mutex para sincronização
 } MonitorLinearizacao;
 
 // Monitor para as referências (xref, yref)
 typedef struct {
     double xref, yref;  // Referências para as posições
+    double dxref, dyref;  // Derivadas das referências (feedforward)
+    DataStamp carimbo;  // Sequência e instante da última publicação
     pthread_mutex_t mutex;  // Mutex para sincronização
+    RefPreview preview;  // Horizonte de amostras futuras (sem travas, fora do mutex)
 } MonitorReferencia;
 
 // Monitor para o modelo de referência (direções X e Y)
 typedef struct {
     double y_m, dy_m;  // Saída e derivada do modelo de referência
+    DataStamp carimbo;  // Sequência, instante e origens da última publicação
     pthread_mutex_t mutex;  // Mutex para sincronização
 } MonitorModeloRef;
 
@@ -54,10 +76,24 @@ typedef struct {
     pthread_mutex_t mutex;  // Mutex para sincronização
 } MonitorParametros;
 
+// Monitor para os indicadores online (resumo atualizado a cada amostra)
+typedef struct {
+    Metrics motor;  // Acumuladores (só a thread de métricas os altera; lidos no checkpoint)
+    MetricsSummary resumo;  // Último resumo publicado pela thread de métricas
+    pthread_mutex_t mutex;  // Mutex para sincronização
+} MonitorMetricas;
+
+// Monitor para as distribuições de idade dos dados (um histograma por caminho)
+typedef struct {
+    AgeHistogram caminhos[AGE_PATHS];  // Cada caminho é escrito por uma única thread
+    pthread_mutex_t mutex;  // Mutex para sincronização
+} MonitorIdades;
+
 // Monitor para o tempo de simulação
 typedef struct {
     double tempo_atual;  // Tempo atual da simulação
-    int encerrar;  // Flag para indicar se o sistema deve ser encerrado
+    struct timespec marca;  // Instante (CLOCK_MONOTONIC) da última atualização de tempo_atual
+    double intervalo;  // Passo do relógio de simulação (s)
     pthread_mutex_t mutex;  // Mutex para sincronização
 } MonitorTempo;
 
@@ -70,6 +106,11 @@ typedef struct {
     MonitorEstado *e;  // Estado do robô
     MonitorLinearizacao *l;  // Comandos de linearização
     MonitorTempo *t;  // Tempo de simulação
+    const ScenarioConfig *cfg;  // Configuração do cenário (somente leitura)
+    MonitorIdades *a;  // Idade dos dados na atuação
+    SnapshotHub *g;  // Instantâneo global (publicador do tick)
+    MonitorReferencia *r;  // Referência do instante do tick (para o instantâneo)
+    Estimator *est;  // Sensores e estimador (NULL: o controle lê o estado real); só esta thread o usa
 } ArgsSim;
 
 // Argumentos para a thread de linearização
@@ -78,6 +119,9 @@ typedef struct {
     MonitorComando *c;  // Comandos de controle
     MonitorLinearizacao *l;  // Comandos de linearização
     MonitorTempo *t;  // Tempo de simulação
+    const ScenarioConfig *cfg;  // Configuração do cenário (somente leitura)
+    ReplayRecorder *rec;  // Gravação para reprodução (NULL se desativada)
+    MonitorIdades *a;  // Idade das entradas lidas
 } ArgsLin;
 
 // Argumentos para a thread de controle
@@ -88,6 +132,14 @@ typedef struct {
     MonitorParametros *p;  // Parâmetros de controle
     MonitorComando *c;  // Comandos de controle
     MonitorTempo *t;  // Tempo de simulação
+    const ScenarioConfig *cfg;  // Configuração do cenário (somente leitura)
+    MonitorReferencia *r;  // Referências (apenas para a gravação)
+    ReplayRecorder *rec;  // Gravação para reprodução (NULL se desativada)
+    MonitorIdades *a;  // Idade das entradas lidas
+    SnapshotHub *g;  // Instantâneo global (produtor)
+    Mpc *mpc;  // Controlador preditivo (NULL: lei por modelo de referência); só esta thread o usa
+    const Lqr *lqr;  // Tabela de ganhos do LQR (NULL: sem LQR); somente leitura
+    IntegralAction *pi;  // Integrais da ação integral (ctrl_ki > 0); só esta thread as usa
 } ArgsCtrl;
 
 // Argumentos para a thread de modelo de referência
@@ -96,6 +148,10 @@ typedef struct {
     MonitorModeloRef *m;  // Modelo de referência
     MonitorParametros *p;  // Parâmetros de controle
     MonitorTempo *t;  // Tempo de simulação
+    const ScenarioConfig *cfg;  // Configuração do cenário (somente leitura)
+    const Trajectory *traj;  // Tabela de referências (somente gerador)
+    SnapshotHub *g;  // Instantâneo global (produtor)
+    Replanner *replan;  // Eventos de mapa e D* Lite (somente gerador; NULL sem eventos)
 } ArgsModel;
 
 // Argumentos para a interface com o usuário
@@ -104,6 +160,9 @@ typedef struct {
     MonitorEstado *e;  // Estado do robô
     MonitorReferencia *r;  // Referências
     MonitorTempo *t;  // Tempo de simulação
+    const ScenarioConfig *cfg;  // Configuração do cenário (somente leitura)
+    MonitorMetricas *m;  // Indicadores online
+    SnapshotHub *g;  // Instantâneo global (leitor)
 } ArgsInterface;
 
 // Argumentos para a thread de logging
@@ -113,6 +172,38 @@ typedef struct {
     MonitorComando *c;  // Comandos de controle
     MonitorLinearizacao *l;  // Comandos de linearização
     MonitorTempo *t;  // Tempo de simulação
+    const ScenarioConfig *cfg;  // Configuração do cenário (somente leitura)
+    SnapshotHub *g;  // Instantâneo global (leitor)
+    TelemetryWriter *w;  // Gravação do CSV (aberta e fechada pela thread de registro)
 } ArgsLogger;
 
+// Argumentos para a thread de métricas
+typedef struct {
+    MonitorEstado *e;  // Estado do robô
+    MonitorReferencia *r;  // Referências
+    MonitorModeloRef *mx;  // Modelo de referência na direção X
+    MonitorModeloRef *my;  // Modelo de referência na direção Y
+    MonitorComando *c;  // Comandos de controle
+    MonitorLinearizacao *l;  // Comandos de linearização
+    MonitorMetricas *m;  // Resumo publicado
+    MonitorTempo *t;  // Tempo de simulação
+    const ScenarioConfig *cfg;  // Configuração do cenário (somente leitura)
+    SnapshotHub *g;  // Instantâneo global (leitor)
+} ArgsMetrics;
+
+// Argumentos para a thread de temporização
+typedef struct {
+    MonitorTempo *t;  // Tempo de simulação
+    const ScenarioConfig *cfg;  // Configuração do cenário (somente leitura)
+    Supervisor *sv;  // Supervisor (encerramento ao fim do cenário)
+} ArgsTimer;
+
+// ==========================
+// Funções auxiliares
+// ==========================
+
+/* Tempo de simulação exato: tempo_atual mais o tempo de parede decorrido desde
+   a última atualização, limitado ao passo do relógio (sem quantização) */
+double monitor_tempo_exato(MonitorTempo *t);
+
 #endif // MONITORS_H
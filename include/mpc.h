@@ -0,0 +1,101 @@
+#ifndef MPC_H
+#define MPC_H
+
+/*
+    FILE: mpc.h
+    DESCRIPTION:
+        Controlador preditivo (MPC) alternativo à lei por modelo de
+        referência (controller = mpc no cenário). O modelo de predição é o
+        uniciclo linearizado em torno da trajetória de θ prevista pela
+        solução anterior: a saída deslocada evolui como
+
+            y[k+1] = y[k] + dt B(θk) u[k],   B(θ) = ∂ẏ/∂u = [cos θ  -R sin θ]
+                                                            [sin θ   R cos θ]
+
+        (B obtida por diferenciação automática do modelo, autodiff.h), e os
+        limites |u1| <= u1_max e |u2| <= u2_max entram na otimização como
+        restrições de caixa, em vez de saturar o comando depois.
+
+        Formulação condensada: os estados são eliminados (Y = Y0 + Γ U) e
+        sobra um QP só nas 2N entradas,
+
+            min ½ Uᵀ H U + gᵀ U   s.a.  -umax <= U <= umax
+            H = q ΓᵀΓ + r I,      g = q Γᵀ (Y0 - Yref)
+
+        resolvido por ADMM com partida a quente (solução e variáveis duais
+        do período anterior deslocadas de um passo). Todas as matrizes e
+        vetores de trabalho são alocados em mpc_init; mpc_solve não aloca.
+
+        O comando publicado é v = B(θ) u[0], que a linearização
+        (u = T(θ)^-1 v) converte de volta exatamente em u[0].
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>      // Para o relatório dos tempos de resolução
+#include "matrix.h"     // Para as matrizes da formulação condensada
+#include "scenario.h"   // Para horizonte, pesos e limites
+
+#define MPC_MAX_HORIZON 50  // Passos máximos de predição (mpc_horizon)
+#define MPC_BIN_US 1.0      // Largura de cada faixa do histograma (µs)
+#define MPC_BINS 4096       // Faixas (até ~4 ms; acima disso conta como excesso)
+
+// Distribuição dos tempos de resolução
+typedef struct {
+    unsigned long counts[MPC_BINS];
+    unsigned long n;             // Resoluções registradas
+    unsigned long overflow;      // Resoluções acima da última faixa
+    unsigned long unconverged;   // Resoluções que atingiram mpc_max_iter
+    unsigned long iterations;    // Iterações do ADMM somadas
+    double sum, max;             // Soma e máximo dos tempos (s)
+} MpcTiming;
+
+// Controlador com as áreas de trabalho pré-alocadas
+typedef struct {
+    int n;                       // Horizonte (passos)
+    int nu;                      // Variáveis de decisão (2n)
+    double dt;                   // Passo de predição (período do controle, s)
+    double R;
+    float q, r;                  // Pesos do erro e do esforço
+    float umax[2];               // Limites de u1 e u2
+    int max_iter;
+    float tol;
+
+    Matrix *G;                   // Γ (2n x 2n, triangular inferior por blocos)
+    Matrix *Gt;                  // Γᵀ
+    Matrix *K;                   // H + ρI e, após a fatoração, o seu fator L
+    float *e0;                   // Y0 - Yref (2n)
+    float *g;                    // Gradiente linear (2n)
+    float *x, *z, *w;            // Iterados do ADMM: primal, projeção e dual escalado
+    float *rhs;                  // Lado direito do passo em x
+    double *theta;               // θ previsto em cada passo do horizonte (n)
+    float rho;                   // Penalidade do ADMM usada na última resolução
+    int warm;                    // Há solução anterior para a partida a quente
+    int last_iter;               // Iterações da última resolução
+
+    MpcTiming timing;
+} Mpc;
+
+/* Prepara o controlador para o cenário (horizonte, pesos, limites e
+   período do controle). Retorna 0 ou -1 se a alocação falhar. */
+int mpc_init(Mpc *mpc, const ScenarioConfig *cfg);
+
+/* Descarta a partida a quente (os tempos acumulados são mantidos) */
+void mpc_reset(Mpc *mpc);
+
+/* Resolve o QP a partir da saída (y1, y2) e da orientação theta, com as
+   referências xref[k], yref[k] nos instantes t + (k+1) dt, k < n.
+   Escreve o primeiro comando u (já dentro dos limites) e o v equivalente.
+   Retorna as iterações do ADMM usadas. */
+int mpc_solve(Mpc *mpc, double y1, double y2, double theta,
+              const double *xref, const double *yref,
+              double *u1, double *u2, double *v1, double *v2);
+
+/* Libera as áreas de trabalho */
+void mpc_destroy(Mpc *mpc);
+
+/* Imprime o resumo e o histograma (faixas em potências de 2) dos tempos de resolução */
+void mpc_timing_print(const MpcTiming *t, double period_s, FILE *out);
+
+#endif // MPC_H
@@ -0,0 +1,47 @@
+#ifndef NUMFMT_H
+#define NUMFMT_H
+
+/*
+    FILE: numfmt.h
+    DESCRIPTION:
+        Formatação rápida de números em texto, independente de locale.
+        Oferece saída com precisão fixa (mesmos dígitos de "%.Nf", inclusive
+        além de 2^53) e saída mínima com ida e volta garantida (shortest
+        round-trip: Grisu3, com recurso exato nos casos que ele não
+        garante), usadas pelo registro CSV e pela TAD Dstring.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stddef.h>   // Para size_t
+
+// Tamanho mínimo do buffer de saída para qualquer double formatado: em
+// precisão fixa, sinal, 309 dígitos inteiros (DBL_MAX), ponto, 9 casas e '\0'
+#define NUMFMT_DOUBLE_BUFSZ 328
+
+// Maior precisão aceita pela formatação de precisão fixa
+#define NUMFMT_MAX_PRECISION 9
+
+// ==========================
+// Funções de formatação
+// ==========================
+
+/*
+ * Formata value com 'precision' casas decimais (0..NUMFMT_MAX_PRECISION).
+ * Escreve em buf (>= NUMFMT_DOUBLE_BUFSZ bytes), termina com '\0' e retorna
+ * o número de caracteres escritos. O separador decimal é sempre '.'.
+ */
+size_t numfmt_double_fixed(char *buf, double value, int precision);
+
+/*
+ * Formata value com o menor número de dígitos que, lido por strtod,
+ * reproduz exatamente o mesmo double. Usa notação exponencial apenas
+ * para magnitudes muito grandes ou muito pequenas.
+ */
+size_t numfmt_double_shortest(char *buf, double value);
+
+/* Formata um inteiro com sinal em base 10 (buf >= 21 bytes) */
+size_t numfmt_long(char *buf, long value);
+
+#endif // NUMFMT_H
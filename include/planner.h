@@ -0,0 +1,239 @@
+#ifndef PLANNER_H
+#define PLANNER_H
+
+/*
+    FILE: planner.h
+    DESCRIPTION:
+        Planejamento de caminhos em grade de ocupação para desviar de
+        obstáculos. A grade guarda um bit por célula (64 células por
+        palavra), com uma moldura ocupada que dispensa testes de limite; as
+        varreduras horizontais do JPS examinam 64 células por vez.
+
+        Buscas (8-vizinhança, sem cortar quinas ocupadas, custo 1 nos eixos
+        e √2 nas diagonais, em inteiros: 70 e 99):
+          - A* e Jump Point Search (mesmo custo ótimo, o JPS expande só os
+            pontos de salto), com heap binário indexado e nós de 12 bytes
+            reaproveitados entre consultas por carimbo de geração;
+          - D* Lite, incremental: após mudanças no mapa ou avanço do robô,
+            corrige só os custos afetados em vez de buscar de novo.
+
+        O segmento 'plan' é planejado por JPS ao carregar a trajetória;
+        durante a simulação, os eventos de mapa da especificação vão ao
+        gerador de referências, onde o D* Lite corrige o caminho e o plano
+        novo segue pelo horizonte publicado (replan.h).
+
+        O caminho de células vira uma trajetória de referência: atalhos
+        por linha de visada, quinas arredondadas por Bézier quadráticas
+        (reduzidas se tocarem obstáculos), perfil de velocidade limitado
+        em aceleração e amostragem uniforme no tempo (TrajSample), usada
+        pelo segmento 'plan' das especificações de trajetória.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdint.h>      // Para as palavras da grade
+#include <stddef.h>      // Para size_t
+#include "trajectory.h"  // Para as amostras da trajetória planejada
+
+// ==========================
+// Grade de ocupação
+// ==========================
+
+// Grade com um bit por célula (1 = ocupada). Cada linha tem uma palavra
+// ocupada antes e depois das células, e há uma linha ocupada acima e
+// abaixo: consultas a um passo da borda (e janelas de 64 bits) não testam
+// limites. A célula (0, 0) tem centro em (origin_x + res/2, origin_y + res/2)
+typedef struct {
+    int width, height;          // Células
+    int stride;                 // Palavras por linha (com as molduras)
+    uint64_t *words;            // (height + 2) * stride palavras
+    double resolution;          // Lado da célula (m)
+    double origin_x, origin_y;  // Canto inferior esquerdo (m)
+} OccupancyGrid;
+
+/* Cria a grade livre (com a moldura ocupada). Retorna 0 ou -1. */
+int grid_init(OccupancyGrid *g, int width, int height, double resolution);
+
+/* Lê um mapa PBM (P1 ou P4; preto = ocupado, a primeira linha do arquivo
+   é a de maior y). Retorna 0 ou -1. */
+int grid_load_pbm(OccupancyGrid *g, const char *path, double resolution);
+
+/* Libera a grade */
+void grid_free(OccupancyGrid *g);
+
+/* Palavra da linha y que contém x (x de -64 a width + 63, y de -1 a height) */
+static inline const uint64_t *grid_row(const OccupancyGrid *g, int y) {
+    return g->words + (size_t)(y + 1) * g->stride;
+}
+
+static inline int grid_occupied(const OccupancyGrid *g, int x, int y) {
+    unsigned b = (unsigned)(x + 64);
+    return (int)((grid_row(g, y)[b >> 6] >> (b & 63)) & 1u);
+}
+
+/* Bits das células [x0, x0 + 64) da linha y (bit i = célula x0 + i) */
+static inline uint64_t grid_window(const OccupancyGrid *g, int y, int x0) {
+    const uint64_t *row = grid_row(g, y);
+    unsigned b = (unsigned)(x0 + 64), s = b & 63;
+    uint64_t lo = row[b >> 6] >> s;
+    return s ? lo | row[(b >> 6) + 1] << (64 - s) : lo;
+}
+
+/* Marca (occupied = 1) ou libera uma célula; fora da grade é ignorado */
+void grid_set(OccupancyGrid *g, int x, int y, int occupied);
+
+/* Marca ou libera o retângulo de células [x0, x1] x [y0, y1] (recortado na grade) */
+void grid_fill_rect(OccupancyGrid *g, int x0, int y0, int x1, int y1, int occupied);
+
+/* Engorda os obstáculos em radius células (quadrado), para a folga do robô */
+int grid_inflate(OccupancyGrid *g, int radius);
+
+/* Célula que contém o ponto (x, y); retorna -1 fora da grade */
+int grid_cell_of(const OccupancyGrid *g, double x, double y, int *cx, int *cy);
+
+// ==========================
+// Caminhos e buscas
+// ==========================
+
+// Custos inteiros dos passos (99/70 ≈ √2 com erro de 5e-5): somas e
+// heurística exatas, como exigem as comparações de chaves do D* Lite
+#define PLAN_COST_AXIS 70u
+#define PLAN_COST_DIAG 99u
+#define PLAN_INF UINT32_MAX
+
+// Caminho em células (índices y * width + x), da partida ao destino
+typedef struct {
+    int32_t *cells;
+    int count, capacity;
+    double cost;        // Comprimento em células (1 nos eixos, √2 nas diagonais)
+    long expanded;      // Nós expandidos pela busca
+} PlanPath;
+
+/* Libera o caminho */
+void plan_path_free(PlanPath *path);
+
+// Heap binário indexado: chaves (k1, k2) em ordem lexicográfica e a
+// posição de cada célula no heap, para reduzir a chave em O(log n)
+typedef struct {
+    uint64_t k1;
+    uint32_t k2;
+    int32_t cell;
+} PlanHeapEntry;
+
+typedef struct {
+    PlanHeapEntry *items;
+    int32_t *pos;           // Posição no heap por célula (PLAN_NOT_QUEUED fora dele)
+    int count, capacity;
+} PlanHeap;
+
+#define PLAN_NOT_QUEUED (-1)
+#define PLAN_CLOSED (-2)
+
+typedef enum {
+    PLANNER_ASTAR,
+    PLANNER_JPS
+} PlannerAlgorithm;
+
+// Nó da busca: válido só se stamp for a geração da consulta atual
+typedef struct {
+    uint32_t g;
+    int32_t parent;
+    uint32_t stamp;
+} PlanNode;
+
+// Memória da busca, dimensionada para uma grade e reaproveitada entre consultas
+typedef struct {
+    const OccupancyGrid *grid;
+    PlanNode *nodes;
+    PlanHeap open;
+    uint32_t generation;
+} Planner;
+
+/* Aloca a memória da busca para a grade (que pode mudar entre consultas,
+   desde que mantenha as dimensões). Retorna 0 ou -1. */
+int planner_init(Planner *p, const OccupancyGrid *grid);
+
+/* Caminho ótimo de (sx, sy) a (gx, gy) em células. Retorna 0, ou -1 se
+   não houver caminho ou se partida/destino estiverem ocupados. */
+int planner_search(Planner *p, PlannerAlgorithm alg, int sx, int sy, int gx, int gy, PlanPath *out);
+
+/* Libera a memória da busca */
+void planner_destroy(Planner *p);
+
+// Estado do D* Lite: custos do destino a cada célula (g e a estimativa
+// rhs), mantidos entre replanejamentos
+typedef struct {
+    uint32_t g, rhs;
+} DStarNode;
+
+typedef struct {
+    const OccupancyGrid *grid;
+    DStarNode *nodes;
+    PlanHeap open;
+    int start, goal, last;  // Células (last: partida no último ajuste de km)
+    uint64_t km;            // Acúmulo da heurística com o avanço da partida
+    long expanded;          // Nós expandidos no último replanejamento
+} DStarLite;
+
+/* Aloca o estado para a grade. Retorna 0 ou -1. */
+int dstar_init(DStarLite *d, const OccupancyGrid *grid);
+
+/* Começa um planejamento novo de (sx, sy) a (gx, gy) */
+void dstar_reset(DStarLite *d, int sx, int sy, int gx, int gy);
+
+/* Move a partida (o robô avançou) */
+void dstar_move_start(DStarLite *d, int sx, int sy);
+
+/* Avisa que a ocupação das células indicadas mudou na grade */
+void dstar_cells_changed(DStarLite *d, const int32_t *cells, int n);
+
+/* Corrige os custos e extrai o caminho da partida ao destino. Retorna 0,
+   ou -1 se não houver caminho. */
+int dstar_replan(DStarLite *d, PlanPath *out);
+
+/* Libera o estado */
+void dstar_destroy(DStarLite *d);
+
+// ==========================
+// Trajetória a partir do caminho
+// ==========================
+
+// Limites do perfil de velocidade e do arredondamento das quinas
+typedef struct {
+    double speed;        // Velocidade de cruzeiro (m/s)
+    double accel;        // Aceleração tangencial e centrípeta máximas (m/s²)
+    double blend;        // Maior recuo do arredondamento a partir da quina (m)
+    double dt;           // Período das amostras (s)
+} PlanProfile;
+
+/* Suaviza o caminho e o amostra no tempo, parando no início e no fim.
+   *samples é alocado (liberar com free). Retorna 0 ou -1. */
+int plan_to_samples(const OccupancyGrid *grid, const PlanPath *path, const PlanProfile *profile,
+                    TrajSample **samples, size_t *count);
+
+/* Como plan_to_samples, mas partindo do ponto exato (x0, y0) dentro da
+   primeira célula do caminho (e não do seu centro) */
+int plan_to_samples_at(const OccupancyGrid *grid, const PlanPath *path, const PlanProfile *profile,
+                       double x0, double y0, TrajSample **samples, size_t *count);
+
+// ==========================
+// Segmento 'plan' das especificações
+// ==========================
+
+#define PLAN_DT 0.01     // Período das amostras do caminho suavizado (s)
+#define PLAN_BLEND 0.3   // Recuo máximo padrão do arredondamento das quinas (m)
+
+// Argumentos "mapa.pbm res x0 y0 x1 y1 v a [folga [recuo]]" (origem do mapa em (0, 0))
+typedef struct {
+    char map[1024];          // Arquivo PBM
+    double resolution;       // Lado da célula (m)
+    double x0, y0, x1, y1;   // Partida e destino (m)
+    double margin;           // Folga em torno dos obstáculos (m)
+    PlanProfile profile;     // Velocidade, aceleração e recuo, com dt = PLAN_DT
+} PlanSpec;
+
+/* Lê os argumentos de uma linha plan. Retorna 0 ou -1. */
+int plan_spec_parse(const char *args, PlanSpec *out);
+
+#endif // PLANNER_H
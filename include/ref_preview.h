@@ -0,0 +1,84 @@
+#ifndef REF_PREVIEW_H
+#define REF_PREVIEW_H
+
+/*
+    FILE: ref_preview.h
+    DESCRIPTION:
+        Buffer circular sem travas com o horizonte de pré-visualização das
+        referências. O gerador (único produtor) publica amostras futuras
+        uniformemente espaçadas, cada uma marcada com o tempo de simulação
+        t = k * dt; os consumidores (qualquer número, qualquer taxa)
+        interpolam a referência no seu próprio instante exato.
+        Cada posição do anel é protegida por um contador de sequência
+        (seqlock): o leitor repete a leitura se o produtor sobrescreveu a
+        amostra durante a cópia, e nunca bloqueia o produtor.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdatomic.h>  // Para publicação sem travas
+#include <stdalign.h>   // Para alinhamento em linha de cache
+#include "trajectory.h" // Para preencher o horizonte a partir da tabela
+
+#define REF_PREVIEW_CAPACITY 256u  // Potência de 2
+#define REF_PREVIEW_MASK (REF_PREVIEW_CAPACITY - 1u)
+
+// Posição do anel (uma linha de cache por amostra)
+typedef struct {
+    alignas(64) atomic_ulong seq;  // Ímpar durante a escrita
+    atomic_ulong index;            // Índice k da amostra (t = k * dt)
+    _Atomic double x, y;           // Posição de referência
+    _Atomic double dx, dy;         // Velocidade de referência (feedforward)
+} RefPreviewSlot;
+
+// Horizonte de referências publicado pelo gerador
+typedef struct {
+    RefPreviewSlot slots[REF_PREVIEW_CAPACITY];
+    alignas(64) atomic_ulong head;  // Número de amostras publicadas
+    _Atomic double ativacao;        // Instante monotônico da última ativação do gerador (s)
+    double dt;                      // Espaçamento entre amostras (s)
+} RefPreview;
+
+// Amostra interpolada entregue ao consumidor
+typedef struct {
+    double t;       // Instante consultado (após limitar ao horizonte disponível)
+    double x, y;
+    double dx, dy;
+    double publicado;  // Última ativação do gerador que confirmou o horizonte (s; 0 em ref_preview_eval)
+} RefPreviewSample;
+
+/* Inicializa o anel vazio com espaçamento dt */
+void ref_preview_init(RefPreview *rp, double dt);
+
+/* Produtor: publica a próxima amostra (instante head * dt) na ativação
+   do gerador do instante monotônico 'publicado' (data_age_now) */
+void ref_preview_push(RefPreview *rp, double x, double y, double dx, double dy, double publicado);
+
+/* Produtor: publica amostras da trajetória até cobrir o instante 'until' e
+   registra a ativação 'publicado', mesmo que nenhuma amostra seja nova */
+void ref_preview_fill(RefPreview *rp, const Trajectory *traj, double until, double publicado);
+
+/* Produtor: como ref_preview_fill, para uma trajetória que começa no
+   instante t0 (a amostra k vem de traj em k * dt - t0) */
+void ref_preview_fill_from(RefPreview *rp, const Trajectory *traj, double t0, double until, double publicado);
+
+/* Número de amostras publicadas: a última cobre o instante (head - 1) * dt */
+unsigned long ref_preview_published(const RefPreview *rp);
+
+/* Consumidor: interpola (Hermite cúbica) a referência no instante t.
+   Fora do horizonte disponível, mantém a amostra da extremidade.
+   Retorna 0 em caso de sucesso e -1 se nada foi publicado ainda. */
+int ref_preview_sample(const RefPreview *rp, double t, RefPreviewSample *out);
+
+/* Número de amostras publicadas após ref_preview_fill(until) num anel
+   que já tinha head amostras (sem alterar nenhum anel) */
+unsigned long ref_preview_extent(double dt, unsigned long head, double until);
+
+/* Versão pura de ref_preview_sample: calcula diretamente da tabela a
+   amostra que um anel com head amostras publicadas entregaria em t.
+   Sem estado compartilhado; usada pelo passo puro (diffrobot.h). */
+int ref_preview_eval(const Trajectory *traj, double dt, unsigned long head, double t,
+                     RefPreviewSample *out);
+
+#endif // REF_PREVIEW_H
@@ -0,0 +1,80 @@
+#ifndef REPLAN_H
+#define REPLAN_H
+
+/*
+    FILE: replan.h
+    DESCRIPTION:
+        Replanejamento em execução do segmento 'plan'. Após a linha plan,
+        a especificação de trajetória pode listar eventos de mapa, em
+        ordem de tempo (retângulos em metros, instantes de simulação):
+          block t x0 y0 x1 y1   o retângulo fica ocupado a partir de t
+          clear t x0 y0 x1 y1   o retângulo fica livre a partir de t
+
+        O gerador de referências aplica os eventos vencidos a cada
+        ativação: o mapa é engordado de novo pela folga e só as células
+        que mudaram vão ao D* Lite. Se a referência ainda a percorrer
+        cruzar uma célula ocupada, a partida do D* Lite avança até a
+        última amostra já publicada no horizonte (ref_preview.h), o
+        caminho é corrigido de forma incremental e o plano suavizado
+        segue pelo horizonte a partir dali, chegando aos modelos de
+        referência e a MonitorReferencia.
+
+        Limites: o horizonte já publicado não é reescrito (um obstáculo
+        que surja nele é atravessado); o plano novo parte do repouso, com
+        a posição contínua; liberar células não interrompe o plano em
+        curso, só entra no próximo replanejamento. A simulação headless, a
+        biblioteca (diffrobot.h) e a restauração de checkpoints seguem a
+        tabela carregada, sem os eventos.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include "planner.h"      // Para a grade, o D* Lite e a suavização
+#include "ref_preview.h"  // Para o horizonte onde o plano novo é publicado
+#include "scenario.h"     // Para a especificação de trajetória do cenário
+
+#define REPLAN_MAX_EVENTS 256  // Eventos de mapa por especificação
+
+// Mudança de ocupação de um retângulo do mapa
+typedef struct {
+    double t;               // Instante de simulação (s)
+    double x0, y0, x1, y1;  // Cantos do retângulo (m)
+    int occupied;           // 1 = block, 0 = clear
+} MapEvent;
+
+// Estado do replanejamento (usado só pela thread do gerador)
+typedef struct {
+    PlanSpec spec;           // Linha plan da especificação
+    OccupancyGrid map;       // Mapa lido, sem folga (recebe os eventos)
+    OccupancyGrid grid;      // Mapa engordado, visto pelo D* Lite
+    OccupancyGrid scratch;   // Próxima versão do mapa engordado
+    int margin;              // Folga em células
+    DStarLite dstar;
+    PlanPath path;           // Último caminho do D* Lite (memória reaproveitada)
+    int32_t *changed;        // Células alteradas pelo último evento
+    int changed_capacity;
+    MapEvent events[REPLAN_MAX_EVENTS];
+    int n_events, next;      // Eventos lidos e o próximo a aplicar
+    Trajectory plan;         // Plano em curso (após o primeiro replanejamento)
+    double t0;               // Instante de simulação em que o plano em curso começa
+    int active;              // plan e t0 válidos
+    int replans;             // Replanejamentos publicados
+} Replanner;
+
+/* Lê os eventos de mapa da especificação de trajetória do cenário e
+   prepara o D* Lite sobre o mapa da linha plan. Sem eventos (ou com
+   trajetória figure8 ou .bin), n_events = 0 e nada é alocado.
+   Retorna 0 ou -1. */
+int replanner_load(Replanner *rp, const ScenarioConfig *cfg);
+
+/* Aplica os eventos com t <= tempo e, se a referência a percorrer
+   ficou bloqueada, replaneja a partir da última amostra publicada em
+   preview. Retorna 1 se há um plano novo, 0 se o plano não mudou e -1
+   se não houve caminho (o plano anterior continua). */
+int replanner_update(Replanner *rp, const Trajectory *traj, const RefPreview *preview, double tempo);
+
+/* Libera o mapa, o D* Lite e o plano em curso */
+void replanner_free(Replanner *rp);
+
+#endif // REPLAN_H
@@ -0,0 +1,63 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+/*
+    FILE: replay.h
+    DESCRIPTION:
+        Gravação das entradas e saídas exatas das leis de controle e de
+        linearização, para reprodução determinística (ferramenta replay).
+        Cada ativação gera uma linha, com valores em representação decimal
+        mais curta que reconstrói o double exato:
+          c,t,xref,yref,ymx,dymx,ymy,dymy,y1,y2,alpha1,alpha2,v1,v2
+          l,t,x3,v1,v2,u1,u2
+        O cabeçalho ("# chave=valor") guarda os parâmetros do cenário
+        usados pelas leis (R e saturações).
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>     // Para o arquivo de gravação
+#include <pthread.h>   // Gravação compartilhada por duas threads
+#include "scenario.h"  // Para os parâmetros das leis
+
+#define REPLAY_CTRL_FIELDS 13  // Campos após o marcador 'c'
+#define REPLAY_LIN_FIELDS 6    // Campos após o marcador 'l'
+
+// Ativação da lei de controle
+typedef struct {
+    double t;
+    double xref, yref;             // Referências (contexto)
+    double ymx, dymx, ymy, dymy;   // Modelos de referência
+    double y1, y2;                 // Saída do robô
+    double alpha1, alpha2;         // Ganhos
+    double v1, v2;                 // Saída gravada
+} ReplayCtrl;
+
+// Ativação da linearização
+typedef struct {
+    double t;
+    double x3;                     // Orientação do robô
+    double v1, v2;                 // Entrada
+    double u1, u2;                 // Saída gravada
+} ReplayLin;
+
+// Gravador (NULL nas Args desativa a gravação)
+typedef struct {
+    FILE *file;
+    pthread_mutex_t mutex;
+} ReplayRecorder;
+
+/* Cria o arquivo e grava o cabeçalho com os parâmetros do cenário; retorna 0 ou -1 */
+int replay_recorder_open(ReplayRecorder *rec, const char *path, const ScenarioConfig *cfg);
+
+/* Grava uma ativação da lei de controle (seguro entre threads) */
+void replay_record_ctrl(ReplayRecorder *rec, const ReplayCtrl *c);
+
+/* Grava uma ativação da linearização (seguro entre threads) */
+void replay_record_lin(ReplayRecorder *rec, const ReplayLin *l);
+
+/* Fecha o arquivo */
+void replay_recorder_close(ReplayRecorder *rec);
+
+#endif // REPLAY_H
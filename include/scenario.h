@@ -0,0 +1,129 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+/*
+    FILE: scenario.h
+    DESCRIPTION:
+        Define a configuração de cenário da simulação: períodos das threads,
+        parâmetros do robô, limites de saturação, ganhos e arquivos de saída.
+        O cenário é lido uma única vez na inicialização (arquivo "chave = valor"
+        e sobrescritas "chave=valor" na linha de comando) e depois tratado como
+        imutável, podendo ser lido por todas as threads sem mutex.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdalign.h>  // Para alinhamento em linha de cache
+
+#define SCENARIO_CACHE_LINE 64
+#define SCENARIO_PATH_MAX 256
+
+// Configuração imutável do cenário (alinhada para não compartilhar linha de cache)
+typedef struct {
+    alignas(SCENARIO_CACHE_LINE)
+
+    // Períodos de execução das threads (ms)
+    int sim_period_ms;        // Simulação do robô
+    int lin_period_ms;        // Linearização por realimentação
+    int ctrl_period_ms;       // Controle
+    int model_period_ms;      // Modelos de referência X e Y
+    int ref_period_ms;        // Gerador de referências
+    int logger_period_ms;     // Registro em CSV
+    int interface_period_ms;  // Interface com o usuário
+    int timer_interval_ms;    // Avanço do relógio de simulação
+    int metrics_period_ms;    // Indicadores online
+    int watchdog_ms;          // Verificação das tarefas pelo supervisor (0 desativa)
+
+    double sim_time_s;        // Duração total da simulação (s)
+
+    // Parâmetros do robô e limites
+    double R;                 // Distância do centro geométrico à frente do robô
+    double v_max, w_max;      // Saturação de v(t)
+    double u1_max, u2_max;    // Saturação de u(t)
+
+    // Ganhos iniciais do modelo de referência e do controle
+    double alpha1, alpha2;
+
+    // Faixa de acomodação do erro de rastreamento |ref - y| (m)
+    double settle_band;
+    double metrics_window_s;  // Janela deslizante do RMS recente (s)
+
+    // Trajetória de referência: "figure8", tabela binária ".bin" ou especificação texto
+    char trajectory[SCENARIO_PATH_MAX];
+    double trajectory_dt;     // Espaçamento da tabela pré-calculada (s)
+    double preview_dt;        // Espaçamento das amostras publicadas no horizonte (s)
+    double preview_horizon_s; // Antecedência do horizonte de referências (s)
+
+    // Ação integral opcional da lei por modelo de referência (PI)
+    double ctrl_ki;           // Ganho integral sobre ref - y (0 desativa)
+    double ctrl_ki_limit;     // Maior parcela integral em v (anti-windup)
+
+    // Controlador: "mrac" (modelo de referência, control_law.h), "mpc"
+    // (preditivo sobre o horizonte de referências, mpc.h) ou "lqr"
+    // (regulador quadrático com ganhos escalonados, lqr.h)
+    char controller[SCENARIO_PATH_MAX];
+    int mpc_horizon;          // Passos de ctrl_period_ms no horizonte de predição
+    double mpc_q;             // Peso do erro de rastreamento (por m²)
+    double mpc_r;             // Peso do esforço u1² + u2²
+    int mpc_max_iter;         // Iterações máximas do ADMM por resolução
+    double mpc_tol;           // Tolerância dos resíduos primal e dual do ADMM
+    double lqr_q;             // Peso do erro de posição do LQR (por m²)
+    double lqr_q_theta;       // Peso do erro de orientação (por rad²)
+    double lqr_r;             // Peso do esforço u1² + u2²
+    int lqr_heading_bins;     // Pontos da grade de ganhos em θ
+    int lqr_speed_bins;       // Pontos da grade de ganhos em v
+    double lqr_speed_min;     // Menor velocidade da grade (m/s); a maior é u1_max
+    double lqr_error_max;     // Maior erro de posição realimentado pelo LQR (m)
+
+    // Estimação de estado (estimator.h): "none" (estado real), "raw" (medição
+    // ruidosa) ou "ekf"; ruído dos sensores e deriva da odometria
+    char estimator[SCENARIO_PATH_MAX];
+    double sensor_pos_std;    // Desvio da medição absoluta de posição (m)
+    double sensor_theta_std;  // Desvio da medição absoluta de θ (rad)
+    double odom_std;          // Desvio das velocidades da odometria (m/s e rad/s)
+    double odom_scale;        // Erro relativo de escala da velocidade linear
+    double odom_bias_w;       // Viés da velocidade angular (rad/s)
+    int sensor_seed;          // Semente do ruído (execuções reprodutíveis)
+
+    // Frota (build/fleet): robôs em grade, cada um seguindo a trajetória
+    // deslocada para a sua posição e atrasada conforme a coluna
+    int fleet_size;           // Número de robôs
+    double fleet_spacing;     // Distância entre posições da grade inicial (m)
+    double fleet_delay_s;     // Atraso da referência por coluna (s), ciclo de 8 colunas
+    double fleet_radius;      // Raio das consultas de vizinhança = lado da célula (m)
+    double fleet_collision;   // Distância considerada colisão (m, <= fleet_radius)
+    int fleet_threads;        // Threads das etapas paralelas (0 = processadores online)
+
+    // Arquivos de saída
+    char output_csv[SCENARIO_PATH_MAX];
+    char record_file[SCENARIO_PATH_MAX];  // Gravação das leis para replay (vazio = desativada)
+
+    // Gravação assíncrona do registro (telemetry.h)
+    char telemetry_io[SCENARIO_PATH_MAX];  // "buffered", "fdatasync" ou "direct"
+    int telemetry_buffer_kb;  // Tamanho de cada buffer (KiB)
+    int telemetry_buffers;    // Buffers no anel entre a amostragem e o escritor
+    int telemetry_flush_ms;   // Entrega do buffer parcial (0 = só buffers cheios)
+
+    // Checkpoint e restauração do estado completo (checkpoint.h)
+    char checkpoint_file[SCENARIO_PATH_MAX];  // Destino dos checkpoints (vazio = desativado)
+    double checkpoint_period_s;               // Intervalo entre checkpoints (tempo de simulação, s)
+    char restore_file[SCENARIO_PATH_MAX];     // Checkpoint de partida (vazio = início em t = 0)
+} ScenarioConfig;
+
+/* Preenche cfg com os valores padrão (equivalentes às constantes originais) */
+void scenario_set_defaults(ScenarioConfig *cfg);
+
+/* Lê um arquivo de cenário; retorna 0 em caso de sucesso e -1 em erro */
+int scenario_load_file(ScenarioConfig *cfg, const char *path);
+
+/* Aplica uma atribuição "chave=valor"; retorna 0 em caso de sucesso e -1 em erro */
+int scenario_apply(ScenarioConfig *cfg, const char *assignment);
+
+/* Retorna 1 se a chave é um campo inteiro, 0 se é real ou texto e -1 se não existe */
+int scenario_key_is_int(const char *key);
+
+/* Valida a consistência do cenário; retorna 0 se válido e -1 caso contrário */
+int scenario_validate(const ScenarioConfig *cfg);
+
+#endif // SCENARIO_H
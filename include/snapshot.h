@@ -0,0 +1,92 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+/*
+    FILE: snapshot.h
+    DESCRIPTION:
+        Instantâneo global do sistema com buffer triplo, montado uma vez por
+        tick de simulação. A thread do robô é o único publicador: a cada
+        período ela registra o estado integrado, o u(t) aplicado e a
+        referência do instante do tick, completa a cópia com o último valor
+        dos demais produtores e a entrega a todos os leitores. Os produtores
+        de fora do tick (modelos e controle) não disputam uma trava: cada um
+        escreve só no seu canal, protegido por um seqlock, e o publicador o
+        lê sem bloquear o produtor.
+        Cada leitor (registro, interface, métricas) tem seu próprio canal de
+        três buffers: o publicador escreve no buffer de trás e o troca pelo
+        do meio; o leitor troca o do meio pelo da frente com uma única troca
+        atômica, sem travas, e obtém todos os sinais de um mesmo tick.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdatomic.h>  // Para os canais sem travas
+#include <stdalign.h>   // Para separar os canais em linhas de cache
+
+// Leitores do instantâneo (um canal cada)
+typedef enum {
+    SNAPSHOT_LOGGER,
+    SNAPSHOT_INTERFACE,
+    SNAPSHOT_METRICS,
+    SNAPSHOT_READERS
+} SnapshotReader;
+
+// Produtores fora do tick (um escritor por canal)
+typedef enum {
+    SNAPSHOT_SRC_MODELO_X,  // ymx
+    SNAPSHOT_SRC_MODELO_Y,  // ymy
+    SNAPSHOT_SRC_CONTROLE,  // v1, v2
+    SNAPSHOT_SOURCES
+} SnapshotSource;
+
+// Todos os sinais do sistema em um mesmo tick
+typedef struct {
+    unsigned long tick;          // Número do tick publicado (0: nada publicado)
+    double publicado;            // Instante monotônico da publicação (s)
+    double t;                    // Tempo de simulação do tick (s)
+    double xref, yref;           // Referência no instante do tick
+    double x1, x2, x3;           // Estado do robô
+    double y1, y2;               // Saída do robô
+    double ymx, ymy;             // Modelos de referência
+    double v1, v2;               // Saída do controle
+    double u1, u2;               // Saída da linearização aplicada no tick
+} SystemSnapshot;
+
+// Último valor de um produtor (seq ímpar durante a escrita)
+typedef struct {
+    alignas(64) atomic_uint seq;
+    _Atomic double valor[2];
+} SnapshotSlot;
+
+// Buffer triplo de um leitor
+typedef struct {
+    alignas(64) SystemSnapshot buf[3];
+    atomic_uint middle;  // Índice do buffer do meio | SNAPSHOT_FRESH se ainda não lido
+    unsigned back;       // Buffer de escrita (do publicador)
+    unsigned front;      // Buffer de leitura (do leitor)
+} SnapshotChannel;
+
+// Instantâneo global compartilhado por produtores, publicador e leitores
+typedef struct {
+    SnapshotChannel canais[SNAPSHOT_READERS];
+    SnapshotSlot fontes[SNAPSHOT_SOURCES];
+    unsigned long tick;  // Ticks publicados (só o publicador o altera)
+} SnapshotHub;
+
+/* Inicializa o instantâneo com todos os sinais nulos */
+void snapshot_init(SnapshotHub *h);
+
+/* Produtor: registra seu último valor (a, b) no próprio canal, sem travas */
+void snapshot_post(SnapshotHub *h, SnapshotSource src, double a, double b);
+
+/* Publicador (um só): completa s com o último valor de cada produtor,
+   numera o tick e o entrega a todos os leitores. s traz t, a referência,
+   o estado e u(t) do tick. */
+void snapshot_publish(SnapshotHub *h, SystemSnapshot *s, double publicado);
+
+/* Leitor: obtém o tick mais recente (ou mantém o atual se nada novo foi
+   publicado); a visão permanece válida até a próxima chamada do mesmo leitor */
+const SystemSnapshot *snapshot_acquire(SnapshotHub *h, SnapshotReader r);
+
+#endif // SNAPSHOT_H
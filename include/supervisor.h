@@ -0,0 +1,114 @@
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+/*
+    FILE: supervisor.h
+    DESCRIPTION:
+        Supervisor das tarefas periódicas. O supervisor cria todas as
+        threads, que aguardam em uma barreira comum e são liberadas em uma
+        época compartilhada; cada tarefa é defasada de alguns microssegundos
+        na ordem causal em que foi registrada (relógio, referência, modelos,
+        controle, linearização, robô, observadores), de modo que ativações
+        coincidentes sempre ocorrem na mesma ordem. As esperas pelo próximo
+        período são feitas em um futex com prazo absoluto: o encerramento
+        acorda todas as tarefas imediatamente. Um cão de guarda verifica os
+        batimentos de cada tarefa e acusa as que pararam. Uma pausa curta
+        retém as tarefas entre ativações, para ler o estado de todas sem
+        que nenhuma esteja no meio de um cálculo (checkpoint).
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <pthread.h>    // Para as threads das tarefas
+#include <stdatomic.h>  // Para as palavras de futex e os batimentos
+#include <stdio.h>      // Para o relatório
+#include <time.h>       // Para os prazos absolutos
+
+#define SUPERVISOR_MAX_TASKS 16
+#define SUPERVISOR_PHASE_US 200      // Defasagem entre tarefas consecutivas na partida
+#define SUPERVISOR_STALL_PERIODS 3   // Períodos sem batimento até acusar parada
+
+typedef struct Supervisor Supervisor;
+
+// Tarefa supervisionada
+typedef struct {
+    const char *nome;
+    int periodo_ms;
+    void *(*fn)(void *);
+    void *arg;
+    Supervisor *sv;
+    pthread_t thread;
+    long fase_ns;                  // Defasagem em relação à época
+    atomic_ullong ultimo_batimento;  // Instante (ns monotônico) da última ativação concluída
+    atomic_ulong ativacoes;        // Ativações concluídas
+    atomic_ulong atrasos;          // Ativações que terminaram após o prazo da seguinte
+    unsigned long paradas;         // Paradas acusadas pelo cão de guarda
+    int parada;                    // 1 enquanto a tarefa estiver acusada
+    int ocupada;                   // 1 durante uma ativação (só a própria thread altera)
+    int chegou;                    // 1 após contar na barreira de partida (só a própria thread altera)
+    atomic_int encerrada;          // 1 se a thread saiu antes do encerramento (o cão de guarda a ignora)
+} SupervisorTask;
+
+// Supervisor de todas as tarefas
+struct Supervisor {
+    SupervisorTask tarefas[SUPERVISOR_MAX_TASKS];
+    int n_tarefas;
+    int watchdog_ms;               // Período do cão de guarda (0 desativa)
+    atomic_int chegadas;           // Tarefas que já chegaram à barreira de partida (futex)
+    atomic_int partida;            // 1 após a publicação da época (futex)
+    struct timespec epoca;         // Instante comum da primeira ativação
+    atomic_int encerrar;           // Palavra do futex: 1 após o encerramento
+    struct timespec pedido;        // Instante do pedido de encerramento
+    double latencia_encerramento;  // Do pedido até a última thread terminar (s)
+    atomic_int pausa;              // Palavra do futex: 1 enquanto as ativações estão retidas
+    atomic_int ocupadas;           // Tarefas no meio de uma ativação (futex)
+};
+
+/* Inicializa o supervisor (sem tarefas) */
+void supervisor_init(Supervisor *sv, int watchdog_ms);
+
+/* Registra uma tarefa; a ordem de registro define a ordem causal da partida.
+   Retorna -1 se o limite de tarefas foi atingido */
+int supervisor_add(Supervisor *sv, const char *nome, int periodo_ms, void *(*fn)(void *), void *arg);
+
+/* Cria as threads, libera a partida, vigia até o encerramento e aguarda todas */
+void supervisor_run(Supervisor *sv);
+
+/* Pede o encerramento: acorda todas as tarefas imediatamente (qualquer thread) */
+void supervisor_shutdown(Supervisor *sv);
+
+/* Retém as tarefas entre ativações: retorna quando nenhuma outra tarefa
+   está no meio de uma ativação (as que acordarem aguardam a retomada).
+   Pode ser chamada por uma tarefa, durante a sua ativação; um único
+   chamador por vez. */
+void supervisor_pause(Supervisor *sv);
+
+/* Libera as tarefas retidas por supervisor_pause */
+void supervisor_resume(Supervisor *sv);
+
+/* Imprime ativações, atrasos e paradas por tarefa e a latência de encerramento */
+void supervisor_print(const Supervisor *sv, FILE *out);
+
+// ==========================
+// Chamadas feitas pelas próprias tarefas
+// ==========================
+
+/* Aguarda a partida comum; devolve em 'next' o instante da primeira ativação
+   e retorna 0 se o sistema foi encerrado antes dela */
+int supervisor_start(struct timespec *next);
+
+/* Sai da supervisão antes do fim (ex.: falha ao abrir um arquivo): conta na
+   barreira de partida, se ainda não contou, para não retê-la, e deixa de
+   ser vigiada pelo cão de guarda. A saída da thread também tem esse efeito;
+   chamar antes de pthread_exit torna a intenção explícita. */
+void supervisor_leave(void);
+
+/* Avança 'next' em periodo_ms */
+void supervisor_advance(struct timespec *next, int periodo_ms);
+
+/* Registra o batimento e dorme até o instante absoluto 'next' (CLOCK_MONOTONIC);
+   retorna 0 se o sistema foi encerrado (imediatamente, sem esperar o prazo) */
+int supervisor_sleep_until(const struct timespec *next);
+
+#endif // SUPERVISOR_H
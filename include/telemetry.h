@@ -0,0 +1,97 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+/*
+    FILE: telemetry.h
+    DESCRIPTION:
+        Gravação assíncrona do registro em disco. A thread que amostra só
+        copia as linhas para um anel de buffers grandes, alocados e tocados
+        na abertura; cada buffer cheio (ou o parcial, a cada
+        telemetry_flush_ms) é entregue por um contador atômico a uma thread
+        escritora, que grava todos os buffers pendentes numa única chamada
+        writev. Uma demora do disco só atinge a amostragem se o anel
+        inteiro estiver pendente (contada em "esperas").
+        Políticas (telemetry_io):
+          buffered  - writev no cache de páginas do sistema
+          fdatasync - writev seguido de fdatasync a cada lote
+          direct    - O_DIRECT: só buffers cheios (alinhados) são entregues,
+                      o restante é gravado sem O_DIRECT no fechamento; sem
+                      suporte do sistema de arquivos, cai para buffered
+        Um produtor e um escritor por arquivo.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>      // Para o relatório
+#include <stddef.h>     // Para size_t
+#include <stdatomic.h>  // Para a entrega sem travas
+#include <stdalign.h>   // Para separar os contadores em linhas de cache
+#include <pthread.h>    // Para a thread escritora
+#include <time.h>       // Para o instante da última entrega
+#include "scenario.h"   // Para a política, o tamanho e o número de buffers
+
+#define TELEMETRY_ALIGN 4096u      // Alinhamento dos buffers (exigido por O_DIRECT)
+#define TELEMETRY_MAX_BUFFERS 16   // Limite de buffers no anel (e de entradas de um writev)
+
+typedef enum {
+    TELEMETRY_BUFFERED,
+    TELEMETRY_FDATASYNC,
+    TELEMETRY_DIRECT
+} TelemetryIo;
+
+// Contadores (os do produtor e os do escritor só são lidos após o fechamento)
+typedef struct {
+    unsigned long linhas;             // Linhas recebidas
+    unsigned long entregas;           // Buffers entregues ao escritor
+    unsigned long esperas;            // Entregas que encontraram o anel cheio
+    double espera_total, espera_max;  // Tempo do produtor bloqueado (s)
+    unsigned long lotes;              // Chamadas de writev (cada uma com 1 ou mais buffers)
+    unsigned long long bytes;         // Bytes gravados
+    double escrita_total, escrita_max;  // Duração de cada lote, com a sincronização (s)
+    unsigned long erros;              // Lotes que falharam (os dados são descartados)
+} TelemetryStats;
+
+typedef struct {
+    char *data[TELEMETRY_MAX_BUFFERS];  // Buffers do anel
+    size_t used[TELEMETRY_MAX_BUFFERS]; // Bytes de cada buffer entregue
+    size_t capacity;                    // Bytes por buffer (múltiplo de TELEMETRY_ALIGN)
+    unsigned count;                     // Buffers no anel
+    TelemetryIo io;                     // Política em uso
+    int fd;
+    double flush_s;                     // Entrega do buffer parcial (0 = só cheios)
+
+    // Produtor
+    alignas(64) atomic_uint head;       // Buffers entregues
+    size_t fill;                        // Bytes no buffer corrente (data[head % count])
+    struct timespec ultima_entrega;
+
+    // Escritor
+    alignas(64) atomic_uint tail;       // Buffers gravados (palavra do futex do produtor)
+    atomic_uint sinal;                  // Palavra do futex do escritor: muda a cada entrega
+    atomic_int fechar;                  // 1 após a última entrega
+    pthread_t thread;
+
+    TelemetryStats stats;
+} TelemetryWriter;
+
+/* Cria (trunca) path, aloca o anel conforme cfg->telemetry_*, grava
+   header (se não NULL) e inicia a thread escritora. Retorna 0 ou -1. */
+int telemetry_open(TelemetryWriter *w, const char *path, const ScenarioConfig *cfg,
+                   const char *header);
+
+/* Produtor: copia len bytes (uma linha) para o anel. Só bloqueia se o
+   buffer seguinte ainda não foi gravado. */
+void telemetry_write(TelemetryWriter *w, const char *data, size_t len);
+
+/* Produtor: entrega o buffer parcial ao escritor (nada em direct) */
+void telemetry_flush(TelemetryWriter *w);
+
+/* Entrega o restante, aguarda o escritor e fecha o arquivo. Retorna 0, ou
+   -1 se algum lote falhou. */
+int telemetry_close(TelemetryWriter *w);
+
+/* Imprime linhas, lotes, esperas do produtor e duração das gravações */
+void telemetry_print(const TelemetryWriter *w, const char *path, FILE *out);
+
+#endif // TELEMETRY_H
@@ -0,0 +1,64 @@
+#ifndef THREADS_H
+#define THREADS_H
+
+/*
+    FILE: threads.h
+    DESCRIPTION:
+        Declara as funções das threads do sistema e, para cada thread
+        periódica, o corpo de uma ativação (leitura dos monitores, cálculo e
+        publicação) separado da espera pelo próximo período. Os corpos são
+        chamados pelas próprias threads e medidos isoladamente nos benchmarks.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stddef.h>         // Para size_t
+#include "monitors.h"       // Para as estruturas de argumentos
+#include "logger_thread.h"  // Para a thread de registro e logger_step
+#include "metrics.h"        // Para o motor de métricas
+
+#define INTERFACE_LINE_MAX (12 * NUMFMT_DOUBLE_BUFSZ + 64)  // Tamanho máximo da linha de status (12 valores e rótulos)
+
+// ==========================
+// Funções das threads
+// ==========================
+
+void *sim_thread(void *arg);
+void *linearization_thread(void *arg);
+void *control_thread(void *arg);
+void *ref_generator_thread(void *arg);
+void *model_ref_x_thread(void *arg);
+void *model_ref_y_thread(void *arg);
+void *interface_thread(void *arg);
+void *timer_thread(void *arg);
+void *metrics_thread(void *arg);
+void *checkpoint_thread(void *arg);
+
+// ==========================
+// Corpos das ativações (sem espera)
+// ==========================
+
+/* Integra o robô por um período e publica o estado */
+void sim_step(ArgsSim *args);
+
+/* Calcula e publica u(t) a partir de θ e v(t) */
+void linearization_step(ArgsLin *args);
+
+/* Calcula e publica v(t) a partir dos modelos de referência e de y(t) */
+void control_step(ArgsCtrl *args);
+
+/* Estende o horizonte de referências e publica a referência atual */
+void ref_generator_step(ArgsModel *args);
+
+/* Integra os modelos de referência X e Y por um período */
+void model_ref_x_step(ArgsModel *args);
+void model_ref_y_step(ArgsModel *args);
+
+/* Monta a linha de status do instante t; retorna o comprimento */
+size_t interface_step(ArgsInterface *args, double t, char *line);
+
+/* Incorpora uma amostra ao motor de métricas e publica o resumo */
+void metrics_step(ArgsMetrics *args, Metrics *metrics);
+
+#endif // THREADS_H
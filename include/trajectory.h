@@ -0,0 +1,121 @@
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+/*
+    FILE: trajectory.h
+    DESCRIPTION:
+        Biblioteca de trajetórias de referência. Curvas paramétricas (retas,
+        arcos, Lissajous, splines por waypoints, caminhos planejados em
+        mapas de ocupação e o oito original) são pré-calculadas em uma
+        tabela uniformemente amostrada com derivadas analíticas; a consulta
+        de xref/yref (e das velocidades de feedforward) é O(1), por
+        interpolação de Hermite cúbica entre duas amostras.
+        Tabelas podem ser salvas em binário e mapeadas em memória (mmap),
+        de modo que o custo independe do comprimento da trajetória.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stddef.h>   // Para size_t
+#include "scenario.h" // Para a seleção da trajetória no cenário
+
+#define TRAJ_MAGIC 0x4A415254u  // "TRAJ"
+#define TRAJ_VERSION 1u
+
+// Amostra da tabela: posição e velocidade (32 bytes, duas por linha de cache)
+typedef struct {
+    double x, y;    // Posição de referência
+    double dx, dy;  // Derivadas analíticas (feedforward)
+} TrajSample;
+
+// Cabeçalho do arquivo binário (seguido de 'count' TrajSample)
+typedef struct {
+    unsigned magic;
+    unsigned version;
+    unsigned long long count;
+    double dt;
+    double reserved[4];
+} TrajFileHeader;
+
+// Tabela de trajetória pronta para consulta
+typedef struct {
+    const TrajSample *samples;  // Amostras em t = i * dt
+    size_t count;               // Número de amostras (>= 2)
+    double dt, inv_dt;          // Espaçamento e seu inverso
+    double duration;            // (count - 1) * dt
+    void *owned;                // Buffer alocado (NULL se mapeado)
+    void *map_base;             // Região mapeada (NULL se alocado)
+    size_t map_len;
+} Trajectory;
+
+// Resultado de uma consulta
+typedef struct {
+    double x, y, dx, dy;
+} TrajPoint;
+
+/* Consulta O(1): posição por Hermite cúbica e velocidade por interpolação linear.
+   Antes de t = 0 e após o fim, mantém a amostra da extremidade (velocidade nula após o fim). */
+static inline TrajPoint trajectory_eval(const Trajectory *traj, double t) {
+    TrajPoint p;
+    if (t <= 0.0) {
+        const TrajSample *s = &traj->samples[0];
+        p.x = s->x; p.y = s->y; p.dx = s->dx; p.dy = s->dy;
+        return p;
+    }
+    double u = t * traj->inv_dt;
+    size_t i = (size_t)u;
+    if (i >= traj->count - 1) {
+        const TrajSample *s = &traj->samples[traj->count - 1];
+        p.x = s->x; p.y = s->y; p.dx = 0.0; p.dy = 0.0;
+        return p;
+    }
+    double f = u - (double)i;
+    const TrajSample *a = &traj->samples[i];
+    const TrajSample *b = a + 1;
+
+    // Bases de Hermite cúbica (derivadas escaladas por dt)
+    double f2 = f * f, f3 = f2 * f;
+    double h00 = 2 * f3 - 3 * f2 + 1;
+    double h10 = (f3 - 2 * f2 + f) * traj->dt;
+    double h01 = -2 * f3 + 3 * f2;
+    double h11 = (f3 - f2) * traj->dt;
+
+    p.x = h00 * a->x + h10 * a->dx + h01 * b->x + h11 * b->dx;
+    p.y = h00 * a->y + h10 * a->dy + h01 * b->y + h11 * b->dy;
+    p.dx = a->dx + f * (b->dx - a->dx);
+    p.dy = a->dy + f * (b->dy - a->dy);
+    return p;
+}
+
+/* Oito original (xref = 5/π cos(0.2πt), yref com inversão em t = 10 s) amostrado em dt */
+int trajectory_build_figure8(Trajectory *traj, double duration, double dt);
+
+/*
+ * Constrói a tabela a partir de um arquivo de especificação texto, um segmento por linha
+ * (tempos em segundos, segmentos concatenados no tempo):
+ *   line x0 y0 x1 y1 T
+ *   arc cx cy r theta0 theta1 T
+ *   lissajous ax ay wx wy phase T
+ *   figure8 T
+ *   spline T x0 y0 x1 y1 ... (spline cúbica natural pelos waypoints)
+ *   plan mapa.pbm res x0 y0 x1 y1 v a [folga [recuo]] (caminho livre pelo mapa,
+ *     planner.h; a duração sai do perfil de velocidade)
+ *   block t x0 y0 x1 y1 / clear t x0 y0 x1 y1 (eventos de mapa do segmento plan,
+ *     ignorados aqui e aplicados em execução pelo gerador de referências, replan.h)
+ */
+int trajectory_build_from_spec(Trajectory *traj, const char *path, double dt);
+
+/* Salva a tabela em formato binário */
+int trajectory_save(const Trajectory *traj, const char *path);
+
+/* Mapeia em memória uma tabela binária (páginas carregadas sob demanda) */
+int trajectory_map(Trajectory *traj, const char *path);
+
+/* Seleciona a trajetória do cenário: "figure8", arquivo ".bin" (mmap) ou especificação texto */
+int trajectory_load(Trajectory *traj, const ScenarioConfig *cfg);
+
+/* Libera o buffer ou desfaz o mapeamento */
+void trajectory_free(Trajectory *traj);
+
+#endif // TRAJECTORY_H
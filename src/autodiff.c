@@ -0,0 +1,70 @@
+/*
+    FILE: autodiff.c
+    DESCRIPTION:
+        Implementa a avaliação das Jacobianas do uniciclo por números
+        duais (autodiff.h), para um ponto e em lote.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include "autodiff.h"
+
+/* Avalia o modelo sobre Dual com as cinco variáveis semeadas */
+static inline void eval(double x1, double x2, double x3, double u1, double u2, double R,
+                        Dual f[3], Dual y[2]) {
+    Dual x[3] = { ad_var(x1, AD_X1), ad_var(x2, AD_X2), ad_var(x3, AD_X3) };
+    Dual u[2] = { ad_var(u1, AD_U1), ad_var(u2, AD_U2) };
+    ad_unicycle_model(x, u, R, f, y);
+}
+
+void ad_unicycle(const double x[3], const double u[2], double R, UnicycleJacobians *out) {
+    Dual f[3], y[2];
+    eval(x[0], x[1], x[2], u[0], u[1], R, f, y);
+
+    for (int i = 0; i < 3; i++) {
+        out->f[i] = f[i].v;
+        for (int j = 0; j < 3; j++) out->A[i][j] = f[i].d[AD_X1 + j];
+        for (int j = 0; j < 2; j++) out->B[i][j] = f[i].d[AD_U1 + j];
+    }
+    for (int i = 0; i < 2; i++) {
+        out->y[i] = y[i].v;
+        for (int j = 0; j < 3; j++) out->C[i][j] = y[i].d[AD_X1 + j];
+    }
+}
+
+int ad_unicycle_batch(int n, const double *x1, const double *x2, const double *x3,
+                      const double *u1, const double *u2, double R,
+                      Matrix *A, Matrix *B, Matrix *C) {
+    if ((A && (A->rows != 3 * n || A->cols != 3)) || (B && (B->rows != 3 * n || B->cols != 2)) ||
+        (C && (C->rows != 2 * n || C->cols != 3))) {
+        LOG_ERROR("ad_unicycle_batch - Erro: Dimensões incompatíveis com %d pontos "
+                  "(esperado A 3nx3, B 3nx2, C 2nx3).\n", n);
+        return -1;
+    }
+
+    for (int p = 0; p < n; p++) {
+        Dual f[3], y[2];
+        eval(x1[p], x2[p], x3[p], u1[p], u2[p], R, f, y);
+
+        if (A) {
+            for (int i = 0; i < 3; i++) {
+                float *row = A->data[3 * p + i];
+                for (int j = 0; j < 3; j++) row[j] = (float)f[i].d[AD_X1 + j];
+            }
+        }
+        if (B) {
+            for (int i = 0; i < 3; i++) {
+                float *row = B->data[3 * p + i];
+                for (int j = 0; j < 2; j++) row[j] = (float)f[i].d[AD_U1 + j];
+            }
+        }
+        if (C) {
+            for (int i = 0; i < 2; i++) {
+                float *row = C->data[2 * p + i];
+                for (int j = 0; j < 3; j++) row[j] = (float)y[i].d[AD_X1 + j];
+            }
+        }
+    }
+    return 0;
+}
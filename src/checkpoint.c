@@ -0,0 +1,264 @@
+/*
+    FILE: checkpoint.c
+    DESCRIPTION:
+        Implementa a captura, a gravação atômica, a leitura validada e a
+        restauração do estado da simulação (checkpoint.h).
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "checkpoint.h"
+#include "logs.h"
+
+/* FNV-1a de 64 bits */
+static uint64_t fnv1a(const void *data, size_t len) {
+    const unsigned char *p = data;
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+/* Escreve len bytes (repetindo escritas parciais); retorna 0 ou -1 */
+static int write_all(int fd, const void *data, size_t len) {
+    const char *p = data;
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+/* Sincroniza o diretório de path (a renomeação passa a sobreviver a uma queda) */
+static void sync_parent(const char *path) {
+    char dir[SCENARIO_PATH_MAX];
+    const char *slash = strrchr(path, '/');
+    if (!slash) {
+        strcpy(dir, ".");
+    } else {
+        size_t len = slash == path ? 1 : (size_t)(slash - path);
+        if (len >= sizeof(dir)) return;
+        memcpy(dir, path, len);
+        dir[len] = '\0';
+    }
+    int fd = open(dir, O_RDONLY);
+    if (fd < 0) return;
+    fsync(fd);
+    close(fd);
+}
+
+void checkpoint_capture(const ArgsCheckpoint *a, SystemCheckpoint *ck) {
+    memset(ck, 0, sizeof(*ck));
+
+    pthread_mutex_lock(&a->t->mutex);
+    ck->tempo = a->t->tempo_atual;
+    pthread_mutex_unlock(&a->t->mutex);
+
+    pthread_mutex_lock(&a->e->mutex);
+    ck->x1 = a->e->x1;
+    ck->x2 = a->e->x2;
+    ck->x3 = a->e->x3;
+    ck->y1 = a->e->y1;
+    ck->y2 = a->e->y2;
+    ck->xe3 = a->e->xe3;
+    ck->ye1 = a->e->ye1;
+    ck->ye2 = a->e->ye2;
+    pthread_mutex_unlock(&a->e->mutex);
+
+    pthread_mutex_lock(&a->c->mutex);
+    ck->v1 = a->c->v1;
+    ck->v2 = a->c->v2;
+    pthread_mutex_unlock(&a->c->mutex);
+
+    pthread_mutex_lock(&a->l->mutex);
+    ck->u1 = a->l->u1;
+    ck->u2 = a->l->u2;
+    pthread_mutex_unlock(&a->l->mutex);
+
+    pthread_mutex_lock(&a->r->mutex);
+    ck->xref = a->r->xref;
+    ck->yref = a->r->yref;
+    ck->dxref = a->r->dxref;
+    ck->dyref = a->r->dyref;
+    pthread_mutex_unlock(&a->r->mutex);
+
+    pthread_mutex_lock(&a->mx->mutex);
+    ck->ymx = a->mx->y_m;
+    ck->dymx = a->mx->dy_m;
+    pthread_mutex_unlock(&a->mx->mutex);
+
+    pthread_mutex_lock(&a->my->mutex);
+    ck->ymy = a->my->y_m;
+    ck->dymy = a->my->dy_m;
+    pthread_mutex_unlock(&a->my->mutex);
+
+    pthread_mutex_lock(&a->p->mutex);
+    ck->alpha1 = a->p->alpha1;
+    ck->alpha2 = a->p->alpha2;
+    pthread_mutex_unlock(&a->p->mutex);
+
+    // Estado local das tarefas: sem mutex, estável enquanto as tarefas estão retidas
+    if (a->est) ck->estimador = *a->est;
+    if (a->pi) ck->integral = *a->pi;
+    ck->metricas = a->m->motor;
+}
+
+int checkpoint_save(const SystemCheckpoint *ck, const char *path) {
+    char tmp[SCENARIO_PATH_MAX + 8];
+    if (snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= (int)sizeof(tmp)) {
+        LOG_ERROR("Caminho do checkpoint muito longo: %s\n", path);
+        return -1;
+    }
+
+    CheckpointFileHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = CHECKPOINT_MAGIC;
+    hdr.version = CHECKPOINT_VERSION;
+    hdr.size = sizeof(*ck);
+    hdr.checksum = fnv1a(ck, sizeof(*ck));
+
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        LOG_ERROR("Não foi possível criar '%s'\n", tmp);
+        return -1;
+    }
+    int ok = write_all(fd, &hdr, sizeof(hdr)) == 0 && write_all(fd, ck, sizeof(*ck)) == 0 &&
+             fsync(fd) == 0;
+    if (close(fd) != 0) ok = 0;
+    if (!ok || rename(tmp, path) != 0) {
+        LOG_ERROR("Falha ao gravar o checkpoint '%s'\n", path);
+        unlink(tmp);
+        return -1;
+    }
+    sync_parent(path);
+    return 0;
+}
+
+int checkpoint_load(SystemCheckpoint *ck, const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        LOG_ERROR("Não foi possível abrir o checkpoint '%s'\n", path);
+        return -1;
+    }
+    CheckpointFileHeader hdr;
+    int ok = fread(&hdr, sizeof(hdr), 1, file) == 1 && hdr.magic == CHECKPOINT_MAGIC &&
+             hdr.version == CHECKPOINT_VERSION && hdr.size == sizeof(*ck) &&
+             fread(ck, sizeof(*ck), 1, file) == 1;
+    fclose(file);
+    if (!ok) {
+        LOG_ERROR("'%s' não é um checkpoint da versão %u\n", path, CHECKPOINT_VERSION);
+        return -1;
+    }
+    if (fnv1a(ck, sizeof(*ck)) != hdr.checksum) {
+        LOG_ERROR("Checkpoint '%s' corrompido (soma de verificação)\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+void checkpoint_restore(const ArgsCheckpoint *a, const SystemCheckpoint *ck,
+                        const Trajectory *traj, SnapshotHub *g) {
+    const ScenarioConfig *cfg = a->cfg;
+
+    pthread_mutex_lock(&a->t->mutex);
+    a->t->tempo_atual = ck->tempo;
+    clock_gettime(CLOCK_MONOTONIC, &a->t->marca);
+    pthread_mutex_unlock(&a->t->mutex);
+
+    pthread_mutex_lock(&a->e->mutex);
+    a->e->x1 = ck->x1;
+    a->e->x2 = ck->x2;
+    a->e->x3 = ck->x3;
+    a->e->y1 = ck->y1;
+    a->e->y2 = ck->y2;
+    a->e->xe3 = ck->xe3;
+    a->e->ye1 = ck->ye1;
+    a->e->ye2 = ck->ye2;
+    pthread_mutex_unlock(&a->e->mutex);
+
+    pthread_mutex_lock(&a->c->mutex);
+    a->c->v1 = ck->v1;
+    a->c->v2 = ck->v2;
+    pthread_mutex_unlock(&a->c->mutex);
+
+    pthread_mutex_lock(&a->l->mutex);
+    a->l->u1 = ck->u1;
+    a->l->u2 = ck->u2;
+    pthread_mutex_unlock(&a->l->mutex);
+
+    // Horizonte refeito da tabela até cobrir o instante restaurado, como o
+    // gerador o deixaria na sua próxima ativação
+    pthread_mutex_lock(&a->r->mutex);
+    a->r->xref = ck->xref;
+    a->r->yref = ck->yref;
+    a->r->dxref = ck->dxref;
+    a->r->dyref = ck->dyref;
+    pthread_mutex_unlock(&a->r->mutex);
+    ref_preview_init(&a->r->preview, cfg->preview_dt);
+    ref_preview_fill(&a->r->preview, traj, ck->tempo + cfg->preview_horizon_s, data_age_now());
+
+    pthread_mutex_lock(&a->mx->mutex);
+    a->mx->y_m = ck->ymx;
+    a->mx->dy_m = ck->dymx;
+    pthread_mutex_unlock(&a->mx->mutex);
+
+    pthread_mutex_lock(&a->my->mutex);
+    a->my->y_m = ck->ymy;
+    a->my->dy_m = ck->dymy;
+    pthread_mutex_unlock(&a->my->mutex);
+
+    // Estimador: estado e gerador do checkpoint, modo do cenário atual
+    if (a->est) {
+        int mode = a->est->mode;
+        *a->est = ck->estimador;
+        a->est->mode = mode;
+    }
+    if (a->pi) *a->pi = ck->integral;
+
+    // Métricas: acumuladores do checkpoint, limites e janela do cenário atual
+    // (o motor já foi preparado com metrics_init)
+    Metrics atual = a->m->motor;
+    pthread_mutex_lock(&a->m->mutex);
+    a->m->motor = ck->metricas;
+    memcpy(a->m->motor.v_lim, atual.v_lim, sizeof(atual.v_lim));
+    memcpy(a->m->motor.u_lim, atual.u_lim, sizeof(atual.u_lim));
+    a->m->motor.settle_band = atual.settle_band;
+    a->m->motor.recent_ise.window = atual.recent_ise.window;
+    metrics_summary(&a->m->motor, &a->m->resumo);
+    pthread_mutex_unlock(&a->m->mutex);
+
+    // Instantâneo global já com os sinais restaurados (leitores na partida);
+    // antes da partida esta função é o único publicador
+    snapshot_post(g, SNAPSHOT_SRC_MODELO_X, ck->ymx, 0.0);
+    snapshot_post(g, SNAPSHOT_SRC_MODELO_Y, ck->ymy, 0.0);
+    snapshot_post(g, SNAPSHOT_SRC_CONTROLE, ck->v1, ck->v2);
+    SystemSnapshot tick = { .t = ck->tempo, .xref = ck->xref, .yref = ck->yref,
+                            .x1 = ck->x1, .x2 = ck->x2, .x3 = ck->x3, .y1 = ck->y1, .y2 = ck->y2,
+                            .u1 = ck->u1, .u2 = ck->u2 };
+    snapshot_publish(g, &tick, data_age_now());
+
+    LOG_DEBUG("Checkpoint restaurado em t=%.3f s: x=(%.3f, %.3f, %.3f)\n", ck->tempo, ck->x1, ck->x2, ck->x3);
+}
+
+void checkpoint_print(const CheckpointStats *s, const char *path, FILE *out) {
+    fprintf(out, "[CHECKPOINT] %lu gravados em %s (último em t=%.2f s), %lu falhas\n",
+            s->capturas, path, s->ultimo, s->falhas);
+    if (s->capturas + s->falhas == 0) return;
+    double n = (double)(s->capturas + s->falhas);
+    fprintf(out, "  pausa das tarefas: média %.1f µs, máx %.1f µs; gravação: média %.2f ms, máx %.2f ms\n",
+            s->pausa_total / n * 1e6, s->pausa_max * 1e6, s->gravacao_total / n * 1e3,
+            s->gravacao_max * 1e3);
+}
@@ -0,0 +1,82 @@
+/*
+    FILE: checkpoint_thread.c
+    DESCRIPTION:
+        Implementa a thread de checkpoint: a cada checkpoint_period_s de
+        tempo de simulação, retém as tarefas entre ativações, copia o
+        estado do sistema para a memória, libera as tarefas e só então
+        grava o arquivo (de forma atômica), sem segurar as demais durante
+        a escrita em disco.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include <time.h>
+#include "monitors.h"    // Para acessar dados compartilhados entre threads
+#include "threads.h"     // Protótipos das threads
+#include "checkpoint.h"  // Captura e gravação
+#include "logs.h"        // Para log de eventos
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Função da thread de checkpoint */
+void *checkpoint_thread(void *arg) {
+    ArgsCheckpoint *args = (ArgsCheckpoint *)arg;
+    const ScenarioConfig *cfg = args->cfg;  // Arquivo, intervalo e período de verificação
+    CheckpointStats *st = &args->stats;
+
+    LOG_DEBUG("Thread de checkpoint iniciada.\n");
+
+    // Primeiro checkpoint um intervalo após o início (ou após o instante restaurado)
+    pthread_mutex_lock(&args->t->mutex);
+    double proximo = args->t->tempo_atual + cfg->checkpoint_period_s;
+    pthread_mutex_unlock(&args->t->mutex);
+
+    struct timespec next_activation;
+    int ativo = supervisor_start(&next_activation);
+
+    while (ativo) {
+        pthread_mutex_lock(&args->t->mutex);
+        double t = args->t->tempo_atual;
+        pthread_mutex_unlock(&args->t->mutex);
+
+        if (t >= proximo - 1e-9) {
+            // Captura com as tarefas retidas entre ativações
+            SystemCheckpoint ck;
+            double t0 = now_s();
+            supervisor_pause(args->sv);
+            checkpoint_capture(args, &ck);
+            supervisor_resume(args->sv);
+            double pausa = now_s() - t0;
+
+            // Gravação fora da pausa
+            int status = checkpoint_save(&ck, cfg->checkpoint_file);
+            double gravacao = now_s() - t0 - pausa;
+
+            st->pausa_total += pausa;
+            st->gravacao_total += gravacao;
+            if (pausa > st->pausa_max) st->pausa_max = pausa;
+            if (gravacao > st->gravacao_max) st->gravacao_max = gravacao;
+            if (status == 0) {
+                st->capturas++;
+                st->ultimo = ck.tempo;
+            } else {
+                st->falhas++;
+            }
+            LOG_DEBUG("Checkpoint em t=%.3f s: pausa de %.1f µs, gravação de %.2f ms\n",
+                      ck.tempo, pausa * 1e6, gravacao * 1e3);
+            while (proximo <= t + 1e-9) proximo += cfg->checkpoint_period_s;
+        }
+
+        // Verifica o relógio a cada passo do relógio de simulação
+        supervisor_advance(&next_activation, cfg->timer_interval_ms);
+        ativo = supervisor_sleep_until(&next_activation);
+    }
+
+    pthread_exit(NULL);  // Encerra a thread
+}
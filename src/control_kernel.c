@@ -0,0 +1,172 @@
+/*
+    FILE: control_kernel.c
+    DESCRIPTION:
+        Implementa os backends float32 e Q16.16 das leis do controlador e
+        as tabelas de backends (control_kernel.h). As versões em double
+        ficam em control_law.c.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <math.h>
+#include "control_kernel.h"
+
+static inline float saturatef(float value, float limit) {
+    if (value > limit) return limit;
+    if (value < -limit) return -limit;
+    return value;
+}
+
+// ==========================
+// float32
+// ==========================
+
+void kernel_f32_params(const ScenarioConfig *cfg, KernelParamsF32 *p) {
+    p->v_max = (float)cfg->v_max;
+    p->w_max = (float)cfg->w_max;
+    p->u1_max = (float)cfg->u1_max;
+    p->u2_max = (float)cfg->u2_max;
+    p->R = (float)cfg->R;
+}
+
+void kernel_f32_model_ref(float ref, float alpha, float dt, float *y_m, float *dy_m) {
+    *dy_m = alpha * (ref - *y_m);
+    *y_m += *dy_m * dt;
+}
+
+void kernel_f32_control(const KernelParamsF32 *p,
+                        float ymx, float dymx, float ymy, float dymy,
+                        float y1, float y2, float alpha1, float alpha2,
+                        float *v1, float *v2) {
+    *v1 = saturatef(dymx + alpha1 * (ymx - y1), p->v_max);
+    *v2 = saturatef(dymy + alpha2 * (ymy - y2), p->w_max);
+}
+
+void kernel_f32_linearization(const KernelParamsF32 *p, float theta, float v1, float v2,
+                              float *u1, float *u2) {
+    float c = cosf(theta), s = sinf(theta);
+    *u1 = saturatef(c * v1 + s * v2, p->u1_max);
+    *u2 = saturatef((-s * v1 + c * v2) / p->R, p->u2_max);
+}
+
+void model_ref_step_f32(double ref, double alpha, double dt, double *y_m, double *dy_m) {
+    float y = (float)*y_m, dy;
+    kernel_f32_model_ref((float)ref, (float)alpha, (float)dt, &y, &dy);
+    *y_m = y;
+    *dy_m = dy;
+}
+
+void control_law_f32(const ScenarioConfig *cfg,
+                     double ymx, double dymx, double ymy, double dymy,
+                     double y1, double y2, double alpha1, double alpha2,
+                     double *v1, double *v2) {
+    KernelParamsF32 p;
+    float a, b;
+    kernel_f32_params(cfg, &p);
+    kernel_f32_control(&p, (float)ymx, (float)dymx, (float)ymy, (float)dymy,
+                       (float)y1, (float)y2, (float)alpha1, (float)alpha2, &a, &b);
+    *v1 = a;
+    *v2 = b;
+}
+
+void linearization_law_f32(const ScenarioConfig *cfg, double theta, double v1, double v2,
+                           double *u1, double *u2) {
+    KernelParamsF32 p;
+    float a, b;
+    kernel_f32_params(cfg, &p);
+    kernel_f32_linearization(&p, (float)theta, (float)v1, (float)v2, &a, &b);
+    *u1 = a;
+    *u2 = b;
+}
+
+// ==========================
+// Q16.16
+// ==========================
+
+void kernel_q16_params(const ScenarioConfig *cfg, KernelParamsQ16 *p) {
+    p->v_max = q16_from_double(cfg->v_max);
+    p->w_max = q16_from_double(cfg->w_max);
+    p->u1_max = q16_from_double(cfg->u1_max);
+    p->u2_max = q16_from_double(cfg->u2_max);
+    p->inv_R = q16_from_double(1.0 / cfg->R);
+}
+
+void kernel_q16_model_ref(q16_t ref, q16_t alpha, q16_t dt, q16_t *y_m, q16_t *dy_m) {
+    *dy_m = q16_mul(alpha, q16_sub(ref, *y_m));
+    *y_m = q16_add(*y_m, q16_mul(*dy_m, dt));
+}
+
+void kernel_q16_control(const KernelParamsQ16 *p,
+                        q16_t ymx, q16_t dymx, q16_t ymy, q16_t dymy,
+                        q16_t y1, q16_t y2, q16_t alpha1, q16_t alpha2,
+                        q16_t *v1, q16_t *v2) {
+    *v1 = q16_saturate(q16_add(dymx, q16_mul(alpha1, q16_sub(ymx, y1))), p->v_max);
+    *v2 = q16_saturate(q16_add(dymy, q16_mul(alpha2, q16_sub(ymy, y2))), p->w_max);
+}
+
+void kernel_q16_linearization(const KernelParamsQ16 *p, q16_t theta, q16_t v1, q16_t v2,
+                              q16_t *u1, q16_t *u2) {
+    q16_t c = q16_cos(theta), s = q16_sin(theta);
+    *u1 = q16_saturate(q16_add(q16_mul(c, v1), q16_mul(s, v2)), p->u1_max);
+    q16_t w = q16_sub(q16_mul(c, v2), q16_mul(s, v1));
+    *u2 = q16_saturate(q16_mul(w, p->inv_R), p->u2_max);
+}
+
+void model_ref_step_q16(double ref, double alpha, double dt, double *y_m, double *dy_m) {
+    q16_t y = q16_from_double(*y_m), dy;
+    kernel_q16_model_ref(q16_from_double(ref), q16_from_double(alpha), q16_from_double(dt),
+                         &y, &dy);
+    *y_m = q16_to_double(y);
+    *dy_m = q16_to_double(dy);
+}
+
+void control_law_q16(const ScenarioConfig *cfg,
+                     double ymx, double dymx, double ymy, double dymy,
+                     double y1, double y2, double alpha1, double alpha2,
+                     double *v1, double *v2) {
+    KernelParamsQ16 p;
+    q16_t a, b;
+    kernel_q16_params(cfg, &p);
+    kernel_q16_control(&p, q16_from_double(ymx), q16_from_double(dymx),
+                       q16_from_double(ymy), q16_from_double(dymy),
+                       q16_from_double(y1), q16_from_double(y2),
+                       q16_from_double(alpha1), q16_from_double(alpha2), &a, &b);
+    *v1 = q16_to_double(a);
+    *v2 = q16_to_double(b);
+}
+
+void linearization_law_q16(const ScenarioConfig *cfg, double theta, double v1, double v2,
+                           double *u1, double *u2) {
+    KernelParamsQ16 p;
+    q16_t a, b;
+    kernel_q16_params(cfg, &p);
+    kernel_q16_linearization(&p, q16_from_double(theta), q16_from_double(v1),
+                             q16_from_double(v2), &a, &b);
+    *u1 = q16_to_double(a);
+    *u2 = q16_to_double(b);
+}
+
+// ==========================
+// Tabelas de backends
+// ==========================
+
+const ControlKernel control_kernel_double = {
+    "double", model_ref_step_f64, control_law_f64, linearization_law_f64
+};
+
+const ControlKernel control_kernel_float32 = {
+    "float32", model_ref_step_f32, control_law_f32, linearization_law_f32
+};
+
+const ControlKernel control_kernel_q16 = {
+    "q16.16", model_ref_step_q16, control_law_q16, linearization_law_q16
+};
+
+#if CONTROL_BACKEND == CONTROL_BACKEND_FLOAT32
+const ControlKernel *const control_kernel_compiled = &control_kernel_float32;
+#elif CONTROL_BACKEND == CONTROL_BACKEND_Q16
+const ControlKernel *const control_kernel_compiled = &control_kernel_q16;
+#else
+const ControlKernel *const control_kernel_compiled = &control_kernel_double;
+#endif
@@ -0,0 +1,94 @@
+/*
+    FILE: control_law.c
+    DESCRIPTION:
+        Implementa as leis puras do robô diferencial (control_law.h). As
+        leis do controlador daqui são o backend double; as públicas
+        encaminham para o backend escolhido na compilação (control_kernel.h).
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <math.h>
+#include "control_law.h"
+#include "control_kernel.h"
+
+#if CONTROL_BACKEND == CONTROL_BACKEND_FLOAT32
+#define BACKEND(fn) fn##_f32
+#elif CONTROL_BACKEND == CONTROL_BACKEND_Q16
+#define BACKEND(fn) fn##_q16
+#else
+#define BACKEND(fn) fn##_f64
+#endif
+
+void reference_figure8(double t, double *xref, double *yref) {
+    *xref = (5.0 / M_PI) * cos(0.2 * M_PI * t);
+    *yref = (t < 10.0) ?
+        (5.0 / M_PI) * sin(0.2 * M_PI * t) :
+        -(5.0 / M_PI) * sin(0.2 * M_PI * t);
+}
+
+void model_ref_step_f64(double ref, double alpha, double dt, double *y_m, double *dy_m) {
+    *dy_m = alpha * (ref - *y_m);  // Derivada do modelo
+    *y_m += *dy_m * dt;            // Integração de Euler
+}
+
+void control_law_f64(const ScenarioConfig *cfg,
+                     double ymx, double dymx, double ymy, double dymy,
+                     double y1, double y2, double alpha1, double alpha2,
+                     double *v1, double *v2) {
+    *v1 = saturate(dymx + alpha1 * (ymx - y1), cfg->v_max);
+    *v2 = saturate(dymy + alpha2 * (ymy - y2), cfg->w_max);
+}
+
+void linearization_law_f64(const ScenarioConfig *cfg, double theta, double v1, double v2,
+                           double *u1, double *u2) {
+    double c = cos(theta), s = sin(theta);
+    *u1 = saturate(c * v1 + s * v2, cfg->u1_max);
+    *u2 = saturate((-s * v1 + c * v2) / cfg->R, cfg->u2_max);
+}
+
+void model_ref_step(double ref, double alpha, double dt, double *y_m, double *dy_m) {
+    BACKEND(model_ref_step)(ref, alpha, dt, y_m, dy_m);
+}
+
+void control_law(const ScenarioConfig *cfg,
+                 double ymx, double dymx, double ymy, double dymy,
+                 double y1, double y2, double alpha1, double alpha2,
+                 double *v1, double *v2) {
+    BACKEND(control_law)(cfg, ymx, dymx, ymy, dymy, y1, y2, alpha1, alpha2, v1, v2);
+}
+
+void linearization_law(const ScenarioConfig *cfg, double theta, double v1, double v2,
+                       double *u1, double *u2) {
+    BACKEND(linearization_law)(cfg, theta, v1, v2, u1, u2);
+}
+
+void integral_action_init(IntegralAction *ia) {
+    running_integral_init(&ia->ex, INTEGRAL_TRAPEZOID);
+    running_integral_init(&ia->ey, INTEGRAL_TRAPEZOID);
+}
+
+void integral_action_apply(IntegralAction *ia, const ScenarioConfig *cfg, double t,
+                           double ex, double ey, double *v1, double *v2) {
+    double limit = cfg->ctrl_ki_limit / cfg->ctrl_ki;
+    running_integral_add(&ia->ex, t, ex);
+    running_integral_add(&ia->ey, t, ey);
+    running_integral_clamp(&ia->ex, limit);
+    running_integral_clamp(&ia->ey, limit);
+    *v1 = saturate(*v1 + cfg->ctrl_ki * running_integral_value(&ia->ex), cfg->v_max);
+    *v2 = saturate(*v2 + cfg->ctrl_ki * running_integral_value(&ia->ey), cfg->w_max);
+}
+
+void robot_step(RobotState *s, double R, double u1, double u2, double dt) {
+    s->x1 += cos(s->x3) * u1 * dt;
+    s->x2 += sin(s->x3) * u1 * dt;
+    s->x3 += u2 * dt;
+
+    // Mantém θ ∈ [-π, π]
+    while (s->x3 > M_PI) s->x3 -= 2 * M_PI;
+    while (s->x3 < -M_PI) s->x3 += 2 * M_PI;
+
+    s->y1 = s->x1 + R * cos(s->x3);
+    s->y2 = s->x2 + R * sin(s->x3);
+}
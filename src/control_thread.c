@@ -8,87 +8,163 @@
     LICENSE: CC BY-SA
 */
 
-#define _POSIX_C_SOURCE 199309L
+#define _POSIX_C_SOURCE 200112L
 #include <time.h>
 #include <unistd.h>
 #include <math.h>
 #include "monitors.h"  // Para acesso às variáveis compartilhadas (mutexes)
+#include "threads.h"   // Protótipos das threads e dos corpos das ativações
 #include "logs.h"      // Para registro de logs de depuração
+#include "control_law.h" // Lei de controle por modelo de referência
+
+/* Corpo de uma ativação: calcula e publica v(t) (sem espera) */
+void control_step(ArgsCtrl *args) {
+    const ScenarioConfig *cfg = args->cfg;
+
+    // Captura a pose vista pelo controle (y1, y2 e θ para o preditivo)
+    double y1, y2, theta;
+    DataStamp ce, cmx, cmy;  // Carimbos das entradas
+    pthread_mutex_lock(&args->e->mutex);
+    y1 = args->e->ye1;
+    y2 = args->e->ye2;
+    theta = args->e->xe3;
+    ce = args->e->carimbo;
+    pthread_mutex_unlock(&args->e->mutex);
+
+    // Captura o modelo de referência nas direções X e Y
+    double ymx, dymx, ymy, dymy;
+    pthread_mutex_lock(&args->mx->mutex);
+    ymx = args->mx->y_m;
+    dymx = args->mx->dy_m;
+    cmx = args->mx->carimbo;
+    pthread_mutex_unlock(&args->mx->mutex);
+
+    pthread_mutex_lock(&args->my->mutex);
+    ymy = args->my->y_m;
+    dymy = args->my->dy_m;
+    cmy = args->my->carimbo;
+    pthread_mutex_unlock(&args->my->mutex);
+
+    // Captura os parâmetros α1 e α2
+    double alpha1, alpha2;
+    pthread_mutex_lock(&args->p->mutex);
+    alpha1 = args->p->alpha1;
+    alpha2 = args->p->alpha2;
+    pthread_mutex_unlock(&args->p->mutex);
+
+    double v1, v2;
+    if (args->mpc) {
+        // Preditivo: referências do horizonte publicado em t + (k+1) dt;
+        // u respeita u1_max/u2_max e v = B(θ) u é invertido pela linearização
+        double t = monitor_tempo_exato(args->t);
+        double xr[MPC_MAX_HORIZON], yr[MPC_MAX_HORIZON], u1, u2;
+        for (int k = 0; k < args->mpc->n; k++) {
+            RefPreviewSample amostra;
+            if (ref_preview_sample(&args->r->preview, t + (k + 1) * args->mpc->dt, &amostra) != 0) {
+                pthread_mutex_lock(&args->r->mutex);
+                amostra.x = args->r->xref;
+                amostra.y = args->r->yref;
+                pthread_mutex_unlock(&args->r->mutex);
+            }
+            xr[k] = amostra.x;
+            yr[k] = amostra.y;
+        }
+        mpc_solve(args->mpc, y1, y2, theta, xr, yr, &u1, &u2, &v1, &v2);
+    } else if (args->lqr) {
+        // LQR: ganho interpolado no ponto de operação da referência atual;
+        // a amostra um período adiante dá o giro de referência
+        double t = monitor_tempo_exato(args->t), u1, u2;
+        RefPreviewSample agora, seguinte;
+        if (ref_preview_sample(&args->r->preview, t, &agora) != 0) {
+            pthread_mutex_lock(&args->r->mutex);
+            agora.x = args->r->xref;
+            agora.y = args->r->yref;
+            agora.dx = args->r->dxref;
+            agora.dy = args->r->dyref;
+            pthread_mutex_unlock(&args->r->mutex);
+            seguinte = agora;
+        } else {
+            ref_preview_sample(&args->r->preview, t + args->lqr->dt, &seguinte);
+        }
+        lqr_control(args->lqr, y1, y2, theta, &agora, &seguinte, &u1, &u2, &v1, &v2);
+    } else {
+        // Calcula o sinal de controle v(t) para as duas direções, já saturado
+        control_law(cfg, ymx, dymx, ymy, dymy, y1, y2, alpha1, alpha2, &v1, &v2);
+        // Ação integral em fluxo sobre o erro de rastreamento no instante
+        // exato da ativação (PI)
+        if (args->pi && cfg->ctrl_ki > 0) {
+            double t = monitor_tempo_exato(args->t);
+            RefPreviewSample ref;
+            if (ref_preview_sample(&args->r->preview, t, &ref) != 0) {
+                pthread_mutex_lock(&args->r->mutex);
+                ref.x = args->r->xref;
+                ref.y = args->r->yref;
+                pthread_mutex_unlock(&args->r->mutex);
+            }
+            integral_action_apply(args->pi, cfg, t, ref.x - y1, ref.y - y2, &v1, &v2);
+        }
+    }
 
-#define PERIOD_MS 50   // Período de execução da thread em ms
-#define V_MAX 1.0      // Limite máximo de velocidade linear (v1)
-#define W_MAX 1.0      // Limite máximo de velocidade angular (v2)
+    // Grava entradas e saídas exatas da lei para reprodução determinística
+    // (preditivo, LQR e ação integral não são reproduzidos pela lei: só a
+    // linearização é gravada)
+    if (args->rec && !args->mpc && !args->lqr && cfg->ctrl_ki == 0) {
+        ReplayCtrl rc = { monitor_tempo_exato(args->t), 0, 0, ymx, dymx, ymy, dymy,
+                          y1, y2, alpha1, alpha2, v1, v2 };
+        pthread_mutex_lock(&args->r->mutex);
+        rc.xref = args->r->xref;
+        rc.yref = args->r->yref;
+        pthread_mutex_unlock(&args->r->mutex);
+        replay_record_ctrl(args->rec, &rc);
+    }
+
+    // v(t) herda a origem mais antiga de cada fonte entre as entradas
+    double agora = data_age_now();
+    double origem[DATA_SOURCES];
+    data_stamp_begin(origem);
+    data_stamp_merge(origem, &ce);
+    data_stamp_merge(origem, &cmx);
+    data_stamp_merge(origem, &cmy);
+
+    // Atualiza os comandos de controle nas estruturas compartilhadas
+    pthread_mutex_lock(&args->c->mutex);
+    args->c->v1 = v1;
+    args->c->v2 = v2;
+    data_stamp_publish(&args->c->carimbo, origem, agora);
+    pthread_mutex_unlock(&args->c->mutex);
+
+    snapshot_post(args->g, SNAPSHOT_SRC_CONTROLE, v1, v2);  // Lido pelo próximo tick do robô
+
+    // Idade das entradas (modelos: o mais antigo; repetida só se nenhum dos dois mudou)
+    double pub_m = cmx.publicado < cmy.publicado ? cmx.publicado : cmy.publicado;
+    pthread_mutex_lock(&args->a->mutex);
+    age_histogram_add(&args->a->caminhos[AGE_ESTADO_CONTROLE], agora - ce.publicado, ce.seq);
+    if (cmx.seq && cmy.seq)
+        age_histogram_add(&args->a->caminhos[AGE_MODELO_CONTROLE], agora - pub_m, cmx.seq + cmy.seq);
+    pthread_mutex_unlock(&args->a->mutex);
+
+    // Registra as variáveis de controle e de referência no log
+    LOG_DEBUG("Controle atualizado: v=(%.2f, %.2f), ym=(%.2f, %.2f), y=(%.2f, %.2f)\n",
+              v1, v2, ymx, ymy, y1, y2);
+}
 
 void *control_thread(void *arg) {
     ArgsCtrl *args = (ArgsCtrl *)arg;
+    const ScenarioConfig *cfg = args->cfg;  // Período e limites de saturação
 
     LOG_DEBUG("Thread de controle iniciada.\n");
 
+    // Aguarda a partida comum liberada pelo supervisor
     struct timespec next_activation;
-    clock_gettime(CLOCK_MONOTONIC, &next_activation);  // Tempo inicial da thread
-
-    while (1) {
-        // Verifica o tempo de simulação e se a thread deve ser encerrada
-        pthread_mutex_lock(&args->t->mutex);
-        if (args->t->encerrar) {
-            pthread_mutex_unlock(&args->t->mutex);
-            pthread_exit(NULL);  // Encerra a thread quando indicado
-        }
-        pthread_mutex_unlock(&args->t->mutex);
-
-        // Captura o estado atual do robô (y1, y2)
-        double y1, y2;
-        pthread_mutex_lock(&args->e->mutex);
-        y1 = args->e->y1;
-        y2 = args->e->y2;
-        pthread_mutex_unlock(&args->e->mutex);
-
-        // Captura o modelo de referência nas direções X e Y
-        double ymx, dymx, ymy, dymy;
-        pthread_mutex_lock(&args->mx->mutex);
-        ymx = args->mx->y_m;
-        dymx = args->mx->dy_m;
-        pthread_mutex_unlock(&args->mx->mutex);
-
-        pthread_mutex_lock(&args->my->mutex);
-        ymy = args->my->y_m;
-        dymy = args->my->dy_m;
-        pthread_mutex_unlock(&args->my->mutex);
-
-        // Captura os parâmetros α1 e α2
-        double alpha1, alpha2;
-        pthread_mutex_lock(&args->p->mutex);
-        alpha1 = args->p->alpha1;
-        alpha2 = args->p->alpha2;
-        pthread_mutex_unlock(&args->p->mutex);
-
-        // Calcula o sinal de controle v(t) para as duas direções
-        double v1 = dymx + alpha1 * (ymx - y1);  // Velocidade linear para a direção X
-        double v2 = dymy + alpha2 * (ymy - y2);  // Velocidade angular para a direção Y
-
-        // Aplicação de saturação para evitar valores de controle excessivos
-        if (v1 > V_MAX) v1 = V_MAX;
-        if (v1 < -V_MAX) v1 = -V_MAX;
-        if (v2 > W_MAX) v2 = W_MAX;
-        if (v2 < -W_MAX) v2 = -W_MAX;
-
-        // Atualiza os comandos de controle nas estruturas compartilhadas
-        pthread_mutex_lock(&args->c->mutex);
-        args->c->v1 = v1;
-        args->c->v2 = v2;
-        pthread_mutex_unlock(&args->c->mutex);
-
-        // Registra as variáveis de controle e de referência no log
-        LOG_DEBUG("Controle atualizado: v=(%.2f, %.2f), ym=(%.2f, %.2f), y=(%.2f, %.2f)\n",
-                  v1, v2, ymx, ymy, y1, y2);
-
-        // Espera até o próximo período de ativação
-        next_activation.tv_nsec += PERIOD_MS * 1e6;
-        while (next_activation.tv_nsec >= 1e9) {
-            next_activation.tv_sec++;
-            next_activation.tv_nsec -= 1e9;
-        }
-        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_activation, NULL);
+    int ativo = supervisor_start(&next_activation);
+
+    while (ativo) {
+        // Corpo da ativação (isolado da espera para benchmarks)
+        control_step(args);
+
+        // Dorme até o próximo período (o encerramento acorda a thread imediatamente)
+        supervisor_advance(&next_activation, cfg->ctrl_period_ms);
+        ativo = supervisor_sleep_until(&next_activation);
     }
 
     pthread_exit(NULL);
@@ -0,0 +1,116 @@
+/*
+    FILE: data_age.c
+    DESCRIPTION:
+        Implementa o rastreamento da idade dos dados (data_age.h).
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include <time.h>
+#include <math.h>
+#include "data_age.h"
+
+static const char *path_names[AGE_PATHS] = {
+    "estado → controle",
+    "modelos → controle",
+    "estado (θ) → linearização",
+    "v → linearização",
+    "u → robô",
+    "sensor → atuação",
+    "referência → atuação",
+};
+
+double data_age_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+void data_stamp_source(DataStamp *s, int src, double now) {
+    s->seq++;
+    s->publicado = now;
+    for (int i = 0; i < DATA_SOURCES; i++) s->origem[i] = INFINITY;
+    s->origem[src] = now;
+}
+
+void data_stamp_begin(double origem[DATA_SOURCES]) {
+    for (int i = 0; i < DATA_SOURCES; i++) origem[i] = INFINITY;
+}
+
+void data_stamp_merge(double origem[DATA_SOURCES], const DataStamp *in) {
+    if (in->seq == 0) return;  // Entrada ainda não publicada: valor inicial, sem origem
+    for (int i = 0; i < DATA_SOURCES; i++)
+        if (in->origem[i] < origem[i]) origem[i] = in->origem[i];
+}
+
+void data_stamp_publish(DataStamp *s, const double origem[DATA_SOURCES], double now) {
+    s->seq++;
+    s->publicado = now;
+    for (int i = 0; i < DATA_SOURCES; i++) s->origem[i] = origem[i];
+}
+
+void age_histogram_add(AgeHistogram *h, double age, unsigned long seq) {
+    if (seq == 0 || !isfinite(age)) return;  // Nada publicado ainda ou dado sem essa origem
+    if (seq == h->last_seq) h->repeated++;
+    h->last_seq = seq;
+
+    if (age < 0.0) age = 0.0;
+    long bin = (long)(age * 1e3 / AGE_BIN_MS);
+    if (bin < AGE_BINS) h->counts[bin]++;
+    else h->overflow++;
+    h->n++;
+    h->sum += age;
+    if (age > h->max) h->max = age;
+}
+
+/* Idade abaixo da qual está a fração q das leituras */
+static double quantile(const AgeHistogram *h, double q) {
+    unsigned long target = (unsigned long)(q * h->n + 0.5);
+    if (target == 0) target = 1;
+    unsigned long acc = 0;
+    for (int i = 0; i < AGE_BINS; i++) {
+        acc += h->counts[i];
+        if (acc >= target) return fmin((i + 1) * AGE_BIN_MS / 1e3, h->max);
+    }
+    return h->max;  // No excesso
+}
+
+void age_histogram_summary(const AgeHistogram *h, AgeSummary *out) {
+    out->n = h->n;
+    if (h->n == 0) {
+        out->mean = out->p50 = out->p90 = out->p99 = out->max = out->repeated_ratio = 0.0;
+        out->overflow_ratio = 0.0;
+        return;
+    }
+    out->mean = h->sum / h->n;
+    out->p50 = quantile(h, 0.50);
+    out->p90 = quantile(h, 0.90);
+    out->p99 = quantile(h, 0.99);
+    out->max = h->max;
+    out->repeated_ratio = (double)h->repeated / h->n;
+    out->overflow_ratio = (double)h->overflow / h->n;
+}
+
+/* Imprime um rótulo UTF-8 alinhado em 'width' colunas */
+static void print_label(FILE *out, const char *label, int width) {
+    int cols = 0;
+    for (const char *c = label; *c; c++)
+        if ((*c & 0xC0) != 0x80) cols++;  // Conta apenas o primeiro byte de cada caractere
+    fprintf(out, "  %s%*s", label, width > cols ? width - cols : 0, "");
+}
+
+void age_report_print(const AgeHistogram h[AGE_PATHS], FILE *out) {
+    fprintf(out, "Idade dos dados (ms):\n");
+    print_label(out, "caminho", 28);
+    fprintf(out, " leituras    média      p50      p90      p99      máx repetidas  excesso\n");
+    for (int i = 0; i < AGE_PATHS; i++) {
+        AgeSummary s;
+        age_histogram_summary(&h[i], &s);
+        print_label(out, path_names[i], 28);
+        fprintf(out, " %8lu %8.2f %8.2f %8.2f %8.2f %8.2f %8.1f%% %7.1f%%\n",
+                s.n, s.mean * 1e3, s.p50 * 1e3, s.p90 * 1e3, s.p99 * 1e3,
+                s.max * 1e3, 100.0 * s.repeated_ratio, 100.0 * s.overflow_ratio);
+    }
+}
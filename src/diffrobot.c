@@ -0,0 +1,254 @@
+/*
+    FILE: diffrobot.c
+    DESCRIPTION:
+        Implementa o passo puro e o contexto reentrante da biblioteca
+        libdiffrobot (diffrobot.h). O horizonte de referências não é
+        guardado: o passo recalcula da tabela a amostra que o anel do
+        gerador entregaria (ref_preview_eval), de modo que o estado cabe
+        num valor pequeno e copiável.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "diffrobot.h"
+#include "ref_preview.h"
+
+// Instância completa: cenário, tabela, estado e indicadores próprios
+struct robot_ctx {
+    ScenarioConfig cfg;
+    Trajectory traj;          // Tabela própria (vazia quando compartilhada)
+    int owns_traj;
+    DiffRobotModel model;
+    DiffRobotState state;
+    Metrics metrics;
+    Mpc mpc;                  // Controlador preditivo (controller = mpc)
+    Lqr lqr;                  // Tabela de ganhos (controller = lqr)
+};
+
+static int gcd(int a, int b) {
+    while (b) {
+        int r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+/* Indica se uma tarefa de período period_ms é ativada no instante t_ms */
+static int due(long t_ms, int period_ms) {
+    return t_ms % period_ms == 0;
+}
+
+void diffrobot_model_init(DiffRobotModel *m, const ScenarioConfig *cfg, const Trajectory *traj) {
+    m->cfg = cfg;
+    m->traj = traj;
+    m->kernel = control_kernel_compiled;
+    m->mpc = NULL;
+    m->lqr = NULL;
+
+    int base = cfg->sim_period_ms;
+    base = gcd(base, cfg->lin_period_ms);
+    base = gcd(base, cfg->ctrl_period_ms);
+    base = gcd(base, cfg->model_period_ms);
+    base = gcd(base, cfg->ref_period_ms);
+    base = gcd(base, cfg->timer_interval_ms);
+    m->base_ms = base;
+    m->total_ticks = (long)(cfg->sim_time_s * 1000.0 / base);
+}
+
+void diffrobot_state_init(const DiffRobotModel *m, DiffRobotState *s) {
+    const ScenarioConfig *cfg = m->cfg;
+    memset(s, 0, sizeof(*s));
+    s->alpha1 = cfg->alpha1;
+    s->alpha2 = cfg->alpha2;
+
+    // Horizonte inicial de referências (como em main antes de criar as threads)
+    s->preview_head = ref_preview_extent(cfg->preview_dt, 0, cfg->preview_horizon_s);
+
+    // Saída inicial coerente com o estado nulo (como a primeira iteração do sim_thread)
+    s->robot.y1 = cfg->R;
+    integral_action_init(&s->pi);
+    estimator_init(&s->est, cfg, &s->robot);
+}
+
+int diffrobot_step(const DiffRobotModel *m, const DiffRobotState *in, DiffRobotState *out) {
+    if (in->tick > m->total_ticks) return 0;
+
+    const ScenarioConfig *cfg = m->cfg;
+    DiffRobotState s = *in;
+    long t_ms = s.tick * m->base_ms;
+    s.ativadas = 0;
+
+    if (due(t_ms, cfg->timer_interval_ms)) {
+        s.tempo_atual = t_ms / 1000.0;
+        s.ativadas |= DIFFROBOT_TIMER;
+    }
+    if (due(t_ms, cfg->ref_period_ms)) {
+        s.preview_head = ref_preview_extent(cfg->preview_dt, s.preview_head,
+                                            t_ms / 1000.0 + cfg->preview_horizon_s);
+        TrajPoint ref = trajectory_eval(m->traj, s.tempo_atual);
+        s.xref = ref.x;
+        s.yref = ref.y;
+        s.dxref = ref.dx;
+        s.dyref = ref.dy;
+        s.ativadas |= DIFFROBOT_REFERENCIA;
+    }
+    if (due(t_ms, cfg->model_period_ms)) {
+        // Os modelos interpolam o horizonte no instante exato da ativação
+        double dt = cfg->model_period_ms / 1000.0;
+        RefPreviewSample ref;
+        ref_preview_eval(m->traj, cfg->preview_dt, s.preview_head, t_ms / 1000.0, &ref);
+        m->kernel->model_ref(ref.x, s.alpha1, dt, &s.ymx, &s.dymx);
+        m->kernel->model_ref(ref.y, s.alpha2, dt, &s.ymy, &s.dymy);
+        s.ativadas |= DIFFROBOT_MODELO;
+    }
+    // Controle e linearização leem a pose estimada (a real com estimator = none)
+    const RobotState *seen = estimator_view(&s.est, &s.robot);
+    if (due(t_ms, cfg->ctrl_period_ms)) {
+        if (m->mpc) {
+            // Referências do horizonte de predição nos instantes t + (k+1) dt
+            double xr[MPC_MAX_HORIZON], yr[MPC_MAX_HORIZON], u1, u2;
+            for (int k = 0; k < m->mpc->n; k++) {
+                RefPreviewSample ref;
+                ref_preview_eval(m->traj, cfg->preview_dt, s.preview_head,
+                                 t_ms / 1000.0 + (k + 1) * m->mpc->dt, &ref);
+                xr[k] = ref.x;
+                yr[k] = ref.y;
+            }
+            mpc_solve(m->mpc, seen->y1, seen->y2, seen->x3, xr, yr, &u1, &u2, &s.v1, &s.v2);
+        } else if (m->lqr) {
+            // Referência agora e um período depois (orientação e giro de referência)
+            double t = t_ms / 1000.0, u1, u2;
+            RefPreviewSample now, next;
+            ref_preview_eval(m->traj, cfg->preview_dt, s.preview_head, t, &now);
+            ref_preview_eval(m->traj, cfg->preview_dt, s.preview_head, t + m->lqr->dt, &next);
+            lqr_control(m->lqr, seen->y1, seen->y2, seen->x3, &now, &next, &u1, &u2, &s.v1, &s.v2);
+        } else {
+            m->kernel->control(cfg, s.ymx, s.dymx, s.ymy, s.dymy, seen->y1, seen->y2,
+                               s.alpha1, s.alpha2, &s.v1, &s.v2);
+            if (cfg->ctrl_ki > 0) {
+                // Ação integral sobre o erro de rastreamento no instante exato
+                RefPreviewSample ref;
+                ref_preview_eval(m->traj, cfg->preview_dt, s.preview_head, t_ms / 1000.0, &ref);
+                integral_action_apply(&s.pi, cfg, t_ms / 1000.0, ref.x - seen->y1, ref.y - seen->y2,
+                                      &s.v1, &s.v2);
+            }
+        }
+        s.ativadas |= DIFFROBOT_CONTROLE;
+    }
+    if (due(t_ms, cfg->lin_period_ms)) {
+        m->kernel->linearization(cfg, seen->x3, s.v1, s.v2, &s.u1, &s.u2);
+        s.ativadas |= DIFFROBOT_LINEARIZACAO;
+    }
+    if (due(t_ms, cfg->sim_period_ms)) {
+        robot_step(&s.robot, cfg->R, s.u1, s.u2, cfg->sim_period_ms / 1000.0);
+        estimator_step(&s.est, cfg, &s.robot, s.u1, s.u2, cfg->sim_period_ms / 1000.0);
+        s.ativadas |= DIFFROBOT_ROBO;
+    }
+
+    s.tick++;
+    *out = s;
+    return 1;
+}
+
+void diffrobot_sample(const DiffRobotModel *m, const DiffRobotState *s, MetricsSample *out) {
+    RefPreviewSample ref;
+    out->t = (s->tick - 1) * m->base_ms / 1000.0;
+    ref_preview_eval(m->traj, m->cfg->preview_dt, s->preview_head, out->t, &ref);
+    out->xref = ref.x;
+    out->yref = ref.y;
+    out->y1 = s->robot.y1;
+    out->y2 = s->robot.y2;
+    out->ymx = s->ymx;
+    out->ymy = s->ymy;
+    out->v1 = s->v1;
+    out->v2 = s->v2;
+    out->u1 = s->u1;
+    out->u2 = s->u2;
+}
+
+/* Parte comum da criação: a tabela já está em ctx->traj ou em traj */
+static robot_ctx *ctx_start(robot_ctx *ctx, const Trajectory *traj) {
+    diffrobot_model_init(&ctx->model, &ctx->cfg, traj);
+    if (strcmp(ctx->cfg.controller, "mpc") == 0) {
+        if (mpc_init(&ctx->mpc, &ctx->cfg) != 0) {
+            robot_ctx_destroy(ctx);
+            return NULL;
+        }
+        ctx->model.mpc = &ctx->mpc;
+    } else if (strcmp(ctx->cfg.controller, "lqr") == 0) {
+        if (lqr_init(&ctx->lqr, &ctx->cfg) != 0) {
+            robot_ctx_destroy(ctx);
+            return NULL;
+        }
+        ctx->model.lqr = &ctx->lqr;
+    }
+    diffrobot_state_init(&ctx->model, &ctx->state);
+    metrics_init(&ctx->metrics, &ctx->cfg);
+    return ctx;
+}
+
+robot_ctx *robot_ctx_create(const ScenarioConfig *cfg) {
+    if (scenario_validate(cfg) != 0) return NULL;
+
+    robot_ctx *ctx = calloc(1, sizeof(*ctx));
+    if (!ctx) return NULL;
+    ctx->cfg = *cfg;
+    if (trajectory_load(&ctx->traj, &ctx->cfg) != 0) {
+        free(ctx);
+        return NULL;
+    }
+    ctx->owns_traj = 1;
+    return ctx_start(ctx, &ctx->traj);
+}
+
+robot_ctx *robot_ctx_create_shared(const ScenarioConfig *cfg, const Trajectory *traj) {
+    if (scenario_validate(cfg) != 0) return NULL;
+
+    robot_ctx *ctx = calloc(1, sizeof(*ctx));
+    if (!ctx) return NULL;
+    ctx->cfg = *cfg;
+    return ctx_start(ctx, traj);
+}
+
+void robot_ctx_set_gains(robot_ctx *ctx, double alpha1, double alpha2) {
+    ctx->state.alpha1 = alpha1;
+    ctx->state.alpha2 = alpha2;
+}
+
+int robot_ctx_step(robot_ctx *ctx) {
+    if (!diffrobot_step(&ctx->model, &ctx->state, &ctx->state)) return 0;
+
+    // Indicadores em fluxo no período do robô
+    if (ctx->state.ativadas & DIFFROBOT_ROBO) {
+        MetricsSample s;
+        diffrobot_sample(&ctx->model, &ctx->state, &s);
+        metrics_update(&ctx->metrics, &s, ctx->cfg.sim_period_ms / 1000.0);
+    }
+    return 1;
+}
+
+void robot_ctx_run(robot_ctx *ctx, MetricsSummary *out) {
+    while (robot_ctx_step(ctx)) {
+    }
+    if (out) robot_ctx_summary(ctx, out);
+}
+
+const DiffRobotState *robot_ctx_state(const robot_ctx *ctx) {
+    return &ctx->state;
+}
+
+void robot_ctx_summary(const robot_ctx *ctx, MetricsSummary *out) {
+    metrics_summary(&ctx->metrics, out);
+}
+
+void robot_ctx_destroy(robot_ctx *ctx) {
+    if (!ctx) return;
+    if (ctx->owns_traj) trajectory_free(&ctx->traj);
+    mpc_destroy(&ctx->mpc);  // Sem efeito se o MPC não foi criado
+    lqr_destroy(&ctx->lqr);  // Idem para a tabela do LQR
+    free(ctx);
+}
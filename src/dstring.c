@@ -2,78 +2,170 @@
     FILE: dstring.c
     DESCRIPTION:
         Implementa as funções da TAD Dstring (string dinâmica).
+        Strings de até DSTRING_SSO_CAPACITY caracteres ficam no próprio
+        cabeçalho (sem buffer no heap); Dstrings criadas em uma arena não
+        tocam o malloc e são liberadas em bloco com dstring_arena_reset.
     AUTHOR: Darlysson Lima
-    LAST UPDATE: Julho, 2025
+    LAST UPDATE: Outubro, 2026
     LICENSE: CC BY-SA
 */
 
 #include "dstring.h"
+#include "numfmt.h"
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
-#include <stdio.h>
+
+#define ARENA_ALIGN 16  // Alinhamento dos blocos entregues pela arena
 
 // ==========================
-// Funções de criação
+// Funções internas de memória
 // ==========================
 
-/* Cria uma Dstring a partir de uma string C */
-Dstring *dstring_new_from_char(const char *str) {
-    if (!str) {
-        LOG_ERROR_AND_EXIT("str é NULL\n");
+/* Reserva 'size' bytes alinhados na arena */
+static void *arena_alloc(DstringArena *arena, size_t size) {
+    size_t start = (arena->used + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    if (start + size > arena->size) {
+        LOG_ERROR_AND_EXIT("Arena esgotada (%zu de %zu bytes em uso, pedido de %zu)\n",
+                           arena->used, arena->size, size);
         return NULL;
     }
+    arena->used = start + size;
+    return arena->base + start;
+}
 
-    size_t len = strlen(str);
-    Dstring *dstr = malloc(sizeof(Dstring));
-    if (!dstr) {
-        LOG_ERROR_AND_EXIT("Falha ao alocar Dstring\n");
-        return NULL;
+/* Prepara o cabeçalho e reserva espaço para 'len' caracteres */
+static void dstring_setup(Dstring *dstr, DstringArena *arena, size_t len) {
+    dstr->arena = arena;
+    dstr->length = 0;
+    dstr->inline_buf[0] = '\0';
+
+    if (len <= DSTRING_SSO_CAPACITY) {
+        dstr->buffer = dstr->inline_buf;
+        dstr->capacity = DSTRING_SSO_CAPACITY;
+        return;
     }
 
-    dstr->buffer = malloc(len + 1);
+    dstr->buffer = arena ? arena_alloc(arena, len + 1) : malloc(len + 1);
     if (!dstr->buffer) {
-        free(dstr);
         LOG_ERROR_AND_EXIT("Falha ao alocar buffer\n");
+        return;
+    }
+    dstr->capacity = len;
+}
+
+/* Aloca o cabeçalho (heap ou arena) e copia 'len' bytes de str */
+static Dstring *dstring_create(DstringArena *arena, const char *str, size_t len) {
+    Dstring *dstr = arena ? arena_alloc(arena, sizeof(Dstring)) : malloc(sizeof(Dstring));
+    if (!dstr) {
+        LOG_ERROR_AND_EXIT("Falha ao alocar Dstring\n");
         return NULL;
     }
 
-    strcpy(dstr->buffer, str);
+    dstring_setup(dstr, arena, len);
+    memcpy(dstr->buffer, str, len);
+    dstr->buffer[len] = '\0';
     dstr->length = len;
     return dstr;
 }
 
+/* Garante capacidade para 'needed' caracteres, com crescimento geométrico */
+static void dstring_reserve(Dstring *dstr, size_t needed) {
+    if (needed <= dstr->capacity) return;
+
+    size_t new_capacity = dstr->capacity * 2;
+    if (new_capacity < needed) new_capacity = needed;
+
+    char *new_buffer;
+    if (dstr->arena) {
+        // Na arena o bloco antigo só é recuperado no reset
+        new_buffer = arena_alloc(dstr->arena, new_capacity + 1);
+        if (new_buffer) memcpy(new_buffer, dstr->buffer, dstr->length + 1);
+    } else if (dstr->buffer == dstr->inline_buf) {
+        new_buffer = malloc(new_capacity + 1);
+        if (new_buffer) memcpy(new_buffer, dstr->buffer, dstr->length + 1);
+    } else {
+        new_buffer = realloc(dstr->buffer, new_capacity + 1);
+    }
+
+    if (!new_buffer) {
+        LOG_ERROR_AND_EXIT("Falha ao realocar memória\n");
+        return;
+    }
+    dstr->buffer = new_buffer;
+    dstr->capacity = new_capacity;
+}
+
+/* Anexa 'len' bytes de str ao final de dest. str pode apontar para o
+   próprio buffer de dest (dest == src em dstring_concat): a posição é
+   guardada como deslocamento e refeita após o crescimento. */
+static void dstring_append_raw(Dstring *dest, const char *str, size_t len) {
+    uintptr_t base = (uintptr_t)dest->buffer, p = (uintptr_t)str;
+    int interno = p >= base && p <= base + dest->length;
+    size_t offset = interno ? (size_t)(p - base) : 0;
+
+    dstring_reserve(dest, dest->length + len);
+    if (interno) str = dest->buffer + offset;
+    memmove(dest->buffer + dest->length, str, len);
+    dest->length += len;
+    dest->buffer[dest->length] = '\0';
+}
+
+// ==========================
+// Funções de criação
+// ==========================
+
+/* Cria uma Dstring a partir de uma string C */
+Dstring *dstring_new_from_char(const char *str) {
+    if (!str) {
+        LOG_ERROR_AND_EXIT("str é NULL\n");
+        return NULL;
+    }
+    return dstring_create(NULL, str, strlen(str));
+}
+
 /* Cria uma Dstring a partir de um único caractere */
 Dstring *dstring_new_from_char_single(char c) {
     char str[2] = {c, '\0'};
-    return dstring_new_from_char(str);
+    return dstring_create(NULL, str, 1);
 }
 
 /* Cria uma Dstring a partir de um inteiro */
 Dstring *dstring_new_from_int(int value) {
-    char buffer[12];
-    snprintf(buffer, sizeof(buffer), "%d", value);
-    return dstring_new_from_char(buffer);
+    char buffer[21];
+    size_t len = numfmt_long(buffer, value);
+    return dstring_create(NULL, buffer, len);
 }
 
 /* Cria uma Dstring a partir de um valor long */
 Dstring *dstring_new_from_long(long value) {
     char buffer[21];
-    snprintf(buffer, sizeof(buffer), "%ld", value);
-    return dstring_new_from_char(buffer);
+    size_t len = numfmt_long(buffer, value);
+    return dstring_create(NULL, buffer, len);
 }
 
 /* Cria uma Dstring a partir de um float */
 Dstring *dstring_new_from_float(float value) {
-    char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%.6f", value);
-    return dstring_new_from_char(buffer);
+    return dstring_new_from_double_prec(value, 6);
 }
 
 /* Cria uma Dstring a partir de um double */
 Dstring *dstring_new_from_double(double value) {
-    char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%.6lf", value);
-    return dstring_new_from_char(buffer);
+    return dstring_new_from_double_prec(value, 6);
+}
+
+/* Cria uma Dstring a partir de um double com precisão fixa */
+Dstring *dstring_new_from_double_prec(double value, int precision) {
+    char buffer[NUMFMT_DOUBLE_BUFSZ];
+    size_t len = numfmt_double_fixed(buffer, value, precision);
+    return dstring_create(NULL, buffer, len);
+}
+
+/* Cria uma Dstring com a menor representação exata de um double */
+Dstring *dstring_new_from_double_shortest(double value) {
+    char buffer[NUMFMT_DOUBLE_BUFSZ];
+    size_t len = numfmt_double_shortest(buffer, value);
+    return dstring_create(NULL, buffer, len);
 }
 
 /* Cria uma Dstring a partir de outra Dstring */
@@ -82,7 +174,127 @@ Dstring *dstring_new_from_dstring(const Dstring *src) {
         LOG_ERROR_AND_EXIT("src é NULL\n");
         return NULL;
     }
-    return dstring_new_from_char(src->buffer);
+    return dstring_create(NULL, src->buffer, src->length);
+}
+
+// ==========================
+// Dstrings em memória do chamador
+// ==========================
+
+/* Inicializa uma Dstring cujo cabeçalho pertence ao chamador */
+void dstring_init_from_char(Dstring *dstr, const char *str) {
+    if (!dstr || !str) {
+        LOG_ERROR_AND_EXIT("Argumentos inválidos\n");
+        return;
+    }
+
+    size_t len = strlen(str);
+    dstring_setup(dstr, NULL, len);
+    memcpy(dstr->buffer, str, len + 1);
+    dstr->length = len;
+}
+
+/* Libera o buffer externo de uma Dstring inicializada com dstring_init_from_char */
+void dstring_release(Dstring *dstr) {
+    if (!dstr) {
+        LOG_ERROR_AND_EXIT("dstr é NULL\n");
+        return;
+    }
+
+    if (!dstr->arena && dstr->buffer != dstr->inline_buf) free(dstr->buffer);
+    dstr->buffer = dstr->inline_buf;
+    dstr->capacity = DSTRING_SSO_CAPACITY;
+    dstr->length = 0;
+    dstr->inline_buf[0] = '\0';
+}
+
+// ==========================
+// Funções de arena
+// ==========================
+
+/* Cria uma arena com região própria de 'size' bytes */
+DstringArena *dstring_arena_create(size_t size) {
+    DstringArena *arena = malloc(sizeof(DstringArena));
+    if (!arena) {
+        LOG_ERROR_AND_EXIT("Falha ao alocar arena\n");
+        return NULL;
+    }
+
+    arena->base = malloc(size);
+    if (!arena->base) {
+        free(arena);
+        LOG_ERROR_AND_EXIT("Falha ao alocar região da arena (%zu bytes)\n", size);
+        return NULL;
+    }
+    arena->size = size;
+    arena->used = 0;
+    arena->owns_memory = 1;
+    return arena;
+}
+
+/* Inicializa uma arena sobre uma região fornecida pelo chamador */
+void dstring_arena_init(DstringArena *arena, void *memory, size_t size) {
+    if (!arena || !memory) {
+        LOG_ERROR_AND_EXIT("Argumentos inválidos\n");
+        return;
+    }
+    arena->base = memory;
+    arena->size = size;
+    arena->used = 0;
+    arena->owns_memory = 0;
+}
+
+/* Invalida todas as Dstrings da arena de uma só vez */
+void dstring_arena_reset(DstringArena *arena) {
+    if (!arena) {
+        LOG_ERROR_AND_EXIT("arena é NULL\n");
+        return;
+    }
+    arena->used = 0;
+}
+
+/* Destroi uma arena criada com dstring_arena_create */
+void dstring_arena_destroy(DstringArena *arena) {
+    if (!arena) {
+        LOG_ERROR_AND_EXIT("arena é NULL\n");
+        return;
+    }
+    if (arena->owns_memory) {
+        free(arena->base);
+        free(arena);
+    }
+}
+
+/* Cria uma Dstring na arena a partir de uma string C */
+Dstring *dstring_arena_new_from_char(DstringArena *arena, const char *str) {
+    if (!arena || !str) {
+        LOG_ERROR_AND_EXIT("Argumentos inválidos\n");
+        return NULL;
+    }
+    return dstring_create(arena, str, strlen(str));
+}
+
+/* Cria uma Dstring na arena a partir de um inteiro */
+Dstring *dstring_arena_new_from_int(DstringArena *arena, int value) {
+    if (!arena) {
+        LOG_ERROR_AND_EXIT("arena é NULL\n");
+        return NULL;
+    }
+    char buffer[21];
+    size_t len = numfmt_long(buffer, value);
+    return dstring_create(arena, buffer, len);
+}
+
+/* Cria uma Dstring na arena a partir de um double com precisão fixa (< 0: mínimo exato) */
+Dstring *dstring_arena_new_from_double(DstringArena *arena, double value, int precision) {
+    if (!arena) {
+        LOG_ERROR_AND_EXIT("arena é NULL\n");
+        return NULL;
+    }
+    char buffer[NUMFMT_DOUBLE_BUFSZ];
+    size_t len = (precision < 0) ? numfmt_double_shortest(buffer, value)
+                                 : numfmt_double_fixed(buffer, value, precision);
+    return dstring_create(arena, buffer, len);
 }
 
 // ==========================
@@ -95,17 +307,20 @@ void dstring_concat(Dstring *dest, const Dstring *src) {
         LOG_ERROR_AND_EXIT("Argumentos inválidos\n");
         return;
     }
+    dstring_append_raw(dest, src->buffer, src->length);
+}
 
-    size_t new_length = dest->length + src->length;
-    char *new_buffer = realloc(dest->buffer, new_length + 1);
-    if (!new_buffer) {
-        LOG_ERROR_AND_EXIT("Falha ao realocar memória\n");
+/* Anexa um double formatado ao final de dest (precision < 0: mínimo exato) */
+void dstring_append_double(Dstring *dest, double value, int precision) {
+    if (!dest) {
+        LOG_ERROR_AND_EXIT("dest é NULL\n");
         return;
     }
 
-    strcat(new_buffer, src->buffer);
-    dest->buffer = new_buffer;
-    dest->length = new_length;
+    char buffer[NUMFMT_DOUBLE_BUFSZ];
+    size_t len = (precision < 0) ? numfmt_double_shortest(buffer, value)
+                                 : numfmt_double_fixed(buffer, value, precision);
+    dstring_append_raw(dest, buffer, len);
 }
 
 /* Retorna o tamanho da Dstring */
@@ -137,6 +352,9 @@ void dstring_free(Dstring *dstr) {
         return;
     }
 
-    free(dstr->buffer);
+    // Dstrings de arena são liberadas em bloco por dstring_arena_reset
+    if (dstr->arena) return;
+
+    if (dstr->buffer != dstr->inline_buf) free(dstr->buffer);
     free(dstr);
 }
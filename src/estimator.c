@@ -0,0 +1,192 @@
+/*
+    FILE: estimator.c
+    DESCRIPTION:
+        Implementa a camada de sensores (odometria com deriva e medição
+        absoluta ruidosa) e o filtro de Kalman estendido de 3 estados
+        (estimator.h), com matrizes 3x3 de tamanho fixo.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <math.h>
+#include <string.h>
+#include "estimator.h"
+#include "autodiff.h"
+
+// ==========================
+// Ruído dos sensores
+// ==========================
+
+/* xorshift64*: período 2^64 - 1, estado nunca nulo */
+static uint64_t rng_next(uint64_t *s) {
+    uint64_t x = *s;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *s = x;
+    return x * 2685821657736338717ull;
+}
+
+/* Uniforme em (0, 1] */
+static double rng_uniform(uint64_t *s) {
+    return ((rng_next(s) >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+/* Par de normais padrão independentes (Box-Muller) */
+static void rng_normal2(uint64_t *s, double *a, double *b) {
+    double r = sqrt(-2.0 * log(rng_uniform(s)));
+    double phi = 2.0 * M_PI * rng_uniform(s);
+    *a = r * cos(phi);
+    *b = r * sin(phi);
+}
+
+/* Reduz um ângulo a (-π, π] */
+static double wrap_angle(double a) {
+    return a - 2.0 * M_PI * floor((a + M_PI) / (2.0 * M_PI));
+}
+
+// ==========================
+// Filtro de Kalman estendido
+// ==========================
+
+void ekf_predict(Ekf *f, const Odometry *odo, double dt, double q_v, double q_w) {
+    // Modelo e Jacobianas numa só avaliação dual: F = I + dt ∂f/∂x, G = dt ∂f/∂u
+    Dual x[3] = { ad_var(f->x[0], AD_X1), ad_var(f->x[1], AD_X2), ad_var(f->x[2], AD_X3) };
+    Dual u[2] = { ad_var(odo->v, AD_U1), ad_var(odo->w, AD_U2) };
+    Dual fd[3], yd[2];
+    ad_unicycle_model(x, u, 0.0, fd, yd);
+
+    double F[3][3], G[3][2];
+    for (int i = 0; i < 3; i++) {
+        f->x[i] += dt * fd[i].v;
+        for (int j = 0; j < 3; j++) F[i][j] = (i == j) + dt * fd[i].d[AD_X1 + j];
+        for (int j = 0; j < 2; j++) G[i][j] = dt * fd[i].d[AD_U1 + j];
+    }
+
+    // P = F P Fᵀ + G diag(q_v, q_w) Gᵀ
+    double (*P)[3] = f->P;
+    double FP[3][3];
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            FP[i][j] = F[i][0] * P[0][j] + F[i][1] * P[1][j] + F[i][2] * P[2][j];
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            P[i][j] = FP[i][0] * F[j][0] + FP[i][1] * F[j][1] + FP[i][2] * F[j][2]
+                    + G[i][0] * q_v * G[j][0] + G[i][1] * q_w * G[j][1];
+}
+
+void ekf_update(Ekf *f, const double z[3], const double r[3]) {
+    double (*P)[3] = f->P;
+
+    // S = P + diag(r) (H = I) e sua inversa pelos cofatores (S simétrica)
+    double s00 = P[0][0] + r[0], s01 = P[0][1], s02 = P[0][2];
+    double s11 = P[1][1] + r[1], s12 = P[1][2];
+    double s22 = P[2][2] + r[2];
+    double c00 = s11 * s22 - s12 * s12;
+    double c01 = s02 * s12 - s01 * s22;
+    double c02 = s01 * s12 - s02 * s11;
+    double c11 = s00 * s22 - s02 * s02;
+    double c12 = s01 * s02 - s00 * s12;
+    double c22 = s00 * s11 - s01 * s01;
+    double inv_det = 1.0 / (s00 * c00 + s01 * c01 + s02 * c02);
+    double Si[3][3] = {
+        { c00 * inv_det, c01 * inv_det, c02 * inv_det },
+        { c01 * inv_det, c11 * inv_det, c12 * inv_det },
+        { c02 * inv_det, c12 * inv_det, c22 * inv_det },
+    };
+
+    // K = P S^-1
+    double K[3][3];
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            K[i][j] = P[i][0] * Si[0][j] + P[i][1] * Si[1][j] + P[i][2] * Si[2][j];
+
+    // x += K (z - x), com a inovação de θ reduzida a (-π, π]
+    double y[3] = { z[0] - f->x[0], z[1] - f->x[1], wrap_angle(z[2] - f->x[2]) };
+    for (int i = 0; i < 3; i++) f->x[i] += K[i][0] * y[0] + K[i][1] * y[1] + K[i][2] * y[2];
+
+    // P = (I - K) P, simetrizada para conter o arredondamento
+    double Pn[3][3];
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            Pn[i][j] = P[i][j] - (K[i][0] * P[0][j] + K[i][1] * P[1][j] + K[i][2] * P[2][j]);
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            P[i][j] = 0.5 * (Pn[i][j] + Pn[j][i]);
+}
+
+// ==========================
+// Estágio de estimação
+// ==========================
+
+/* Pose publicada a partir de (x1, x2, θ), com a saída y à frente */
+static void set_pose(RobotState *p, const double x[3], double R) {
+    p->x1 = x[0];
+    p->x2 = x[1];
+    p->x3 = x[2];
+    p->y1 = x[0] + R * cos(x[2]);
+    p->y2 = x[1] + R * sin(x[2]);
+}
+
+void estimator_init(Estimator *e, const ScenarioConfig *cfg, const RobotState *truth) {
+    memset(e, 0, sizeof(*e));
+    if (strcmp(cfg->estimator, "ekf") == 0) e->mode = ESTIMATOR_EKF;
+    else if (strcmp(cfg->estimator, "raw") == 0) e->mode = ESTIMATOR_RAW;
+    else e->mode = ESTIMATOR_NONE;
+
+    // Semente espalhada (splitmix64) para que sementes vizinhas não se correlacionem
+    uint64_t z = (uint64_t)cfg->sensor_seed + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    e->rng = (z ^ (z >> 31)) | 1;
+
+    // Pose inicial conhecida, com a incerteza de uma medição
+    e->ekf.x[0] = truth->x1;
+    e->ekf.x[1] = truth->x2;
+    e->ekf.x[2] = truth->x3;
+    e->ekf.P[0][0] = e->ekf.P[1][1] = cfg->sensor_pos_std * cfg->sensor_pos_std;
+    e->ekf.P[2][2] = cfg->sensor_theta_std * cfg->sensor_theta_std;
+    e->pose = *truth;
+}
+
+void estimator_step(Estimator *e, const ScenarioConfig *cfg, const RobotState *truth,
+                    double u1, double u2, double dt) {
+    if (e->mode == ESTIMATOR_NONE) return;
+
+    double n[6];
+    rng_normal2(&e->rng, &n[0], &n[1]);
+    rng_normal2(&e->rng, &n[2], &n[3]);
+    rng_normal2(&e->rng, &n[4], &n[5]);
+
+    // Medição absoluta da pose real já integrada
+    double z[3] = {
+        truth->x1 + cfg->sensor_pos_std * n[2],
+        truth->x2 + cfg->sensor_pos_std * n[3],
+        truth->x3 + cfg->sensor_theta_std * n[4],
+    };
+    if (e->mode == ESTIMATOR_RAW) {
+        set_pose(&e->pose, z, cfg->R);
+        return;
+    }
+
+    // Odometria dos comandos aplicados: erro de escala em v, viés em w e ruído
+    Odometry odo = {
+        u1 * (1.0 + cfg->odom_scale) + cfg->odom_std * n[0],
+        u2 + cfg->odom_bias_w + cfg->odom_std * n[1],
+    };
+
+    // O filtro não conhece a escala nem o viés: entram como ruído de processo
+    double sv = cfg->odom_scale * odo.v;
+    double q_v = cfg->odom_std * cfg->odom_std + sv * sv;
+    double q_w = cfg->odom_std * cfg->odom_std + cfg->odom_bias_w * cfg->odom_bias_w;
+    double r[3] = {
+        cfg->sensor_pos_std * cfg->sensor_pos_std,
+        cfg->sensor_pos_std * cfg->sensor_pos_std,
+        cfg->sensor_theta_std * cfg->sensor_theta_std,
+    };
+
+    ekf_predict(&e->ekf, &odo, dt, q_v, q_w);
+    ekf_update(&e->ekf, z, r);
+    set_pose(&e->pose, e->ekf.x, cfg->R);
+}
@@ -0,0 +1,417 @@
+/*
+    FILE: fleet.c
+    DESCRIPTION:
+        Implementa a simulação de frotas com estado em SoA e índice de
+        vizinhança por hash espacial incremental (fleet.h).
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "fleet.h"
+#include "diffrobot.h"
+#include "logs.h"
+
+#define FLEET_ALIGN 64
+#define FLEET_MIN_BUCKETS 64u
+#define DELAY_COLUMNS 8  // Ciclo do atraso da referência por coluna
+
+/* Indica se uma tarefa de período period_ms é ativada no instante t_ms */
+static int due(long t_ms, int period_ms) {
+    return t_ms % period_ms == 0;
+}
+
+static inline uint32_t cell_hash(int32_t cx, int32_t cy, uint32_t mask) {
+    return ((uint32_t)cx * 73856093u ^ (uint32_t)cy * 19349663u) & mask;
+}
+
+static inline int32_t cell_of(const FleetGrid *g, double v) {
+    return (int32_t)floor(v * g->inv_cell);
+}
+
+/* Faixa [lo, hi) da parte part de parts sobre n itens */
+static void part_range(long n, int part, int parts, long *lo, long *hi) {
+    *lo = n * part / parts;
+    *hi = n * (part + 1) / parts;
+}
+
+// ==========================
+// Grupo de trabalhadores
+// ==========================
+
+static void *pool_worker(void *arg) {
+    FleetWorker *w = arg;
+    FleetPool *p = &w->f->pool;
+    unsigned long seen = 0;
+
+    pthread_mutex_lock(&p->mutex);
+    for (;;) {
+        while (!p->stop && p->generation == seen) pthread_cond_wait(&p->start, &p->mutex);
+        if (p->stop) break;
+        seen = p->generation;
+        FleetJob job = p->job;
+        pthread_mutex_unlock(&p->mutex);
+
+        job(w->f, w->part, p->n_threads + 1);
+
+        pthread_mutex_lock(&p->mutex);
+        if (--p->pending == 0) pthread_cond_signal(&p->done);
+    }
+    pthread_mutex_unlock(&p->mutex);
+    return NULL;
+}
+
+/* Executa job em todas as partes e aguarda o término */
+static void pool_run(Fleet *f, FleetJob job) {
+    FleetPool *p = &f->pool;
+    if (p->n_threads == 0) {
+        job(f, 0, 1);
+        return;
+    }
+
+    pthread_mutex_lock(&p->mutex);
+    p->job = job;
+    p->pending = p->n_threads;
+    p->generation++;
+    pthread_cond_broadcast(&p->start);
+    pthread_mutex_unlock(&p->mutex);
+
+    job(f, 0, p->n_threads + 1);
+
+    pthread_mutex_lock(&p->mutex);
+    while (p->pending > 0) pthread_cond_wait(&p->done, &p->mutex);
+    pthread_mutex_unlock(&p->mutex);
+}
+
+static int pool_start(Fleet *f, int threads) {
+    FleetPool *p = &f->pool;
+    memset(p, 0, sizeof(*p));
+    pthread_mutex_init(&p->mutex, NULL);
+    pthread_cond_init(&p->start, NULL);
+    pthread_cond_init(&p->done, NULL);
+    if (threads <= 1) return 0;
+
+    p->threads = calloc(threads - 1, sizeof(*p->threads));
+    p->workers = calloc(threads - 1, sizeof(*p->workers));
+    if (!p->threads || !p->workers) return -1;
+    for (int i = 0; i < threads - 1; i++) {
+        p->workers[i].f = f;
+        p->workers[i].part = i + 1;
+        if (pthread_create(&p->threads[i], NULL, pool_worker, &p->workers[i]) != 0) {
+            LOG_ERROR("Falha ao criar o trabalhador %d da frota\n", i + 1);
+            return -1;
+        }
+        p->n_threads++;
+    }
+    return 0;
+}
+
+static void pool_stop(FleetPool *p) {
+    pthread_mutex_lock(&p->mutex);
+    p->stop = 1;
+    pthread_cond_broadcast(&p->start);
+    pthread_mutex_unlock(&p->mutex);
+    for (int i = 0; i < p->n_threads; i++) pthread_join(p->threads[i], NULL);
+    free(p->threads);
+    free(p->workers);
+    pthread_mutex_destroy(&p->mutex);
+    pthread_cond_destroy(&p->start);
+    pthread_cond_destroy(&p->done);
+}
+
+// ==========================
+// Índice espacial
+// ==========================
+
+static void grid_link(FleetGrid *g, int32_t i, int32_t cx, int32_t cy) {
+    uint32_t b = cell_hash(cx, cy, g->mask);
+    g->cx[i] = cx;
+    g->cy[i] = cy;
+    g->bucket[i] = b;
+    g->prev[i] = -1;
+    g->next[i] = g->head[b];
+    if (g->head[b] >= 0) g->prev[g->head[b]] = i;
+    g->head[b] = i;
+}
+
+static void grid_unlink(FleetGrid *g, int32_t i) {
+    if (g->prev[i] >= 0) g->next[g->prev[i]] = g->next[i];
+    else g->head[g->bucket[i]] = g->next[i];
+    if (g->next[i] >= 0) g->prev[g->next[i]] = g->prev[i];
+}
+
+/* Reconstrói o índice do zero (inicialização e reinício) */
+static void grid_build(Fleet *f) {
+    FleetGrid *g = &f->grid;
+    for (uint32_t b = 0; b <= g->mask; b++) g->head[b] = -1;
+    for (int32_t i = 0; i < f->n; i++) grid_link(g, i, cell_of(g, f->x1[i]), cell_of(g, f->x2[i]));
+}
+
+/* Aplica as trocas de célula marcadas no passo (atualização incremental) */
+static void grid_update(Fleet *f) {
+    FleetGrid *g = &f->grid;
+    for (int32_t i = 0; i < f->n; i++) {
+        if (!f->moved[i]) continue;
+        grid_unlink(g, i);
+        grid_link(g, i, f->new_cx[i], f->new_cy[i]);
+        f->stats.moves++;
+    }
+}
+
+// ==========================
+// Etapas paralelas
+// ==========================
+
+/* Leis, planta e nova célula de uma faixa de robôs */
+static void job_laws(Fleet *f, int part, int parts) {
+    const ScenarioConfig *cfg = f->cfg;
+    const FleetGrid *g = &f->grid;
+    unsigned tasks = f->tasks;
+    double t = f->t;
+    double dt_model = cfg->model_period_ms / 1000.0;
+    double dt_sim = cfg->sim_period_ms / 1000.0;
+    long lo, hi;
+    part_range(f->n, part, parts, &lo, &hi);
+
+    for (long i = lo; i < hi; i++) {
+        if (tasks & DIFFROBOT_MODELO) {
+            TrajPoint p = trajectory_eval(f->traj, t - f->delay[i]);
+            model_ref_step(f->ox[i] + p.x, cfg->alpha1, dt_model, &f->ymx[i], &f->dymx[i]);
+            model_ref_step(f->oy[i] + p.y, cfg->alpha2, dt_model, &f->ymy[i], &f->dymy[i]);
+        }
+        if (tasks & DIFFROBOT_CONTROLE) {
+            control_law(cfg, f->ymx[i], f->dymx[i], f->ymy[i], f->dymy[i], f->y1[i], f->y2[i],
+                        cfg->alpha1, cfg->alpha2, &f->v1[i], &f->v2[i]);
+        }
+        if (tasks & DIFFROBOT_LINEARIZACAO) {
+            linearization_law(cfg, f->x3[i], f->v1[i], f->v2[i], &f->u1[i], &f->u2[i]);
+        }
+        if (tasks & DIFFROBOT_ROBO) {
+            RobotState s = { f->x1[i], f->x2[i], f->x3[i], f->y1[i], f->y2[i] };
+            robot_step(&s, cfg->R, f->u1[i], f->u2[i], dt_sim);
+            f->x1[i] = s.x1;
+            f->x2[i] = s.x2;
+            f->x3[i] = s.x3;
+            f->y1[i] = s.y1;
+            f->y2[i] = s.y2;
+
+            TrajPoint p = trajectory_eval(f->traj, t - f->delay[i]);
+            double ex = f->ox[i] + p.x - s.y1, ey = f->oy[i] + p.y - s.y2;
+            f->ise[i] += (ex * ex + ey * ey) * dt_sim;
+
+            int32_t cx = cell_of(g, s.x1), cy = cell_of(g, s.x2);
+            f->moved[i] = cx != g->cx[i] || cy != g->cy[i];
+            f->new_cx[i] = cx;
+            f->new_cy[i] = cy;
+        }
+    }
+}
+
+/* Consultas de vizinhança de uma faixa de baldes (células) */
+static void job_query(Fleet *f, int part, int parts) {
+    const FleetGrid *g = &f->grid;
+    double r2 = f->cfg->fleet_radius * f->cfg->fleet_radius;
+    double c2 = f->cfg->fleet_collision * f->cfg->fleet_collision;
+    long checks = 0, collisions = 0;
+    double min_d2 = INFINITY;
+    long lo, hi;
+    part_range((long)g->mask + 1, part, parts, &lo, &hi);
+
+    for (long b = lo; b < hi; b++) {
+        for (int32_t i = g->head[b]; i >= 0; i = g->next[i]) {
+            double xi = f->x1[i], yi = f->x2[i];
+            double nearest = INFINITY;
+            int32_t count = 0;
+
+            for (int32_t dy = -1; dy <= 1; dy++) {
+                for (int32_t dx = -1; dx <= 1; dx++) {
+                    int32_t cx = g->cx[i] + dx, cy = g->cy[i] + dy;
+                    for (int32_t j = g->head[cell_hash(cx, cy, g->mask)]; j >= 0; j = g->next[j]) {
+                        // Baldes podem misturar células diferentes: confere a célula exata
+                        if (j == i || g->cx[j] != cx || g->cy[j] != cy) continue;
+                        double ex = f->x1[j] - xi, ey = f->x2[j] - yi;
+                        double d2 = ex * ex + ey * ey;
+                        checks++;
+                        if (d2 > r2) continue;
+                        count++;
+                        if (d2 < nearest) nearest = d2;
+                        if (j > i && d2 < c2) collisions++;  // Cada par conta uma vez
+                    }
+                }
+            }
+            f->neighbors[i] = count;
+            f->nearest[i] = sqrt(nearest);
+            if (nearest < min_d2) min_d2 = nearest;
+        }
+    }
+
+    FleetPart *p = &f->parts[part];
+    p->checks = checks;
+    p->collisions = collisions;
+    p->min_d2 = min_d2;
+}
+
+// ==========================
+// Funções públicas
+// ==========================
+
+/* Reserva n elementos de size bytes a partir de *offset, alinhados em linha de cache;
+   com base NULL apenas avança o deslocamento (medição do bloco) */
+static void *carve(char *base, size_t *offset, size_t n, size_t size) {
+    void *p = base ? base + *offset : NULL;
+    *offset += (n * size + FLEET_ALIGN - 1) / FLEET_ALIGN * FLEET_ALIGN;
+    return p;
+}
+
+/* Distribui os vetores no bloco base e retorna o tamanho total */
+static size_t layout(Fleet *f, char *base, size_t buckets, int parts) {
+    size_t off = 0, n = (size_t)f->n;
+
+    double **doubles[] = { &f->ox, &f->oy, &f->delay, &f->x1, &f->x2, &f->x3, &f->y1, &f->y2,
+                           &f->ymx, &f->dymx, &f->ymy, &f->dymy, &f->v1, &f->v2, &f->u1,
+                           &f->u2, &f->ise, &f->nearest };
+    for (size_t k = 0; k < sizeof(doubles) / sizeof(doubles[0]); k++) {
+        *doubles[k] = carve(base, &off, n, sizeof(double));
+    }
+    f->neighbors = carve(base, &off, n, sizeof(int32_t));
+    f->new_cx = carve(base, &off, n, sizeof(int32_t));
+    f->new_cy = carve(base, &off, n, sizeof(int32_t));
+    f->moved = carve(base, &off, n, sizeof(uint8_t));
+    f->grid.head = carve(base, &off, buckets, sizeof(int32_t));
+    f->grid.next = carve(base, &off, n, sizeof(int32_t));
+    f->grid.prev = carve(base, &off, n, sizeof(int32_t));
+    f->grid.cx = carve(base, &off, n, sizeof(int32_t));
+    f->grid.cy = carve(base, &off, n, sizeof(int32_t));
+    f->grid.bucket = carve(base, &off, n, sizeof(uint32_t));
+    f->parts = carve(base, &off, (size_t)parts, sizeof(FleetPart));
+    return off;
+}
+
+int fleet_init(Fleet *f, const ScenarioConfig *cfg, const Trajectory *traj) {
+    memset(f, 0, sizeof(*f));
+    f->cfg = cfg;
+    f->traj = traj;
+    f->n = cfg->fleet_size;
+    f->check_neighbors = 1;
+
+    DiffRobotModel m;
+    diffrobot_model_init(&m, cfg, traj);
+    f->base_ms = m.base_ms;
+    f->total_ticks = m.total_ticks;
+
+    int threads = cfg->fleet_threads > 0 ? cfg->fleet_threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads < 1) threads = 1;
+    if (threads > f->n && f->n > 0) threads = f->n;
+
+    size_t buckets = FLEET_MIN_BUCKETS;
+    while (buckets < 2 * (size_t)f->n) buckets <<= 1;
+    f->grid.cell = cfg->fleet_radius;
+    f->grid.inv_cell = 1.0 / cfg->fleet_radius;
+    f->grid.mask = (uint32_t)(buckets - 1);
+
+    size_t bytes = layout(f, NULL, buckets, threads);
+    f->memory = aligned_alloc(FLEET_ALIGN, bytes);
+    if (!f->memory) {
+        LOG_ERROR("Falha ao alocar a frota (%zu bytes)\n", bytes);
+        return -1;
+    }
+    layout(f, f->memory, buckets, threads);
+
+    if (pool_start(f, threads) != 0) {
+        fleet_destroy(f);
+        return -1;
+    }
+    fleet_reset(f);
+    return 0;
+}
+
+void fleet_reset(Fleet *f) {
+    const ScenarioConfig *cfg = f->cfg;
+    int side = (int)ceil(sqrt((double)f->n));
+
+    for (int i = 0; i < f->n; i++) {
+        int row = i / side, col = i % side;
+        f->ox[i] = col * cfg->fleet_spacing;
+        f->oy[i] = row * cfg->fleet_spacing;
+        f->delay[i] = (col % DELAY_COLUMNS) * cfg->fleet_delay_s;
+
+        // Parado na origem local, como o robô único
+        f->x1[i] = f->ox[i];
+        f->x2[i] = f->oy[i];
+        f->x3[i] = 0.0;
+        f->y1[i] = f->x1[i] + cfg->R;
+        f->y2[i] = f->x2[i];
+        // Modelos de referência partem da origem da vaga, como os do robô
+        // único partem de (0, 0): a referência da vaga é deslocada por (ox, oy)
+        f->ymx[i] = f->ox[i];
+        f->ymy[i] = f->oy[i];
+        f->dymx[i] = f->dymy[i] = 0.0;
+        f->v1[i] = f->v2[i] = f->u1[i] = f->u2[i] = 0.0;
+        f->ise[i] = 0.0;
+        f->nearest[i] = INFINITY;
+        f->neighbors[i] = 0;
+        f->moved[i] = 0;
+    }
+    grid_build(f);
+
+    f->tick = 0;
+    memset(&f->stats, 0, sizeof(f->stats));
+    f->stats.min_distance = INFINITY;
+}
+
+int fleet_step(Fleet *f) {
+    if (f->tick > f->total_ticks) return 0;
+
+    const ScenarioConfig *cfg = f->cfg;
+    long t_ms = f->tick * f->base_ms;
+    f->t = t_ms / 1000.0;
+    f->tasks = 0;
+    if (due(t_ms, cfg->model_period_ms)) f->tasks |= DIFFROBOT_MODELO;
+    if (due(t_ms, cfg->ctrl_period_ms)) f->tasks |= DIFFROBOT_CONTROLE;
+    if (due(t_ms, cfg->lin_period_ms)) f->tasks |= DIFFROBOT_LINEARIZACAO;
+    if (due(t_ms, cfg->sim_period_ms)) f->tasks |= DIFFROBOT_ROBO;
+
+    if (f->tasks) pool_run(f, job_laws);
+    if (f->tasks & DIFFROBOT_ROBO) {
+        grid_update(f);
+        f->stats.steps++;
+        if (f->check_neighbors) fleet_query(f);
+    }
+
+    f->tick++;
+    return 1;
+}
+
+void fleet_query(Fleet *f) {
+    pool_run(f, job_query);
+
+    long collisions = 0;
+    double min_d2 = INFINITY;
+    for (int p = 0; p <= f->pool.n_threads; p++) {
+        f->stats.pair_checks += f->parts[p].checks;
+        collisions += f->parts[p].collisions;
+        if (f->parts[p].min_d2 < min_d2) min_d2 = f->parts[p].min_d2;
+    }
+    f->stats.collisions_now = collisions;
+    f->stats.collisions += collisions;
+    if (sqrt(min_d2) < f->stats.min_distance) f->stats.min_distance = sqrt(min_d2);
+}
+
+void fleet_stats(const Fleet *f, FleetStats *out) {
+    *out = f->stats;
+    double ise = 0.0;
+    for (int i = 0; i < f->n; i++) ise += f->ise[i];
+    double duration = f->stats.steps * f->cfg->sim_period_ms / 1000.0;
+    out->rms_error = f->n > 0 && duration > 0 ? sqrt(ise / (f->n * duration)) : 0.0;
+}
+
+void fleet_destroy(Fleet *f) {
+    pool_stop(&f->pool);
+    free(f->memory);
+    f->memory = NULL;
+}
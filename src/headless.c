@@ -0,0 +1,92 @@
+/*
+    FILE: headless.c
+    DESCRIPTION:
+        Implementa a simulação determinística sem threads (headless.h).
+        O escalonamento e as leis ficam no passo puro (diffrobot.h);
+        aqui se acrescentam a gravação, a contagem de saturação e o motor
+        de indicadores a partir das tarefas ativadas em cada tick.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <math.h>
+#include <string.h>
+#include "headless.h"
+
+void headless_init(HeadlessSim *sim, const ScenarioConfig *cfg, const Trajectory *traj) {
+    memset(sim, 0, sizeof(*sim));
+    diffrobot_model_init(&sim->model, cfg, traj);
+    diffrobot_state_init(&sim->model, &sim->state);
+    metrics_init(&sim->metrics, cfg);
+}
+
+int headless_step(HeadlessSim *sim) {
+    const ScenarioConfig *cfg = sim->model.cfg;
+    DiffRobotState *s = &sim->state;
+    // O robô avança por último no tick: controle e linearização viram a pose
+    // anterior (a estimada, quando há estimador)
+    RobotState robot = *estimator_view(&s->est, &s->robot);
+    if (!diffrobot_step(&sim->model, s, s)) return 0;
+
+    double t = (s->tick - 1) * sim->model.base_ms / 1000.0;
+    // O MPC, o LQR e a ação integral não são funções das entradas gravadas da
+    // lei por modelo de referência: só a linearização é gravada para reprodução
+    if ((s->ativadas & DIFFROBOT_CONTROLE) && sim->rec && !sim->model.mpc && !sim->model.lqr &&
+        cfg->ctrl_ki == 0) {
+        ReplayCtrl rc = { t, s->xref, s->yref, s->ymx, s->dymx, s->ymy, s->dymy,
+                          robot.y1, robot.y2, s->alpha1, s->alpha2, s->v1, s->v2 };
+        replay_record_ctrl(sim->rec, &rc);
+    }
+    if (s->ativadas & DIFFROBOT_LINEARIZACAO) {
+        if (sim->rec) {
+            ReplayLin rl = { t, robot.x3, s->v1, s->v2, s->u1, s->u2 };
+            replay_record_lin(sim->rec, &rl);
+        }
+        sim->lin_ticks++;
+        if (fabs(s->u1) >= cfg->u1_max || fabs(s->u2) >= cfg->u2_max) sim->sat_ticks++;
+    }
+    if ((s->ativadas & DIFFROBOT_ROBO) && s->est.mode != ESTIMATOR_NONE) {
+        double ex = s->est.pose.y1 - s->robot.y1, ey = s->est.pose.y2 - s->robot.y2;
+        sim->est_sq += ex * ex + ey * ey;
+        sim->est_n++;
+    }
+    if (s->ativadas & DIFFROBOT_ROBO) {
+        // Indicadores em fluxo com a referência no instante exato
+        MetricsSample ms;
+        diffrobot_sample(&sim->model, s, &ms);
+        metrics_update(&sim->metrics, &ms, cfg->sim_period_ms / 1000.0);
+    }
+    return 1;
+}
+
+void headless_finish(HeadlessSim *sim) {
+    HeadlessResult *r = &sim->result;
+    metrics_summary(&sim->metrics, &r->metrics);
+    r->ise = r->metrics.ise;
+    r->iae = r->metrics.iae;
+    r->itae = r->metrics.itae;
+    r->rms_error = r->metrics.rms_error;
+    r->max_error = r->metrics.max_error;
+    r->effort = r->metrics.effort_u;
+    r->sim_time = r->metrics.duration;
+    r->sat_ratio = sim->lin_ticks ? (double)sim->sat_ticks / sim->lin_ticks : 0.0;
+    r->est_rms = sim->est_n ? sqrt(sim->est_sq / sim->est_n) : 0.0;
+}
+
+void headless_run(const ScenarioConfig *cfg, const Trajectory *traj, HeadlessResult *out) {
+    HeadlessSim sim;
+    headless_init(&sim, cfg, traj);
+    Mpc mpc;
+    int use_mpc = strcmp(cfg->controller, "mpc") == 0 && mpc_init(&mpc, cfg) == 0;
+    if (use_mpc) sim.model.mpc = &mpc;
+    Lqr lqr;
+    int use_lqr = strcmp(cfg->controller, "lqr") == 0 && lqr_init(&lqr, cfg) == 0;
+    if (use_lqr) sim.model.lqr = &lqr;
+    while (headless_step(&sim)) {
+    }
+    headless_finish(&sim);
+    if (use_mpc) mpc_destroy(&mpc);
+    if (use_lqr) lqr_destroy(&lqr);
+    *out = sim.result;
+}
@@ -3,13 +3,34 @@
     DESCRIPTION:
         Implementa as funções de integração numérica, como a Regra do Ponto Médio e a Regra do Trapézio Composta.
         Essas funções são usadas na simulação do modelo do robô.
+        As regras sobre séries amostradas têm uma versão escalar e uma com
+        AVX2, escolhida em tempo de execução conforme a CPU.
     AUTHOR: Darlysson Lima
-    LAST UPDATE: Julho, 2025
+    LAST UPDATE: Outubro, 2026
     LICENSE: CC BY-SA
 */
 
+#include <string.h>
 #include "integral.h"
 
+// AVX2 só é compilado para x86 com GCC/Clang; as funções marcadas com
+// AVX2_FN são geradas para AVX2 mesmo sem -mavx2 e só são chamadas após a
+// verificação da CPU
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SAMPLES_HAVE_AVX2 1
+#include <immintrin.h>
+#define AVX2_FN __attribute__((target("avx2")))
+#else
+#define SAMPLES_HAVE_AVX2 0
+#endif
+
+/* Simpson num par de intervalos com espaçamentos livres: integral da
+   parábola por (t0, f0), (t1, f1) e (t2, f2) de t0 a t2 */
+static inline double simpson_pair(double t0, double t1, double t2, double f0, double f1, double f2) {
+    double h0 = t1 - t0, h1 = t2 - t1, hs = h0 + h1;
+    return hs / 6.0 * ((2.0 - h1 / h0) * f0 + hs * hs / (h0 * h1) * f1 + (2.0 - h0 / h1) * f2);
+}
+
 // ==========================
 // Funções de Integração
 // ==========================
@@ -71,3 +92,286 @@ double composite_trapezoidal(function_ptr f, double a, double b, int n) {
     LOG_DEBUG("Composite_trapezoidal - Integral aproximada: %lf\n", result);
     return result;
 }
+
+// ==========================
+// Integração em fluxo
+// ==========================
+
+/* Incorpora (t, value). Retorna 1 se uma parcela foi fechada, escrevendo
+   o seu valor e o instante em que ela começa, e 0 caso contrário. */
+static int running_step(RunningIntegral *ri, double t, double value, double *part, double *start) {
+    if (ri->samples == 0) {
+        ri->t1 = t;
+        ri->f1 = value;
+        ri->samples = 1;
+        return 0;
+    }
+    double h = t - ri->t1;
+    if (!(h > 0.0)) return 0;
+
+    *start = ri->t1;
+    switch (ri->rule) {
+    case INTEGRAL_RECT:
+        *part = ri->f1 * h;
+        break;
+    case INTEGRAL_TRAPEZOID:
+        *part = 0.5 * h * (ri->f1 + value);
+        break;
+    case INTEGRAL_SIMPSON:
+        if (!ri->open) {
+            // Primeiro intervalo do par: trapézio provisório até a próxima amostra
+            ri->pending = 0.5 * h * (ri->f1 + value);
+            ri->open = 1;
+            ri->t0 = ri->t1;
+            ri->f0 = ri->f1;
+            ri->t1 = t;
+            ri->f1 = value;
+            ri->samples++;
+            return 0;
+        }
+        // Par fechado: parábola pelas três amostras
+        *part = simpson_pair(ri->t0, ri->t1, t, ri->f0, ri->f1, value);
+        *start = ri->t0;
+        ri->pending = 0.0;
+        ri->open = 0;
+        break;
+    }
+    compensated_add(&ri->total, *part);
+    ri->t1 = t;
+    ri->f1 = value;
+    ri->samples++;
+    return 1;
+}
+
+void running_integral_init(RunningIntegral *ri, IntegralRule rule) {
+    memset(ri, 0, sizeof(*ri));
+    ri->rule = rule;
+}
+
+double running_integral_add(RunningIntegral *ri, double t, double value) {
+    double part, start;
+    return running_step(ri, t, value, &part, &start) ? part : 0.0;
+}
+
+void running_integral_clamp(RunningIntegral *ri, double limit) {
+    double v = running_integral_value(ri);
+    if (v > limit || v < -limit) {
+        ri->total.sum = (v > 0 ? limit : -limit) - ri->pending;
+        ri->total.comp = 0.0;
+    }
+}
+
+void sliding_integral_init(SlidingIntegral *si, IntegralRule rule, double window) {
+    memset(si, 0, sizeof(*si));
+    running_integral_init(&si->acc, rule);
+    si->window = window;
+}
+
+/* Retira a parcela mais antiga do anel */
+static void sliding_pop(SlidingIntegral *si) {
+    compensated_add(&si->sum, -si->part[si->head]);
+    si->head = (si->head + 1) % SLIDING_INTEGRAL_CAPACITY;
+    si->count--;
+}
+
+void sliding_integral_add(SlidingIntegral *si, double t, double value) {
+    double part, start;
+    int closed = running_step(&si->acc, t, value, &part, &start);
+
+    // Parcelas que começam antes da janela saem da soma
+    while (si->count > 0 && si->start[si->head] < t - si->window) sliding_pop(si);
+    if (!closed) return;
+
+    if (si->count == SLIDING_INTEGRAL_CAPACITY) {
+        sliding_pop(si);
+        si->dropped++;
+    }
+    int tail = (si->head + si->count) % SLIDING_INTEGRAL_CAPACITY;
+    si->start[tail] = start;
+    si->part[tail] = part;
+    si->count++;
+    compensated_add(&si->sum, part);
+}
+
+double sliding_integral_span(const SlidingIntegral *si) {
+    if (si->acc.samples < 2) return 0.0;
+    double first = si->count > 0 ? si->start[si->head] : (si->acc.open ? si->acc.t0 : si->acc.t1);
+    return si->acc.t1 - first;
+}
+
+// ==========================
+// Integração de séries amostradas
+// ==========================
+
+/* Último intervalo [t[n-2], t[n-1]] pela parábola das três últimas amostras
+   (fecha o Simpson com número ímpar de intervalos) */
+static double simpson_last_interval(const double *t, const double *y, size_t n) {
+    double h0 = t[n - 2] - t[n - 3], h1 = t[n - 1] - t[n - 2];
+    double a = (2.0 * h1 * h1 + 3.0 * h0 * h1) / (6.0 * (h0 + h1));
+    double b = (h1 * h1 + 3.0 * h0 * h1) / (6.0 * h0);
+    double c = h1 * h1 * h1 / (6.0 * h0 * (h0 + h1));
+    return a * y[n - 1] + b * y[n - 2] - c * y[n - 3];
+}
+
+double samples_trapezoid_scalar(const double *t, const double *y, size_t n) {
+    double sum = 0.0;
+    for (size_t i = 0; i + 1 < n; i++) sum += (t[i + 1] - t[i]) * (y[i] + y[i + 1]);
+    return 0.5 * sum;
+}
+
+double samples_simpson_scalar(const double *t, const double *y, size_t n) {
+    if (n < 3) return samples_trapezoid_scalar(t, y, n);
+    size_t pairs = (n - 1) / 2;
+    double sum = 0.0;
+    for (size_t k = 0; k < pairs; k++) {
+        size_t i = 2 * k;
+        sum += simpson_pair(t[i], t[i + 1], t[i + 2], y[i], y[i + 1], y[i + 2]);
+    }
+    if ((n - 1) % 2) sum += simpson_last_interval(t, y, n);
+    return sum;
+}
+
+void samples_cumulative_trapezoid_scalar(const double *t, const double *y, size_t n,
+                                         double *restrict out) {
+    if (n == 0) return;
+    double acc = 0.0;
+    out[0] = 0.0;
+    for (size_t i = 0; i + 1 < n; i++) {
+        acc += 0.5 * (t[i + 1] - t[i]) * (y[i] + y[i + 1]);
+        out[i + 1] = acc;
+    }
+}
+
+#if SAMPLES_HAVE_AVX2
+
+/* Soma das quatro posições do vetor */
+AVX2_FN static inline double hsum(__m256d v) {
+    __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+AVX2_FN static double trapezoid_avx2(const double *t, const double *y, size_t n) {
+    // Dois acumuladores independentes escondem a latência da soma
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 < n; i += 8) {
+        __m256d h0 = _mm256_sub_pd(_mm256_loadu_pd(t + i + 1), _mm256_loadu_pd(t + i));
+        __m256d h1 = _mm256_sub_pd(_mm256_loadu_pd(t + i + 5), _mm256_loadu_pd(t + i + 4));
+        __m256d s0 = _mm256_add_pd(_mm256_loadu_pd(y + i), _mm256_loadu_pd(y + i + 1));
+        __m256d s1 = _mm256_add_pd(_mm256_loadu_pd(y + i + 4), _mm256_loadu_pd(y + i + 5));
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(h0, s0));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(h1, s1));
+    }
+    double sum = hsum(_mm256_add_pd(acc0, acc1));
+    for (; i + 1 < n; i++) sum += (t[i + 1] - t[i]) * (y[i] + y[i + 1]);
+    return 0.5 * sum;
+}
+
+/* Amostras pares e ímpares de v[0..7] (quatro pares de intervalos) */
+AVX2_FN static inline void deinterleave(const double *v, __m256d *even, __m256d *odd) {
+    __m256d a = _mm256_loadu_pd(v), b = _mm256_loadu_pd(v + 4);
+    *even = _mm256_permute4x64_pd(_mm256_unpacklo_pd(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+    *odd = _mm256_permute4x64_pd(_mm256_unpackhi_pd(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+/* Pares seguintes das amostras pares: (v0, v2, v4, v6) -> (v2, v4, v6, v8) */
+AVX2_FN static inline __m256d shift_even(__m256d even, double v8) {
+    __m256d r = _mm256_permute4x64_pd(even, _MM_SHUFFLE(0, 3, 2, 1));
+    return _mm256_blend_pd(r, _mm256_set1_pd(v8), 0x8);
+}
+
+AVX2_FN static double simpson_avx2(const double *t, const double *y, size_t n) {
+    if (n < 3) return samples_trapezoid_scalar(t, y, n);
+    size_t pairs = (n - 1) / 2, k = 0;
+    const __m256d two = _mm256_set1_pd(2.0), sixth = _mm256_set1_pd(1.0 / 6.0);
+    __m256d acc = _mm256_setzero_pd();
+
+    // Quatro pares por iteração: usa as amostras 2k a 2k + 8
+    for (; k + 4 <= pairs; k += 4) {
+        size_t i = 2 * k;
+        __m256d t0, t1, f0, f1;
+        deinterleave(t + i, &t0, &t1);
+        deinterleave(y + i, &f0, &f1);
+        __m256d t2 = shift_even(t0, t[i + 8]), f2 = shift_even(f0, y[i + 8]);
+
+        __m256d h0 = _mm256_sub_pd(t1, t0), h1 = _mm256_sub_pd(t2, t1), hs = _mm256_add_pd(h0, h1);
+        __m256d w0 = _mm256_sub_pd(two, _mm256_div_pd(h1, h0));
+        __m256d w1 = _mm256_div_pd(_mm256_mul_pd(hs, hs), _mm256_mul_pd(h0, h1));
+        __m256d w2 = _mm256_sub_pd(two, _mm256_div_pd(h0, h1));
+        __m256d s = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(w0, f0), _mm256_mul_pd(w1, f1)),
+                                  _mm256_mul_pd(w2, f2));
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_mul_pd(hs, sixth), s));
+    }
+
+    double sum = hsum(acc);
+    for (; k < pairs; k++) {
+        size_t i = 2 * k;
+        sum += simpson_pair(t[i], t[i + 1], t[i + 2], y[i], y[i + 1], y[i + 2]);
+    }
+    if ((n - 1) % 2) sum += simpson_last_interval(t, y, n);
+    return sum;
+}
+
+AVX2_FN static void cumulative_trapezoid_avx2(const double *t, const double *y, size_t n,
+                                              double *restrict out) {
+    if (n == 0) return;
+    const __m256d half = _mm256_set1_pd(0.5), zero = _mm256_setzero_pd();
+    __m256d carry = zero;
+    out[0] = 0.0;
+    size_t i = 0;
+    for (; i + 4 < n; i += 4) {
+        __m256d h = _mm256_sub_pd(_mm256_loadu_pd(t + i + 1), _mm256_loadu_pd(t + i));
+        __m256d s = _mm256_add_pd(_mm256_loadu_pd(y + i), _mm256_loadu_pd(y + i + 1));
+        __m256d p = _mm256_mul_pd(_mm256_mul_pd(h, s), half);
+
+        // Soma prefixada das quatro parcelas: desloca uma e depois duas posições
+        p = _mm256_add_pd(p, _mm256_blend_pd(_mm256_permute4x64_pd(p, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x1));
+        p = _mm256_add_pd(p, _mm256_blend_pd(_mm256_permute4x64_pd(p, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x3));
+        p = _mm256_add_pd(p, carry);
+        _mm256_storeu_pd(out + i + 1, p);
+        carry = _mm256_permute4x64_pd(p, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    double acc = out[i];
+    for (; i + 1 < n; i++) {
+        acc += 0.5 * (t[i + 1] - t[i]) * (y[i] + y[i + 1]);
+        out[i + 1] = acc;
+    }
+}
+
+#endif // SAMPLES_HAVE_AVX2
+
+SamplesIsa samples_isa(void) {
+#if SAMPLES_HAVE_AVX2
+    if (__builtin_cpu_supports("avx2")) return SAMPLES_ISA_AVX2;
+#endif
+    return SAMPLES_ISA_SCALAR;
+}
+
+const char *samples_isa_name(SamplesIsa isa) {
+    return isa == SAMPLES_ISA_AVX2 ? "avx2" : "escalar";
+}
+
+double samples_trapezoid(const double *t, const double *y, size_t n) {
+#if SAMPLES_HAVE_AVX2
+    if (samples_isa() == SAMPLES_ISA_AVX2) return trapezoid_avx2(t, y, n);
+#endif
+    return samples_trapezoid_scalar(t, y, n);
+}
+
+double samples_simpson(const double *t, const double *y, size_t n) {
+#if SAMPLES_HAVE_AVX2
+    if (samples_isa() == SAMPLES_ISA_AVX2) return simpson_avx2(t, y, n);
+#endif
+    return samples_simpson_scalar(t, y, n);
+}
+
+void samples_cumulative_trapezoid(const double *t, const double *y, size_t n,
+                                  double *restrict out) {
+#if SAMPLES_HAVE_AVX2
+    if (samples_isa() == SAMPLES_ISA_AVX2) {
+        cumulative_trapezoid_avx2(t, y, n, out);
+        return;
+    }
+#endif
+    samples_cumulative_trapezoid_scalar(t, y, n, out);
+}
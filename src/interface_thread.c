@@ -8,49 +8,70 @@
     LICENSE: CC BY-SA
 */
 
-#include <unistd.h>  // Para usleep (pausa de 1 segundo)
 #include <stdio.h>   // Para exibição de informações na tela
+#include <string.h>  // Para montagem da linha de status
 #include "monitors.h" // Para acesso aos dados compartilhados entre threads
+#include "numfmt.h"   // Para formatação rápida dos valores exibidos
+#include "threads.h"  // Protótipos das threads e dos corpos das ativações
+
+/* Corpo de uma ativação: lê os monitores e monta a linha de status do instante t
+   em line (INTERFACE_LINE_MAX bytes); retorna o comprimento (sem espera nem escrita) */
+size_t interface_step(ArgsInterface *args, double t, char *line) {
+    // Estado do robô e referências do mesmo tick, sem travas (instantâneo global)
+    const SystemSnapshot *g = snapshot_acquire(args->g, SNAPSHOT_INTERFACE);
+    double a1, a2;
+
+    // Leitura dos parâmetros de controle (α1, α2)
+    pthread_mutex_lock(&args->p->mutex);
+    a1 = args->p->alpha1; a2 = args->p->alpha2;
+    pthread_mutex_unlock(&args->p->mutex);
+
+    // Leitura dos indicadores online (erro RMS e ciclo de saturação de u)
+    double rms, duty_u;
+    pthread_mutex_lock(&args->m->mutex);
+    rms = args->m->resumo.rms_error;
+    duty_u = 100.0 * args->m->resumo.duty_u;
+    pthread_mutex_unlock(&args->m->mutex);
+
+    // Exibe as informações da simulação no formato:
+    // [tempo] estado_do_robô | referência | parâmetros de controle | indicadores
+    const char *labels[] = { "[", "s] x=(", ", ", ", ", ") | y=(", ", ",
+                             ") | ref=(", ", ", ") | α=(", ", ", ") | rms=", " sat_u=" };
+    double values[] = { t, g->x1, g->x2, g->x3, g->y1, g->y2, g->xref, g->yref, a1, a2, rms, duty_u };
+    size_t n = 0;
+    for (int i = 0; i < 12; i++) {
+        size_t len = strlen(labels[i]);
+        memcpy(line + n, labels[i], len);
+        n += len;
+        n += numfmt_double_fixed(line + n, values[i], 2);
+    }
+    memcpy(line + n, "%\n", 3);
+    return n + 2;
+}
 
 /* Função da thread da interface com o usuário */
 void *interface_thread(void *arg) {
     ArgsInterface *args = (ArgsInterface *)arg;
 
-    while (1) {
-        // Verifica se o sistema deve ser encerrado
+    // Aguarda a partida comum liberada pelo supervisor
+    struct timespec next_activation;
+    int ativo = supervisor_start(&next_activation);
+
+    while (ativo) {
+        // Tempo de simulação atual
         pthread_mutex_lock(&args->t->mutex);
-        if (args->t->encerrar) {
-            pthread_mutex_unlock(&args->t->mutex);
-            pthread_exit(NULL);  // Encerra a thread se a flag 'encerrar' for setada
-        }
-        double t = args->t->tempo_atual;  // Captura o tempo atual
+        double t = args->t->tempo_atual;
         pthread_mutex_unlock(&args->t->mutex);
 
-        // Leitura do estado atual do robô e das referências
-        double x1, x2, x3, y1, y2, xref, yref, a1, a2;
-
-        // Leitura do estado do robô (posição e orientação)
-        pthread_mutex_lock(&args->e->mutex);
-        x1 = args->e->x1; x2 = args->e->x2; x3 = args->e->x3;
-        y1 = args->e->y1; y2 = args->e->y2;
-        pthread_mutex_unlock(&args->e->mutex);
-
-        // Leitura das referências de posição
-        pthread_mutex_lock(&args->r->mutex);
-        xref = args->r->xref; yref = args->r->yref;
-        pthread_mutex_unlock(&args->r->mutex);
+        // Corpo da ativação (isolado da espera para benchmarks) e exibição
+        char line[INTERFACE_LINE_MAX];
+        interface_step(args, t, line);
+        fputs(line, stdout);
 
-        // Leitura dos parâmetros de controle (α1, α2)
-        pthread_mutex_lock(&args->p->mutex);
-        a1 = args->p->alpha1; a2 = args->p->alpha2;
-        pthread_mutex_unlock(&args->p->mutex);
-
-        // Exibe as informações da simulação no formato:
-        // [tempo] estado_do_robô | referência | parâmetros de controle
-        printf("[%.2fs] x=(%.2f, %.2f, %.2f) | y=(%.2f, %.2f) | ref=(%.2f, %.2f) | α=(%.2f, %.2f)\n",
-               t, x1, x2, x3, y1, y2, xref, yref, a1, a2);
-
-        // Pausa a thread por 1 segundo
-        usleep(1000000); // 1 segundo
+        // Pausa até a próxima atualização da tela (o encerramento acorda a thread imediatamente)
+        supervisor_advance(&next_activation, args->cfg->interface_period_ms);
+        ativo = supervisor_sleep_until(&next_activation);
     }
+
+    pthread_exit(NULL);  // Encerra a thread
 }
@@ -8,76 +8,88 @@
     LICENSE: CC BY-SA
 */
 
-#define _POSIX_C_SOURCE 199309L
+#define _POSIX_C_SOURCE 200112L
 #include <time.h>
 #include <unistd.h>
 #include <math.h>
 #include "monitors.h"  // Para acessar dados compartilhados
+#include "threads.h"   // Protótipos das threads e dos corpos das ativações
 #include "logs.h"      // Para log de eventos
+#include "control_law.h" // Linearização por realimentação
 
-#define R 0.3           // Distância do centro geométrico à frente do robô
-#define PERIOD_MS 30    // Período de amostragem em ms
-#define U1_MAX 1.0      // Saturação máxima para velocidade linear
-#define U2_MAX 3.0      // Saturação máxima para velocidade angular
+/* Corpo de uma ativação: calcula e publica u(t) (sem espera) */
+void linearization_step(ArgsLin *args) {
+    const ScenarioConfig *cfg = args->cfg;
+
+    // Leitura do ângulo de orientação θ
+    double theta;
+    DataStamp ce, cc;  // Carimbos das entradas
+    pthread_mutex_lock(&args->e->mutex);
+    theta = args->e->xe3;  // Estimado (o real sem estimador)
+    ce = args->e->carimbo;
+    pthread_mutex_unlock(&args->e->mutex);
+
+    // Leitura das velocidades de controle (v1 e v2)
+    double v1, v2;
+    pthread_mutex_lock(&args->c->mutex);
+    v1 = args->c->v1;
+    v2 = args->c->v2;
+    cc = args->c->carimbo;
+    pthread_mutex_unlock(&args->c->mutex);
+
+    // Equações de linearização inversa para calcular u1 e u2 (saturados)
+    double u1, u2;
+    linearization_law(cfg, theta, v1, v2, &u1, &u2);
+
+    // Grava entradas e saídas exatas da linearização para reprodução determinística
+    if (args->rec) {
+        ReplayLin rl = { monitor_tempo_exato(args->t), theta, v1, v2, u1, u2 };
+        replay_record_lin(args->rec, &rl);
+    }
+
+    // u(t) herda a origem mais antiga de cada fonte entre θ e v(t)
+    double agora = data_age_now();
+    double origem[DATA_SOURCES];
+    data_stamp_begin(origem);
+    data_stamp_merge(origem, &ce);
+    data_stamp_merge(origem, &cc);
+
+    // Atualiza os comandos de controle (u1, u2) no monitor compartilhado
+    pthread_mutex_lock(&args->l->mutex);
+    args->l->u1 = u1;
+    args->l->u2 = u2;
+    data_stamp_publish(&args->l->carimbo, origem, agora);
+    pthread_mutex_unlock(&args->l->mutex);
+
+    // Idade das entradas
+    pthread_mutex_lock(&args->a->mutex);
+    age_histogram_add(&args->a->caminhos[AGE_ESTADO_LINEARIZACAO], agora - ce.publicado, ce.seq);
+    age_histogram_add(&args->a->caminhos[AGE_COMANDO_LINEARIZACAO], agora - cc.publicado, cc.seq);
+    pthread_mutex_unlock(&args->a->mutex);
+
+    // Registra no log os valores calculados de linearização
+    LOG_DEBUG("Linearização: theta=%.2f, v=(%.2f, %.2f) → u=(%.2f, %.2f)\n",
+              theta, v1, v2, u1, u2);
+}
 
 /* Função da thread de linearização */
 void *linearization_thread(void *arg) {
     ArgsLin *args = (ArgsLin *)arg;
+    const ScenarioConfig *cfg = args->cfg;  // R, período e limites de saturação
 
     LOG_DEBUG("Thread de linearização iniciada.\n");
 
+    // Aguarda a partida comum liberada pelo supervisor
     struct timespec next_activation;
-    clock_gettime(CLOCK_MONOTONIC, &next_activation);  // Define o tempo inicial
-
-    while (1) {
-        // Verifica se o sistema deve ser encerrado
-        pthread_mutex_lock(&args->t->mutex);
-        if (args->t->encerrar) {
-            pthread_mutex_unlock(&args->t->mutex);
-            pthread_exit(NULL);  // Encerra a thread se a flag 'encerrar' for setada
-        }
-        pthread_mutex_unlock(&args->t->mutex);
-
-        // Leitura do ângulo de orientação θ
-        double theta;
-        pthread_mutex_lock(&args->e->mutex);
-        theta = args->e->x3;
-        pthread_mutex_unlock(&args->e->mutex);
-
-        // Leitura das velocidades de controle (v1 e v2)
-        double v1, v2;
-        pthread_mutex_lock(&args->c->mutex);
-        v1 = args->c->v1;
-        v2 = args->c->v2;
-        pthread_mutex_unlock(&args->c->mutex);
-
-        // Equações de linearização inversa para calcular u1 e u2
-        double u1 = cos(theta) * v1 + sin(theta) * v2;   // Cálculo da velocidade linear
-        double u2 = (-sin(theta) * v1 + cos(theta) * v2) / R;  // Cálculo da velocidade angular
-
-        // Saturação para evitar valores excessivos
-        if (u1 > U1_MAX) u1 = U1_MAX;
-        if (u1 < -U1_MAX) u1 = -U1_MAX;
-        if (u2 > U2_MAX) u2 = U2_MAX;
-        if (u2 < -U2_MAX) u2 = -U2_MAX;
-
-        // Atualiza os comandos de controle (u1, u2) no monitor compartilhado
-        pthread_mutex_lock(&args->l->mutex);
-        args->l->u1 = u1;
-        args->l->u2 = u2;
-        pthread_mutex_unlock(&args->l->mutex);
-
-        // Registra no log os valores calculados de linearização
-        LOG_DEBUG("Linearização: theta=%.2f, v=(%.2f, %.2f) → u=(%.2f, %.2f)\n",
-                  theta, v1, v2, u1, u2);
-
-        // Dorme até o próximo período de amostragem
-        next_activation.tv_nsec += PERIOD_MS * 1e6;
-        while (next_activation.tv_nsec >= 1e9) {
-            next_activation.tv_sec++;
-            next_activation.tv_nsec -= 1e9;
-        }
-        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_activation, NULL);
+    int ativo = supervisor_start(&next_activation);
+
+    while (ativo) {
+        // Corpo da ativação (isolado da espera para benchmarks)
+        linearization_step(args);
+
+        // Dorme até o próximo período (o encerramento acorda a thread imediatamente)
+        supervisor_advance(&next_activation, cfg->lin_period_ms);
+        ativo = supervisor_sleep_until(&next_activation);
     }
 
     pthread_exit(NULL);  // Encerra a thread
@@ -2,100 +2,75 @@
     FILE: logger_thread.c
     DESCRIPTION:
         Implementa a thread que registra os dados da simulação em arquivos CSV.
+        A thread só amostra e copia as linhas para os buffers de telemetry.h;
+        a escrita em disco acontece na thread escritora, fora do período.
     AUTHOR: Darlysson Lima
-    LAST UPDATE: Julho, 2025
+    LAST UPDATE: Outubro, 2026
     LICENSE: CC BY-SA
 */
 
-#define _POSIX_C_SOURCE 199309L  // Necessário para a função clock_gettime
+#define _POSIX_C_SOURCE 200112L  // Necessário para clock_gettime e clock_nanosleep
 #include <time.h>
-#include <unistd.h>
 #include <stdio.h>
-#include "monitors.h"  // Para uso de monitores e mutexes
+#include "logger_thread.h" // Para monitores e o formato da linha
 #include "logs.h"      // Para uso do sistema de logs
+#include "numfmt.h"    // Para formatação rápida dos valores do CSV
+
+/* Monta uma linha do CSV em buf: t com 2 casas, demais colunas com 4 casas */
+static size_t format_csv_row(char *buf, const double *values, int count) {
+    size_t n = numfmt_double_fixed(buf, values[0], 2);
+    for (int i = 1; i < count; i++) {
+        buf[n++] = ',';
+        n += numfmt_double_fixed(buf + n, values[i], 4);
+    }
+    buf[n++] = '\n';
+    buf[n] = '\0';
+    return n;
+}
 
-#define PERIOD_MS 50   // Período da thread de logging em milissegundos
+/* Corpo de uma ativação: monta em line (LOGGER_LINE_MAX bytes) a linha do
+   tick mais recente; retorna o comprimento (sem espera nem escrita) */
+size_t logger_step(ArgsLogger *args, char *line) {
+    // Todas as colunas do mesmo tick de simulação, sem travas (instantâneo global)
+    const SystemSnapshot *g = snapshot_acquire(args->g, SNAPSHOT_LOGGER);
+
+    // Monta a linha do CSV
+    double row[CSV_COLUMNS] = { g->t, g->xref, g->yref, g->x1, g->x2, g->x3, g->y1, g->y2,
+                                g->v1, g->v2, g->u1, g->u2 };
+    return format_csv_row(line, row, CSV_COLUMNS);
+}
 
 /* Função da thread de logging */
 void *logger_thread(void *arg) {
     ArgsLogger *args = (ArgsLogger *)arg;  // Dados passados para a thread
+    const ScenarioConfig *cfg = args->cfg;  // Período e arquivo de saída
 
     LOG_DEBUG("Thread de registro iniciada.\n");
 
-    // Abre o arquivo de saída para registro
-    FILE *file = fopen("data/saida.csv", "w");
-    if (!file) {
-        perror("Erro ao abrir data/saida.csv");
+    // Abre o arquivo de saída com o cabeçalho do CSV; a gravação fica com a
+    // thread escritora, e esta thread só amostra
+    if (telemetry_open(args->w, cfg->output_csv, cfg, "t,xref,yref,x1,x2,x3,y1,y2,v1,v2,u1,u2\n") != 0) {
+        fprintf(stderr, "[ERRO] Não foi possível gravar o registro em %s\n", cfg->output_csv);
+        supervisor_leave();  // Libera a barreira de partida e sai da vigilância do cão de guarda
         pthread_exit(NULL);  // Finaliza a thread em caso de erro
     }
 
-    // Escreve o cabeçalho do CSV
-    fprintf(file, "t,xref,yref,x1,x2,x3,y1,y2,v1,v2,u1,u2\n");
-
+    // Aguarda a partida comum liberada pelo supervisor
     struct timespec next_activation;
-    clock_gettime(CLOCK_MONOTONIC, &next_activation);  // Inicializa o tempo de ativação
-
-    double t = 0.0;          // Tempo inicial
-    double dt = PERIOD_MS / 1000.0;  // Intervalo de tempo para a próxima leitura (em segundos)
-
-    while (1) {
-        // Verifica se a thread deve ser encerrada
-        pthread_mutex_lock(&args->t->mutex);
-        if (args->t->encerrar) {
-            pthread_mutex_unlock(&args->t->mutex);
-            break;  // Encerra a thread se a flag de encerramento estiver ativada
-        }
-        pthread_mutex_unlock(&args->t->mutex);
-
-        // Leitura dos dados de várias fontes, protegidas por mutexes
-        double xref, yref, x1, x2, x3, y1, y2, v1, v2, u1, u2;
-
-        // Leitura dos valores de referência
-        pthread_mutex_lock(&args->r->mutex);
-        xref = args->r->xref;
-        yref = args->r->yref;
-        pthread_mutex_unlock(&args->r->mutex);
-
-        // Leitura do estado do robô
-        pthread_mutex_lock(&args->e->mutex);
-        x1 = args->e->x1;
-        x2 = args->e->x2;
-        x3 = args->e->x3;
-        y1 = args->e->y1;
-        y2 = args->e->y2;
-        pthread_mutex_unlock(&args->e->mutex);
-
-        // Leitura das velocidades
-        pthread_mutex_lock(&args->c->mutex);
-        v1 = args->c->v1;
-        v2 = args->c->v2;
-        pthread_mutex_unlock(&args->c->mutex);
-
-        // Leitura dos comandos de controle
-        pthread_mutex_lock(&args->l->mutex);
-        u1 = args->l->u1;
-        u2 = args->l->u2;
-        pthread_mutex_unlock(&args->l->mutex);
-
-        // Grava os dados no arquivo
-        fprintf(file, "%.2f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n",
-                t, xref, yref, x1, x2, x3, y1, y2, v1, v2, u1, u2);
-
-        fflush(file);  // Força a gravação no arquivo
-        t += dt;       // Incrementa o tempo
+    int ativo = supervisor_start(&next_activation);
 
-        // Atualiza o tempo da próxima ativação
-        next_activation.tv_nsec += PERIOD_MS * 1e6;
-        while (next_activation.tv_nsec >= 1e9) {
-            next_activation.tv_sec++;
-            next_activation.tv_nsec -= 1e9;
-        }
+    while (ativo) {
+        // Corpo da ativação (isolado da espera para benchmarks) e cópia para o anel
+        char line[LOGGER_LINE_MAX];
+        size_t len = logger_step(args, line);
+        telemetry_write(args->w, line, len);
 
-        // Espera até o próximo período de ativação
-        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_activation, NULL);
+        // Espera até o próximo período de ativação (o encerramento acorda a thread imediatamente)
+        supervisor_advance(&next_activation, cfg->logger_period_ms);
+        ativo = supervisor_sleep_until(&next_activation);
     }
 
-    fclose(file);  // Fecha o arquivo de saída
+    telemetry_close(args->w);  // Grava o restante e fecha o arquivo de saída
     LOG_DEBUG("Logger finalizado.\n");
     pthread_exit(NULL);  // Finaliza a thread
 }
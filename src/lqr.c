@@ -0,0 +1,250 @@
+/*
+    FILE: lqr.c
+    DESCRIPTION:
+        Implementa o regulador quadrático com ganhos escalonados (lqr.h):
+        iteração da equação de Riccati discreta sobre o módulo de matrizes
+        em cada ponto da grade (θ, v), tabela alinhada de ganhos e
+        interpolação bilinear no período do controle.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lqr.h"
+#include "matrix.h"
+#include "autodiff.h"
+#include "control_law.h"
+
+#define RICCATI_MAX_ITER 100000  // Iterações máximas por ponto da grade
+#define RICCATI_TOL 1e-5f        // Variação relativa máxima de P na convergência
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Reduz um ângulo a (-π, π] */
+static double wrap_angle(double a) {
+    return a - 2.0 * M_PI * floor((a + M_PI) / (2.0 * M_PI));
+}
+
+// Áreas de trabalho da iteração de Riccati (3 estados, 2 entradas)
+typedef struct {
+    Matrix *A, *At, *B, *Bt;     // Modelo discreto no ponto de operação
+    Matrix *Q, *P, *Pn;          // Peso do estado e iterados de P
+    Matrix *PA, *PB, *AtPA;      // Produtos intermediários
+    Matrix *M, *S;               // M = Bᵀ P A e S = R + Bᵀ P B (fatorada)
+    float r;                     // Peso do esforço (R = r I)
+} Riccati;
+
+static void riccati_free(Riccati *w) {
+    Matrix *all[] = { w->A, w->At, w->B, w->Bt, w->Q, w->P, w->Pn,
+                      w->PA, w->PB, w->AtPA, w->M, w->S };
+    for (size_t i = 0; i < sizeof(all) / sizeof(all[0]); i++) destroy_matrix(all[i]);
+}
+
+static void riccati_alloc(Riccati *w, const ScenarioConfig *cfg) {
+    w->A = create_matrix(3, 3);
+    w->At = create_matrix(3, 3);
+    w->B = create_matrix(3, 2);
+    w->Bt = create_matrix(2, 3);
+    w->Q = create_matrix_zeros(3, 3);
+    w->P = create_matrix(3, 3);
+    w->Pn = create_matrix(3, 3);
+    w->PA = create_matrix(3, 3);
+    w->PB = create_matrix(3, 2);
+    w->AtPA = create_matrix(3, 3);
+    w->M = create_matrix(2, 3);
+    w->S = create_matrix(2, 2);
+    w->Q->data[0][0] = w->Q->data[1][1] = (float)cfg->lqr_q;
+    w->Q->data[2][2] = (float)cfg->lqr_q_theta;
+    w->r = (float)cfg->lqr_r;
+}
+
+/* Ganho estacionário do modelo discreto em (θ, v): itera
+   P = Q + AᵀPA - AᵀPB (R + BᵀPB)^-1 BᵀPA a partir de P = Q até a
+   convergência. Escreve K = (R + BᵀPB)^-1 BᵀPA e retorna as iterações,
+   ou -1 se não convergir. */
+static int riccati_gain(Riccati *w, double theta, double v, double dt, float K[6]) {
+    UnicycleJacobians J;
+    const double x[3] = { 0.0, 0.0, theta }, u[2] = { v, 0.0 };
+    ad_unicycle(x, u, 0.0, &J);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) w->A->data[i][j] = (float)((i == j) + dt * J.A[i][j]);
+        for (int j = 0; j < 2; j++) w->B->data[i][j] = (float)(dt * J.B[i][j]);
+    }
+    transpose_matrix_into(w->A, w->At);
+    transpose_matrix_into(w->B, w->Bt);
+    for (int i = 0; i < 3; i++) memcpy(w->P->data[i], w->Q->data[i], 3 * sizeof(float));
+
+    for (int it = 1; it <= RICCATI_MAX_ITER; it++) {
+        multiply_matrices_into(w->P, w->A, w->PA);
+        multiply_matrices_into(w->At, w->PA, w->AtPA);
+        multiply_matrices_into(w->Bt, w->PA, w->M);
+        multiply_matrices_into(w->P, w->B, w->PB);
+        multiply_matrices_into(w->Bt, w->PB, w->S);
+        w->S->data[0][0] += w->r;
+        w->S->data[1][1] += w->r;
+        if (cholesky_decompose(w->S) != 0) return -1;
+
+        // K por colunas: S K[:, j] = M[:, j]
+        for (int j = 0; j < 3; j++) {
+            float b[2] = { w->M->data[0][j], w->M->data[1][j] };
+            cholesky_solve(w->S, b, b);
+            K[j] = b[0];
+            K[3 + j] = b[1];
+        }
+
+        // Pn = Q + AᵀPA - Mᵀ K, simetrizada; converge pela variação relativa
+        float diff = 0.0f, scale = 1.0f;
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                float a = w->AtPA->data[i][j] - (w->M->data[0][i] * K[j] + w->M->data[1][i] * K[3 + j]);
+                float b = w->AtPA->data[j][i] - (w->M->data[0][j] * K[i] + w->M->data[1][j] * K[3 + i]);
+                w->Pn->data[i][j] = w->Q->data[i][j] + 0.5f * (a + b);
+                diff = fmaxf(diff, fabsf(w->Pn->data[i][j] - w->P->data[i][j]));
+                scale = fmaxf(scale, fabsf(w->Pn->data[i][j]));
+            }
+        }
+        Matrix *tmp = w->P;
+        w->P = w->Pn;
+        w->Pn = tmp;
+        if (diff <= RICCATI_TOL * scale) return it;
+    }
+    return -1;
+}
+
+// ==========================
+// Funções públicas
+// ==========================
+
+int lqr_init(Lqr *lqr, const ScenarioConfig *cfg) {
+    double t0 = now_s();
+    memset(lqr, 0, sizeof(*lqr));
+    lqr->n_heading = cfg->lqr_heading_bins;
+    lqr->n_speed = cfg->lqr_speed_bins;
+    lqr->v_min = cfg->lqr_speed_min;
+    lqr->v_max = cfg->u1_max;
+    lqr->heading_scale = lqr->n_heading / (2.0 * M_PI);
+    lqr->speed_scale = lqr->n_speed > 1 ? (lqr->n_speed - 1) / (lqr->v_max - lqr->v_min) : 0.0;
+    lqr->dt = cfg->ctrl_period_ms / 1000.0;
+    lqr->R = cfg->R;
+    lqr->error_max = cfg->lqr_error_max;
+
+    size_t count = (size_t)lqr->n_heading * lqr->n_speed;
+    lqr->gains = aligned_alloc(alignof(LqrGain), count * sizeof(LqrGain));
+    if (!lqr->gains) {
+        LOG_ERROR("Falha ao alocar a tabela de ganhos do LQR (%zu pontos)\n", count);
+        return -1;
+    }
+    memset(lqr->gains, 0, count * sizeof(LqrGain));
+
+    Riccati w;
+    riccati_alloc(&w, cfg);
+    int status = 0;
+    for (int iv = 0; iv < lqr->n_speed && status == 0; iv++) {
+        double v = lqr->n_speed > 1 ? lqr->v_min + iv / lqr->speed_scale : lqr->v_min;
+        for (int ih = 0; ih < lqr->n_heading; ih++) {
+            double theta = ih / lqr->heading_scale;
+            int it = riccati_gain(&w, theta, v, lqr->dt, lqr->gains[iv * lqr->n_heading + ih].k);
+            if (it < 0) {
+                LOG_ERROR("LQR: a equação de Riccati não convergiu em θ=%.3f rad, v=%.3f m/s\n", theta, v);
+                status = -1;
+                break;
+            }
+            if (it > lqr->max_iter) lqr->max_iter = it;
+        }
+    }
+    riccati_free(&w);
+    if (status != 0) {
+        lqr_destroy(lqr);
+        return -1;
+    }
+
+    lqr->build_s = now_s() - t0;
+    LOG_DEBUG("LQR: grade %d x %d (v de %.2f a %.2f m/s) montada em %.3f ms, até %d iterações\n",
+              lqr->n_heading, lqr->n_speed, lqr->v_min, lqr->v_max, lqr->build_s * 1e3, lqr->max_iter);
+    return 0;
+}
+
+void lqr_gain(const Lqr *lqr, double theta, double v, float K[6]) {
+    // θ periódico: a última faixa interpola com a primeira
+    double fh = floor(theta * lqr->heading_scale);
+    float a = (float)(theta * lqr->heading_scale - fh);
+    int h0 = (int)fh % lqr->n_heading;
+    if (h0 < 0) h0 += lqr->n_heading;
+    int h1 = h0 + 1 == lqr->n_heading ? 0 : h0 + 1;
+
+    // v limitado à faixa da grade
+    double fv = (v - lqr->v_min) * lqr->speed_scale;
+    if (fv < 0.0) fv = 0.0;
+    if (fv > lqr->n_speed - 1) fv = lqr->n_speed - 1;
+    int v0 = (int)fv;
+    int v1 = v0 + 1 < lqr->n_speed ? v0 + 1 : v0;
+    float b = (float)(fv - v0);
+
+    const float *k00 = lqr->gains[v0 * lqr->n_heading + h0].k;
+    const float *k01 = lqr->gains[v0 * lqr->n_heading + h1].k;
+    const float *k10 = lqr->gains[v1 * lqr->n_heading + h0].k;
+    const float *k11 = lqr->gains[v1 * lqr->n_heading + h1].k;
+    for (int i = 0; i < 6; i++) {
+        float lo = k00[i] + a * (k01[i] - k00[i]);
+        float hi = k10[i] + a * (k11[i] - k10[i]);
+        K[i] = lo + b * (hi - lo);
+    }
+}
+
+void lqr_control(const Lqr *lqr, double y1, double y2, double theta,
+                 const RefPreviewSample *now, const RefPreviewSample *next,
+                 double *u1, double *u2, double *v1, double *v2) {
+    double c = cos(theta), s = sin(theta), R = lqr->R;
+
+    // Pose de referência: orientação da velocidade da saída e centro R atrás
+    // (cos θr e sin θr saem da própria velocidade); parada, a referência
+    // mantém a orientação atual
+    double vr = hypot(now->dx, now->dy), thr = theta, cr = c, sr = s;
+    if (vr > 1e-9) {
+        thr = atan2(now->dy, now->dx);
+        cr = now->dx / vr;
+        sr = now->dy / vr;
+    }
+
+    // Giro de referência: ângulo entre as velocidades agora e um período depois
+    double cross = now->dx * next->dy - now->dy * next->dx;
+    double dot = now->dx * next->dx + now->dy * next->dy;
+    double wr = (cross != 0.0 || dot > 0.0) ? atan2(cross, dot) / lqr->dt : 0.0;
+
+    // Erro da pose (centro do robô menos centro de referência)
+    double e[3] = {
+        (y1 - R * c) - (now->x - R * cr),
+        (y2 - R * s) - (now->y - R * sr),
+        wrap_angle(theta - thr),
+    };
+
+    // Longe da referência o modelo linear não vale (u1 saturado chega a
+    // inverter o sentido): o erro de posição é limitado a error_max
+    double en = hypot(e[0], e[1]);
+    if (en > lqr->error_max) {
+        e[0] *= lqr->error_max / en;
+        e[1] *= lqr->error_max / en;
+    }
+
+    float K[6];
+    lqr_gain(lqr, thr, vr, K);
+    *u1 = vr - (K[0] * e[0] + K[1] * e[1] + K[2] * e[2]);
+    *u2 = wr - (K[3] * e[0] + K[4] * e[1] + K[5] * e[2]);
+
+    // v = T(θ) u: a linearização devolve exatamente u (dentro dos limites)
+    *v1 = c * *u1 - R * s * *u2;
+    *v2 = s * *u1 + R * c * *u2;
+}
+
+void lqr_destroy(Lqr *lqr) {
+    free(lqr->gains);
+    lqr->gains = NULL;
+}
@@ -7,32 +7,79 @@
     LICENSE: CC BY-SA
 */
 
+#define _POSIX_C_SOURCE 200112L
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <pthread.h>
 #include "monitors.h"
-#include "logger_thread.h"
-
-// Protótipos das threads
-void *sim_thread(void *arg);
-void *linearization_thread(void *arg);
-void *control_thread(void *arg);
-void *ref_generator_thread(void *arg);
-void *model_ref_x_thread(void *arg);
-void *model_ref_y_thread(void *arg);
-void *interface_thread(void *arg);
-void *logger_thread(void *arg);
-void *timer_thread(void *arg);
-
-int main() {
-    // Monitores
+#include "threads.h"
+#include "scenario.h"
+#include "trajectory.h"
+#include "checkpoint.h"
+
+/* Lê o cenário: argv[1] opcional com o arquivo e argumentos "chave=valor" como sobrescritas */
+static int load_scenario(ScenarioConfig *cfg, int argc, char **argv) {
+    scenario_set_defaults(cfg);
+    for (int i = 1; i < argc; i++) {
+        int status = strchr(argv[i], '=') ? scenario_apply(cfg, argv[i])
+                                          : scenario_load_file(cfg, argv[i]);
+        if (status != 0) {
+            fprintf(stderr, "[ERRO] Cenário inválido: %s\n", argv[i]);
+            return -1;
+        }
+    }
+    if (scenario_validate(cfg) != 0) {
+        fprintf(stderr, "[ERRO] Cenário inconsistente\n");
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    // Configuração do cenário: lida uma vez e somente lida pelas threads
+    static ScenarioConfig scenario;
+    if (load_scenario(&scenario, argc, argv) != 0) {
+        return EXIT_FAILURE;
+    }
+    const ScenarioConfig *cfg = &scenario;
+
+    // Tabela de referências pré-calculada (ou mapeada) antes de iniciar as threads
+    Trajectory trajetoria;
+    if (trajectory_load(&trajetoria, cfg) != 0) {
+        fprintf(stderr, "[ERRO] Trajetória inválida: %s\n", cfg->trajectory);
+        return EXIT_FAILURE;
+    }
+
+    // Eventos de mapa do segmento plan, aplicados pelo gerador de referências
+    static Replanner replanejador;
+    if (replanner_load(&replanejador, cfg) != 0) {
+        fprintf(stderr, "[ERRO] Eventos de mapa inválidos: %s\n", cfg->trajectory);
+        return EXIT_FAILURE;
+    }
+
+    // Gravação opcional das ativações das leis para reprodução (replay)
+    static ReplayRecorder gravacao;
+    ReplayRecorder *rec = NULL;
+    if (cfg->record_file[0] != '\0') {
+        if (replay_recorder_open(&gravacao, cfg->record_file, cfg) != 0) {
+            fprintf(stderr, "[ERRO] Gravação inválida: %s\n", cfg->record_file);
+            return EXIT_FAILURE;
+        }
+        rec = &gravacao;
+    }
+
+    // Monitores (a referência inclui o anel do horizonte, mantido fora da pilha)
     MonitorEstado estado;
     MonitorComando comando;
     MonitorLinearizacao linearizacao;
-    MonitorReferencia referencia;
+    static MonitorReferencia referencia;
     MonitorModeloRef modeloX, modeloY;
     MonitorParametros parametros;
     MonitorTempo tempo;
+    MonitorMetricas metricas;
+    static MonitorIdades idades;
+    static SnapshotHub global;  // Instantâneo global lido pelo registro, interface e métricas
 
     // Inicializa mutexes
     pthread_mutex_init(&estado.mutex, NULL);
@@ -43,52 +90,155 @@ int main() {
     pthread_mutex_init(&modeloY.mutex, NULL);
     pthread_mutex_init(&parametros.mutex, NULL);
     pthread_mutex_init(&tempo.mutex, NULL);
+    pthread_mutex_init(&metricas.mutex, NULL);
+    pthread_mutex_init(&idades.mutex, NULL);
+    snapshot_init(&global);
 
-    // Inicializa variáveis
+    // Inicializa variáveis (carimbos com seq = 0: nada publicado)
+    memset(&estado.carimbo, 0, sizeof(DataStamp));
+    memset(&comando.carimbo, 0, sizeof(DataStamp));
+    memset(&linearizacao.carimbo, 0, sizeof(DataStamp));
+    memset(&referencia.carimbo, 0, sizeof(DataStamp));
+    memset(&modeloX.carimbo, 0, sizeof(DataStamp));
+    memset(&modeloY.carimbo, 0, sizeof(DataStamp));
     estado.x1 = estado.x2 = estado.x3 = estado.y1 = estado.y2 = 0;
+    estado.xe3 = estado.ye1 = estado.ye2 = 0;
     comando.v1 = comando.v2 = 0;
     linearizacao.u1 = linearizacao.u2 = 0;
     referencia.xref = referencia.yref = 0;
+    referencia.dxref = referencia.dyref = 0;
+    ref_preview_init(&referencia.preview, cfg->preview_dt);
+    ref_preview_fill(&referencia.preview, &trajetoria, cfg->preview_horizon_s, data_age_now());  // Horizonte inicial
     modeloX.y_m = modeloX.dy_m = 0;
     modeloY.y_m = modeloY.dy_m = 0;
-    parametros.alpha1 = parametros.alpha2 = 3;
+    parametros.alpha1 = cfg->alpha1;
+    parametros.alpha2 = cfg->alpha2;
     tempo.tempo_atual = 0;
-    tempo.encerrar = 0;
+    metrics_init(&metricas.motor, cfg);
+    memset(&metricas.resumo, 0, sizeof(metricas.resumo));
+    tempo.intervalo = cfg->timer_interval_ms / 1000.0;
+    clock_gettime(CLOCK_MONOTONIC, &tempo.marca);
 
     // Structs de argumentos
-    ArgsSim sim_args         = { &estado, &linearizacao, &tempo };
-    ArgsLin lin_args         = { &estado, &comando, &linearizacao, &tempo };
-    ArgsCtrl ctrl_args       = { &estado, &modeloX, &modeloY, &parametros, &comando, &tempo };
-    ArgsModel modelx_args    = { &referencia, &modeloX, &parametros, &tempo };
-    ArgsModel modely_args    = { &referencia, &modeloY, &parametros, &tempo };
-    ArgsModel ref_args       = { &referencia, NULL, NULL, &tempo };
-    ArgsInterface intf_args  = { &parametros, &estado, &referencia, &tempo };
-    ArgsLogger logger_args   = { &estado, &referencia, &comando, &linearizacao, &tempo };
-
-    // Criação das threads
-    pthread_t th_sim, th_lin, th_ctrl, th_ref, th_mx, th_my, th_intf, th_log, th_timer;
-
-    pthread_create(&th_sim,   NULL, sim_thread,         &sim_args);
-    pthread_create(&th_lin,   NULL, linearization_thread, &lin_args);
-    pthread_create(&th_ctrl,  NULL, control_thread,     &ctrl_args);
-    pthread_create(&th_ref,   NULL, ref_generator_thread, &ref_args);
-    pthread_create(&th_mx,    NULL, model_ref_x_thread, &modelx_args);
-    pthread_create(&th_my,    NULL, model_ref_y_thread, &modely_args);
-    pthread_create(&th_intf,  NULL, interface_thread,   &intf_args);
-    pthread_create(&th_log,   NULL, logger_thread,      &logger_args);
-    pthread_create(&th_timer, NULL, timer_thread,       &tempo);
-
-    // Aguarda todas as threads
-    pthread_join(th_sim,   NULL);
-    pthread_join(th_lin,   NULL);
-    pthread_join(th_ctrl,  NULL);
-    pthread_join(th_ref,   NULL);
-    pthread_join(th_mx,    NULL);
-    pthread_join(th_my,    NULL);
-    pthread_join(th_intf,  NULL);
-    pthread_join(th_log,   NULL);
-    pthread_join(th_timer, NULL);
+    ArgsSim sim_args         = { &estado, &linearizacao, &tempo, cfg, &idades, &global, &referencia, NULL };
+    ArgsLin lin_args         = { &estado, &comando, &linearizacao, &tempo, cfg, rec, &idades };
+    ArgsCtrl ctrl_args       = { &estado, &modeloX, &modeloY, &parametros, &comando, &tempo, cfg,
+                                 &referencia, rec, &idades, &global, NULL, NULL, NULL };
+    ArgsModel modelx_args    = { &referencia, &modeloX, &parametros, &tempo, cfg, NULL, &global, NULL };
+    ArgsModel modely_args    = { &referencia, &modeloY, &parametros, &tempo, cfg, NULL, &global, NULL };
+    ArgsModel ref_args       = { &referencia, NULL, NULL, &tempo, cfg, &trajetoria, &global,
+                                 replanejador.n_events > 0 ? &replanejador : NULL };
+    ArgsInterface intf_args  = { &parametros, &estado, &referencia, &tempo, cfg, &metricas, &global };
+    static TelemetryWriter telemetria;
+    ArgsLogger logger_args   = { &estado, &referencia, &comando, &linearizacao, &tempo, cfg, &global,
+                                 &telemetria };
+    ArgsTimer timer_args     = { &tempo, cfg, NULL };
+    ArgsMetrics metrics_args = { &estado, &referencia, &modeloX, &modeloY, &comando,
+                                 &linearizacao, &metricas, &tempo, cfg, &global };
+
+    // Sensores e estimador de estado (estimator = none mantém o estado real)
+    static Estimator estimador;
+    RobotState pose_inicial = { 0 };
+    estimator_init(&estimador, cfg, &pose_inicial);
+    sim_args.est = &estimador;
+
+    // Ação integral da lei (integrais em fluxo, só a thread de controle as usa)
+    static IntegralAction integral;
+    integral_action_init(&integral);
+    ctrl_args.pi = &integral;
+
+    // Controlador preditivo opcional, com as áreas de trabalho alocadas antes da partida
+    static Mpc preditivo;
+    if (strcmp(cfg->controller, "mpc") == 0) {
+        if (mpc_init(&preditivo, cfg) != 0) {
+            fprintf(stderr, "[ERRO] Falha ao preparar o controlador preditivo\n");
+            return EXIT_FAILURE;
+        }
+        ctrl_args.mpc = &preditivo;
+    }
+
+    // LQR opcional: a equação de Riccati é resolvida na grade antes da partida
+    static Lqr regulador;
+    if (strcmp(cfg->controller, "lqr") == 0) {
+        if (lqr_init(&regulador, cfg) != 0) {
+            fprintf(stderr, "[ERRO] Falha ao montar a tabela de ganhos do LQR\n");
+            return EXIT_FAILURE;
+        }
+        ctrl_args.lqr = &regulador;
+    }
+
+    // O supervisor cria as tarefas e as libera juntas na ordem causal:
+    // relógio, checkpoint, referência, modelos, controle, linearização, robô
+    // e observadores
+    static Supervisor supervisor;
+    supervisor_init(&supervisor, cfg->watchdog_ms);
+    timer_args.sv = &supervisor;
+
+    // Checkpoint: as mesmas fontes servem à captura periódica e à restauração
+    static ArgsCheckpoint ckpt_args;
+    ckpt_args = (ArgsCheckpoint){ &estado, &comando, &linearizacao, &referencia, &modeloX, &modeloY,
+                                  &parametros, &tempo, &metricas, cfg, &estimador, &integral,
+                                  &supervisor, { 0 } };
+    if (cfg->restore_file[0] != '\0') {
+        static SystemCheckpoint partida;
+        if (checkpoint_load(&partida, cfg->restore_file) != 0) {
+            fprintf(stderr, "[ERRO] Checkpoint inválido: %s\n", cfg->restore_file);
+            return EXIT_FAILURE;
+        }
+        if (partida.tempo >= cfg->sim_time_s) {
+            fprintf(stderr, "[ERRO] O checkpoint (t=%.2f s) não é anterior ao fim do cenário (%.2f s)\n",
+                    partida.tempo, cfg->sim_time_s);
+            return EXIT_FAILURE;
+        }
+        checkpoint_restore(&ckpt_args, &partida, &trajetoria, &global);
+        printf("[INFO] Execução retomada de %s em t=%.2f s\n", cfg->restore_file, partida.tempo);
+    }
+
+    supervisor_add(&supervisor, "timer",         cfg->timer_interval_ms,   timer_thread,         &timer_args);
+    if (cfg->checkpoint_file[0] != '\0')
+        supervisor_add(&supervisor, "checkpoint", cfg->timer_interval_ms, checkpoint_thread, &ckpt_args);
+    supervisor_add(&supervisor, "referencia",    cfg->ref_period_ms,       ref_generator_thread, &ref_args);
+    supervisor_add(&supervisor, "modelo_x",      cfg->model_period_ms,     model_ref_x_thread,   &modelx_args);
+    supervisor_add(&supervisor, "modelo_y",      cfg->model_period_ms,     model_ref_y_thread,   &modely_args);
+    supervisor_add(&supervisor, "controle",      cfg->ctrl_period_ms,      control_thread,       &ctrl_args);
+    supervisor_add(&supervisor, "linearizacao",  cfg->lin_period_ms,       linearization_thread, &lin_args);
+    supervisor_add(&supervisor, "robo",          cfg->sim_period_ms,       sim_thread,           &sim_args);
+    supervisor_add(&supervisor, "metricas",      cfg->metrics_period_ms,   metrics_thread,       &metrics_args);
+    supervisor_add(&supervisor, "registro",      cfg->logger_period_ms,    logger_thread,        &logger_args);
+    supervisor_add(&supervisor, "interface",     cfg->interface_period_ms, interface_thread,     &intf_args);
+
+    // Executa até o fim do cenário e aguarda todas as tarefas
+    supervisor_run(&supervisor);
+    supervisor_print(&supervisor, stdout);
+
+    // Resumo final dos indicadores online
+    metrics_print(&metricas.resumo, stdout);
+
+    // Checkpoints gravados e custo das pausas
+    if (cfg->checkpoint_file[0] != '\0') checkpoint_print(&ckpt_args.stats, cfg->checkpoint_file, stdout);
+
+    // Vazão do registro e esperas da amostragem pelo disco
+    if (telemetria.capacity > 0) telemetry_print(&telemetria, cfg->output_csv, stdout);
+
+    // Distribuição da idade dos dados por caminho (sensor → atuação)
+    age_report_print(idades.caminhos, stdout);
+
+    // Distribuição dos tempos de resolução do preditivo
+    if (ctrl_args.mpc) {
+        mpc_timing_print(&preditivo.timing, cfg->ctrl_period_ms / 1000.0, stdout);
+        mpc_destroy(&preditivo);
+    }
+    if (ctrl_args.lqr) lqr_destroy(&regulador);
+
+    // Replanejamentos do segmento plan após os eventos de mapa
+    if (ref_args.replan) {
+        printf("Mapa: %d de %d eventos aplicados, %d replanejamentos pelo D* Lite\n", replanejador.next,
+               replanejador.n_events, replanejador.replans);
+        replanner_free(&replanejador);
+    }
 
+    if (rec) replay_recorder_close(rec);
+    trajectory_free(&trajetoria);
     printf("Simulação concluída com sucesso.\n");
     return 0;
 }
@@ -213,3 +213,115 @@ Matrix* multiply_matrices(const Matrix* m1, const Matrix* m2) {
     LOG_DEBUG("multiply_matrices - Saída: Matrizes multiplicadas com sucesso.\n");
     return result;
 }
+
+// Função para transpor uma matriz
+Matrix* transpose_matrix(const Matrix* matrix) {
+    if (matrix == NULL) {
+        LOG_ERROR_AND_EXIT("transpose_matrix - Erro: Matriz é NULL.\n");
+    }
+
+    LOG_DEBUG("transpose_matrix - Entrada: matrix(rows=%d, cols=%d)\n", matrix->rows, matrix->cols);
+
+    Matrix* result = create_matrix(matrix->cols, matrix->rows);
+    transpose_matrix_into(matrix, result);
+
+    LOG_DEBUG("transpose_matrix - Saída: Matriz transposta com sucesso.\n");
+    return result;
+}
+
+// ==========================
+// Operações sem alocação
+// ==========================
+
+// Função para multiplicar duas matrizes num destino pré-alocado
+void multiply_matrices_into(const Matrix* m1, const Matrix* m2, Matrix* out) {
+    if (m1->cols != m2->rows || out->rows != m1->rows || out->cols != m2->cols) {
+        LOG_ERROR_AND_EXIT("multiply_matrices_into - Erro: Dimensões incompatíveis (%dx%d * %dx%d -> %dx%d).\n",
+                           m1->rows, m1->cols, m2->rows, m2->cols, out->rows, out->cols);
+    }
+
+    // Ordem i-k-j: a linha de m2 e a de out são percorridas de forma contígua
+    for (int i = 0; i < m1->rows; i++) {
+        float* row = out->data[i];
+        for (int j = 0; j < out->cols; j++) row[j] = 0.0f;
+        for (int k = 0; k < m1->cols; k++) {
+            float a = m1->data[i][k];
+            if (a == 0.0f) continue;  // Aproveita matrizes esparsas (ex.: triangulares)
+            const float* b = m2->data[k];
+            for (int j = 0; j < out->cols; j++) row[j] += a * b[j];
+        }
+    }
+}
+
+// Função para transpor uma matriz num destino pré-alocado
+void transpose_matrix_into(const Matrix* matrix, Matrix* out) {
+    if (out->rows != matrix->cols || out->cols != matrix->rows) {
+        LOG_ERROR_AND_EXIT("transpose_matrix_into - Erro: Dimensões incompatíveis (%dx%d -> %dx%d).\n",
+                           matrix->rows, matrix->cols, out->rows, out->cols);
+    }
+
+    for (int i = 0; i < matrix->rows; i++)
+        for (int j = 0; j < matrix->cols; j++)
+            out->data[j][i] = matrix->data[i][j];
+}
+
+// Função para multiplicar uma matriz por um vetor
+void multiply_matrix_vector(const Matrix* matrix, const float* x, float* y) {
+    for (int i = 0; i < matrix->rows; i++) {
+        const float* row = matrix->data[i];
+        float acc = 0.0f;
+        for (int j = 0; j < matrix->cols; j++) acc += row[j] * x[j];
+        y[i] = acc;
+    }
+}
+
+// Função para fatorar uma matriz simétrica definida positiva (Cholesky)
+int cholesky_decompose(Matrix* matrix) {
+    if (matrix->rows != matrix->cols) {
+        LOG_ERROR_AND_EXIT("cholesky_decompose - Erro: Matriz não quadrada (%dx%d).\n",
+                           matrix->rows, matrix->cols);
+    }
+
+    float** a = matrix->data;
+    int n = matrix->rows;
+    for (int j = 0; j < n; j++) {
+        // Pivô: a[j][j] - Σ L[j][k]² (acumulado em double para reduzir o erro)
+        double d = a[j][j];
+        for (int k = 0; k < j; k++) d -= (double)a[j][k] * a[j][k];
+        if (d <= 0.0) return -1;
+        float ljj = (float)sqrt(d);
+        a[j][j] = ljj;
+
+        for (int i = j + 1; i < n; i++) {
+            double s = a[i][j];
+            for (int k = 0; k < j; k++) s -= (double)a[i][k] * a[j][k];
+            a[i][j] = (float)(s / ljj);
+        }
+    }
+
+    // Zera o triângulo superior para que a matriz seja exatamente L
+    for (int i = 0; i < n; i++)
+        for (int j = i + 1; j < n; j++)
+            a[i][j] = 0.0f;
+    return 0;
+}
+
+// Função para resolver L Lᵀ x = b por substituições direta e inversa
+void cholesky_solve(const Matrix* L, const float* b, float* x) {
+    float** l = L->data;
+    int n = L->rows;
+
+    // L z = b
+    for (int i = 0; i < n; i++) {
+        float s = b[i];
+        for (int k = 0; k < i; k++) s -= l[i][k] * x[k];
+        x[i] = s / l[i][i];
+    }
+
+    // Lᵀ x = z
+    for (int i = n - 1; i >= 0; i--) {
+        float s = x[i];
+        for (int k = i + 1; k < n; k++) s -= l[k][i] * x[k];
+        x[i] = s / l[i][i];
+    }
+}
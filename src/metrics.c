@@ -0,0 +1,119 @@
+/*
+    FILE: metrics.c
+    DESCRIPTION:
+        Implementa o motor de indicadores em fluxo (metrics.h).
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <math.h>
+#include <string.h>
+#include "metrics.h"
+
+// Tolerância relativa para considerar um sinal saturado (a saturação devolve o limite exato)
+#define SAT_TOL 1e-9
+
+enum { SAT_V1, SAT_V2, SAT_U1, SAT_U2, SAT_V, SAT_U };
+
+void metrics_init(Metrics *m, const ScenarioConfig *cfg) {
+    memset(m, 0, sizeof(*m));
+    m->v_lim[0] = cfg->v_max * (1.0 - SAT_TOL);
+    m->v_lim[1] = cfg->w_max * (1.0 - SAT_TOL);
+    m->u_lim[0] = cfg->u1_max * (1.0 - SAT_TOL);
+    m->u_lim[1] = cfg->u2_max * (1.0 - SAT_TOL);
+    m->settle_band = cfg->settle_band;
+    sliding_integral_init(&m->recent_ise, INTEGRAL_TRAPEZOID, cfg->metrics_window_s);
+}
+
+void metrics_update(Metrics *m, const MetricsSample *s, double dt) {
+    // Erro de rastreamento
+    double ex = s->xref - s->y1;
+    double ey = s->yref - s->y2;
+    double e2 = ex * ex + ey * ey;
+    double e = sqrt(e2);
+    m->ise += e2 * dt;
+    m->iae += e * dt;
+    m->itae += s->t * e * dt;
+    sliding_integral_add(&m->recent_ise, s->t, e2);
+    if (e > m->max_error) m->max_error = e;
+
+    // Erro do modelo de referência
+    double mx = s->ymx - s->y1;
+    double my = s->ymy - s->y2;
+    double m2 = mx * mx + my * my;
+    m->model_ise += m2 * dt;
+    if (m2 > m->model_max * m->model_max) m->model_max = sqrt(m2);
+
+    // Esforço de controle
+    m->effort_v += (s->v1 * s->v1 + s->v2 * s->v2) * dt;
+    m->effort_u += (s->u1 * s->u1 + s->u2 * s->u2) * dt;
+
+    // Ciclo de saturação
+    int sv1 = fabs(s->v1) >= m->v_lim[0], sv2 = fabs(s->v2) >= m->v_lim[1];
+    int su1 = fabs(s->u1) >= m->u_lim[0], su2 = fabs(s->u2) >= m->u_lim[1];
+    m->sat_time[SAT_V1] += sv1 * dt;
+    m->sat_time[SAT_V2] += sv2 * dt;
+    m->sat_time[SAT_U1] += su1 * dt;
+    m->sat_time[SAT_U2] += su2 * dt;
+    m->sat_time[SAT_V] += (sv1 | sv2) * dt;
+    m->sat_time[SAT_U] += (su1 | su2) * dt;
+
+    // Acomodação: último instante em que o erro esteve fora da faixa
+    if (e > m->settle_band) {
+        m->last_outside = s->t + dt;
+        m->ever_outside = 1;
+    }
+
+    m->final_error = e;
+    m->duration += dt;
+    m->samples++;
+}
+
+void metrics_summary(const Metrics *m, MetricsSummary *out) {
+    double T = m->duration;
+    double inv_T = T > 0 ? 1.0 / T : 0.0;
+
+    out->duration = T;
+    out->samples = m->samples;
+    out->ise = m->ise;
+    out->iae = m->iae;
+    out->itae = m->itae;
+    out->rms_error = sqrt(m->ise * inv_T);
+    out->max_error = m->max_error;
+    out->recent_span = sliding_integral_span(&m->recent_ise);
+    out->recent_rms = out->recent_span > 0
+                    ? sqrt(sliding_integral_value(&m->recent_ise) / out->recent_span) : 0.0;
+    out->model_rms = sqrt(m->model_ise * inv_T);
+    out->model_max = m->model_max;
+    out->effort_v = m->effort_v;
+    out->effort_u = m->effort_u;
+    out->duty_v1 = m->sat_time[SAT_V1] * inv_T;
+    out->duty_v2 = m->sat_time[SAT_V2] * inv_T;
+    out->duty_u1 = m->sat_time[SAT_U1] * inv_T;
+    out->duty_u2 = m->sat_time[SAT_U2] * inv_T;
+    out->duty_v = m->sat_time[SAT_V] * inv_T;
+    out->duty_u = m->sat_time[SAT_U] * inv_T;
+    out->final_error = m->final_error;
+
+    // Acomodado se a última amostra está dentro da faixa
+    if (m->samples == 0 || m->final_error > m->settle_band) out->settling_time = -1.0;
+    else out->settling_time = m->ever_outside ? m->last_outside : 0.0;
+}
+
+void metrics_print(const MetricsSummary *s, FILE *out) {
+    fprintf(out, "[MÉTRICAS] %.2f s, %ld amostras\n", s->duration, s->samples);
+    fprintf(out, "  Rastreamento |ref - y|: RMS=%.4f  máx=%.4f  final=%.4f\n",
+            s->rms_error, s->max_error, s->final_error);
+    fprintf(out, "  RMS recente (últimos %.2f s): %.4f\n", s->recent_span, s->recent_rms);
+    fprintf(out, "  Integrais: ISE=%.4f  IAE=%.4f  ITAE=%.4f\n", s->ise, s->iae, s->itae);
+    fprintf(out, "  Modelo |y_m - y|: RMS=%.4f  máx=%.4f\n", s->model_rms, s->model_max);
+    fprintf(out, "  Esforço: ∫|v|²=%.4f  ∫|u|²=%.4f\n", s->effort_v, s->effort_u);
+    fprintf(out, "  Saturação: v1=%.1f%%  v2=%.1f%%  u1=%.1f%%  u2=%.1f%%  (v=%.1f%%, u=%.1f%%)\n",
+            100 * s->duty_v1, 100 * s->duty_v2, 100 * s->duty_u1, 100 * s->duty_u2,
+            100 * s->duty_v, 100 * s->duty_u);
+    if (s->settling_time >= 0)
+        fprintf(out, "  Tempo de acomodação: %.2f s\n", s->settling_time);
+    else
+        fprintf(out, "  Tempo de acomodação: não acomodou\n");
+}
@@ -0,0 +1,70 @@
+/*
+    FILE: metrics_thread.c
+    DESCRIPTION:
+        Implementa a thread de indicadores online: a cada período lê os
+        monitores, incorpora a amostra ao motor de métricas (O(1), sem
+        alocação) e publica o resumo atualizado no monitor de métricas,
+        disponível ao vivo para a interface e, no encerramento, para main.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include <time.h>
+#include "monitors.h"  // Para acessar dados compartilhados entre threads
+#include "threads.h"   // Protótipos das threads e dos corpos das ativações
+#include "logs.h"      // Para log de eventos
+#include "metrics.h"   // Motor de indicadores em fluxo
+
+/* Corpo de uma ativação: incorpora uma amostra e publica o resumo (sem espera) */
+void metrics_step(ArgsMetrics *args, Metrics *metrics) {
+    double dt = args->cfg->metrics_period_ms / 1000.0;  // Intervalo de tempo em segundos
+
+    // Sinais e referência do mesmo tick de simulação, sem travas (instantâneo global)
+    const SystemSnapshot *g = snapshot_acquire(args->g, SNAPSHOT_METRICS);
+    MetricsSample s;
+    s.t = g->t;
+    s.xref = g->xref;
+    s.yref = g->yref;
+    s.y1 = g->y1;
+    s.y2 = g->y2;
+    s.ymx = g->ymx;
+    s.ymy = g->ymy;
+    s.v1 = g->v1;
+    s.v2 = g->v2;
+    s.u1 = g->u1;
+    s.u2 = g->u2;
+
+    metrics_update(metrics, &s, dt);
+
+    // Publica o resumo ao vivo
+    MetricsSummary resumo;
+    metrics_summary(metrics, &resumo);
+    pthread_mutex_lock(&args->m->mutex);
+    args->m->resumo = resumo;
+    pthread_mutex_unlock(&args->m->mutex);
+}
+
+/* Função da thread de indicadores online */
+void *metrics_thread(void *arg) {
+    ArgsMetrics *args = (ArgsMetrics *)arg;
+    const ScenarioConfig *cfg = args->cfg;  // Período da amostragem
+
+    LOG_DEBUG("Thread de métricas iniciada.\n");
+
+    // Aguarda a partida comum liberada pelo supervisor
+    struct timespec next_activation;
+    int ativo = supervisor_start(&next_activation);
+
+    while (ativo) {
+        // Corpo da ativação (isolado da espera para benchmarks)
+        metrics_step(args, &args->m->motor);
+
+        // Dorme até o próximo período (o encerramento acorda a thread imediatamente)
+        supervisor_advance(&next_activation, cfg->metrics_period_ms);
+        ativo = supervisor_sleep_until(&next_activation);
+    }
+
+    pthread_exit(NULL);  // Encerra a thread
+}
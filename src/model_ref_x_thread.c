@@ -8,72 +8,82 @@
     LICENSE: CC BY-SA
 */
 
-#define _POSIX_C_SOURCE 199309L
+#define _POSIX_C_SOURCE 200112L
 #include <time.h>
 #include <unistd.h>
 #include "monitors.h"  // Para acessar dados compartilhados entre threads
+#include "threads.h"   // Protótipos das threads e dos corpos das ativações
 #include "logs.h"      // Para log de eventos
+#include "control_law.h" // Modelo de referência de 1ª ordem
 
-#define PERIOD_MS 50  // Período de execução da thread em ms
+/* Corpo de uma ativação: integra o modelo de referência X por um período (sem espera) */
+void model_ref_x_step(ArgsModel *args) {
+    double dt = args->cfg->model_period_ms / 1000.0;  // Intervalo de tempo em segundos
 
-/* Função da thread de modelo de referência na direção X */
-void *model_ref_x_thread(void *arg) {
-    ArgsModel *args = (ArgsModel *)arg;
+    // Referência xref interpolada no horizonte publicado, no instante exato desta ativação
+    // (a origem da referência é a última ativação do gerador que confirmou o horizonte)
+    double xref;
+    double agora = data_age_now();
+    double origem[DATA_SOURCES];
+    data_stamp_begin(origem);
+    RefPreviewSample amostra;
+    if (ref_preview_sample(&args->r->preview, monitor_tempo_exato(args->t), &amostra) == 0) {
+        xref = amostra.x;
+        origem[DATA_SRC_REFERENCIA] = amostra.publicado;
+    } else {
+        pthread_mutex_lock(&args->r->mutex);
+        xref = args->r->xref;
+        data_stamp_merge(origem, &args->r->carimbo);
+        pthread_mutex_unlock(&args->r->mutex);
+    }
 
-    LOG_DEBUG("Thread modelo de referência X iniciada.\n");
+    // Leitura do modelo de referência (y_m)
+    double ymx;
+    pthread_mutex_lock(&args->m->mutex);
+    ymx = args->m->y_m;
+    pthread_mutex_unlock(&args->m->mutex);
 
-    struct timespec next_activation;
-    clock_gettime(CLOCK_MONOTONIC, &next_activation);  // Define o tempo inicial
+    // Leitura do parâmetro α1
+    double alpha1;
+    pthread_mutex_lock(&args->p->mutex);
+    alpha1 = args->p->alpha1;
+    pthread_mutex_unlock(&args->p->mutex);
 
-    double dt = PERIOD_MS / 1000.0;  // Intervalo de tempo em segundos
+    // Cálculo da variação do modelo de referência (dymx) e integração
+    double dymx;
+    model_ref_step(xref, alpha1, dt, &ymx, &dymx);  // Derivada e integração de Euler
 
-    while (1) {
-        // Verifica se o sistema deve ser encerrado
-        pthread_mutex_lock(&args->t->mutex);
-        if (args->t->encerrar) {
-            pthread_mutex_unlock(&args->t->mutex);
-            pthread_exit(NULL);  // Encerra a thread se a flag 'encerrar' for setada
-        }
-        pthread_mutex_unlock(&args->t->mutex);
+    // Atualiza o modelo de referência
+    pthread_mutex_lock(&args->m->mutex);
+    args->m->y_m = ymx;
+    args->m->dy_m = dymx;
+    data_stamp_publish(&args->m->carimbo, origem, agora);
+    pthread_mutex_unlock(&args->m->mutex);
 
-        // Leitura da referência de posição xref
-        double xref;
-        pthread_mutex_lock(&args->r->mutex);
-        xref = args->r->xref;
-        pthread_mutex_unlock(&args->r->mutex);
+    snapshot_post(args->g, SNAPSHOT_SRC_MODELO_X, ymx, 0.0);  // Lido pelo próximo tick do robô
 
-        // Leitura do modelo de referência (y_m)
-        double ymx;
-        pthread_mutex_lock(&args->m->mutex);
-        ymx = args->m->y_m;
-        pthread_mutex_unlock(&args->m->mutex);
+    // Log de depuração com os valores calculados
+    LOG_DEBUG("Modelo X: xref=%.2f, ymx=%.2f, dymx=%.2f\n", xref, ymx, dymx);
+}
 
-        // Leitura do parâmetro α1
-        double alpha1;
-        pthread_mutex_lock(&args->p->mutex);
-        alpha1 = args->p->alpha1;
-        pthread_mutex_unlock(&args->p->mutex);
+/* Função da thread de modelo de referência na direção X */
+void *model_ref_x_thread(void *arg) {
+    ArgsModel *args = (ArgsModel *)arg;
+    const ScenarioConfig *cfg = args->cfg;  // Período de integração do modelo
 
-        // Cálculo da variação do modelo de referência (dymx) e integração
-        double dymx = alpha1 * (xref - ymx);  // Derivada do modelo
-        ymx += dymx * dt;  // Integração para atualizar o valor de ymx
+    LOG_DEBUG("Thread modelo de referência X iniciada.\n");
 
-        // Atualiza o modelo de referência
-        pthread_mutex_lock(&args->m->mutex);
-        args->m->y_m = ymx;
-        args->m->dy_m = dymx;
-        pthread_mutex_unlock(&args->m->mutex);
+    // Aguarda a partida comum liberada pelo supervisor
+    struct timespec next_activation;
+    int ativo = supervisor_start(&next_activation);
 
-        // Log de depuração com os valores calculados
-        LOG_DEBUG("Modelo X: xref=%.2f, ymx=%.2f, dymx=%.2f\n", xref, ymx, dymx);
+    while (ativo) {
+        // Corpo da ativação (isolado da espera para benchmarks)
+        model_ref_x_step(args);
 
-        // Dorme até o próximo período de amostragem
-        next_activation.tv_nsec += PERIOD_MS * 1e6;
-        while (next_activation.tv_nsec >= 1e9) {
-            next_activation.tv_sec++;
-            next_activation.tv_nsec -= 1e9;
-        }
-        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_activation, NULL);
+        // Dorme até o próximo período (o encerramento acorda a thread imediatamente)
+        supervisor_advance(&next_activation, cfg->model_period_ms);
+        ativo = supervisor_sleep_until(&next_activation);
     }
 
     pthread_exit(NULL);  // Encerra a thread
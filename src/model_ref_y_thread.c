@@ -8,72 +8,82 @@
     LICENSE: CC BY-SA
 */
 
-#define _POSIX_C_SOURCE 199309L
+#define _POSIX_C_SOURCE 200112L
 #include <time.h>
 #include <unistd.h>
 #include "monitors.h"  // Para acessar dados compartilhados entre threads
+#include "threads.h"   // Protótipos das threads e dos corpos das ativações
 #include "logs.h"      // Para log de eventos
+#include "control_law.h" // Modelo de referência de 1ª ordem
 
-#define PERIOD_MS 50  // Período de execução da thread em ms
+/* Corpo de uma ativação: integra o modelo de referência Y por um período (sem espera) */
+void model_ref_y_step(ArgsModel *args) {
+    double dt = args->cfg->model_period_ms / 1000.0;  // Intervalo de tempo em segundos
 
-/* Função da thread de modelo de referência na direção Y */
-void *model_ref_y_thread(void *arg) {
-    ArgsModel *args = (ArgsModel *)arg;
+    // Referência yref interpolada no horizonte publicado, no instante exato desta ativação
+    // (a origem da referência é a última ativação do gerador que confirmou o horizonte)
+    double yref;
+    double agora = data_age_now();
+    double origem[DATA_SOURCES];
+    data_stamp_begin(origem);
+    RefPreviewSample amostra;
+    if (ref_preview_sample(&args->r->preview, monitor_tempo_exato(args->t), &amostra) == 0) {
+        yref = amostra.y;
+        origem[DATA_SRC_REFERENCIA] = amostra.publicado;
+    } else {
+        pthread_mutex_lock(&args->r->mutex);
+        yref = args->r->yref;
+        data_stamp_merge(origem, &args->r->carimbo);
+        pthread_mutex_unlock(&args->r->mutex);
+    }
 
-    LOG_DEBUG("Thread modelo de referência Y iniciada.\n");
+    // Leitura do modelo de referência (ymy)
+    double ymy;
+    pthread_mutex_lock(&args->m->mutex);
+    ymy = args->m->y_m;
+    pthread_mutex_unlock(&args->m->mutex);
 
-    struct timespec next_activation;
-    clock_gettime(CLOCK_MONOTONIC, &next_activation);  // Define o tempo inicial
+    // Leitura do parâmetro α2
+    double alpha2;
+    pthread_mutex_lock(&args->p->mutex);
+    alpha2 = args->p->alpha2;
+    pthread_mutex_unlock(&args->p->mutex);
 
-    double dt = PERIOD_MS / 1000.0;  // Intervalo de tempo em segundos
+    // Cálculo da variação do modelo de referência (dymy) e integração
+    double dymy;
+    model_ref_step(yref, alpha2, dt, &ymy, &dymy);  // Derivada e integração de Euler
 
-    while (1) {
-        // Verifica se o sistema deve ser encerrado
-        pthread_mutex_lock(&args->t->mutex);
-        if (args->t->encerrar) {
-            pthread_mutex_unlock(&args->t->mutex);
-            pthread_exit(NULL);  // Encerra a thread se a flag 'encerrar' for setada
-        }
-        pthread_mutex_unlock(&args->t->mutex);
+    // Atualiza o modelo de referência Y
+    pthread_mutex_lock(&args->m->mutex);
+    args->m->y_m = ymy;
+    args->m->dy_m = dymy;
+    data_stamp_publish(&args->m->carimbo, origem, agora);
+    pthread_mutex_unlock(&args->m->mutex);
 
-        // Leitura da referência de posição yref
-        double yref;
-        pthread_mutex_lock(&args->r->mutex);
-        yref = args->r->yref;
-        pthread_mutex_unlock(&args->r->mutex);
+    snapshot_post(args->g, SNAPSHOT_SRC_MODELO_Y, ymy, 0.0);  // Lido pelo próximo tick do robô
 
-        // Leitura do modelo de referência (ymy)
-        double ymy;
-        pthread_mutex_lock(&args->m->mutex);
-        ymy = args->m->y_m;
-        pthread_mutex_unlock(&args->m->mutex);
+    // Log de depuração com os valores calculados
+    LOG_DEBUG("Modelo Y: yref=%.2f, ymy=%.2f, dymy=%.2f\n", yref, ymy, dymy);
+}
 
-        // Leitura do parâmetro α2
-        double alpha2;
-        pthread_mutex_lock(&args->p->mutex);
-        alpha2 = args->p->alpha2;
-        pthread_mutex_unlock(&args->p->mutex);
+/* Função da thread de modelo de referência na direção Y */
+void *model_ref_y_thread(void *arg) {
+    ArgsModel *args = (ArgsModel *)arg;
+    const ScenarioConfig *cfg = args->cfg;  // Período de integração do modelo
 
-        // Cálculo da variação do modelo de referência (dymy) e integração
-        double dymy = alpha2 * (yref - ymy);  // Derivada do modelo
-        ymy += dymy * dt;  // Integração para atualizar o valor de ymy
+    LOG_DEBUG("Thread modelo de referência Y iniciada.\n");
 
-        // Atualiza o modelo de referência Y
-        pthread_mutex_lock(&args->m->mutex);
-        args->m->y_m = ymy;
-        args->m->dy_m = dymy;
-        pthread_mutex_unlock(&args->m->mutex);
+    // Aguarda a partida comum liberada pelo supervisor
+    struct timespec next_activation;
+    int ativo = supervisor_start(&next_activation);
 
-        // Log de depuração com os valores calculados
-        LOG_DEBUG("Modelo Y: yref=%.2f, ymy=%.2f, dymy=%.2f\n", yref, ymy, dymy);
+    while (ativo) {
+        // Corpo da ativação (isolado da espera para benchmarks)
+        model_ref_y_step(args);
 
-        // Dorme até o próximo período de amostragem
-        next_activation.tv_nsec += PERIOD_MS * 1e6;
-        while (next_activation.tv_nsec >= 1e9) {
-            next_activation.tv_sec++;
-            next_activation.tv_nsec -= 1e9;
-        }
-        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_activation, NULL);
+        // Dorme até o próximo período (o encerramento acorda a thread imediatamente)
+        supervisor_advance(&next_activation, cfg->model_period_ms);
+        ativo = supervisor_sleep_until(&next_activation);
     }
 
     pthread_exit(NULL);  // Encerra a thread
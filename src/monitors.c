@@ -0,0 +1,28 @@
+/*
+    FILE: monitors.c
+    DESCRIPTION:
+        Funções auxiliares de acesso aos monitores compartilhados.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include <time.h>
+#include "monitors.h"
+
+double monitor_tempo_exato(MonitorTempo *t) {
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+
+    pthread_mutex_lock(&t->mutex);
+    double base = t->tempo_atual;
+    double decorrido = (agora.tv_sec - t->marca.tv_sec) + (agora.tv_nsec - t->marca.tv_nsec) / 1e9;
+    double intervalo = t->intervalo;
+    pthread_mutex_unlock(&t->mutex);
+
+    // Entre duas atualizações do relógio o tempo avança com o tempo de parede
+    if (decorrido < 0.0) decorrido = 0.0;
+    if (decorrido > intervalo) decorrido = intervalo;
+    return base + decorrido;
+}
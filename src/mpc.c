@@ -0,0 +1,272 @@
+/*
+    FILE: mpc.c
+    DESCRIPTION:
+        Implementa o controlador preditivo (mpc.h): montagem da formulação
+        condensada sobre o módulo de matrizes, QP com restrições de caixa
+        resolvido por ADMM com partida a quente e o histograma dos tempos
+        de resolução.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include <string.h>
+#include <time.h>
+#include "mpc.h"
+#include "autodiff.h"
+
+#define ADMM_ALPHA 1.6f   // Sobrerrelaxação do ADMM (1 desativa)
+#define BAR_WIDTH 40      // Largura máxima das barras do histograma
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Jacobiana da velocidade da saída em relação a u, ∂ẏ/∂u = C B (autodiff.h) */
+static void output_jacobian(double theta, double R, double By[2][2]) {
+    UnicycleJacobians J;
+    const double x[3] = { 0.0, 0.0, theta }, u[2] = { 0.0, 0.0 };
+    ad_unicycle(x, u, R, &J);
+    for (int i = 0; i < 2; i++)
+        for (int k = 0; k < 2; k++)
+            By[i][k] = J.C[i][0] * J.B[0][k] + J.C[i][1] * J.B[1][k] + J.C[i][2] * J.B[2][k];
+}
+
+static float clampf(float value, float limit) {
+    if (value > limit) return limit;
+    if (value < -limit) return -limit;
+    return value;
+}
+
+/* Registra o tempo de uma resolução */
+static void timing_add(MpcTiming *t, double seconds, int iterations, int converged) {
+    double bin = seconds * 1e6 / MPC_BIN_US;
+    if (bin < MPC_BINS) t->counts[(int)bin]++;
+    else t->overflow++;
+    t->n++;
+    t->iterations += (unsigned long)iterations;
+    if (!converged) t->unconverged++;
+    t->sum += seconds;
+    if (seconds > t->max) t->max = seconds;
+}
+
+/* Quantil q a partir das faixas (limite superior da faixa, em s) */
+static double timing_quantile(const MpcTiming *t, double q) {
+    unsigned long target = (unsigned long)(q * t->n);
+    unsigned long acc = 0;
+    for (int i = 0; i < MPC_BINS; i++) {
+        acc += t->counts[i];
+        if (acc > target) return fmin((i + 1) * MPC_BIN_US * 1e-6, t->max);
+    }
+    return t->max;
+}
+
+// ==========================
+// Funções públicas
+// ==========================
+
+int mpc_init(Mpc *mpc, const ScenarioConfig *cfg) {
+    memset(mpc, 0, sizeof(*mpc));
+    mpc->n = cfg->mpc_horizon;
+    mpc->nu = 2 * mpc->n;
+    mpc->dt = cfg->ctrl_period_ms / 1000.0;
+    mpc->R = cfg->R;
+    mpc->q = (float)cfg->mpc_q;
+    mpc->r = (float)cfg->mpc_r;
+    mpc->umax[0] = (float)cfg->u1_max;
+    mpc->umax[1] = (float)cfg->u2_max;
+    mpc->max_iter = cfg->mpc_max_iter;
+    mpc->tol = (float)cfg->mpc_tol;
+
+    // Γ começa nula: os blocos acima da diagonal nunca são escritos
+    int nu = mpc->nu;
+    mpc->G = create_matrix_zeros(nu, nu);
+    mpc->Gt = create_matrix(nu, nu);
+    mpc->K = create_matrix(nu, nu);
+    float *buf = calloc(6 * (size_t)nu, sizeof(float));
+    mpc->theta = calloc((size_t)mpc->n, sizeof(double));
+    if (!mpc->G || !mpc->Gt || !mpc->K || !buf || !mpc->theta) {
+        free(buf);
+        mpc_destroy(mpc);
+        LOG_ERROR("Falha ao alocar o controlador preditivo (horizonte %d)\n", mpc->n);
+        return -1;
+    }
+    mpc->e0 = buf;
+    mpc->g = buf + nu;
+    mpc->x = buf + 2 * nu;
+    mpc->z = buf + 3 * nu;
+    mpc->w = buf + 4 * nu;
+    mpc->rhs = buf + 5 * nu;
+
+    LOG_DEBUG("MPC: horizonte %d x %.3f s, %d variáveis, q=%g r=%g\n",
+              mpc->n, mpc->dt, nu, cfg->mpc_q, cfg->mpc_r);
+    return 0;
+}
+
+void mpc_reset(Mpc *mpc) {
+    mpc->warm = 0;
+}
+
+int mpc_solve(Mpc *mpc, double y1, double y2, double theta,
+              const double *xref, const double *yref,
+              double *u1, double *u2, double *v1, double *v2) {
+    double t0 = now_s();
+    int n = mpc->n, nu = mpc->nu;
+    float *z = mpc->z, *w = mpc->w, *x = mpc->x, *g = mpc->g;
+
+    // Partida a quente: a solução e os duais anteriores avançam um passo
+    // (o último bloco é repetido); sem solução anterior, parte do zero
+    if (mpc->warm) {
+        memmove(z, z + 2, (size_t)(nu - 2) * sizeof(float));
+        memmove(w, w + 2, (size_t)(nu - 2) * sizeof(float));
+    } else {
+        memset(z, 0, (size_t)nu * sizeof(float));
+        memset(w, 0, (size_t)nu * sizeof(float));
+    }
+
+    // θ previsto com os u2 do plano deslocado (linearização variante no tempo)
+    mpc->theta[0] = theta;
+    for (int k = 0; k + 1 < n; k++) mpc->theta[k + 1] = mpc->theta[k] + mpc->dt * z[2 * k + 1];
+
+    // Γ: o bloco (k, j) vale dt B(θj) para j <= k, com B = ∂ẏ/∂u
+    float **G = mpc->G->data;
+    for (int j = 0; j < n; j++) {
+        double By[2][2];
+        output_jacobian(mpc->theta[j], mpc->R, By);
+        float b00 = (float)(mpc->dt * By[0][0]), b01 = (float)(mpc->dt * By[0][1]);
+        float b10 = (float)(mpc->dt * By[1][0]), b11 = (float)(mpc->dt * By[1][1]);
+        for (int k = j; k < n; k++) {
+            G[2 * k][2 * j] = b00;
+            G[2 * k][2 * j + 1] = b01;
+            G[2 * k + 1][2 * j] = b10;
+            G[2 * k + 1][2 * j + 1] = b11;
+        }
+    }
+
+    // H = q ΓᵀΓ + r I; ρ acompanha a escala média da diagonal
+    transpose_matrix_into(mpc->G, mpc->Gt);
+    multiply_matrices_into(mpc->Gt, mpc->G, mpc->K);
+    float **K = mpc->K->data;
+    float trace = 0.0f;
+    for (int i = 0; i < nu; i++) {
+        for (int j = 0; j < nu; j++) K[i][j] *= mpc->q;
+        K[i][i] += mpc->r;
+        trace += K[i][i];
+    }
+    float rho = trace / nu;
+    if (mpc->warm && mpc->rho > 0.0f) {
+        // w é o dual escalado (y / ρ): muda de escala junto com ρ
+        float ratio = mpc->rho / rho;
+        for (int i = 0; i < nu; i++) w[i] *= ratio;
+    }
+    mpc->rho = rho;
+    for (int i = 0; i < nu; i++) K[i][i] += rho;
+
+    int iterations = 0, converged = 0;
+    if (cholesky_decompose(mpc->K) != 0) {
+        // Não ocorre com r > 0 (H + ρI é definida positiva); por segurança, comando nulo
+        LOG_ERROR("MPC: fatoração de Cholesky falhou\n");
+        memset(z, 0, (size_t)nu * sizeof(float));
+        mpc->warm = 0;
+    } else {
+        // g = q Γᵀ (Y0 - Yref)
+        for (int k = 0; k < n; k++) {
+            mpc->e0[2 * k] = (float)(y1 - xref[k]);
+            mpc->e0[2 * k + 1] = (float)(y2 - yref[k]);
+        }
+        multiply_matrix_vector(mpc->Gt, mpc->e0, g);
+        for (int i = 0; i < nu; i++) g[i] *= mpc->q;
+
+        // ADMM: x = (H + ρI)^-1 (ρ(z - w) - g), z = proj(x + w), w += x - z
+        while (iterations < mpc->max_iter) {
+            iterations++;
+            for (int i = 0; i < nu; i++) mpc->rhs[i] = rho * (z[i] - w[i]) - g[i];
+            cholesky_solve(mpc->K, mpc->rhs, x);
+
+            float primal = 0.0f, dual = 0.0f;
+            for (int i = 0; i < nu; i++) {
+                float xr = ADMM_ALPHA * x[i] + (1.0f - ADMM_ALPHA) * z[i];
+                float zn = clampf(xr + w[i], mpc->umax[i & 1]);
+                w[i] += xr - zn;
+                primal = fmaxf(primal, fabsf(x[i] - zn));
+                dual = fmaxf(dual, fabsf(zn - z[i]));
+                z[i] = zn;
+            }
+            if (primal < mpc->tol && rho * dual < mpc->tol) {
+                converged = 1;
+                break;
+            }
+        }
+        mpc->warm = 1;
+    }
+
+    // Primeiro comando (z já respeita os limites) e o v = ẏ que a linearização inverte
+    double By[2][2];
+    output_jacobian(theta, mpc->R, By);
+    *u1 = z[0];
+    *u2 = z[1];
+    *v1 = By[0][0] * *u1 + By[0][1] * *u2;
+    *v2 = By[1][0] * *u1 + By[1][1] * *u2;
+
+    mpc->last_iter = iterations;
+    timing_add(&mpc->timing, now_s() - t0, iterations, converged);
+    return iterations;
+}
+
+void mpc_destroy(Mpc *mpc) {
+    destroy_matrix(mpc->G);
+    destroy_matrix(mpc->Gt);
+    destroy_matrix(mpc->K);
+    free(mpc->e0);  // Início do bloco dos vetores
+    free(mpc->theta);
+    mpc->G = mpc->Gt = mpc->K = NULL;
+    mpc->e0 = NULL;
+    mpc->theta = NULL;
+}
+
+void mpc_timing_print(const MpcTiming *t, double period_s, FILE *out) {
+    fprintf(out, "Controle preditivo (MPC): %lu resoluções, %.1f iterações em média, %lu sem convergir\n",
+            t->n, t->n ? (double)t->iterations / t->n : 0.0, t->unconverged);
+    if (t->n == 0) return;
+
+    fprintf(out, "  tempo (µs)   média      p50      p90      p99      máx  (máx = %.2f%% do período)\n",
+            100.0 * t->max / period_s);
+    fprintf(out, "             %8.1f %8.1f %8.1f %8.1f %8.1f\n",
+            t->sum / t->n * 1e6, timing_quantile(t, 0.50) * 1e6, timing_quantile(t, 0.90) * 1e6,
+            timing_quantile(t, 0.99) * 1e6, t->max * 1e6);
+
+    // Faixas agrupadas em potências de 2 de MPC_BIN_US: [0,1), [1,2), [2,4), ...
+    enum { ROWS = 13 };  // 2^12 = MPC_BINS
+    unsigned long rows[ROWS] = { 0 };
+    for (int i = 0; i < MPC_BINS; i++) {
+        int r = 0;
+        while (r + 1 < ROWS && (1 << r) <= i) r++;
+        rows[r] += t->counts[i];
+    }
+    int first = 0, last = ROWS - 1;
+    while (first < ROWS && rows[first] == 0) first++;
+    while (last > first && rows[last] == 0) last--;
+    unsigned long peak = t->overflow;
+    for (int r = first; r <= last; r++)
+        if (rows[r] > peak) peak = rows[r];
+
+    char bar[BAR_WIDTH + 1];
+    for (int r = first; r <= last && r < ROWS; r++) {
+        int lo = r == 0 ? 0 : 1 << (r - 1);
+        int hi = 1 << r;
+        int len = (int)((double)rows[r] / peak * BAR_WIDTH + 0.5);
+        memset(bar, '#', (size_t)len);
+        bar[len] = '\0';
+        fprintf(out, "  [%5.0f, %5.0f) µs %-*s %lu\n",
+                lo * MPC_BIN_US, hi * MPC_BIN_US, BAR_WIDTH, bar, rows[r]);
+    }
+    if (t->overflow) {
+        int len = (int)((double)t->overflow / peak * BAR_WIDTH + 0.5);
+        memset(bar, '#', (size_t)len);
+        bar[len] = '\0';
+        fprintf(out, "  [%5.0f,   ...) µs %-*s %lu\n", MPC_BINS * MPC_BIN_US, BAR_WIDTH, bar, t->overflow);
+    }
+}
@@ -0,0 +1,644 @@
+/*
+    FILE: numfmt.c
+    DESCRIPTION:
+        Implementa a formatação rápida de números (numfmt.h).
+        A saída mínima usa o algoritmo Grisu3 (Loitsch, 2010): o double é
+        escalado por uma potência de 10 em cache com aritmética de 64 bits
+        e os dígitos são gerados dentro do intervalo de arredondamento.
+        Quando o erro da aritmética aproximada não permite garantir o
+        resultado mais curto (cerca de 0,5% dos doubles), recorre à menor
+        precisão de "%.*e" que strtod lê de volta.
+        A precisão fixa além de 2^53 usa aritmética inteira exata (128
+        bits ou inteiros grandes), com os mesmos dígitos de "%.Nf".
+        A tabela de potências é calculada uma única vez com aritmética
+        inteira exata, evitando constantes mágicas no código-fonte.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include "numfmt.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+// ==========================
+// Escrita de inteiros
+// ==========================
+
+static const char DIGIT_PAIRS[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/* Escreve u em decimal no final de 'end' (de trás para frente); retorna o início */
+static char *write_u64_rev(char *end, uint64_t u) {
+    while (u >= 100) {
+        unsigned idx = (unsigned)(u % 100) * 2;
+        u /= 100;
+        *--end = DIGIT_PAIRS[idx + 1];
+        *--end = DIGIT_PAIRS[idx];
+    }
+    if (u >= 10) {
+        unsigned idx = (unsigned)u * 2;
+        *--end = DIGIT_PAIRS[idx + 1];
+        *--end = DIGIT_PAIRS[idx];
+    } else {
+        *--end = (char)('0' + u);
+    }
+    return end;
+}
+
+/* Copia u em decimal para buf e retorna o número de caracteres */
+static size_t write_u64(char *buf, uint64_t u) {
+    char tmp[24];
+    char *end = tmp + sizeof(tmp);
+    char *start = write_u64_rev(end, u);
+    size_t n = (size_t)(end - start);
+    memcpy(buf, start, n);
+    return n;
+}
+
+size_t numfmt_long(char *buf, long value) {
+    size_t n = 0;
+    uint64_t u = (uint64_t)value;
+    if (value < 0) {
+        buf[n++] = '-';
+        u = 0 - u;
+    }
+    n += write_u64(buf + n, u);
+    buf[n] = '\0';
+    return n;
+}
+
+/* Trata NaN e infinitos; retorna 0 se o valor for finito */
+static size_t write_non_finite(char *buf, double value) {
+    if (isnan(value)) {
+        memcpy(buf, "nan", 4);
+        return 3;
+    }
+    if (isinf(value)) {
+        if (value < 0) {
+            memcpy(buf, "-inf", 5);
+            return 4;
+        }
+        memcpy(buf, "inf", 4);
+        return 3;
+    }
+    return 0;
+}
+
+// ==========================
+// Grisu3: aritmética DiyFp
+// ==========================
+
+typedef struct {
+    uint64_t f;  // Significando
+    int e;       // Expoente binário
+} DiyFp;
+
+typedef struct {
+    uint64_t f;
+    int e;
+    int k;       // Expoente decimal correspondente (10^k ~ f * 2^e)
+} CachedPower;
+
+#define GRISU_ALPHA (-60)
+#define GRISU_GAMMA (-32)
+#define CACHED_MIN_DEC_EXP (-300)
+#define CACHED_DEC_STEP 8
+#define CACHED_COUNT 79
+
+static CachedPower cached_powers[CACHED_COUNT];
+static pthread_once_t cached_powers_once = PTHREAD_ONCE_INIT;
+
+static DiyFp diyfp_sub(DiyFp x, DiyFp y) {
+    DiyFp r = { x.f - y.f, x.e };
+    return r;
+}
+
+static DiyFp diyfp_mul(DiyFp x, DiyFp y) {
+    unsigned __int128 p = (unsigned __int128)x.f * y.f;
+    uint64_t h = (uint64_t)(p >> 64);
+    uint64_t l = (uint64_t)p;
+    h += l >> 63;  // Arredonda para o mais próximo
+    DiyFp r = { h, x.e + y.e + 64 };
+    return r;
+}
+
+static DiyFp diyfp_normalize(DiyFp x) {
+    int s = __builtin_clzll(x.f);
+    DiyFp r = { x.f << s, x.e - s };
+    return r;
+}
+
+static DiyFp diyfp_normalize_to(DiyFp x, int target_e) {
+    DiyFp r = { x.f << (x.e - target_e), target_e };
+    return r;
+}
+
+// ==========================
+// Inteiros grandes exatos
+// ==========================
+
+#define BIG_LIMBS 40  // 1280 bits: cobre 10^340 e o maior double (< 2^1024)
+
+typedef struct {
+    uint32_t d[BIG_LIMBS];  // Limbs little-endian
+    int n;                  // Limbs em uso
+} BigUint;
+
+static void big_set_u32(BigUint *b, uint32_t v) {
+    memset(b, 0, sizeof(*b));
+    b->d[0] = v;
+    b->n = 1;
+}
+
+static void big_mul_u32(BigUint *b, uint32_t m) {
+    uint64_t carry = 0;
+    for (int i = 0; i < b->n; i++) {
+        uint64_t p = (uint64_t)b->d[i] * m + carry;
+        b->d[i] = (uint32_t)p;
+        carry = p >> 32;
+    }
+    if (carry) b->d[b->n++] = (uint32_t)carry;
+}
+
+static int big_bitlen(const BigUint *b) {
+    int top = b->n - 1;
+    while (top > 0 && b->d[top] == 0) top--;
+    if (b->d[top] == 0) return 0;
+    return top * 32 + (32 - __builtin_clz(b->d[top]));
+}
+
+static int big_bit(const BigUint *b, int i) {
+    if (i < 0) return 0;
+    return (b->d[i / 32] >> (i % 32)) & 1u;
+}
+
+static void big_shl1(BigUint *b) {
+    uint32_t carry = 0;
+    for (int i = 0; i < b->n; i++) {
+        uint32_t next = b->d[i] >> 31;
+        b->d[i] = (b->d[i] << 1) | carry;
+        carry = next;
+    }
+    if (carry) b->d[b->n++] = carry;
+}
+
+static int big_cmp(const BigUint *a, const BigUint *b) {
+    int n = a->n > b->n ? a->n : b->n;
+    for (int i = n - 1; i >= 0; i--) {
+        uint32_t x = i < a->n ? a->d[i] : 0;
+        uint32_t y = i < b->n ? b->d[i] : 0;
+        if (x != y) return x < y ? -1 : 1;
+    }
+    return 0;
+}
+
+static void big_sub(BigUint *a, const BigUint *b) {
+    int64_t borrow = 0;
+    for (int i = 0; i < a->n; i++) {
+        int64_t diff = (int64_t)a->d[i] - (i < b->n ? b->d[i] : 0) - borrow;
+        borrow = diff < 0;
+        a->d[i] = (uint32_t)(diff + (borrow ? (int64_t)1 << 32 : 0));
+    }
+}
+
+static void big_set_u64(BigUint *b, uint64_t v) {
+    big_set_u32(b, (uint32_t)v);
+    b->d[1] = (uint32_t)(v >> 32);
+    b->n = 2;
+}
+
+/* Desloca b para a esquerda em 'bits' posições */
+static void big_shl(BigUint *b, int bits) {
+    int limbs = bits / 32, rest = bits % 32;
+    if (rest) {
+        uint32_t carry = 0;
+        for (int i = 0; i < b->n; i++) {
+            uint32_t next = b->d[i] >> (32 - rest);
+            b->d[i] = (b->d[i] << rest) | carry;
+            carry = next;
+        }
+        if (carry) b->d[b->n++] = carry;
+    }
+    if (limbs) {
+        memmove(b->d + limbs, b->d, (size_t)b->n * sizeof(uint32_t));
+        memset(b->d, 0, (size_t)limbs * sizeof(uint32_t));
+        b->n += limbs;
+    }
+}
+
+/* Divide b por d e retorna o resto */
+static uint32_t big_divmod_u32(BigUint *b, uint32_t d) {
+    uint64_t r = 0;
+    for (int i = b->n - 1; i >= 0; i--) {
+        uint64_t cur = (r << 32) | b->d[i];
+        b->d[i] = (uint32_t)(cur / d);
+        r = cur % d;
+    }
+    while (b->n > 1 && b->d[b->n - 1] == 0) b->n--;
+    return (uint32_t)r;
+}
+
+static void big_pow10(BigUint *b, int k) {
+    big_set_u32(b, 1);
+    for (; k >= 9; k -= 9) big_mul_u32(b, 1000000000u);
+    for (; k > 0; k--) big_mul_u32(b, 10u);
+}
+
+// ==========================
+// Tabela de potências de 10
+// ==========================
+
+/* 10^k arredondado para 64 bits normalizados (k >= 0) */
+static CachedPower power_from_positive(int k) {
+    BigUint b;
+    big_pow10(&b, k);
+    int len = big_bitlen(&b);
+    uint64_t f = 0;
+    for (int i = 0; i < 64; i++) f = (f << 1) | (uint64_t)big_bit(&b, len - 1 - i);
+    int e = len - 64;
+    if (big_bit(&b, len - 65)) {
+        if (++f == 0) {
+            f = (uint64_t)1 << 63;
+            e++;
+        }
+    }
+    CachedPower c = { f, e, k };
+    return c;
+}
+
+/* 10^k = 1 / 10^-k por divisão longa bit a bit (k < 0) */
+static CachedPower power_from_negative(int k) {
+    BigUint d, r;
+    big_pow10(&d, -k);
+    big_set_u32(&r, 1);
+
+    unsigned __int128 q = 0;
+    int n = 0;
+    while ((q >> 64) == 0) {
+        big_shl1(&r);
+        n++;
+        q <<= 1;
+        if (big_cmp(&r, &d) >= 0) {
+            big_sub(&r, &d);
+            q |= 1;
+        }
+    }
+
+    // q tem 65 bits significativos: o último decide o arredondamento
+    uint64_t f = (uint64_t)(q >> 1) + (uint64_t)(q & 1);
+    int e = 1 - n;
+    if (f == 0) {
+        f = (uint64_t)1 << 63;
+        e++;
+    }
+    CachedPower c = { f, e, k };
+    return c;
+}
+
+static void init_cached_powers(void) {
+    for (int i = 0; i < CACHED_COUNT; i++) {
+        int k = CACHED_MIN_DEC_EXP + i * CACHED_DEC_STEP;
+        cached_powers[i] = (k >= 0) ? power_from_positive(k) : power_from_negative(k);
+    }
+}
+
+/* Seleciona c = 10^-k tal que ALPHA <= c.e + e + 64 <= GAMMA */
+static CachedPower cached_power_for_binary_exponent(int e) {
+    int f = GRISU_ALPHA - e - 1;
+    int k = (f * 78913) / (1 << 18) + (f > 0);
+    int index = (-CACHED_MIN_DEC_EXP + k + (CACHED_DEC_STEP - 1)) / CACHED_DEC_STEP;
+    return cached_powers[index];
+}
+
+// ==========================
+// Grisu3: geração de dígitos
+// ==========================
+
+static int find_largest_pow10(uint32_t n, uint32_t *pow10) {
+    static const uint32_t P10[] = {
+        1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u,
+        10000000u, 100000000u, 1000000000u
+    };
+    int digits = 10;
+    while (digits > 1 && n < P10[digits - 1]) digits--;
+    *pow10 = P10[digits - 1];
+    return digits;
+}
+
+/* Aproxima o último dígito de w; retorna 1 se os dígitos são comprovadamente
+   os mais curtos e os mais próximos de w apesar do erro de 'unit' ulps */
+static int grisu3_round_weed(char *buf, int len, uint64_t dist_high, uint64_t unsafe,
+                             uint64_t rest, uint64_t ten_k, uint64_t unit) {
+    uint64_t small_dist = dist_high - unit;  // Distância até w no melhor caso
+    uint64_t big_dist = dist_high + unit;    // Distância até w no pior caso
+    while (rest < small_dist && unsafe - rest >= ten_k &&
+           (rest + ten_k < small_dist || small_dist - rest >= rest + ten_k - small_dist)) {
+        buf[len - 1]--;
+        rest += ten_k;
+    }
+
+    // Se no pior caso outro dígito estaria mais perto de w, não há garantia
+    if (rest < big_dist && unsafe - rest >= ten_k &&
+        (rest + ten_k < big_dist || big_dist - rest > rest + ten_k - big_dist)) {
+        return 0;
+    }
+    return 2 * unit <= rest && rest <= unsafe - 4 * unit;
+}
+
+/* Gera os dígitos de high (ampliado de 1 ulp) até caírem no intervalo
+   inseguro (low, high) ampliado; retorna 0 se o resultado não é garantido */
+static int grisu3_digit_gen(char *buf, int *len, int *kappa, DiyFp low, DiyFp w, DiyFp high) {
+    uint64_t unit = 1;
+    DiyFp too_low = { low.f - unit, low.e };
+    DiyFp too_high = { high.f + unit, high.e };
+    uint64_t unsafe = diyfp_sub(too_high, too_low).f;
+
+    const int shift = -w.e;
+    const uint64_t one_f = (uint64_t)1 << shift;
+
+    uint32_t p1 = (uint32_t)(too_high.f >> shift);
+    uint64_t p2 = too_high.f & (one_f - 1);
+
+    uint32_t pow10;
+    *kappa = find_largest_pow10(p1, &pow10);
+    *len = 0;
+
+    // Parte inteira
+    while (*kappa > 0) {
+        buf[(*len)++] = (char)('0' + p1 / pow10);
+        p1 %= pow10;
+        (*kappa)--;
+
+        uint64_t rest = ((uint64_t)p1 << shift) + p2;
+        if (rest < unsafe) {
+            return grisu3_round_weed(buf, *len, diyfp_sub(too_high, w).f, unsafe, rest,
+                                     (uint64_t)pow10 << shift, unit);
+        }
+        pow10 /= 10;
+    }
+
+    // Parte fracionária: o erro cresce com cada dígito
+    for (;;) {
+        p2 *= 10;
+        unit *= 10;
+        unsafe *= 10;
+        buf[(*len)++] = (char)('0' + (p2 >> shift));
+        p2 &= one_f - 1;
+        (*kappa)--;
+        if (p2 < unsafe) {
+            return grisu3_round_weed(buf, *len, diyfp_sub(too_high, w).f * unit, unsafe, p2,
+                                     one_f, unit);
+        }
+    }
+}
+
+/* Gera os dígitos mínimos de value > 0: value = digits * 10^dec_exp.
+   Retorna o número de dígitos, ou 0 se Grisu3 não garante o resultado. */
+static int grisu3(char *digits, int *dec_exp, double value) {
+    pthread_once(&cached_powers_once, init_cached_powers);
+
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    const uint64_t hidden = (uint64_t)1 << 52;
+    const int bias = 1075;  // 1023 + 52
+    uint64_t F = bits & (hidden - 1);
+    int E = (int)(bits >> 52) & 0x7FF;
+
+    DiyFp v = (E == 0) ? (DiyFp){ F, 1 - bias } : (DiyFp){ F + hidden, E - bias };
+    int lower_closer = (F == 0 && E > 1);
+
+    DiyFp m_plus = { 2 * v.f + 1, v.e - 1 };
+    DiyFp m_minus = lower_closer ? (DiyFp){ 4 * v.f - 1, v.e - 2 }
+                                 : (DiyFp){ 2 * v.f - 1, v.e - 1 };
+
+    DiyFp w_plus = diyfp_normalize(m_plus);
+    DiyFp w_minus = diyfp_normalize_to(m_minus, w_plus.e);
+    DiyFp w = diyfp_normalize(v);
+
+    CachedPower cached = cached_power_for_binary_exponent(w_plus.e);
+    DiyFp c = { cached.f, cached.e };
+
+    DiyFp sw = diyfp_mul(w, c);
+    DiyFp sw_minus = diyfp_mul(w_minus, c);
+    DiyFp sw_plus = diyfp_mul(w_plus, c);
+
+    int len, kappa;
+    if (!grisu3_digit_gen(digits, &len, &kappa, sw_minus, sw, sw_plus)) return 0;
+    *dec_exp = kappa - cached.k;
+    return len;
+}
+
+/* Lê digits * 10^dec_exp com strtod (sem ponto decimal: independe do locale) */
+static double parse_digits(const char *digits, int len, int dec_exp) {
+    char tmp[48];
+    snprintf(tmp, sizeof(tmp), "%.*se%d", len, digits, dec_exp);
+    return strtod(tmp, NULL);
+}
+
+/* Recurso exato de Grisu3: a menor precisão de "%.*e" (arredondamento
+   exato da libc) cujo resultado strtod lê de volta como value */
+static int shortest_fallback(char *digits, int *dec_exp, double value) {
+    char tmp[48];
+    for (int p = 1;; p++) {
+        snprintf(tmp, sizeof(tmp), "%.*e", p - 1, value);
+        int len = 0;
+        const char *c = tmp;
+        for (; *c != 'e'; c++) {
+            if (*c >= '0' && *c <= '9') digits[len++] = *c;
+        }
+        *dec_exp = (int)strtol(c + 1, NULL, 10) - (len - 1);
+
+        double lido = parse_digits(digits, len, *dec_exp);
+        if (lido == value || p == 17) return len;  // 17 dígitos sempre bastam
+
+        // Numa potência de 2 o intervalo abaixo de value é mais estreito: o
+        // vizinho acima pode ser lido de volta mesmo que o mais próximo não seja
+        if (lido < value) {
+            int i = len - 1;
+            while (i >= 0 && digits[i] == '9') digits[i--] = '0';
+            if (i < 0) {
+                digits[0] = '1';
+                *dec_exp += len;
+                len = 1;
+            } else {
+                digits[i]++;
+            }
+            while (len > 1 && digits[len - 1] == '0') {
+                len--;
+                (*dec_exp)++;
+            }
+            if (parse_digits(digits, len, *dec_exp) == value) return len;
+        }
+    }
+}
+
+// ==========================
+// Formatação de doubles
+// ==========================
+
+size_t numfmt_double_shortest(char *buf, double value) {
+    size_t n = write_non_finite(buf, value);
+    if (n) return n;
+
+    if (signbit(value)) {
+        buf[n++] = '-';
+        value = -value;
+    }
+    if (value == 0.0) {
+        buf[n++] = '0';
+        buf[n] = '\0';
+        return n;
+    }
+
+    char digits[24];
+    int dec_exp;
+    int k = grisu3(digits, &dec_exp, value);
+    if (k == 0) k = shortest_fallback(digits, &dec_exp, value);
+    int point = k + dec_exp;  // Posição do ponto decimal em relação aos dígitos
+
+    if (k <= point && point <= 17) {
+        // Inteiro: dígitos seguidos de zeros (ex.: 12300)
+        memcpy(buf + n, digits, (size_t)k);
+        n += (size_t)k;
+        memset(buf + n, '0', (size_t)(point - k));
+        n += (size_t)(point - k);
+    } else if (0 < point && point <= 17) {
+        // Ponto no meio dos dígitos (ex.: 12.34)
+        memcpy(buf + n, digits, (size_t)point);
+        n += (size_t)point;
+        buf[n++] = '.';
+        memcpy(buf + n, digits + point, (size_t)(k - point));
+        n += (size_t)(k - point);
+    } else if (-5 < point && point <= 0) {
+        // Magnitude pequena (ex.: 0.00123)
+        buf[n++] = '0';
+        buf[n++] = '.';
+        memset(buf + n, '0', (size_t)(-point));
+        n += (size_t)(-point);
+        memcpy(buf + n, digits, (size_t)k);
+        n += (size_t)k;
+    } else {
+        // Notação exponencial (ex.: 1.5e-07, 1e+300)
+        buf[n++] = digits[0];
+        if (k > 1) {
+            buf[n++] = '.';
+            memcpy(buf + n, digits + 1, (size_t)(k - 1));
+            n += (size_t)(k - 1);
+        }
+        int e = point - 1;
+        buf[n++] = 'e';
+        buf[n++] = e < 0 ? '-' : '+';
+        if (e < 0) e = -e;
+        if (e < 10) buf[n++] = '0';
+        n += write_u64(buf + n, (uint64_t)e);
+    }
+    buf[n] = '\0';
+    return n;
+}
+
+static const uint64_t P10U[NUMFMT_MAX_PRECISION + 1] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u,
+    10000000u, 100000000u, 1000000000u
+};
+
+/* Escreve ip.fp com 'precision' casas (fp < 10^precision) */
+static size_t write_fixed(char *buf, size_t n, uint64_t ip, uint64_t fp, int precision) {
+    n += write_u64(buf + n, ip);
+    if (precision > 0) {
+        buf[n++] = '.';
+        char *end = buf + n + precision;
+        char *start = write_u64_rev(end, fp);
+        while (start > buf + n) *--start = '0';  // Zeros à esquerda da fração
+        n += (size_t)precision;
+    }
+    buf[n] = '\0';
+    return n;
+}
+
+/* Precisão fixa exata quando a * 10^precision passa de 2^53 (a = m * 2^e):
+   abaixo de 2^53 o produto m * 10^precision cabe em 128 bits e é dividido
+   por 2^-e com empate para o par, como printf; acima, a é inteiro e seus
+   dígitos vêm da conversão exata de m * 2^e */
+static size_t fixed_exact(char *buf, size_t n, double a, int precision) {
+    int e;
+    uint64_t m = (uint64_t)ldexp(frexp(a, &e), 53);
+    e -= 53;
+
+    if (e < 0) {
+        // Aqui a >= 2^53 / 10^9, então -e <= 29 e o produto tem menos de 83 bits
+        int s = -e;
+        unsigned __int128 prod = (unsigned __int128)m * P10U[precision];
+        unsigned __int128 q = prod >> s;
+        unsigned __int128 rem = prod - (q << s);
+        unsigned __int128 half = (unsigned __int128)1 << (s - 1);
+        if (rem > half || (rem == half && (q & 1))) q++;
+        return write_fixed(buf, n, (uint64_t)(q / P10U[precision]),
+                           (uint64_t)(q % P10U[precision]), precision);
+    }
+
+    // Blocos de 9 dígitos, do menos para o mais significativo
+    BigUint b;
+    big_set_u64(&b, m);
+    big_shl(&b, e);
+    uint32_t blocos[BIG_LIMBS];
+    int nb = 0;
+    do {
+        blocos[nb++] = big_divmod_u32(&b, 1000000000u);
+    } while (b.n > 1 || b.d[0] != 0);
+
+    n += write_u64(buf + n, blocos[--nb]);
+    while (nb > 0) {
+        char *end = buf + n + 9;
+        char *start = write_u64_rev(end, blocos[--nb]);
+        while (start > buf + n) *--start = '0';
+        n += 9;
+    }
+    if (precision > 0) {
+        buf[n++] = '.';
+        memset(buf + n, '0', (size_t)precision);
+        n += (size_t)precision;
+    }
+    buf[n] = '\0';
+    return n;
+}
+
+size_t numfmt_double_fixed(char *buf, double value, int precision) {
+    static const double P10D[NUMFMT_MAX_PRECISION + 1] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9
+    };
+
+    size_t n = write_non_finite(buf, value);
+    if (n) return n;
+
+    if (precision < 0) precision = 0;
+    if (precision > NUMFMT_MAX_PRECISION) precision = NUMFMT_MAX_PRECISION;
+
+    if (signbit(value)) {
+        buf[n++] = '-';
+        value = -value;
+    }
+
+    double scaled = value * P10D[precision];
+    if (!(scaled < 9007199254740992.0)) {  // 2^53: inteiros deixam de ser exatos
+        return fixed_exact(buf, n, value, precision);
+    }
+
+    // Arredondamento idêntico ao printf: só o caso de empate aparente (.5)
+    // exige o erro exato do produto, obtido com fma
+    uint64_t r = (uint64_t)scaled;
+    double frac = scaled - (double)r;
+    if (frac > 0.5) {
+        r++;
+    } else if (frac == 0.5) {
+        double err = fma(value, P10D[precision], -scaled);
+        if (err > 0 || (err == 0 && (r & 1))) r++;
+    }
+    return write_fixed(buf, n, r / P10U[precision], r % P10U[precision], precision);
+}
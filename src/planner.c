@@ -0,0 +1,1031 @@
+/*
+    FILE: planner.c
+    DESCRIPTION:
+        Implementa a grade de ocupação compactada em bits, as buscas A*,
+        Jump Point Search e D* Lite sobre um heap binário indexado e a
+        conversão do caminho em amostras de trajetória (planner.h).
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "planner.h"
+#include "logs.h"
+
+#define HEAP_INITIAL 4096
+#define BLEND_TRIES 4          // Reduções do arredondamento antes de manter a quina
+#define BLEND_CHECKS 16        // Pontos verificados em cada curva de arredondamento
+
+// Vizinhança: 4 eixos e 4 diagonais
+static const int DX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+static const int DY[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+// ==========================
+// Grade de ocupação
+// ==========================
+
+/* Marca ou libera os bits das células [x0, x1] de uma linha */
+static void row_fill(uint64_t *row, int x0, int x1, int occupied) {
+    for (int x = x0; x <= x1;) {
+        unsigned b = (unsigned)(x + 64), w = b >> 6, s = b & 63;
+        int n = 64 - (int)s;
+        if (n > x1 - x + 1) n = x1 - x + 1;
+        uint64_t mask = (n == 64 ? ~0ull : ((1ull << n) - 1)) << s;
+        if (occupied) row[w] |= mask;
+        else row[w] &= ~mask;
+        x += n;
+    }
+}
+
+int grid_init(OccupancyGrid *g, int width, int height, double resolution) {
+    memset(g, 0, sizeof(*g));
+    if (width <= 0 || height <= 0 || !(resolution > 0.0)) {
+        LOG_ERROR("Grade inválida: %d x %d células de %g m\n", width, height, resolution);
+        return -1;
+    }
+    g->width = width;
+    g->height = height;
+    g->stride = (width + 63) / 64 + 2;
+    g->resolution = resolution;
+    size_t n = (size_t)(height + 2) * g->stride;
+    g->words = malloc(n * sizeof(uint64_t));
+    if (!g->words) {
+        LOG_ERROR("Falha ao alocar a grade de %d x %d células\n", width, height);
+        return -1;
+    }
+    memset(g->words, 0xff, n * sizeof(uint64_t));  // Moldura (e tudo mais) ocupada
+    for (int y = 0; y < height; y++) row_fill(g->words + (size_t)(y + 1) * g->stride, 0, width - 1, 0);
+    return 0;
+}
+
+/* Próximo inteiro do cabeçalho PBM (pula espaços e comentários) */
+static int pbm_int(FILE *f, int *out) {
+    int c;
+    for (;;) {
+        c = fgetc(f);
+        if (c == '#') {
+            while (c != '\n' && c != EOF) c = fgetc(f);
+        } else if (c == EOF || !(c == ' ' || c == '\t' || c == '\r' || c == '\n')) {
+            break;
+        }
+    }
+    if (c == EOF) return -1;
+    ungetc(c, f);
+    return fscanf(f, "%d", out) == 1 ? 0 : -1;
+}
+
+int grid_load_pbm(OccupancyGrid *g, const char *path, double resolution) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        LOG_ERROR("Não foi possível abrir o mapa '%s'\n", path);
+        return -1;
+    }
+    char magic[3] = { 0 };
+    int w, h, status = 0;
+    if (fread(magic, 1, 2, f) != 2 || magic[0] != 'P' || (magic[1] != '1' && magic[1] != '4') ||
+        pbm_int(f, &w) != 0 || pbm_int(f, &h) != 0 || grid_init(g, w, h, resolution) != 0) {
+        LOG_ERROR("Mapa PBM inválido: '%s'\n", path);
+        fclose(f);
+        return -1;
+    }
+    fgetc(f);  // Um espaço separa o cabeçalho dos dados
+
+    // A primeira linha do arquivo é a de cima (maior y)
+    int byte = 0;
+    for (int r = 0; r < h && status == 0; r++) {
+        int y = h - 1 - r;
+        for (int x = 0; x < w; x++) {
+            int v;
+            if (magic[1] == '4') {
+                if (x % 8 == 0 && (byte = fgetc(f)) == EOF) { status = -1; break; }
+                v = (byte >> (7 - x % 8)) & 1;
+            } else {
+                int c;
+                do c = fgetc(f); while (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+                if (c != '0' && c != '1') { status = -1; break; }
+                v = c == '1';
+            }
+            if (v) grid_set(g, x, y, 1);
+        }
+    }
+    fclose(f);
+    if (status != 0) {
+        LOG_ERROR("Mapa PBM truncado: '%s'\n", path);
+        grid_free(g);
+        return -1;
+    }
+    return 0;
+}
+
+void grid_free(OccupancyGrid *g) {
+    free(g->words);
+    memset(g, 0, sizeof(*g));
+}
+
+void grid_set(OccupancyGrid *g, int x, int y, int occupied) {
+    if (x < 0 || y < 0 || x >= g->width || y >= g->height) return;
+    unsigned b = (unsigned)(x + 64);
+    uint64_t *word = g->words + (size_t)(y + 1) * g->stride + (b >> 6);
+    if (occupied) *word |= 1ull << (b & 63);
+    else *word &= ~(1ull << (b & 63));
+}
+
+void grid_fill_rect(OccupancyGrid *g, int x0, int y0, int x1, int y1, int occupied) {
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= g->width) x1 = g->width - 1;
+    if (y1 >= g->height) y1 = g->height - 1;
+    for (int y = y0; y <= y1 && x0 <= x1; y++) row_fill(g->words + (size_t)(y + 1) * g->stride, x0, x1, occupied);
+}
+
+/* Dilatação quadrada de até 64 células (alcance das janelas na moldura) */
+static int inflate_step(OccupancyGrid *g, int radius) {
+    int inner = g->stride - 2;
+    uint64_t *horiz = malloc((size_t)g->height * inner * sizeof(uint64_t));
+    if (!horiz) {
+        LOG_ERROR("Falha ao alocar a dilatação da grade\n");
+        return -1;
+    }
+
+    // Linhas: OR das janelas deslocadas de -radius a +radius (64 células por vez)
+    for (int y = 0; y < g->height; y++) {
+        for (int w = 0; w < inner; w++) {
+            uint64_t acc = 0;
+            for (int k = -radius; k <= radius; k++) acc |= grid_window(g, y, 64 * w + k);
+            horiz[(size_t)y * inner + w] = acc;
+        }
+    }
+
+    // Colunas: OR das linhas vizinhas (a moldura conta como ocupada)
+    for (int y = 0; y < g->height; y++) {
+        uint64_t *row = g->words + (size_t)(y + 1) * g->stride + 1;
+        int edge = y < radius || y + radius >= g->height;
+        for (int w = 0; w < inner; w++) {
+            uint64_t acc = edge ? ~0ull : 0;
+            for (int k = -radius; k <= radius && !edge; k++) acc |= horiz[(size_t)(y + k) * inner + w];
+            row[w] = acc;
+        }
+    }
+    free(horiz);
+    return 0;
+}
+
+int grid_inflate(OccupancyGrid *g, int radius) {
+    // Dilatações quadradas se compõem: r = r1 + r2
+    while (radius > 0) {
+        int step = radius > 64 ? 64 : radius;
+        if (inflate_step(g, step) != 0) return -1;
+        radius -= step;
+    }
+    return 0;
+}
+
+int grid_cell_of(const OccupancyGrid *g, double x, double y, int *cx, int *cy) {
+    double fx = floor((x - g->origin_x) / g->resolution), fy = floor((y - g->origin_y) / g->resolution);
+    if (fx < 0 || fy < 0 || fx >= g->width || fy >= g->height) return -1;
+    *cx = (int)fx;
+    *cy = (int)fy;
+    return 0;
+}
+
+/* Custo do passo de (x, y) na direção k (PLAN_INF se bloqueado ou cortando quina) */
+static inline uint32_t step_cost(const OccupancyGrid *g, int x, int y, int k) {
+    int nx = x + DX[k], ny = y + DY[k];
+    if (grid_occupied(g, nx, ny)) return PLAN_INF;
+    if (k >= 4 && (grid_occupied(g, nx, y) || grid_occupied(g, x, ny))) return PLAN_INF;
+    return k < 4 ? PLAN_COST_AXIS : PLAN_COST_DIAG;
+}
+
+/* Soma de custos saturada em PLAN_INF */
+static inline uint32_t cost_add(uint32_t a, uint32_t b) {
+    uint64_t s = (uint64_t)a + b;
+    return s >= PLAN_INF ? PLAN_INF : (uint32_t)s;
+}
+
+/* Distância octil (heurística consistente e exata em linha reta ou diagonal) */
+static inline uint32_t octile(int x0, int y0, int x1, int y1) {
+    unsigned dx = (unsigned)abs(x1 - x0), dy = (unsigned)abs(y1 - y0);
+    unsigned lo = dx < dy ? dx : dy, hi = dx < dy ? dy : dx;
+    return PLAN_COST_AXIS * (hi - lo) + PLAN_COST_DIAG * lo;
+}
+
+// ==========================
+// Heap binário indexado
+// ==========================
+
+static int heap_init(PlanHeap *h, size_t cells) {
+    h->count = 0;
+    h->capacity = HEAP_INITIAL;
+    h->items = malloc((size_t)h->capacity * sizeof(PlanHeapEntry));
+    h->pos = malloc(cells * sizeof(int32_t));
+    if (!h->items || !h->pos) return -1;
+    memset(h->pos, 0xff, cells * sizeof(int32_t));  // PLAN_NOT_QUEUED
+    return 0;
+}
+
+static void heap_free(PlanHeap *h) {
+    free(h->items);
+    free(h->pos);
+    memset(h, 0, sizeof(*h));
+}
+
+static inline int key_less(uint64_t a1, uint32_t a2, uint64_t b1, uint32_t b2) {
+    return a1 < b1 || (a1 == b1 && a2 < b2);
+}
+
+static void heap_sift_up(PlanHeap *h, int i) {
+    PlanHeapEntry e = h->items[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        PlanHeapEntry *p = &h->items[parent];
+        if (!key_less(e.k1, e.k2, p->k1, p->k2)) break;
+        h->items[i] = *p;
+        h->pos[p->cell] = i;
+        i = parent;
+    }
+    h->items[i] = e;
+    h->pos[e.cell] = i;
+}
+
+static void heap_sift_down(PlanHeap *h, int i) {
+    PlanHeapEntry e = h->items[i];
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= h->count) break;
+        if (child + 1 < h->count &&
+            key_less(h->items[child + 1].k1, h->items[child + 1].k2, h->items[child].k1, h->items[child].k2))
+            child++;
+        if (!key_less(h->items[child].k1, h->items[child].k2, e.k1, e.k2)) break;
+        h->items[i] = h->items[child];
+        h->pos[h->items[i].cell] = i;
+        i = child;
+    }
+    h->items[i] = e;
+    h->pos[e.cell] = i;
+}
+
+/* Insere a célula ou atualiza a sua chave */
+static int heap_set(PlanHeap *h, int32_t cell, uint64_t k1, uint32_t k2) {
+    int i = h->pos[cell];
+    if (i >= 0) {
+        uint64_t o1 = h->items[i].k1;
+        uint32_t o2 = h->items[i].k2;
+        h->items[i].k1 = k1;
+        h->items[i].k2 = k2;
+        if (key_less(k1, k2, o1, o2)) heap_sift_up(h, i);
+        else heap_sift_down(h, i);
+        return 0;
+    }
+    if (h->count == h->capacity) {
+        PlanHeapEntry *items = realloc(h->items, 2 * (size_t)h->capacity * sizeof(PlanHeapEntry));
+        if (!items) {
+            LOG_ERROR("Falha ao ampliar a fila do planejador (%d nós)\n", h->count);
+            return -1;
+        }
+        h->items = items;
+        h->capacity *= 2;
+    }
+    h->items[h->count] = (PlanHeapEntry){ k1, k2, cell };
+    heap_sift_up(h, h->count++);
+    return 0;
+}
+
+/* Remove a célula i-ésima do heap (a posição dela passa a PLAN_NOT_QUEUED) */
+static void heap_remove_at(PlanHeap *h, int i) {
+    int32_t cell = h->items[i].cell;
+    h->pos[cell] = PLAN_NOT_QUEUED;
+    if (--h->count == i) return;
+    PlanHeapEntry last = h->items[h->count];
+    uint64_t o1 = h->items[i].k1;
+    uint32_t o2 = h->items[i].k2;
+    h->items[i] = last;
+    h->pos[last.cell] = i;
+    if (key_less(last.k1, last.k2, o1, o2)) heap_sift_up(h, i);
+    else heap_sift_down(h, i);
+}
+
+static inline int32_t heap_pop(PlanHeap *h) {
+    int32_t cell = h->items[0].cell;
+    heap_remove_at(h, 0);
+    return cell;
+}
+
+/* Esvazia o heap (só as células presentes voltam a PLAN_NOT_QUEUED) */
+static void heap_clear(PlanHeap *h) {
+    for (int i = 0; i < h->count; i++) h->pos[h->items[i].cell] = PLAN_NOT_QUEUED;
+    h->count = 0;
+}
+
+// ==========================
+// Caminhos
+// ==========================
+
+static int path_reserve(PlanPath *path, int n) {
+    if (n <= path->capacity) return 0;
+    int cap = path->capacity ? path->capacity : 256;
+    while (cap < n) cap *= 2;
+    int32_t *cells = realloc(path->cells, (size_t)cap * sizeof(int32_t));
+    if (!cells) {
+        LOG_ERROR("Falha ao alocar o caminho (%d células)\n", n);
+        return -1;
+    }
+    path->cells = cells;
+    path->capacity = cap;
+    return 0;
+}
+
+void plan_path_free(PlanPath *path) {
+    free(path->cells);
+    memset(path, 0, sizeof(*path));
+}
+
+static inline int sign(int v) {
+    return (v > 0) - (v < 0);
+}
+
+// ==========================
+// A* e Jump Point Search
+// ==========================
+
+int planner_init(Planner *p, const OccupancyGrid *grid) {
+    memset(p, 0, sizeof(*p));
+    size_t cells = (size_t)grid->width * grid->height;
+    p->grid = grid;
+    p->nodes = calloc(cells, sizeof(PlanNode));
+    if (!p->nodes || heap_init(&p->open, cells) != 0) {
+        LOG_ERROR("Falha ao alocar o planejador para %zu células\n", cells);
+        planner_destroy(p);
+        return -1;
+    }
+    return 0;
+}
+
+void planner_destroy(Planner *p) {
+    free(p->nodes);
+    heap_free(&p->open);
+    memset(p, 0, sizeof(*p));
+}
+
+typedef struct {
+    const OccupancyGrid *g;
+    int gx, gy;
+} JumpCtx;
+
+/* Salto horizontal a partir de (x, y) no sentido dx, 64 células por vez:
+   para na primeira célula ocupada (sem ponto de salto), no destino ou na
+   primeira célula com vizinho forçado (livre acima/abaixo com a célula
+   anterior da mesma linha ocupada). Retorna x do ponto de salto ou -1. */
+static int jump_horizontal(const JumpCtx *c, int x, int y, int dx) {
+    const OccupancyGrid *g = c->g;
+    for (;;) {
+        int x0 = dx > 0 ? x : x - 63;  // Janela de 64 células à frente
+        uint64_t blocked = grid_window(g, y, x0);
+        uint64_t up = grid_window(g, y + 1, x0), up_prev = grid_window(g, y + 1, x0 - dx);
+        uint64_t down = grid_window(g, y - 1, x0), down_prev = grid_window(g, y - 1, x0 - dx);
+        uint64_t stop = blocked | (~up & up_prev) | (~down & down_prev);
+        if (y == c->gy && c->gx >= x0 && c->gx < x0 + 64) stop |= 1ull << (c->gx - x0);
+        if (stop) {
+            int i = dx > 0 ? __builtin_ctzll(stop) : 63 - __builtin_clzll(stop);
+            return (blocked >> i) & 1 ? -1 : x0 + i;
+        }
+        x += 64 * dx;
+    }
+}
+
+/* Salto vertical a partir de (x, y) no sentido dy; retorna y do ponto de salto ou -1 */
+static int jump_vertical(const JumpCtx *c, int x, int y, int dy) {
+    const OccupancyGrid *g = c->g;
+    for (;; y += dy) {
+        if (grid_occupied(g, x, y)) return -1;
+        if (x == c->gx && y == c->gy) return y;
+        if ((!grid_occupied(g, x - 1, y) && grid_occupied(g, x - 1, y - dy)) ||
+            (!grid_occupied(g, x + 1, y) && grid_occupied(g, x + 1, y - dy)))
+            return y;
+    }
+}
+
+/* Salto na direção (dx, dy) a partir de (x, y); escreve o ponto de salto e retorna 0, ou -1 */
+static int jump(const JumpCtx *c, int x, int y, int dx, int dy, int *jx, int *jy) {
+    const OccupancyGrid *g = c->g;
+    if (dy == 0) {
+        int r = jump_horizontal(c, x, y, dx);
+        if (r < 0) return -1;
+        *jx = r;
+        *jy = y;
+        return 0;
+    }
+    if (dx == 0) {
+        int r = jump_vertical(c, x, y, dy);
+        if (r < 0) return -1;
+        *jx = x;
+        *jy = r;
+        return 0;
+    }
+    // Diagonal: é ponto de salto se um salto nos eixos a partir dele encontrar um
+    for (;;) {
+        if (grid_occupied(g, x, y)) return -1;
+        if ((x == c->gx && y == c->gy) || jump_horizontal(c, x + dx, y, dx) >= 0 ||
+            jump_vertical(c, x, y + dy, dy) >= 0) {
+            *jx = x;
+            *jy = y;
+            return 0;
+        }
+        if (grid_occupied(g, x + dx, y) || grid_occupied(g, x, y + dy)) return -1;
+        x += dx;
+        y += dy;
+    }
+}
+
+/* Direções a explorar a partir de (x, y), chegando de (px, py) (poda do JPS,
+   sem cortar quinas); retorna quantas foram escritas */
+static int jps_directions(const OccupancyGrid *g, int x, int y, int px, int py, int dirs[8][2]) {
+    int n = 0;
+    if (px < 0) {
+        for (int k = 0; k < 8; k++) {
+            if (step_cost(g, x, y, k) == PLAN_INF) continue;
+            dirs[n][0] = DX[k];
+            dirs[n++][1] = DY[k];
+        }
+        return n;
+    }
+    int dx = sign(x - px), dy = sign(y - py);
+#define ADD(a, b) do { dirs[n][0] = (a); dirs[n++][1] = (b); } while (0)
+#define FREE(a, b) (!grid_occupied(g, x + (a), y + (b)))
+    if (dx && dy) {
+        if (FREE(0, dy)) ADD(0, dy);
+        if (FREE(dx, 0)) ADD(dx, 0);
+        if (FREE(0, dy) && FREE(dx, 0) && FREE(dx, dy)) ADD(dx, dy);
+    } else if (dx) {
+        int next = FREE(dx, 0), up = FREE(0, 1), down = FREE(0, -1);
+        if (next) {
+            ADD(dx, 0);
+            if (up && FREE(dx, 1)) ADD(dx, 1);
+            if (down && FREE(dx, -1)) ADD(dx, -1);
+        }
+        if (up) ADD(0, 1);
+        if (down) ADD(0, -1);
+    } else {
+        int next = FREE(0, dy), right = FREE(1, 0), left = FREE(-1, 0);
+        if (next) {
+            ADD(0, dy);
+            if (right && FREE(1, dy)) ADD(1, dy);
+            if (left && FREE(-1, dy)) ADD(-1, dy);
+        }
+        if (right) ADD(1, 0);
+        if (left) ADD(-1, 0);
+    }
+#undef ADD
+#undef FREE
+    return n;
+}
+
+/* Reconstrói o caminho pelos pais, preenchendo as células entre pontos de salto */
+static int reconstruct(const Planner *p, int32_t goal, PlanPath *out) {
+    int w = p->grid->width, n = 0;
+    for (int32_t c = goal; c >= 0;) {
+        int32_t parent = p->nodes[c].parent;
+        if (parent < 0) { n++; break; }
+        int dx = abs(c % w - parent % w), dy = abs(c / w - parent / w);
+        n += dx > dy ? dx : dy;
+        c = parent;
+    }
+    if (path_reserve(out, n) != 0) return -1;
+
+    // Do destino à partida, passo a passo (segmentos retos ou diagonais)
+    int i = n;
+    for (int32_t c = goal; c >= 0; c = p->nodes[c].parent) {
+        int32_t parent = p->nodes[c].parent;
+        if (parent < 0) {
+            out->cells[--i] = c;
+            break;
+        }
+        int x = c % w, y = c / w, px = parent % w, py = parent / w;
+        int sx = sign(px - x), sy = sign(py - y);
+        for (; x != px || y != py; x += sx, y += sy) out->cells[--i] = y * w + x;
+    }
+    out->count = n;
+    out->cost = (double)p->nodes[goal].g / PLAN_COST_AXIS;
+    return 0;
+}
+
+int planner_search(Planner *p, PlannerAlgorithm alg, int sx, int sy, int gx, int gy, PlanPath *out) {
+    const OccupancyGrid *g = p->grid;
+    int w = g->width;
+    out->count = 0;
+    out->cost = 0.0;
+    out->expanded = 0;
+    if (sx < 0 || sy < 0 || gx < 0 || gy < 0 || sx >= w || gx >= w || sy >= g->height || gy >= g->height ||
+        grid_occupied(g, sx, sy) || grid_occupied(g, gx, gy))
+        return -1;
+
+    // Nova geração: os nós de consultas anteriores passam a valer como não visitados
+    if (++p->generation == 0) {
+        for (size_t i = 0; i < (size_t)w * g->height; i++) p->nodes[i].stamp = 0;
+        p->generation = 1;
+    }
+    heap_clear(&p->open);
+
+    JumpCtx jc = { g, gx, gy };
+    int32_t start = sy * w + sx, goal = gy * w + gx;
+    p->nodes[start] = (PlanNode){ 0, -1, p->generation };
+    uint32_t h0 = octile(sx, sy, gx, gy);
+    if (heap_set(&p->open, start, h0, h0) != 0) return -1;
+
+    while (p->open.count > 0) {
+        int32_t cur = heap_pop(&p->open);
+        p->open.pos[cur] = PLAN_CLOSED;
+        out->expanded++;
+        if (cur == goal) return reconstruct(p, goal, out);
+
+        int x = cur % w, y = cur / w;
+        uint32_t gc = p->nodes[cur].g;
+        int32_t par = p->nodes[cur].parent;
+
+        int dirs[8][2], nd = 0;
+        if (alg == PLANNER_JPS) {
+            nd = jps_directions(g, x, y, par >= 0 ? par % w : -1, par >= 0 ? par / w : -1, dirs);
+        } else {
+            for (int k = 0; k < 8; k++) {
+                dirs[nd][0] = DX[k];
+                dirs[nd++][1] = DY[k];
+            }
+        }
+
+        for (int k = 0; k < nd; k++) {
+            int nx, ny;
+            uint32_t cost;
+            if (alg == PLANNER_JPS) {
+                if (jump(&jc, x + dirs[k][0], y + dirs[k][1], dirs[k][0], dirs[k][1], &nx, &ny) != 0) continue;
+                cost = octile(x, y, nx, ny);
+            } else {
+                cost = step_cost(g, x, y, k);
+                if (cost == PLAN_INF) continue;
+                nx = x + DX[k];
+                ny = y + DY[k];
+            }
+
+            int32_t nb = ny * w + nx;
+            PlanNode *node = &p->nodes[nb];
+            if (node->stamp != p->generation) {
+                *node = (PlanNode){ PLAN_INF, -1, p->generation };
+                p->open.pos[nb] = PLAN_NOT_QUEUED;
+            } else if (p->open.pos[nb] == PLAN_CLOSED) {
+                continue;
+            }
+            uint32_t ng = cost_add(gc, cost);
+            if (ng < node->g) {
+                node->g = ng;
+                node->parent = cur;
+                uint32_t h = octile(nx, ny, gx, gy);
+                if (heap_set(&p->open, nb, (uint64_t)ng + h, h) != 0) return -1;
+            }
+        }
+    }
+    return -1;
+}
+
+// ==========================
+// D* Lite
+// ==========================
+
+int dstar_init(DStarLite *d, const OccupancyGrid *grid) {
+    memset(d, 0, sizeof(*d));
+    size_t cells = (size_t)grid->width * grid->height;
+    d->grid = grid;
+    d->nodes = malloc(cells * sizeof(DStarNode));
+    if (!d->nodes || heap_init(&d->open, cells) != 0) {
+        LOG_ERROR("Falha ao alocar o D* Lite para %zu células\n", cells);
+        dstar_destroy(d);
+        return -1;
+    }
+    d->start = d->goal = d->last = -1;
+    return 0;
+}
+
+void dstar_destroy(DStarLite *d) {
+    free(d->nodes);
+    heap_free(&d->open);
+    memset(d, 0, sizeof(*d));
+}
+
+static inline uint32_t dstar_h(const DStarLite *d, int32_t a, int32_t b) {
+    int w = d->grid->width;
+    return octile(a % w, a / w, b % w, b / w);
+}
+
+/* Recoloca a célula na fila conforme a consistência (g == rhs) */
+static int dstar_update_vertex(DStarLite *d, int32_t u) {
+    DStarNode *n = &d->nodes[u];
+    if (n->g != n->rhs) {
+        uint32_t m = n->g < n->rhs ? n->g : n->rhs;
+        return heap_set(&d->open, u, (uint64_t)m + dstar_h(d, d->start, u) + d->km, m);
+    }
+    if (d->open.pos[u] >= 0) heap_remove_at(&d->open, d->open.pos[u]);
+    return 0;
+}
+
+/* rhs(u) = min sobre os vizinhos de c(u, s) + g(s) */
+static uint32_t dstar_best_rhs(const DStarLite *d, int32_t u) {
+    const OccupancyGrid *g = d->grid;
+    int w = g->width, x = u % w, y = u / w;
+    uint32_t best = PLAN_INF;
+    for (int k = 0; k < 8; k++) {
+        uint32_t c = step_cost(g, x, y, k);
+        if (c == PLAN_INF) continue;
+        uint32_t v = cost_add(c, d->nodes[(y + DY[k]) * w + x + DX[k]].g);
+        if (v < best) best = v;
+    }
+    return best;
+}
+
+void dstar_reset(DStarLite *d, int sx, int sy, int gx, int gy) {
+    int w = d->grid->width;
+    size_t cells = (size_t)w * d->grid->height;
+    for (size_t i = 0; i < cells; i++) d->nodes[i] = (DStarNode){ PLAN_INF, PLAN_INF };
+    heap_clear(&d->open);
+    d->start = d->last = sy * w + sx;
+    d->goal = gy * w + gx;
+    d->km = 0;
+    d->nodes[d->goal].rhs = 0;
+    dstar_update_vertex(d, d->goal);
+}
+
+void dstar_move_start(DStarLite *d, int sx, int sy) {
+    int32_t s = sy * d->grid->width + sx;
+    d->km += dstar_h(d, d->last, s);
+    d->start = d->last = s;
+}
+
+void dstar_cells_changed(DStarLite *d, const int32_t *cells, int n) {
+    const OccupancyGrid *g = d->grid;
+    int w = g->width;
+    // As arestas afetadas por uma célula têm as duas pontas na vizinhança 3x3
+    for (int i = 0; i < n; i++) {
+        int cx = cells[i] % w, cy = cells[i] / w;
+        for (int y = cy - 1; y <= cy + 1; y++) {
+            for (int x = cx - 1; x <= cx + 1; x++) {
+                if (x < 0 || y < 0 || x >= w || y >= g->height) continue;
+                int32_t u = y * w + x;
+                if (u != d->goal) d->nodes[u].rhs = grid_occupied(g, x, y) ? PLAN_INF : dstar_best_rhs(d, u);
+                dstar_update_vertex(d, u);
+            }
+        }
+    }
+}
+
+/* Propaga as inconsistências até a partida ficar consistente e fora do alcance da fila */
+static int dstar_compute(DStarLite *d) {
+    const OccupancyGrid *g = d->grid;
+    int w = g->width;
+    d->expanded = 0;
+    while (d->open.count > 0) {
+        DStarNode *s = &d->nodes[d->start];
+        uint32_t ms = s->g < s->rhs ? s->g : s->rhs;
+        uint64_t s1 = (uint64_t)ms + d->km;  // h(start, start) = 0
+        PlanHeapEntry top = d->open.items[0];
+        if (!key_less(top.k1, top.k2, s1, ms) && s->rhs == s->g) break;
+
+        int32_t u = top.cell;
+        DStarNode *n = &d->nodes[u];
+        uint32_t m = n->g < n->rhs ? n->g : n->rhs;
+        uint64_t k1 = (uint64_t)m + dstar_h(d, d->start, u) + d->km;
+        d->expanded++;
+        if (key_less(top.k1, top.k2, k1, m)) {
+            if (heap_set(&d->open, u, k1, m) != 0) return -1;
+            continue;
+        }
+
+        int x = u % w, y = u / w;
+        if (n->g > n->rhs) {
+            // Sobreconsistente: fixa g e oferece o novo custo aos vizinhos
+            n->g = n->rhs;
+            heap_remove_at(&d->open, 0);
+            for (int k = 0; k < 8; k++) {
+                uint32_t c = step_cost(g, x, y, k);
+                if (c == PLAN_INF) continue;
+                int32_t v = (y + DY[k]) * w + x + DX[k];
+                if (v != d->goal && cost_add(c, n->g) < d->nodes[v].rhs) {
+                    d->nodes[v].rhs = cost_add(c, n->g);
+                    if (dstar_update_vertex(d, v) != 0) return -1;
+                }
+            }
+        } else {
+            // Subconsistente: descarta g e recalcula quem dependia dele
+            uint32_t g_old = n->g;
+            n->g = PLAN_INF;
+            for (int k = 0; k < 8; k++) {
+                uint32_t c = step_cost(g, x, y, k);
+                if (c == PLAN_INF) continue;
+                int32_t v = (y + DY[k]) * w + x + DX[k];
+                if (v != d->goal && d->nodes[v].rhs == cost_add(c, g_old)) {
+                    d->nodes[v].rhs = dstar_best_rhs(d, v);
+                    if (dstar_update_vertex(d, v) != 0) return -1;
+                }
+            }
+            if (u != d->goal && n->rhs == g_old) n->rhs = dstar_best_rhs(d, u);
+            if (dstar_update_vertex(d, u) != 0) return -1;
+        }
+    }
+    return 0;
+}
+
+int dstar_replan(DStarLite *d, PlanPath *out) {
+    const OccupancyGrid *g = d->grid;
+    int w = g->width;
+    out->count = 0;
+    out->cost = 0.0;
+    if (dstar_compute(d) != 0) return -1;
+    out->expanded = d->expanded;
+    if (d->nodes[d->start].g == PLAN_INF) return -1;
+
+    // Desce pelo gradiente de g: cada passo escolhe o vizinho de menor c + g
+    out->cost = (double)d->nodes[d->start].g / PLAN_COST_AXIS;
+    size_t limit = (size_t)w * g->height;
+    for (int32_t u = d->start;;) {
+        if (path_reserve(out, out->count + 1) != 0) return -1;
+        out->cells[out->count++] = u;
+        if (u == d->goal) return 0;
+        if ((size_t)out->count > limit) break;
+        int x = u % w, y = u / w, best_k = -1;
+        uint32_t best = PLAN_INF;
+        for (int k = 0; k < 8; k++) {
+            uint32_t c = step_cost(g, x, y, k);
+            if (c == PLAN_INF) continue;
+            uint32_t v = cost_add(c, d->nodes[(y + DY[k]) * w + x + DX[k]].g);
+            if (v < best) {
+                best = v;
+                best_k = k;
+            }
+        }
+        if (best_k < 0) break;
+        u = (y + DY[best_k]) * w + x + DX[best_k];
+    }
+    LOG_ERROR("D* Lite: caminho interrompido a partir da célula %d\n", d->start);
+    return -1;
+}
+
+// ==========================
+// Suavização e perfil de velocidade
+// ==========================
+
+/* O segmento entre dois pontos (em células, contínuo) só cruza células
+   livres; nos cruzamentos exatos de quina as duas células vizinhas são
+   verificadas */
+static int segment_free(const OccupancyGrid *g, double ax, double ay, double bx, double by) {
+    int x = (int)floor(ax), y = (int)floor(ay), ex = (int)floor(bx), ey = (int)floor(by);
+    double dx = bx - ax, dy = by - ay;
+    int sx = dx > 0 ? 1 : -1, sy = dy > 0 ? 1 : -1;
+    double tdx = dx != 0.0 ? fabs(1.0 / dx) : INFINITY, tdy = dy != 0.0 ? fabs(1.0 / dy) : INFINITY;
+    double tx = dx != 0.0 ? ((sx > 0 ? x + 1 - ax : ax - x) * tdx) : INFINITY;
+    double ty = dy != 0.0 ? ((sy > 0 ? y + 1 - ay : ay - y) * tdy) : INFINITY;
+    if (grid_occupied(g, x, y)) return 0;
+    for (int steps = abs(ex - x) + abs(ey - y); steps > 0;) {
+        if (fabs(tx - ty) < 1e-9) {
+            if (grid_occupied(g, x + sx, y) || grid_occupied(g, x, y + sy)) return 0;
+            x += sx;
+            y += sy;
+            tx += tdx;
+            ty += tdy;
+            steps -= 2;
+        } else if (tx < ty) {
+            x += sx;
+            tx += tdx;
+            steps--;
+        } else {
+            y += sy;
+            ty += tdy;
+            steps--;
+        }
+        if (grid_occupied(g, x, y)) return 0;
+    }
+    return 1;
+}
+
+// Polilinha densa (em metros) crescendo sob demanda
+typedef struct {
+    double *x, *y;
+    size_t count, capacity;
+} Polyline;
+
+static int poly_push(Polyline *p, double x, double y) {
+    if (p->count > 0 && hypot(x - p->x[p->count - 1], y - p->y[p->count - 1]) < 1e-9) return 0;
+    if (p->count == p->capacity) {
+        size_t cap = p->capacity ? 2 * p->capacity : 1024;
+        double *nx = realloc(p->x, cap * sizeof(double));
+        if (nx) p->x = nx;
+        double *ny = nx ? realloc(p->y, cap * sizeof(double)) : NULL;
+        if (!ny) {
+            LOG_ERROR("Falha ao alocar a trajetória planejada (%zu pontos)\n", cap);
+            return -1;
+        }
+        p->y = ny;
+        p->capacity = cap;
+    }
+    p->x[p->count] = x;
+    p->y[p->count++] = y;
+    return 0;
+}
+
+/* Acrescenta o trecho reto até (x, y) em passos de no máximo ds */
+static int poly_line_to(Polyline *p, double x, double y, double ds) {
+    double x0 = p->x[p->count - 1], y0 = p->y[p->count - 1];
+    int n = (int)ceil(hypot(x - x0, y - y0) / ds);
+    for (int i = 1; i <= n; i++) {
+        if (poly_push(p, x0 + (x - x0) * i / n, y0 + (y - y0) * i / n) != 0) return -1;
+    }
+    return 0;
+}
+
+static inline void bezier(double ax, double ay, double cx, double cy, double bx, double by, double u,
+                          double *x, double *y) {
+    double a = (1 - u) * (1 - u), b = 2 * u * (1 - u), c = u * u;
+    *x = a * ax + b * cx + c * bx;
+    *y = a * ay + b * cy + c * by;
+}
+
+/* Arredondamento livre? (curva verificada em trechos retos, em células) */
+static int bezier_free(const OccupancyGrid *g, double ax, double ay, double cx, double cy, double bx, double by) {
+    double inv = 1.0 / g->resolution, px = ax, py = ay;
+    for (int i = 1; i <= BLEND_CHECKS; i++) {
+        double x, y;
+        bezier(ax, ay, cx, cy, bx, by, (double)i / BLEND_CHECKS, &x, &y);
+        if (!segment_free(g, (px - g->origin_x) * inv, (py - g->origin_y) * inv,
+                          (x - g->origin_x) * inv, (y - g->origin_y) * inv))
+            return 0;
+        px = x;
+        py = y;
+    }
+    return 1;
+}
+
+int plan_to_samples(const OccupancyGrid *g, const PlanPath *path, const PlanProfile *prof,
+                    TrajSample **samples, size_t *count) {
+    int32_t c = path->count > 0 ? path->cells[0] : 0;
+    return plan_to_samples_at(g, path, prof, g->origin_x + (c % g->width + 0.5) * g->resolution,
+                              g->origin_y + (c / g->width + 0.5) * g->resolution, samples, count);
+}
+
+int plan_to_samples_at(const OccupancyGrid *g, const PlanPath *path, const PlanProfile *prof,
+                       double x0, double y0, TrajSample **samples, size_t *count) {
+    int w = g->width;
+    double res = g->resolution;
+    if (path->count < 1 || !(prof->speed > 0.0) || !(prof->accel > 0.0) || !(prof->dt > 0.0)) {
+        LOG_ERROR("Caminho vazio ou perfil inválido (v=%g, a=%g, dt=%g)\n", prof->speed, prof->accel, prof->dt);
+        return -1;
+    }
+
+    // 1. Atalhos por linha de visada entre centros de células (em células)
+    int *keep = malloc((size_t)path->count * sizeof(int));
+    if (!keep) return -1;
+    int nk = 0, anchor = 0;
+    keep[nk++] = 0;
+    for (int j = 1; j < path->count; j++) {
+        int32_t a = path->cells[anchor], b = path->cells[j];
+        if (!segment_free(g, a % w + 0.5, a / w + 0.5, b % w + 0.5, b / w + 0.5)) {
+            anchor = j - 1;
+            keep[nk++] = anchor;
+        }
+    }
+    if (keep[nk - 1] != path->count - 1) keep[nk++] = path->count - 1;
+
+    double *wx = malloc((size_t)nk * sizeof(double)), *wy = malloc((size_t)nk * sizeof(double));
+    Polyline poly = { 0 };
+    double *s = NULL, *v = NULL, *t = NULL;
+    int status = -1;
+    if (!wx || !wy) goto done;
+    for (int i = 0; i < nk; i++) {
+        int32_t c = path->cells[keep[i]];
+        wx[i] = g->origin_x + (c % w + 0.5) * res;
+        wy[i] = g->origin_y + (c / w + 0.5) * res;
+    }
+    wx[0] = x0;  // Partida exata, dentro da primeira célula
+    wy[0] = y0;
+
+    // 2. Polilinha densa com as quinas arredondadas
+    double ds = fmin(0.25 * res, 0.5 * prof->speed * prof->dt);
+    if (poly_push(&poly, wx[0], wy[0]) != 0) goto done;
+    for (int k = 1; k < nk - 1; k++) {
+        double lin = hypot(wx[k] - wx[k - 1], wy[k] - wy[k - 1]), lout = hypot(wx[k + 1] - wx[k], wy[k + 1] - wy[k]);
+        double d = fmin(prof->blend, 0.5 * fmin(lin, lout));
+        double ax = 0, ay = 0, bx = 0, by = 0;
+        int tries = 0;
+        for (; tries <= BLEND_TRIES && d > 0.0; tries++, d *= 0.5) {
+            ax = wx[k] - d * (wx[k] - wx[k - 1]) / lin;
+            ay = wy[k] - d * (wy[k] - wy[k - 1]) / lin;
+            bx = wx[k] + d * (wx[k + 1] - wx[k]) / lout;
+            by = wy[k] + d * (wy[k + 1] - wy[k]) / lout;
+            if (bezier_free(g, ax, ay, wx[k], wy[k], bx, by)) break;
+        }
+        if (d <= 0.0 || tries > BLEND_TRIES) {
+            if (poly_line_to(&poly, wx[k], wy[k], ds) != 0) goto done;  // Quina mantida
+            continue;
+        }
+        if (poly_line_to(&poly, ax, ay, ds) != 0) goto done;
+        int n = (int)ceil(2.0 * d / ds);
+        for (int i = 1; i <= n; i++) {
+            double x, y;
+            bezier(ax, ay, wx[k], wy[k], bx, by, (double)i / n, &x, &y);
+            if (poly_push(&poly, x, y) != 0) goto done;
+        }
+    }
+    if (poly_line_to(&poly, wx[nk - 1], wy[nk - 1], ds) != 0) goto done;
+
+    // 3. Perfil de velocidade: limite centrípeto (curvatura pelos três
+    //    pontos vizinhos) e aceleração tangencial nos dois sentidos
+    size_t n = poly.count;
+    s = malloc(n * sizeof(double));
+    v = malloc(n * sizeof(double));
+    t = malloc(n * sizeof(double));
+    if (!s || !v || !t) goto done;
+    s[0] = 0.0;
+    for (size_t i = 1; i < n; i++) s[i] = s[i - 1] + hypot(poly.x[i] - poly.x[i - 1], poly.y[i] - poly.y[i - 1]);
+    for (size_t i = 0; i < n; i++) {
+        v[i] = prof->speed;
+        if (i == 0 || i + 1 == n) continue;
+        double ux = poly.x[i] - poly.x[i - 1], uy = poly.y[i] - poly.y[i - 1];
+        double vx = poly.x[i + 1] - poly.x[i], vy = poly.y[i + 1] - poly.y[i];
+        double cross = fabs(ux * vy - uy * vx);
+        double abc = hypot(ux, uy) * hypot(vx, vy) * hypot(ux + vx, uy + vy);
+        double kappa = abc > 0.0 ? 2.0 * cross / abc : 0.0;
+        if (kappa > 0.0) v[i] = fmin(v[i], sqrt(prof->accel / kappa));
+    }
+    v[0] = 0.0;
+    if (n > 1) v[n - 1] = 0.0;
+    for (size_t i = 1; i < n; i++) v[i] = fmin(v[i], sqrt(v[i - 1] * v[i - 1] + 2.0 * prof->accel * (s[i] - s[i - 1])));
+    for (size_t i = n - 1; i-- > 0;) v[i] = fmin(v[i], sqrt(v[i + 1] * v[i + 1] + 2.0 * prof->accel * (s[i + 1] - s[i])));
+
+    // Tempo de cada ponto (aceleração constante entre pontos)
+    t[0] = 0.0;
+    for (size_t i = 1; i < n; i++) {
+        double vm = v[i - 1] + v[i];  // Nulo só num trecho único: acelera e freia nele
+        t[i] = t[i - 1] + (vm > 0.0 ? 2.0 * (s[i] - s[i - 1]) / vm : 2.0 * sqrt((s[i] - s[i - 1]) / prof->accel));
+    }
+
+    // 4. Amostras uniformes no tempo, com uma além do fim (parada)
+    size_t m = (size_t)ceil(t[n - 1] / prof->dt) + 2;
+    TrajSample *out = malloc(m * sizeof(TrajSample));
+    if (!out) goto done;
+    size_t i = 0;
+    for (size_t k = 0; k < m; k++) {
+        double tk = k * prof->dt;
+        while (i + 1 < n && t[i + 1] < tk) i++;
+        if (i + 1 >= n || tk >= t[n - 1]) {
+            out[k] = (TrajSample){ poly.x[n - 1], poly.y[n - 1], 0.0, 0.0 };
+            continue;
+        }
+        double f = (tk - t[i]) / (t[i + 1] - t[i]), len = s[i + 1] - s[i];
+        double speed = v[i] + f * (v[i + 1] - v[i]);
+        double tx = (poly.x[i + 1] - poly.x[i]) / len, ty = (poly.y[i + 1] - poly.y[i]) / len;
+        // Posição pelo espaço percorrido com aceleração constante no trecho
+        double along = (v[i] + 0.5 * (speed - v[i])) * (tk - t[i]);
+        out[k] = (TrajSample){ poly.x[i] + tx * along, poly.y[i] + ty * along, speed * tx, speed * ty };
+    }
+    *samples = out;
+    *count = m;
+    status = 0;
+    LOG_DEBUG("Plano: %d células, %d vértices após atalhos, %.2f m em %.2f s\n",
+              path->count, nk, s[n - 1], t[n - 1]);
+
+done:
+    free(keep);
+    free(wx);
+    free(wy);
+    free(poly.x);
+    free(poly.y);
+    free(s);
+    free(v);
+    free(t);
+    return status;
+}
+
+// ==========================
+// Segmento 'plan' das especificações
+// ==========================
+
+int plan_spec_parse(const char *args, PlanSpec *out) {
+    int consumed;
+    if (sscanf(args, "%1023s%n", out->map, &consumed) != 1) return -1;
+    double nums[9];
+    int n = 0;
+    const char *s = args + consumed;
+    char *end;
+    while (n < 9) {
+        nums[n] = strtod(s, &end);
+        if (end == s) break;
+        n++;
+        s = end;
+    }
+    if (n < 7 || !(nums[0] > 0.0)) return -1;
+    out->resolution = nums[0];
+    out->x0 = nums[1];
+    out->y0 = nums[2];
+    out->x1 = nums[3];
+    out->y1 = nums[4];
+    out->margin = n > 7 ? nums[7] : 0.0;
+    out->profile = (PlanProfile){ nums[5], nums[6], n > 8 ? nums[8] : PLAN_BLEND, PLAN_DT };
+    return 0;
+}
@@ -2,96 +2,71 @@
 FILE: plot.py
 DESCRIPTION:
     Script Python que gera os gráficos das trajetórias simuladas,
-    incluindo y(t), xref(t) e yref(t).
+    incluindo y(t), xref(t) e yref(t). Lê apenas as séries já reduzidas
+    pelo analisador nativo (build/analyze → data/analise.csv), de modo que
+    o custo de renderização independe da duração da simulação.
 AUTHOR: Darlysson Lima
-LAST UPDATE: Julho, 2025
+LAST UPDATE: Outubro, 2026
 LICENSE: CC BY-SA
 """
 
 
-import pandas as pd
+import csv
+import sys
+from collections import defaultdict
+
 import matplotlib.pyplot as plt
-import numpy as np
 
-def main():
-    # Carrega CSV
-    df = pd.read_csv('data/saida.csv')
 
-    # Extrai colunas
-    tempo = df['t']
-    x_real = df['y1']
-    y_real = df['y2']
-    x_ref = df['xref']
-    y_ref = df['yref']
-    theta = df['x3']
+def carrega_series(caminho):
+    # Formato longo: serie,a,b (a = tempo ou x; b = valor ou y)
+    series = defaultdict(lambda: ([], []))
+    with open(caminho, newline='') as arquivo:
+        for linha in csv.DictReader(arquivo):
+            a, b = series[linha['serie']]
+            a.append(float(linha['a']))
+            b.append(float(linha['b']))
+    return series
 
-    # Calcula erro
-    erro_x = x_ref - x_real
-    erro_y = y_ref - y_real
 
-    # ============= Gráfico 1: Posição X(t) =============
-    plt.figure(figsize=(8,5))
-    plt.plot(tempo, x_ref, 'r--', label='X de Referência')
-    plt.plot(tempo, x_real, 'b-', label='X Real')
-    plt.xlabel('Tempo (s)')
-    plt.ylabel('X (m)')
-    plt.title('Componente X ao longo do tempo')
+def grafico(nome, titulo, xlabel, ylabel, curvas, figsize=(8, 5)):
+    plt.figure(figsize=figsize)
+    for (a, b), estilo, rotulo in curvas:
+        plt.plot(a, b, estilo, label=rotulo)
+    plt.xlabel(xlabel)
+    plt.ylabel(ylabel)
+    plt.title(titulo)
     plt.legend()
     plt.grid(True)
     plt.tight_layout()
-    plt.savefig('data/posicao_x.png')
+    plt.savefig(nome)
     plt.close()
 
+
+def main():
+    s = carrega_series(sys.argv[1] if len(sys.argv) > 1 else 'data/analise.csv')
+
+    # ============= Gráfico 1: Posição X(t) =============
+    grafico('data/posicao_x.png', 'Componente X ao longo do tempo', 'Tempo (s)', 'X (m)',
+            [(s['xref'], 'r--', 'X de Referência'), (s['y1'], 'b-', 'X Real')])
+
     # ============= Gráfico 2: Posição Y(t) =============
-    plt.figure(figsize=(8,5))
-    plt.plot(tempo, y_ref, 'r--', label='Y de Referência')
-    plt.plot(tempo, y_real, 'b-', label='Y Real')
-    plt.xlabel('Tempo (s)')
-    plt.ylabel('Y (m)')
-    plt.title('Componente Y ao longo do tempo')
-    plt.legend()
-    plt.grid(True)
-    plt.tight_layout()
-    plt.savefig('data/posicao_y.png')
-    plt.close()
+    grafico('data/posicao_y.png', 'Componente Y ao longo do tempo', 'Tempo (s)', 'Y (m)',
+            [(s['yref'], 'r--', 'Y de Referência'), (s['y2'], 'b-', 'Y Real')])
 
     # ============= Gráfico 3: Trajetória XY =============
-    plt.figure(figsize=(8,6))
-    plt.plot(x_ref, y_ref, 'r--', label='Trajetória de Referência')
-    plt.plot(x_real, y_real, 'b-', label='Trajetória Real')
-    plt.xlabel('X (m)')
-    plt.ylabel('Y (m)')
-    plt.title('Trajetória no Plano XY')
-    plt.legend()
-    plt.grid(True)
-    plt.tight_layout()
-    plt.savefig('data/trajetoria_xy.png')
-    plt.close()
+    grafico('data/trajetoria_xy.png', 'Trajetória no Plano XY', 'X (m)', 'Y (m)',
+            [(s['xy_ref'], 'r--', 'Trajetória de Referência'), (s['xy_real'], 'b-', 'Trajetória Real')],
+            figsize=(8, 6))
 
     # ============= Gráfico 4: Erro de rastreamento =============
-    plt.figure(figsize=(8,5))
-    plt.plot(tempo, erro_x, 'g-', label='Erro em X')
-    plt.plot(tempo, erro_y, 'm-', label='Erro em Y')
-    plt.xlabel('Tempo (s)')
-    plt.ylabel('Erro (m)')
-    plt.title('Erro de Rastreamento ao longo do tempo')
-    plt.legend()
-    plt.grid(True)
-    plt.tight_layout()
-    plt.savefig('data/erro_rastreamento.png')
-    plt.close()
+    grafico('data/erro_rastreamento.png', 'Erro de Rastreamento ao longo do tempo', 'Tempo (s)', 'Erro (m)',
+            [(s['erro_x'], 'g-', 'Erro em X'), (s['erro_y'], 'm-', 'Erro em Y')])
 
     # ============= Gráfico 5: Ângulo da frente (theta) =============
-    plt.figure(figsize=(8,5))
-    plt.plot(tempo, theta, 'c-', label='Ângulo θ(t)')
-    plt.xlabel('Tempo (s)')
-    plt.ylabel('Ângulo (rad)')
-    plt.title('Ângulo da Frente do Robô ao longo do tempo')
-    plt.legend()
-    plt.grid(True)
-    plt.tight_layout()
-    plt.savefig('data/angulo_theta.png')
-    plt.close()
+    if 'theta' in s:
+        grafico('data/angulo_theta.png', 'Ângulo da Frente do Robô ao longo do tempo', 'Tempo (s)', 'Ângulo (rad)',
+                [(s['theta'], 'c-', 'Ângulo θ(t)')])
 
     print("[INFO] Todos os gráficos foram gerados em data/")
 
@@ -2,68 +2,93 @@
     FILE: ref_generator_thread.c
     DESCRIPTION:
         Implementa a thread de geração das referências xref(t) e yref(t).
-        As referências são baseadas em funções senoidais com dependência do tempo.
+        As referências vêm de uma tabela de trajetória pré-calculada (consulta O(1)).
+        Com eventos de mapa (replan.h), a thread os aplica no seu instante e,
+        se o caminho ficar bloqueado, publica o plano refeito pelo D* Lite a
+        partir do fim do horizonte.
+        A cada período a thread estende o horizonte de amostras futuras
+        (ref_preview.h) até tempo + preview_horizon_s; os consumidores
+        interpolam nesse horizonte no seu próprio instante.
     AUTHOR: Darlysson Lima
     LAST UPDATE: Julho, 2025
     LICENSE: CC BY-SA
 */
 
-#define _POSIX_C_SOURCE 199309L
+#define _POSIX_C_SOURCE 200112L
 #include <time.h>
 #include <unistd.h>
 #include <math.h>
 #include "monitors.h"  // Para acessar dados compartilhados entre threads
+#include "threads.h"   // Protótipos das threads e dos corpos das ativações
 #include "logs.h"      // Para log de eventos
+#include "trajectory.h"  // Consulta à tabela de trajetória
+#include "ref_preview.h" // Horizonte de referências sem travas
 
-#define PERIOD_MS 120  // Período de execução da thread em ms
+/* Corpo de uma ativação: estende o horizonte e publica a referência atual (sem espera) */
+void ref_generator_step(ArgsModel *args) {
+    MonitorReferencia *r = args->r;
+    MonitorTempo *t = args->t;
+    const ScenarioConfig *cfg = args->cfg;
+    const Trajectory *traj = args->traj;
+    Replanner *rp = args->replan;
+
+    double tempo = monitor_tempo_exato(t);
+
+    // Eventos de mapa vencidos: o caminho bloqueado é refeito a partir do fim do horizonte
+    if (rp) replanner_update(rp, traj, &r->preview, tempo);
+
+    // Publica as amostras futuras até cobrir o horizonte (produtor único, sem travas),
+    // carimbadas com o instante desta publicação (origem da referência na cadeia)
+    double agora = data_age_now();
+    double until = tempo + cfg->preview_horizon_s;
+    if (rp && rp->active) {
+        ref_preview_fill_from(&r->preview, &rp->plan, rp->t0, until, agora);
+    } else {
+        ref_preview_fill(&r->preview, traj, until, agora);
+    }
+
+    // Consulta da referência (posição e velocidade de feedforward) no tempo atual; após
+    // um replanejamento ela sai do próprio horizonte, que ainda guarda o plano anterior
+    // até o ponto de troca
+    TrajPoint ref;
+    RefPreviewSample amostra;
+    if (rp && rp->active && ref_preview_sample(&r->preview, tempo, &amostra) == 0) {
+        ref = (TrajPoint){ amostra.x, amostra.y, amostra.dx, amostra.dy };
+    } else {
+        ref = trajectory_eval(traj, tempo);
+    }
 
-#ifndef M_PI
-#define M_PI 3.14159265358979323846  // Definir M_PI se não estiver definido
-#endif
+    // Atualiza o monitor de referência (a referência é uma fonte da cadeia de dados)
+    pthread_mutex_lock(&r->mutex);
+    r->xref = ref.x;
+    r->yref = ref.y;
+    r->dxref = ref.dx;
+    r->dyref = ref.dy;
+    data_stamp_source(&r->carimbo, DATA_SRC_REFERENCIA, agora);
+    pthread_mutex_unlock(&r->mutex);
+
+    // Registra no log a atualização das referências
+    LOG_DEBUG("Referência atualizada: t=%.2f → xref=%.2f, yref=%.2f\n", tempo, ref.x, ref.y);
+}
 
 /* Função da thread de geração de referências (xref, yref) */
 void *ref_generator_thread(void *arg) {
     ArgsModel *args = (ArgsModel *)arg;
-    MonitorReferencia *r = args->r;
-    MonitorTempo *t = args->t;
+    const ScenarioConfig *cfg = args->cfg;  // Período de publicação
 
     LOG_DEBUG("Thread de referência iniciada.\n");
 
+    // Aguarda a partida comum liberada pelo supervisor
     struct timespec next_activation;
-    clock_gettime(CLOCK_MONOTONIC, &next_activation);  // Define o tempo inicial
-
-    while (1) {
-        // Verifica o tempo atual de simulação
-        pthread_mutex_lock(&t->mutex);
-        if (t->encerrar) {
-            pthread_mutex_unlock(&t->mutex);
-            pthread_exit(NULL);  // Encerra a thread se a flag 'encerrar' for setada
-        }
-        double tempo = t->tempo_atual;
-        pthread_mutex_unlock(&t->mutex);
-
-        // Cálculo da referência xref e yref com base no tempo
-        double xref = (5.0 / M_PI) * cos(0.2 * M_PI * tempo);
-        double yref = (tempo < 10.0) ?
-            (5.0 / M_PI) * sin(0.2 * M_PI * tempo) : 
-            -(5.0 / M_PI) * sin(0.2 * M_PI * tempo);
-
-        // Atualiza o monitor de referência
-        pthread_mutex_lock(&r->mutex);
-        r->xref = xref;
-        r->yref = yref;
-        pthread_mutex_unlock(&r->mutex);
+    int ativo = supervisor_start(&next_activation);
 
-        // Registra no log a atualização das referências
-        LOG_DEBUG("Referência atualizada: t=%.2f → xref=%.2f, yref=%.2f\n", tempo, xref, yref);
+    while (ativo) {
+        // Corpo da ativação (isolado da espera para benchmarks)
+        ref_generator_step(args);
 
-        // Espera até o próximo instante
-        next_activation.tv_nsec += PERIOD_MS * 1e6;
-        while (next_activation.tv_nsec >= 1e9) {
-            next_activation.tv_sec++;
-            next_activation.tv_nsec -= 1e9;
-        }
-        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_activation, NULL);
+        // Dorme até o próximo período (o encerramento acorda a thread imediatamente)
+        supervisor_advance(&next_activation, cfg->ref_period_ms);
+        ativo = supervisor_sleep_until(&next_activation);
     }
 
     pthread_exit(NULL);  // Encerra a thread
@@ -0,0 +1,183 @@
+/*
+    FILE: ref_preview.c
+    DESCRIPTION:
+        Implementa o horizonte de referências sem travas (ref_preview.h).
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <math.h>
+#include "ref_preview.h"
+
+// Cópia local de uma amostra lida do anel
+typedef struct {
+    unsigned long index;
+    double x, y, dx, dy;
+} SlotCopy;
+
+void ref_preview_init(RefPreview *rp, double dt) {
+    for (unsigned i = 0; i < REF_PREVIEW_CAPACITY; i++) {
+        RefPreviewSlot *s = &rp->slots[i];
+        atomic_init(&s->seq, 0);
+        atomic_init(&s->index, 0);
+        atomic_init(&s->x, 0.0);
+        atomic_init(&s->y, 0.0);
+        atomic_init(&s->dx, 0.0);
+        atomic_init(&s->dy, 0.0);
+    }
+    atomic_init(&rp->head, 0);
+    atomic_init(&rp->ativacao, 0.0);
+    rp->dt = dt;
+}
+
+void ref_preview_push(RefPreview *rp, double x, double y, double dx, double dy, double publicado) {
+    unsigned long k = atomic_load_explicit(&rp->head, memory_order_relaxed);
+    RefPreviewSlot *s = &rp->slots[k & REF_PREVIEW_MASK];
+
+    // Marca a posição como em escrita (ímpar) antes de alterar os dados
+    unsigned long seq = atomic_load_explicit(&s->seq, memory_order_relaxed);
+    atomic_store_explicit(&s->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&s->index, k, memory_order_relaxed);
+    atomic_store_explicit(&s->x, x, memory_order_relaxed);
+    atomic_store_explicit(&s->y, y, memory_order_relaxed);
+    atomic_store_explicit(&s->dx, dx, memory_order_relaxed);
+    atomic_store_explicit(&s->dy, dy, memory_order_relaxed);
+
+    // Conclui a escrita (par) e publica a nova amostra
+    atomic_store_explicit(&s->seq, seq + 2, memory_order_release);
+    atomic_store_explicit(&rp->ativacao, publicado, memory_order_relaxed);
+    atomic_store_explicit(&rp->head, k + 1, memory_order_release);
+}
+
+void ref_preview_fill(RefPreview *rp, const Trajectory *traj, double until, double publicado) {
+    ref_preview_fill_from(rp, traj, 0.0, until, publicado);
+}
+
+void ref_preview_fill_from(RefPreview *rp, const Trajectory *traj, double t0, double until, double publicado) {
+    unsigned long k = atomic_load_explicit(&rp->head, memory_order_relaxed);
+    while (k * rp->dt <= until) {
+        TrajPoint p = trajectory_eval(traj, k * rp->dt - t0);
+        ref_preview_push(rp, p.x, p.y, p.dx, p.dy, publicado);
+        k++;
+    }
+    atomic_store_explicit(&rp->ativacao, publicado, memory_order_release);
+}
+
+unsigned long ref_preview_published(const RefPreview *rp) {
+    return atomic_load_explicit(&rp->head, memory_order_acquire);
+}
+
+/* Lê uma posição de forma consistente; retorna 0 se a amostra k ainda está no anel */
+static int read_slot(const RefPreview *rp, unsigned long k, SlotCopy *out) {
+    const RefPreviewSlot *s = &rp->slots[k & REF_PREVIEW_MASK];
+    for (;;) {
+        unsigned long seq1 = atomic_load_explicit(&s->seq, memory_order_acquire);
+        if (seq1 & 1u) continue;  // Produtor escrevendo nesta posição
+
+        out->index = atomic_load_explicit(&s->index, memory_order_relaxed);
+        out->x = atomic_load_explicit(&s->x, memory_order_relaxed);
+        out->y = atomic_load_explicit(&s->y, memory_order_relaxed);
+        out->dx = atomic_load_explicit(&s->dx, memory_order_relaxed);
+        out->dy = atomic_load_explicit(&s->dy, memory_order_relaxed);
+
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&s->seq, memory_order_relaxed) == seq1) break;
+    }
+    return out->index == k ? 0 : -1;
+}
+
+/* Janela segura com head amostras publicadas: a posição head pode estar
+   sendo reescrita pelo produtor. Define a amostra k e a fração f de t. */
+static void locate(unsigned long head, double dt, double t, unsigned long *k, double *f) {
+    unsigned long oldest = head > REF_PREVIEW_CAPACITY ? head - REF_PREVIEW_CAPACITY + 1 : 0;
+    unsigned long newest = head - 1;
+
+    double u = t / dt;
+    if (u <= (double)oldest) {
+        *k = oldest;
+        *f = 0.0;
+    } else if (u >= (double)newest) {
+        *k = newest;
+        *f = 0.0;
+    } else {
+        *k = (unsigned long)u;
+        *f = u - (double)*k;
+    }
+}
+
+/* Hermite cúbica com derivadas escaladas por dt (mesma forma de trajectory_eval) */
+static void hermite(double dt, unsigned long k, double f, const SlotCopy *a, const SlotCopy *b,
+                    RefPreviewSample *out) {
+    double f2 = f * f, f3 = f2 * f;
+    double h00 = 2 * f3 - 3 * f2 + 1;
+    double h10 = (f3 - 2 * f2 + f) * dt;
+    double h01 = -2 * f3 + 3 * f2;
+    double h11 = (f3 - f2) * dt;
+
+    out->t = ((double)k + f) * dt;
+    out->x = h00 * a->x + h10 * a->dx + h01 * b->x + h11 * b->dx;
+    out->y = h00 * a->y + h10 * a->dy + h01 * b->y + h11 * b->dy;
+    out->dx = a->dx + f * (b->dx - a->dx);
+    out->dy = a->dy + f * (b->dy - a->dy);
+}
+
+int ref_preview_sample(const RefPreview *rp, double t, RefPreviewSample *out) {
+    for (;;) {
+        unsigned long head = atomic_load_explicit(&rp->head, memory_order_acquire);
+        if (head == 0) return -1;
+
+        unsigned long k;
+        double f;
+        locate(head, rp->dt, t, &k, &f);
+
+        SlotCopy a, b;
+        if (read_slot(rp, k, &a) != 0) continue;  // Sobrescrita: recalcula a janela
+        if (f == 0.0) {
+            b = a;
+        } else if (read_slot(rp, k + 1, &b) != 0) {
+            continue;
+        }
+
+        hermite(rp->dt, k, f, &a, &b, out);
+        out->publicado = atomic_load_explicit(&rp->ativacao, memory_order_acquire);
+        return 0;
+    }
+}
+
+unsigned long ref_preview_extent(double dt, unsigned long head, double until) {
+    while (head * dt <= until) head++;
+    return head;
+}
+
+/* Amostra k da tabela, exatamente como ref_preview_fill a publicaria */
+static void table_slot(const Trajectory *traj, double dt, unsigned long k, SlotCopy *out) {
+    TrajPoint p = trajectory_eval(traj, k * dt);
+    out->index = k;
+    out->x = p.x;
+    out->y = p.y;
+    out->dx = p.dx;
+    out->dy = p.dy;
+}
+
+int ref_preview_eval(const Trajectory *traj, double dt, unsigned long head, double t,
+                     RefPreviewSample *out) {
+    if (head == 0) return -1;
+
+    unsigned long k;
+    double f;
+    locate(head, dt, t, &k, &f);
+
+    SlotCopy a, b;
+    table_slot(traj, dt, k, &a);
+    if (f == 0.0) {
+        b = a;
+    } else {
+        table_slot(traj, dt, k + 1, &b);
+    }
+    hermite(dt, k, f, &a, &b, out);
+    out->publicado = 0.0;  // Sem gerador: não há ativação a registrar
+    return 0;
+}
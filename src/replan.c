@@ -0,0 +1,253 @@
+/*
+    FILE: replan.c
+    DESCRIPTION:
+        Implementa o replanejamento em execução do segmento 'plan'
+        (replan.h): eventos de mapa, atualização incremental do D* Lite e
+        troca do plano publicado pelo gerador de referências.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "replan.h"
+#include "logs.h"
+
+#define CHANGED_INITIAL 256
+
+// ==========================
+// Leitura da especificação
+// ==========================
+
+/* Lê "t x0 y0 x1 y1" de um evento block/clear */
+static int parse_event(MapEvent *ev, const char *rest, int occupied) {
+    char extra;
+    if (sscanf(rest, "%lf %lf %lf %lf %lf %c", &ev->t, &ev->x0, &ev->y0, &ev->x1, &ev->y1, &extra) != 5)
+        return -1;
+    ev->occupied = occupied;
+    return ev->t >= 0.0 && isfinite(ev->t) ? 0 : -1;
+}
+
+/* Lê a linha plan e os eventos; conta os segmentos para exigir um plan único */
+static int read_spec(Replanner *rp, const char *path, int *segments, int *plans) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        LOG_ERROR("Não foi possível abrir a trajetória '%s'\n", path);
+        return -1;
+    }
+    int status = 0, line_no = 0;
+    char line[32768];
+    while (fgets(line, sizeof(line), file)) {
+        line_no++;
+        char *comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+
+        char kind[32];
+        int consumed;
+        if (sscanf(line, "%31s%n", kind, &consumed) != 1) continue;
+
+        int block = strcmp(kind, "block") == 0;
+        if (block || strcmp(kind, "clear") == 0) {
+            MapEvent *ev = &rp->events[rp->n_events];
+            if (rp->n_events == REPLAN_MAX_EVENTS || parse_event(ev, line + consumed, block) != 0 ||
+                (rp->n_events > 0 && ev->t < ev[-1].t)) {
+                LOG_ERROR("%s:%d: evento de mapa inválido (até %d, em ordem de tempo)\n", path, line_no,
+                          REPLAN_MAX_EVENTS);
+                status = -1;
+                break;
+            }
+            rp->n_events++;
+            continue;
+        }
+        (*segments)++;
+        if (strcmp(kind, "plan") == 0 && plan_spec_parse(line + consumed, &rp->spec) == 0) (*plans)++;
+    }
+    fclose(file);
+    return status;
+}
+
+// ==========================
+// Mapa
+// ==========================
+
+/* Cria uma grade com as dimensões e a origem de src (conteúdo copiado se copy) */
+static int grid_clone(OccupancyGrid *dst, const OccupancyGrid *src, int copy) {
+    if (grid_init(dst, src->width, src->height, src->resolution) != 0) return -1;
+    dst->origin_x = src->origin_x;
+    dst->origin_y = src->origin_y;
+    if (copy) memcpy(dst->words, src->words, (size_t)(src->height + 2) * src->stride * sizeof(uint64_t));
+    return 0;
+}
+
+/* Coordenada (m) para índice de célula, limitada a um passo além da grade */
+static int cell_index(double v, double origin, double res, int n) {
+    double f = floor((v - origin) / res);
+    return f < -1.0 ? -1 : f > n ? n : (int)f;
+}
+
+static int push_changed(Replanner *rp, int32_t cell, int *n) {
+    if (*n == rp->changed_capacity) {
+        int cap = rp->changed_capacity ? 2 * rp->changed_capacity : CHANGED_INITIAL;
+        int32_t *grown = realloc(rp->changed, (size_t)cap * sizeof(int32_t));
+        if (!grown) {
+            LOG_ERROR("Falha ao alocar as células alteradas do mapa\n");
+            return -1;
+        }
+        rp->changed = grown;
+        rp->changed_capacity = cap;
+    }
+    rp->changed[(*n)++] = cell;
+    return 0;
+}
+
+/* Aplica um evento ao mapa, engorda o resultado e avisa o D* Lite das
+   células cuja ocupação mudou no mapa engordado */
+static int apply_event(Replanner *rp, const MapEvent *ev) {
+    OccupancyGrid *m = &rp->map;
+    double res = m->resolution;
+    grid_fill_rect(m, cell_index(fmin(ev->x0, ev->x1), m->origin_x, res, m->width),
+                   cell_index(fmin(ev->y0, ev->y1), m->origin_y, res, m->height),
+                   cell_index(fmax(ev->x0, ev->x1), m->origin_x, res, m->width),
+                   cell_index(fmax(ev->y0, ev->y1), m->origin_y, res, m->height), ev->occupied);
+
+    memcpy(rp->scratch.words, m->words, (size_t)(m->height + 2) * m->stride * sizeof(uint64_t));
+    if (grid_inflate(&rp->scratch, rp->margin) != 0) return -1;
+
+    // Diferença palavra a palavra (64 células por vez); as molduras não mudam
+    int n = 0, inner = m->stride - 2;
+    for (int y = 0; y < m->height; y++) {
+        const uint64_t *a = grid_row(&rp->grid, y) + 1, *b = grid_row(&rp->scratch, y) + 1;
+        for (int w = 0; w < inner; w++) {
+            for (uint64_t diff = a[w] ^ b[w]; diff; diff &= diff - 1) {
+                int x = 64 * w + __builtin_ctzll(diff);
+                if (x >= m->width) break;
+                if (push_changed(rp, y * m->width + x, &n) != 0) return -1;
+            }
+        }
+    }
+
+    // O D* Lite guarda o endereço de grid: troca só as palavras
+    uint64_t *words = rp->grid.words;
+    rp->grid.words = rp->scratch.words;
+    rp->scratch.words = words;
+    dstar_cells_changed(&rp->dstar, rp->changed, n);
+    LOG_DEBUG("Evento de mapa em t=%.2f s: %s, %d células alteradas\n", ev->t,
+              ev->occupied ? "bloqueio" : "liberação", n);
+    return 0;
+}
+
+// ==========================
+// Replanejamento
+// ==========================
+
+/* Referência em t >= t0 do plano em curso (ou da tabela, antes do primeiro replanejamento) */
+static TrajPoint reference_at(const Replanner *rp, const Trajectory *traj, double t) {
+    return rp->active ? trajectory_eval(&rp->plan, t - rp->t0) : trajectory_eval(traj, t);
+}
+
+/* Verifica se a referência de t0 até o fim do plano cruza uma célula ocupada */
+static int path_blocked(const Replanner *rp, const Trajectory *traj, double t0) {
+    double end = rp->active ? rp->t0 + rp->plan.duration : traj->duration;
+    double dt = rp->spec.profile.dt;
+    for (long k = 0;; k++) {
+        double t = fmin(t0 + k * dt, end);
+        TrajPoint p = reference_at(rp, traj, t);
+        int cx, cy;
+        if (grid_cell_of(&rp->grid, p.x, p.y, &cx, &cy) == 0 && grid_occupied(&rp->grid, cx, cy)) return 1;
+        if (t >= end) return 0;
+    }
+}
+
+int replanner_load(Replanner *rp, const ScenarioConfig *cfg) {
+    memset(rp, 0, sizeof(*rp));
+    const char *name = cfg->trajectory;
+    size_t len = strlen(name);
+    if (strcmp(name, "figure8") == 0 || (len > 4 && strcmp(name + len - 4, ".bin") == 0)) return 0;
+
+    int segments = 0, plans = 0;
+    if (read_spec(rp, name, &segments, &plans) != 0) return -1;
+    if (rp->n_events == 0) return 0;
+    if (segments != 1 || plans != 1) {
+        LOG_ERROR("%s: eventos de mapa exigem um único segmento, do tipo plan\n", name);
+        return -1;
+    }
+
+    // Mapa sem folga, mapa engordado e D* Lite já resolvido para o caminho inicial
+    PlanSpec *s = &rp->spec;
+    int sx, sy, gx, gy;
+    rp->margin = (int)ceil(s->margin / s->resolution);
+    if (grid_load_pbm(&rp->map, s->map, s->resolution) != 0) return -1;
+    if (grid_clone(&rp->grid, &rp->map, 1) != 0 || grid_clone(&rp->scratch, &rp->map, 0) != 0 ||
+        grid_inflate(&rp->grid, rp->margin) != 0 || dstar_init(&rp->dstar, &rp->grid) != 0) {
+        replanner_free(rp);
+        return -1;
+    }
+    if (grid_cell_of(&rp->grid, s->x0, s->y0, &sx, &sy) != 0 || grid_cell_of(&rp->grid, s->x1, s->y1, &gx, &gy) != 0) {
+        LOG_ERROR("Partida ou destino fora do mapa '%s'\n", s->map);
+        replanner_free(rp);
+        return -1;
+    }
+    dstar_reset(&rp->dstar, sx, sy, gx, gy);
+    if (dstar_replan(&rp->dstar, &rp->path) != 0) {
+        LOG_ERROR("D* Lite: sem caminho livre de (%g, %g) a (%g, %g) em '%s'\n", s->x0, s->y0, s->x1, s->y1, s->map);
+        replanner_free(rp);
+        return -1;
+    }
+    return 0;
+}
+
+int replanner_update(Replanner *rp, const Trajectory *traj, const RefPreview *preview, double tempo) {
+    if (rp->next == rp->n_events || rp->events[rp->next].t > tempo) return 0;
+
+    // O plano novo assume a partir da última amostra já publicada
+    unsigned long head = ref_preview_published(preview);
+    if (head == 0) return 0;
+    double t0 = (head - 1) * preview->dt;
+    TrajPoint p = reference_at(rp, traj, t0);
+    int sx, sy;
+    int inside = grid_cell_of(&rp->grid, p.x, p.y, &sx, &sy) == 0;
+    if (inside) dstar_move_start(&rp->dstar, sx, sy);
+
+    while (rp->next < rp->n_events && rp->events[rp->next].t <= tempo) {
+        if (apply_event(rp, &rp->events[rp->next]) != 0) return -1;
+        rp->next++;
+    }
+    if (!path_blocked(rp, traj, t0)) return 0;
+
+    if (!inside || grid_occupied(&rp->grid, sx, sy)) {
+        LOG_ERROR("Replanejamento: referência em t=%.2f s (%.2f, %.2f) fora do espaço livre\n", t0, p.x, p.y);
+        return -1;
+    }
+    if (dstar_replan(&rp->dstar, &rp->path) != 0) {
+        LOG_ERROR("Replanejamento: sem caminho livre a partir de (%.2f, %.2f)\n", p.x, p.y);
+        return -1;
+    }
+    TrajSample *samples;
+    size_t count;
+    if (plan_to_samples_at(&rp->grid, &rp->path, &rp->spec.profile, p.x, p.y, &samples, &count) != 0) return -1;
+
+    double dt = rp->spec.profile.dt;
+    trajectory_free(&rp->plan);
+    rp->plan = (Trajectory){ .samples = samples, .count = count, .dt = dt, .inv_dt = 1.0 / dt,
+                             .duration = (count - 1) * dt, .owned = samples };
+    rp->t0 = t0;
+    rp->active = 1;
+    rp->replans++;
+    LOG_DEBUG("Replanejamento em t=%.2f s a partir de t=%.2f s: %d células, %ld expandidos, %.2f s de plano\n",
+              tempo, t0, rp->path.count, rp->path.expanded, rp->plan.duration);
+    return 1;
+}
+
+void replanner_free(Replanner *rp) {
+    grid_free(&rp->map);
+    grid_free(&rp->grid);
+    grid_free(&rp->scratch);
+    dstar_destroy(&rp->dstar);
+    plan_path_free(&rp->path);
+    free(rp->changed);
+    trajectory_free(&rp->plan);
+    memset(rp, 0, sizeof(*rp));
+}
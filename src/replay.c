@@ -0,0 +1,78 @@
+/*
+    FILE: replay.c
+    DESCRIPTION:
+        Implementa a gravação das ativações das leis (replay.h).
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <string.h>
+#include "replay.h"
+#include "numfmt.h"
+#include "logs.h"
+
+/* Monta "tag,v0,v1,...\n" com a representação mais curta de cada valor */
+static size_t format_record(char *buf, char tag, const double *values, int count) {
+    size_t n = 0;
+    buf[n++] = tag;
+    for (int i = 0; i < count; i++) {
+        buf[n++] = ',';
+        n += numfmt_double_shortest(buf + n, values[i]);
+    }
+    buf[n++] = '\n';
+    return n;
+}
+
+static void write_line(ReplayRecorder *rec, const char *line, size_t len) {
+    pthread_mutex_lock(&rec->mutex);
+    fwrite(line, 1, len, rec->file);
+    pthread_mutex_unlock(&rec->mutex);
+}
+
+int replay_recorder_open(ReplayRecorder *rec, const char *path, const ScenarioConfig *cfg) {
+    rec->file = fopen(path, "w");
+    if (!rec->file) {
+        LOG_ERROR("Não foi possível criar a gravação '%s'\n", path);
+        return -1;
+    }
+    pthread_mutex_init(&rec->mutex, NULL);
+
+    const char *names[] = { "R", "v_max", "w_max", "u1_max", "u2_max" };
+    const double values[] = { cfg->R, cfg->v_max, cfg->w_max, cfg->u1_max, cfg->u2_max };
+    char line[NUMFMT_DOUBLE_BUFSZ + 32];
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        size_t n = 0, len = strlen(names[i]);
+        line[n++] = '#';
+        line[n++] = ' ';
+        memcpy(line + n, names[i], len);
+        n += len;
+        line[n++] = '=';
+        n += numfmt_double_shortest(line + n, values[i]);
+        line[n++] = '\n';
+        fwrite(line, 1, n, rec->file);
+    }
+    return 0;
+}
+
+void replay_record_ctrl(ReplayRecorder *rec, const ReplayCtrl *c) {
+    const double values[REPLAY_CTRL_FIELDS] = {
+        c->t, c->xref, c->yref, c->ymx, c->dymx, c->ymy, c->dymy,
+        c->y1, c->y2, c->alpha1, c->alpha2, c->v1, c->v2
+    };
+    char line[REPLAY_CTRL_FIELDS * (NUMFMT_DOUBLE_BUFSZ + 1) + 4];
+    write_line(rec, line, format_record(line, 'c', values, REPLAY_CTRL_FIELDS));
+}
+
+void replay_record_lin(ReplayRecorder *rec, const ReplayLin *l) {
+    const double values[REPLAY_LIN_FIELDS] = { l->t, l->x3, l->v1, l->v2, l->u1, l->u2 };
+    char line[REPLAY_LIN_FIELDS * (NUMFMT_DOUBLE_BUFSZ + 1) + 4];
+    write_line(rec, line, format_record(line, 'l', values, REPLAY_LIN_FIELDS));
+}
+
+void replay_recorder_close(ReplayRecorder *rec) {
+    if (!rec->file) return;
+    fclose(rec->file);
+    rec->file = NULL;
+    pthread_mutex_destroy(&rec->mutex);
+}
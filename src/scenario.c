@@ -0,0 +1,400 @@
+/*
+    FILE: scenario.c
+    DESCRIPTION:
+        Implementa a leitura e validação da configuração de cenário.
+        A interpretação é guiada por uma tabela de campos (nome, tipo,
+        deslocamento na struct), de modo que um novo parâmetro exige apenas
+        uma linha na tabela.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include "scenario.h"
+#include "logs.h"
+#include "ref_preview.h"
+#include "mpc.h"
+#include "lqr.h"
+#include "integral.h"
+#include "telemetry.h"
+#include "fleet.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+
+// ==========================
+// Tabela de campos
+// ==========================
+
+typedef enum { FIELD_INT, FIELD_DOUBLE, FIELD_STRING } FieldType;
+
+typedef struct {
+    const char *name;
+    FieldType type;
+    size_t offset;
+} ScenarioField;
+
+#define FIELD(name, type) { #name, type, offsetof(ScenarioConfig, name) }
+
+static const ScenarioField FIELDS[] = {
+    FIELD(sim_period_ms, FIELD_INT),
+    FIELD(lin_period_ms, FIELD_INT),
+    FIELD(ctrl_period_ms, FIELD_INT),
+    FIELD(model_period_ms, FIELD_INT),
+    FIELD(ref_period_ms, FIELD_INT),
+    FIELD(logger_period_ms, FIELD_INT),
+    FIELD(interface_period_ms, FIELD_INT),
+    FIELD(timer_interval_ms, FIELD_INT),
+    FIELD(metrics_period_ms, FIELD_INT),
+    FIELD(watchdog_ms, FIELD_INT),
+    FIELD(sim_time_s, FIELD_DOUBLE),
+    FIELD(R, FIELD_DOUBLE),
+    FIELD(v_max, FIELD_DOUBLE),
+    FIELD(w_max, FIELD_DOUBLE),
+    FIELD(u1_max, FIELD_DOUBLE),
+    FIELD(u2_max, FIELD_DOUBLE),
+    FIELD(alpha1, FIELD_DOUBLE),
+    FIELD(alpha2, FIELD_DOUBLE),
+    FIELD(settle_band, FIELD_DOUBLE),
+    FIELD(metrics_window_s, FIELD_DOUBLE),
+    FIELD(trajectory, FIELD_STRING),
+    FIELD(trajectory_dt, FIELD_DOUBLE),
+    FIELD(preview_dt, FIELD_DOUBLE),
+    FIELD(preview_horizon_s, FIELD_DOUBLE),
+    FIELD(ctrl_ki, FIELD_DOUBLE),
+    FIELD(ctrl_ki_limit, FIELD_DOUBLE),
+    FIELD(controller, FIELD_STRING),
+    FIELD(mpc_horizon, FIELD_INT),
+    FIELD(mpc_q, FIELD_DOUBLE),
+    FIELD(mpc_r, FIELD_DOUBLE),
+    FIELD(mpc_max_iter, FIELD_INT),
+    FIELD(mpc_tol, FIELD_DOUBLE),
+    FIELD(lqr_q, FIELD_DOUBLE),
+    FIELD(lqr_q_theta, FIELD_DOUBLE),
+    FIELD(lqr_r, FIELD_DOUBLE),
+    FIELD(lqr_heading_bins, FIELD_INT),
+    FIELD(lqr_speed_bins, FIELD_INT),
+    FIELD(lqr_speed_min, FIELD_DOUBLE),
+    FIELD(lqr_error_max, FIELD_DOUBLE),
+    FIELD(estimator, FIELD_STRING),
+    FIELD(sensor_pos_std, FIELD_DOUBLE),
+    FIELD(sensor_theta_std, FIELD_DOUBLE),
+    FIELD(odom_std, FIELD_DOUBLE),
+    FIELD(odom_scale, FIELD_DOUBLE),
+    FIELD(odom_bias_w, FIELD_DOUBLE),
+    FIELD(sensor_seed, FIELD_INT),
+    FIELD(fleet_size, FIELD_INT),
+    FIELD(fleet_spacing, FIELD_DOUBLE),
+    FIELD(fleet_delay_s, FIELD_DOUBLE),
+    FIELD(fleet_radius, FIELD_DOUBLE),
+    FIELD(fleet_collision, FIELD_DOUBLE),
+    FIELD(fleet_threads, FIELD_INT),
+    FIELD(output_csv, FIELD_STRING),
+    FIELD(record_file, FIELD_STRING),
+    FIELD(telemetry_io, FIELD_STRING),
+    FIELD(telemetry_buffer_kb, FIELD_INT),
+    FIELD(telemetry_buffers, FIELD_INT),
+    FIELD(telemetry_flush_ms, FIELD_INT),
+    FIELD(checkpoint_file, FIELD_STRING),
+    FIELD(checkpoint_period_s, FIELD_DOUBLE),
+    FIELD(restore_file, FIELD_STRING),
+};
+
+#define N_FIELDS (sizeof(FIELDS) / sizeof(FIELDS[0]))
+
+// ==========================
+// Funções auxiliares
+// ==========================
+
+/* Remove espaços no início e no fim (in-place) */
+static char *trim(char *s) {
+    while (isspace((unsigned char)*s)) s++;
+    char *end = s + strlen(s);
+    while (end > s && isspace((unsigned char)end[-1])) end--;
+    *end = '\0';
+    return s;
+}
+
+/* Converte e grava o valor de um campo */
+static int set_field(ScenarioConfig *cfg, const ScenarioField *field, const char *value) {
+    char *base = (char *)cfg + field->offset;
+    char *end;
+    errno = 0;
+
+    switch (field->type) {
+    case FIELD_INT: {
+        long v = strtol(value, &end, 10);
+        if (errno || end == value || *end != '\0' || v < INT_MIN || v > INT_MAX) return -1;
+        *(int *)base = (int)v;
+        return 0;
+    }
+    case FIELD_DOUBLE: {
+        double v = strtod(value, &end);
+        if (errno || end == value || *end != '\0') return -1;
+        *(double *)base = v;
+        return 0;
+    }
+    case FIELD_STRING:
+        if (strlen(value) >= SCENARIO_PATH_MAX) return -1;
+        strcpy(base, value);
+        return 0;
+    }
+    return -1;
+}
+
+// ==========================
+// Funções públicas
+// ==========================
+
+void scenario_set_defaults(ScenarioConfig *cfg) {
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->sim_period_ms = 30;
+    cfg->lin_period_ms = 30;
+    cfg->ctrl_period_ms = 50;
+    cfg->model_period_ms = 50;
+    cfg->ref_period_ms = 120;
+    cfg->logger_period_ms = 50;
+    cfg->interface_period_ms = 1000;
+    cfg->timer_interval_ms = 100;
+    cfg->metrics_period_ms = 30;
+    cfg->watchdog_ms = 100;
+    cfg->sim_time_s = 20.0;
+    cfg->R = 0.3;
+    cfg->v_max = 1.0;
+    cfg->w_max = 1.0;
+    cfg->u1_max = 1.0;
+    cfg->u2_max = 3.0;
+    cfg->alpha1 = 3.0;
+    cfg->alpha2 = 3.0;
+    cfg->settle_band = 0.05;
+    cfg->metrics_window_s = 2.0;
+    strcpy(cfg->trajectory, "figure8");
+    cfg->trajectory_dt = 0.01;
+    cfg->preview_dt = 0.02;
+    cfg->preview_horizon_s = 1.0;
+    cfg->ctrl_ki = 0.0;
+    cfg->ctrl_ki_limit = 0.2;
+    strcpy(cfg->controller, "mrac");
+    cfg->mpc_horizon = 20;
+    cfg->mpc_q = 1.0;
+    cfg->mpc_r = 0.01;
+    cfg->mpc_max_iter = 100;
+    cfg->mpc_tol = 1e-3;
+    cfg->lqr_q = 5.0;
+    cfg->lqr_q_theta = 0.1;
+    cfg->lqr_r = 0.1;
+    cfg->lqr_heading_bins = 64;
+    cfg->lqr_speed_bins = 16;
+    cfg->lqr_speed_min = 0.1;
+    cfg->lqr_error_max = 0.3;
+    strcpy(cfg->estimator, "none");
+    cfg->sensor_pos_std = 0.02;
+    cfg->sensor_theta_std = 0.02;
+    cfg->odom_std = 0.02;
+    cfg->odom_scale = 0.05;
+    cfg->odom_bias_w = 0.02;
+    cfg->sensor_seed = 1;
+    cfg->fleet_size = 1000;
+    cfg->fleet_spacing = 1.5;
+    cfg->fleet_delay_s = 0.25;
+    cfg->fleet_radius = 0.5;
+    cfg->fleet_collision = 0.2;
+    cfg->fleet_threads = 0;
+    strcpy(cfg->output_csv, "data/saida.csv");
+    strcpy(cfg->telemetry_io, "buffered");
+    cfg->telemetry_buffer_kb = 64;
+    cfg->telemetry_buffers = 2;
+    cfg->telemetry_flush_ms = 1000;
+    cfg->checkpoint_period_s = 5.0;
+}
+
+int scenario_apply(ScenarioConfig *cfg, const char *assignment) {
+    char line[2 * SCENARIO_PATH_MAX];
+    if (strlen(assignment) >= sizeof(line)) {
+        LOG_ERROR("Atribuição muito longa: %.40s...\n", assignment);
+        return -1;
+    }
+    strcpy(line, assignment);
+
+    char *eq = strchr(line, '=');
+    if (!eq) {
+        LOG_ERROR("Atribuição sem '=': %s\n", assignment);
+        return -1;
+    }
+    *eq = '\0';
+    char *key = trim(line);
+    char *value = trim(eq + 1);
+
+    for (size_t i = 0; i < N_FIELDS; i++) {
+        if (strcmp(FIELDS[i].name, key) == 0) {
+            if (set_field(cfg, &FIELDS[i], value) != 0) {
+                LOG_ERROR("Valor inválido para '%s': '%s'\n", key, value);
+                return -1;
+            }
+            return 0;
+        }
+    }
+
+    LOG_ERROR("Chave de cenário desconhecida: '%s'\n", key);
+    return -1;
+}
+
+int scenario_key_is_int(const char *key) {
+    for (size_t i = 0; i < N_FIELDS; i++)
+        if (strcmp(FIELDS[i].name, key) == 0) return FIELDS[i].type == FIELD_INT;
+    return -1;
+}
+
+int scenario_load_file(ScenarioConfig *cfg, const char *path) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        LOG_ERROR("Não foi possível abrir o cenário '%s'\n", path);
+        return -1;
+    }
+
+    char line[2 * SCENARIO_PATH_MAX];
+    int line_no = 0;
+    int status = 0;
+    while (fgets(line, sizeof(line), file)) {
+        line_no++;
+        char *comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+        char *content = trim(line);
+        if (*content == '\0') continue;
+
+        if (scenario_apply(cfg, content) != 0) {
+            LOG_ERROR("%s:%d: linha inválida\n", path, line_no);
+            status = -1;
+        }
+    }
+
+    fclose(file);
+    LOG_DEBUG("Cenário '%s' carregado (%d linhas)\n", path, line_no);
+    return status;
+}
+
+int scenario_validate(const ScenarioConfig *cfg) {
+    const int periods[] = {
+        cfg->sim_period_ms, cfg->lin_period_ms, cfg->ctrl_period_ms, cfg->model_period_ms,
+        cfg->ref_period_ms, cfg->logger_period_ms, cfg->interface_period_ms,
+        cfg->timer_interval_ms, cfg->metrics_period_ms
+    };
+    for (size_t i = 0; i < sizeof(periods) / sizeof(periods[0]); i++) {
+        if (periods[i] <= 0) {
+            LOG_ERROR("Período inválido: %d ms\n", periods[i]);
+            return -1;
+        }
+    }
+    if (cfg->watchdog_ms < 0) {
+        LOG_ERROR("watchdog_ms não pode ser negativo\n");
+        return -1;
+    }
+    if (cfg->sim_time_s <= 0 || cfg->R <= 0) {
+        LOG_ERROR("sim_time_s e R devem ser positivos\n");
+        return -1;
+    }
+    if (cfg->settle_band <= 0) {
+        LOG_ERROR("settle_band deve ser positivo\n");
+        return -1;
+    }
+    // A janela tem que caber no anel no menor período em que os indicadores
+    // são alimentados (thread de métricas ou passo do robô em headless)
+    int feed_ms = cfg->metrics_period_ms < cfg->sim_period_ms ? cfg->metrics_period_ms : cfg->sim_period_ms;
+    if (cfg->metrics_window_s <= 0 ||
+        cfg->metrics_window_s * 1000.0 / feed_ms > SLIDING_INTEGRAL_CAPACITY) {
+        LOG_ERROR("metrics_window_s deve ser positivo e cobrir no máximo %d amostras de %d ms\n",
+                  SLIDING_INTEGRAL_CAPACITY, feed_ms);
+        return -1;
+    }
+    if (cfg->trajectory_dt <= 0) {
+        LOG_ERROR("trajectory_dt deve ser positivo\n");
+        return -1;
+    }
+    if (cfg->preview_dt <= 0 || cfg->preview_horizon_s < 0) {
+        LOG_ERROR("preview_dt deve ser positivo e preview_horizon_s não negativo\n");
+        return -1;
+    }
+    // O anel precisa guardar o horizonte e as amostras já consumidas de um período do gerador
+    double needed = (cfg->preview_horizon_s + cfg->ref_period_ms / 1000.0) / cfg->preview_dt + 4;
+    if (needed > REF_PREVIEW_CAPACITY / 2) {
+        LOG_ERROR("Horizonte de referências excede o anel (%.0f > %u amostras)\n",
+                  needed, REF_PREVIEW_CAPACITY / 2);
+        return -1;
+    }
+    if (cfg->ctrl_ki < 0 || cfg->ctrl_ki_limit <= 0) {
+        LOG_ERROR("ctrl_ki não pode ser negativo e ctrl_ki_limit deve ser positivo\n");
+        return -1;
+    }
+    if (strcmp(cfg->controller, "mrac") != 0 && strcmp(cfg->controller, "mpc") != 0 &&
+        strcmp(cfg->controller, "lqr") != 0) {
+        LOG_ERROR("controller deve ser 'mrac', 'mpc' ou 'lqr' (recebido '%s')\n", cfg->controller);
+        return -1;
+    }
+    if (cfg->mpc_horizon < 1 || cfg->mpc_horizon > MPC_MAX_HORIZON) {
+        LOG_ERROR("mpc_horizon deve estar entre 1 e %d\n", MPC_MAX_HORIZON);
+        return -1;
+    }
+    if (cfg->mpc_q <= 0 || cfg->mpc_r <= 0 || cfg->mpc_max_iter < 1 || cfg->mpc_tol <= 0) {
+        LOG_ERROR("mpc_q, mpc_r, mpc_max_iter e mpc_tol devem ser positivos\n");
+        return -1;
+    }
+    if (cfg->lqr_q <= 0 || cfg->lqr_q_theta <= 0 || cfg->lqr_r <= 0 || cfg->lqr_error_max <= 0) {
+        LOG_ERROR("lqr_q, lqr_q_theta, lqr_r e lqr_error_max devem ser positivos\n");
+        return -1;
+    }
+    if (cfg->lqr_heading_bins < 4 || cfg->lqr_heading_bins > LQR_MAX_BINS ||
+        cfg->lqr_speed_bins < 1 || cfg->lqr_speed_bins > LQR_MAX_BINS) {
+        LOG_ERROR("lqr_heading_bins deve estar entre 4 e %d e lqr_speed_bins entre 1 e %d\n",
+                  LQR_MAX_BINS, LQR_MAX_BINS);
+        return -1;
+    }
+    if (cfg->lqr_speed_min <= 0 || cfg->lqr_speed_min >= cfg->u1_max) {
+        LOG_ERROR("lqr_speed_min deve ser positivo e menor que u1_max\n");
+        return -1;
+    }
+    if (strcmp(cfg->estimator, "none") != 0 && strcmp(cfg->estimator, "raw") != 0 &&
+        strcmp(cfg->estimator, "ekf") != 0) {
+        LOG_ERROR("estimator deve ser 'none', 'raw' ou 'ekf' (recebido '%s')\n", cfg->estimator);
+        return -1;
+    }
+    if (cfg->sensor_pos_std <= 0 || cfg->sensor_theta_std <= 0 || cfg->odom_std < 0 ||
+        cfg->odom_scale < 0 || cfg->odom_bias_w < 0) {
+        LOG_ERROR("Desvios dos sensores devem ser positivos e erros da odometria não negativos\n");
+        return -1;
+    }
+    if (cfg->fleet_size < 0 || cfg->fleet_size > FLEET_MAX_SIZE || cfg->fleet_threads < 0) {
+        LOG_ERROR("fleet_size deve estar entre 0 e %d e fleet_threads não pode ser negativo\n",
+                  FLEET_MAX_SIZE);
+        return -1;
+    }
+    if (cfg->fleet_spacing <= 0 || cfg->fleet_delay_s < 0 || cfg->fleet_radius <= 0 ||
+        cfg->fleet_collision <= 0 || cfg->fleet_collision > cfg->fleet_radius) {
+        LOG_ERROR("Parâmetros da frota inválidos (0 < fleet_collision <= fleet_radius)\n");
+        return -1;
+    }
+    if (cfg->v_max <= 0 || cfg->w_max <= 0 || cfg->u1_max <= 0 || cfg->u2_max <= 0) {
+        LOG_ERROR("Limites de saturação devem ser positivos\n");
+        return -1;
+    }
+    if (strcmp(cfg->telemetry_io, "buffered") != 0 && strcmp(cfg->telemetry_io, "fdatasync") != 0 &&
+        strcmp(cfg->telemetry_io, "direct") != 0) {
+        LOG_ERROR("telemetry_io deve ser 'buffered', 'fdatasync' ou 'direct' (recebido '%s')\n",
+                  cfg->telemetry_io);
+        return -1;
+    }
+    if (cfg->telemetry_buffer_kb < 4 || cfg->telemetry_buffers < 2 ||
+        cfg->telemetry_buffers > TELEMETRY_MAX_BUFFERS || cfg->telemetry_flush_ms < 0) {
+        LOG_ERROR("telemetry_buffer_kb deve ser ao menos 4, telemetry_buffers estar entre 2 e %d "
+                  "e telemetry_flush_ms não ser negativo\n", TELEMETRY_MAX_BUFFERS);
+        return -1;
+    }
+    if (cfg->checkpoint_period_s * 1000.0 < cfg->timer_interval_ms) {
+        LOG_ERROR("checkpoint_period_s deve cobrir ao menos um passo do relógio (%d ms)\n",
+                  cfg->timer_interval_ms);
+        return -1;
+    }
+    return 0;
+}
@@ -8,92 +8,112 @@
     LICENSE: CC BY-SA
 */
 
-#define _POSIX_C_SOURCE 199309L
+#define _POSIX_C_SOURCE 200112L
 #include <time.h>
 #include <unistd.h>
 #include <math.h>
 #include "monitors.h"  // Para acessar dados compartilhados entre threads
+#include "threads.h"   // Protótipos das threads e dos corpos das ativações
 #include "logs.h"      // Para log de eventos
+#include "control_law.h" // Dinâmica do uniciclo
+
+/* Corpo de uma ativação: integra o robô por um período (sem espera) */
+void sim_step(ArgsSim *args) {
+    const ScenarioConfig *cfg = args->cfg;
+    double dt = cfg->sim_period_ms / 1000.0;  // Intervalo de tempo em segundos
+
+    // Captura os comandos de controle u(t)
+    double u1, u2;
+    DataStamp cl;  // Carimbo de u(t): instante da atuação menos as origens = idade ponta a ponta
+    double agora = data_age_now();
+    pthread_mutex_lock(&args->l->mutex);
+    u1 = args->l->u1;
+    u2 = args->l->u2;
+    cl = args->l->carimbo;
+    pthread_mutex_unlock(&args->l->mutex);
+
+    pthread_mutex_lock(&args->a->mutex);
+    age_histogram_add(&args->a->caminhos[AGE_LINEARIZACAO_ROBO], agora - cl.publicado, cl.seq);
+    age_histogram_add(&args->a->caminhos[AGE_SENSOR_ATUACAO], agora - cl.origem[DATA_SRC_ESTADO], cl.seq);
+    age_histogram_add(&args->a->caminhos[AGE_REFERENCIA_ATUACAO], agora - cl.origem[DATA_SRC_REFERENCIA], cl.seq);
+    pthread_mutex_unlock(&args->a->mutex);
+
+    // Captura o estado atual do robô (x1, x2, x3)
+    RobotState s;
+    pthread_mutex_lock(&args->e->mutex);
+    s.x1 = args->e->x1;
+    s.x2 = args->e->x2;
+    s.x3 = args->e->x3;
+    pthread_mutex_unlock(&args->e->mutex);
+
+    // Dinâmica do robô: integração por Euler e saída y(t) = x + deslocamento frontal
+    robot_step(&s, cfg->R, u1, u2, dt);
+
+    // Sensores e estimador no mesmo período: pose que o controle vai ler
+    const RobotState *visto = &s;
+    if (args->est) {
+        estimator_step(args->est, cfg, &s, u1, u2, dt);
+        visto = estimator_view(args->est, &s);
+    }
 
-#define R 0.3           // Distância do centro geométrico à frente do robô
-#define PERIOD_MS 30    // Período de execução da thread em ms
-
-#ifndef M_PI
-#define M_PI 3.14159265358979323846  // Define M_PI se não estiver definido
-#endif
+    // Atualiza o estado no monitor compartilhado
+    pthread_mutex_lock(&args->e->mutex);
+    args->e->x1 = s.x1;
+    args->e->x2 = s.x2;
+    args->e->x3 = s.x3;
+    args->e->y1 = s.y1;
+    args->e->y2 = s.y2;
+    args->e->xe3 = visto->x3;
+    args->e->ye1 = visto->y1;
+    args->e->ye2 = visto->y2;
+    data_stamp_source(&args->e->carimbo, DATA_SRC_ESTADO, data_age_now());  // Nova medição do sensor
+    pthread_mutex_unlock(&args->e->mutex);
+
+    // Publica o tick no instantâneo global: estado integrado, u(t) aplicado e
+    // a referência no instante do tick (os modelos e v(t) vêm de seus canais)
+    SystemSnapshot g;
+    g.t = monitor_tempo_exato(args->t);
+    RefPreviewSample ref;
+    if (ref_preview_sample(&args->r->preview, g.t, &ref) == 0) {
+        g.xref = ref.x;
+        g.yref = ref.y;
+    } else {
+        pthread_mutex_lock(&args->r->mutex);
+        g.xref = args->r->xref;
+        g.yref = args->r->yref;
+        pthread_mutex_unlock(&args->r->mutex);
+    }
+    g.x1 = s.x1;
+    g.x2 = s.x2;
+    g.x3 = s.x3;
+    g.y1 = s.y1;
+    g.y2 = s.y2;
+    g.u1 = u1;
+    g.u2 = u2;
+    snapshot_publish(args->g, &g, agora);
+
+    // Registra no log a atualização do estado do robô
+    LOG_DEBUG("Simulação: x=(%.2f, %.2f, %.2f), y=(%.2f, %.2f)\n", s.x1, s.x2, s.x3, s.y1, s.y2);
+}
 
 /* Função da thread de simulação do robô */
 void *sim_thread(void *arg) {
     ArgsSim *args = (ArgsSim *)arg;
+    const ScenarioConfig *cfg = args->cfg;  // R e período de integração
 
     LOG_DEBUG("Thread de simulação iniciada.\n");
 
+    // Aguarda a partida comum liberada pelo supervisor
     struct timespec next_activation;
-    clock_gettime(CLOCK_MONOTONIC, &next_activation);  // Define o tempo inicial
-
-    double dt = PERIOD_MS / 1000.0;  // Intervalo de tempo em segundos
-
-    while (1) {
-        // Verifica o tempo e se a simulação deve ser encerrada
-        pthread_mutex_lock(&args->t->mutex);
-        if (args->t->encerrar) {
-            pthread_mutex_unlock(&args->t->mutex);
-            pthread_exit(NULL);  // Encerra a thread se a flag 'encerrar' for setada
-        }
-        pthread_mutex_unlock(&args->t->mutex);
-
-        // Captura os comandos de controle u(t)
-        double u1, u2;
-        pthread_mutex_lock(&args->l->mutex);
-        u1 = args->l->u1;
-        u2 = args->l->u2;
-        pthread_mutex_unlock(&args->l->mutex);
-
-        // Captura o estado atual do robô (x1, x2, x3)
-        double x1, x2, x3;
-        pthread_mutex_lock(&args->e->mutex);
-        x1 = args->e->x1;
-        x2 = args->e->x2;
-        x3 = args->e->x3;
-        pthread_mutex_unlock(&args->e->mutex);
-
-        // Dinâmica do robô: integração por Euler para calcular as derivadas
-        double dx1 = cos(x3) * u1;  // Derivada de x1 (velocidade na direção X)
-        double dx2 = sin(x3) * u1;  // Derivada de x2 (velocidade na direção Y)
-        double dx3 = u2;            // Derivada de x3 (velocidade angular)
-
-        // Atualiza o estado do robô
-        x1 += dx1 * dt;
-        x2 += dx2 * dt;
-        x3 += dx3 * dt;
-
-        // Correção do ângulo: mantém θ ∈ [-π, π]
-        while (x3 > M_PI) x3 -= 2 * M_PI;
-        while (x3 < -M_PI) x3 += 2 * M_PI;
-
-        // Cálculo da saída do robô: y(t) = x + deslocamento frontal
-        double y1 = x1 + R * cos(x3);  // Posição Y do robô
-        double y2 = x2 + R * sin(x3);  // Posição X do robô
-
-        // Atualiza o estado no monitor compartilhado
-        pthread_mutex_lock(&args->e->mutex);
-        args->e->x1 = x1;
-        args->e->x2 = x2;
-        args->e->x3 = x3;
-        args->e->y1 = y1;
-        args->e->y2 = y2;
-        pthread_mutex_unlock(&args->e->mutex);
-
-        // Registra no log a atualização do estado do robô
-        LOG_DEBUG("Simulação: x=(%.2f, %.2f, %.2f), y=(%.2f, %.2f)\n", x1, x2, x3, y1, y2);
-
-        // Dorme até o próximo período de amostragem
-        next_activation.tv_nsec += PERIOD_MS * 1e6;
-        while (next_activation.tv_nsec >= 1e9) {
-            next_activation.tv_sec++;
-            next_activation.tv_nsec -= 1e9;
-        }
-        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_activation, NULL);
+    int ativo = supervisor_start(&next_activation);
+
+    while (ativo) {
+        // Corpo da ativação (isolado da espera para benchmarks)
+        sim_step(args);
+
+        // Dorme até o próximo período (o encerramento acorda a thread imediatamente)
+        supervisor_advance(&next_activation, cfg->sim_period_ms);
+        ativo = supervisor_sleep_until(&next_activation);
     }
 
     pthread_exit(NULL);  // Encerra a thread
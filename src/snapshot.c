@@ -0,0 +1,85 @@
+/*
+    FILE: snapshot.c
+    DESCRIPTION:
+        Implementa o instantâneo global com buffer triplo (snapshot.h).
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <string.h>
+#include "snapshot.h"
+
+#define SNAPSHOT_FRESH 4u  // Marca no índice do meio: tick ainda não lido
+
+void snapshot_init(SnapshotHub *h) {
+    for (int r = 0; r < SNAPSHOT_READERS; r++) {
+        SnapshotChannel *c = &h->canais[r];
+        memset(c->buf, 0, sizeof(c->buf));
+        c->front = 0;
+        atomic_init(&c->middle, 1);
+        c->back = 2;
+    }
+    for (int f = 0; f < SNAPSHOT_SOURCES; f++) {
+        atomic_init(&h->fontes[f].seq, 0);
+        atomic_init(&h->fontes[f].valor[0], 0.0);
+        atomic_init(&h->fontes[f].valor[1], 0.0);
+    }
+    h->tick = 0;
+}
+
+void snapshot_post(SnapshotHub *h, SnapshotSource src, double a, double b) {
+    SnapshotSlot *s = &h->fontes[src];
+
+    // Inicia a escrita (ímpar): o publicador relê até a escrita terminar
+    unsigned seq = atomic_load_explicit(&s->seq, memory_order_relaxed);
+    atomic_store_explicit(&s->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&s->valor[0], a, memory_order_relaxed);
+    atomic_store_explicit(&s->valor[1], b, memory_order_relaxed);
+
+    atomic_store_explicit(&s->seq, seq + 2, memory_order_release);
+}
+
+/* Lê o canal de um produtor de forma consistente */
+static void read_source(const SnapshotSlot *s, double *a, double *b) {
+    for (;;) {
+        unsigned seq1 = atomic_load_explicit(&s->seq, memory_order_acquire);
+        if (seq1 & 1u) continue;  // Produtor escrevendo
+
+        *a = atomic_load_explicit(&s->valor[0], memory_order_relaxed);
+        *b = atomic_load_explicit(&s->valor[1], memory_order_relaxed);
+
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&s->seq, memory_order_relaxed) == seq1) return;
+    }
+}
+
+void snapshot_publish(SnapshotHub *h, SystemSnapshot *s, double publicado) {
+    double nada;
+    read_source(&h->fontes[SNAPSHOT_SRC_MODELO_X], &s->ymx, &nada);
+    read_source(&h->fontes[SNAPSHOT_SRC_MODELO_Y], &s->ymy, &nada);
+    read_source(&h->fontes[SNAPSHOT_SRC_CONTROLE], &s->v1, &s->v2);
+    s->tick = ++h->tick;
+    s->publicado = publicado;
+
+    for (int r = 0; r < SNAPSHOT_READERS; r++) {
+        SnapshotChannel *c = &h->canais[r];
+        c->buf[c->back] = *s;
+        // Publica o buffer de trás e recupera o antigo do meio para a próxima escrita
+        unsigned old = atomic_exchange_explicit(&c->middle, c->back | SNAPSHOT_FRESH,
+                                                memory_order_acq_rel);
+        c->back = old & ~SNAPSHOT_FRESH;
+    }
+}
+
+const SystemSnapshot *snapshot_acquire(SnapshotHub *h, SnapshotReader r) {
+    SnapshotChannel *c = &h->canais[r];
+    if (atomic_load_explicit(&c->middle, memory_order_relaxed) & SNAPSHOT_FRESH) {
+        // Troca a frente pelo meio: o publicador nunca escreve nos buffers da frente ou do meio
+        unsigned old = atomic_exchange_explicit(&c->middle, c->front, memory_order_acq_rel);
+        c->front = old & ~SNAPSHOT_FRESH;
+    }
+    return &c->buf[c->front];
+}
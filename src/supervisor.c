@@ -0,0 +1,279 @@
+/*
+    FILE: supervisor.c
+    DESCRIPTION:
+        Implementa o supervisor das tarefas periódicas (supervisor.h).
+        As esperas usam FUTEX_WAIT_BITSET, cujo prazo é absoluto em
+        CLOCK_MONOTONIC, sobre a palavra de encerramento. A pausa usa o
+        par de contadores pausa/ocupadas com ordem sequencial: uma tarefa
+        que começa uma ativação durante a pausa desiste e aguarda, e quem
+        pausa aguarda as ativações em curso terminarem.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include "supervisor.h"
+#include "logs.h"
+
+#define START_MARGIN_NS 5000000L  // Folga para todas as threads chegarem à barreira
+
+// Tarefa executada pela thread corrente (NULL fora das tarefas supervisionadas)
+static _Thread_local SupervisorTask *tarefa_atual;
+
+static unsigned long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static unsigned long long timespec_ns(const struct timespec *ts) {
+    return (unsigned long long)ts->tv_sec * 1000000000ull + ts->tv_nsec;
+}
+
+static void timespec_add_ns(struct timespec *ts, long ns) {
+    ts->tv_nsec += ns;
+    while (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+/* Espera enquanto *word == value (sem prazo) */
+static void futex_wait(atomic_int *word, int value) {
+    while (atomic_load_explicit(word, memory_order_acquire) == value)
+        syscall(SYS_futex, (void *)word, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+}
+
+static void futex_wake_all(atomic_int *word) {
+    syscall(SYS_futex, (void *)word, FUTEX_WAKE_PRIVATE, SUPERVISOR_MAX_TASKS + 1, NULL, NULL, 0);
+}
+
+/* Espera até o prazo absoluto (NULL: sem prazo); retorna 0 se houve encerramento */
+static int wait_until(Supervisor *sv, const struct timespec *deadline) {
+    while (atomic_load_explicit(&sv->encerrar, memory_order_acquire) == 0) {
+        long r = syscall(SYS_futex, (void *)&sv->encerrar, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG,
+                         0, deadline, NULL, FUTEX_BITSET_MATCH_ANY);
+        if (r == -1 && errno == ETIMEDOUT) return 1;
+        // EINTR, EAGAIN (palavra já mudou) ou despertar: reavalia a palavra
+    }
+    return 0;
+}
+
+/* Começa uma ativação, aguardando o fim de uma pausa em curso */
+static void activation_begin(SupervisorTask *t) {
+    Supervisor *sv = t->sv;
+    for (;;) {
+        atomic_fetch_add(&sv->ocupadas, 1);
+        if (atomic_load(&sv->pausa) == 0) break;
+        atomic_fetch_sub(&sv->ocupadas, 1);  // Desiste: quem pausa pode estar aguardando
+        futex_wake_all(&sv->ocupadas);
+        futex_wait(&sv->pausa, 1);
+    }
+    t->ocupada = 1;
+}
+
+/* Encerra a ativação corrente (se houver) e acorda quem aguarda a pausa */
+static void activation_end(SupervisorTask *t) {
+    Supervisor *sv = t->sv;
+    if (!t->ocupada) return;
+    t->ocupada = 0;
+    atomic_fetch_sub(&sv->ocupadas, 1);
+    if (atomic_load(&sv->pausa) != 0) futex_wake_all(&sv->ocupadas);
+}
+
+/* Conta a tarefa na barreira de partida (uma única vez) */
+static void arrive(SupervisorTask *t) {
+    if (t->chegou) return;
+    t->chegou = 1;
+    atomic_fetch_add_explicit(&t->sv->chegadas, 1, memory_order_acq_rel);
+    futex_wake_all(&t->sv->chegadas);
+}
+
+/* Saída da thread (retorno ou pthread_exit), inclusive no meio de uma
+   ativação: a tarefa deixa de ser vigiada e não retém a barreira nem a pausa */
+static void task_exit(void *arg) {
+    SupervisorTask *t = arg;
+    activation_end(t);
+    if (atomic_load_explicit(&t->sv->encerrar, memory_order_acquire) == 0)
+        atomic_store_explicit(&t->encerrada, 1, memory_order_release);
+    arrive(t);
+}
+
+/* Ponto de entrada das threads: associa a tarefa à thread e executa a função */
+static void *trampoline(void *arg) {
+    SupervisorTask *t = arg;
+    tarefa_atual = t;
+    void *ret;
+    pthread_cleanup_push(task_exit, t);
+    ret = t->fn(t->arg);
+    pthread_cleanup_pop(1);
+    return ret;
+}
+
+void supervisor_init(Supervisor *sv, int watchdog_ms) {
+    sv->n_tarefas = 0;
+    sv->watchdog_ms = watchdog_ms;
+    atomic_init(&sv->encerrar, 0);
+    atomic_init(&sv->chegadas, 0);
+    atomic_init(&sv->partida, 0);
+    atomic_init(&sv->pausa, 0);
+    atomic_init(&sv->ocupadas, 0);
+    sv->latencia_encerramento = 0.0;
+}
+
+int supervisor_add(Supervisor *sv, const char *nome, int periodo_ms, void *(*fn)(void *), void *arg) {
+    if (sv->n_tarefas == SUPERVISOR_MAX_TASKS) {
+        LOG_ERROR("[SUPERVISOR] Limite de %d tarefas atingido (%s)\n", SUPERVISOR_MAX_TASKS, nome);
+        return -1;
+    }
+    SupervisorTask *t = &sv->tarefas[sv->n_tarefas];
+    t->nome = nome;
+    t->periodo_ms = periodo_ms;
+    t->fn = fn;
+    t->arg = arg;
+    t->sv = sv;
+    t->fase_ns = (long)sv->n_tarefas * SUPERVISOR_PHASE_US * 1000L;
+    atomic_init(&t->ultimo_batimento, 0);
+    atomic_init(&t->ativacoes, 0);
+    atomic_init(&t->atrasos, 0);
+    t->paradas = 0;
+    t->parada = 0;
+    t->ocupada = 0;
+    t->chegou = 0;
+    atomic_init(&t->encerrada, 0);
+    return sv->n_tarefas++;
+}
+
+/* Acusa as tarefas sem batimento há mais de SUPERVISOR_STALL_PERIODS períodos */
+static void watchdog_check(Supervisor *sv) {
+    unsigned long long agora = now_ns();
+    for (int i = 0; i < sv->n_tarefas; i++) {
+        SupervisorTask *t = &sv->tarefas[i];
+        if (atomic_load_explicit(&t->encerrada, memory_order_acquire)) continue;
+        unsigned long long ultimo = atomic_load_explicit(&t->ultimo_batimento, memory_order_relaxed);
+        unsigned long long limite = (unsigned long long)SUPERVISOR_STALL_PERIODS * t->periodo_ms * 1000000ull +
+                                    (unsigned long long)sv->watchdog_ms * 1000000ull;
+        if (agora > ultimo + limite) {
+            if (!t->parada) {
+                t->parada = 1;
+                t->paradas++;
+                LOG_ERROR("[SUPERVISOR] Tarefa '%s' sem ativação há %.1f ms (período %d ms)\n",
+                          t->nome, (agora - ultimo) / 1e6, t->periodo_ms);
+            }
+        } else if (t->parada) {
+            t->parada = 0;
+            LOG_DEBUG("[SUPERVISOR] Tarefa '%s' voltou a executar\n", t->nome);
+        }
+    }
+}
+
+void supervisor_run(Supervisor *sv) {
+    for (int i = 0; i < sv->n_tarefas; i++) {
+        SupervisorTask *t = &sv->tarefas[i];
+        if (pthread_create(&t->thread, NULL, trampoline, t) != 0) {
+            LOG_ERROR_AND_EXIT("[SUPERVISOR] Falha ao criar a tarefa '%s'\n", t->nome);
+        }
+    }
+
+    // Barreira: espera todas as tarefas chegarem
+    for (int n; (n = atomic_load_explicit(&sv->chegadas, memory_order_acquire)) < sv->n_tarefas;)
+        futex_wait(&sv->chegadas, n);
+
+    // Época comum; os batimentos começam nela para o cão de guarda não acusar a partida
+    clock_gettime(CLOCK_MONOTONIC, &sv->epoca);
+    timespec_add_ns(&sv->epoca, START_MARGIN_NS);
+    for (int i = 0; i < sv->n_tarefas; i++) {
+        SupervisorTask *t = &sv->tarefas[i];
+        atomic_store_explicit(&t->ultimo_batimento, timespec_ns(&sv->epoca) + t->fase_ns, memory_order_relaxed);
+    }
+    atomic_store_explicit(&sv->partida, 1, memory_order_release);  // Publica a época e libera as tarefas
+    futex_wake_all(&sv->partida);
+    LOG_DEBUG("[SUPERVISOR] %d tarefas liberadas\n", sv->n_tarefas);
+
+    // Cão de guarda até o encerramento
+    struct timespec next = sv->epoca;
+    if (sv->watchdog_ms > 0) {
+        for (;;) {
+            timespec_add_ns(&next, sv->watchdog_ms * 1000000L);
+            if (!wait_until(sv, &next)) break;
+            watchdog_check(sv);
+        }
+    } else {
+        wait_until(sv, NULL);
+    }
+
+    for (int i = 0; i < sv->n_tarefas; i++) pthread_join(sv->tarefas[i].thread, NULL);
+    sv->latencia_encerramento = (now_ns() - timespec_ns(&sv->pedido)) / 1e9;
+}
+
+void supervisor_shutdown(Supervisor *sv) {
+    struct timespec pedido;
+    clock_gettime(CLOCK_MONOTONIC, &pedido);
+    if (atomic_exchange_explicit(&sv->encerrar, 1, memory_order_acq_rel) != 0) return;  // Já pedido
+    sv->pedido = pedido;
+    futex_wake_all(&sv->encerrar);
+}
+
+void supervisor_pause(Supervisor *sv) {
+    atomic_store(&sv->pausa, 1);
+    int propria = tarefa_atual && tarefa_atual->sv == sv && tarefa_atual->ocupada;
+    for (int n; (n = atomic_load(&sv->ocupadas)) > propria;) futex_wait(&sv->ocupadas, n);
+}
+
+void supervisor_resume(Supervisor *sv) {
+    atomic_store(&sv->pausa, 0);
+    futex_wake_all(&sv->pausa);
+}
+
+void supervisor_print(const Supervisor *sv, FILE *out) {
+    fprintf(out, "[SUPERVISOR] Encerramento em %.1f µs\n", sv->latencia_encerramento * 1e6);
+    fprintf(out, "  tarefa             período  ativações  atrasos  paradas\n");
+    for (int i = 0; i < sv->n_tarefas; i++) {
+        const SupervisorTask *t = &sv->tarefas[i];
+        fprintf(out, "  %-16s %6d ms %10lu %8lu %8lu%s\n", t->nome, t->periodo_ms,
+                (unsigned long)atomic_load(&t->ativacoes), (unsigned long)atomic_load(&t->atrasos),
+                t->paradas, atomic_load(&t->encerrada) ? "  (saiu antes do fim)" : "");
+    }
+}
+
+int supervisor_start(struct timespec *next) {
+    SupervisorTask *t = tarefa_atual;
+    Supervisor *sv = t->sv;
+    arrive(t);
+    futex_wait(&sv->partida, 0);
+    *next = sv->epoca;
+    timespec_add_ns(next, t->fase_ns);
+    if (!wait_until(sv, next)) return 0;
+    activation_begin(t);
+    return 1;
+}
+
+void supervisor_leave(void) {
+    SupervisorTask *t = tarefa_atual;
+    activation_end(t);
+    atomic_store_explicit(&t->encerrada, 1, memory_order_release);
+    arrive(t);
+    LOG_DEBUG("[SUPERVISOR] Tarefa '%s' saiu da supervisão\n", t->nome);
+}
+
+void supervisor_advance(struct timespec *next, int periodo_ms) {
+    timespec_add_ns(next, periodo_ms * 1000000L);
+}
+
+int supervisor_sleep_until(const struct timespec *next) {
+    SupervisorTask *t = tarefa_atual;
+    unsigned long long agora = now_ns();
+    atomic_store_explicit(&t->ultimo_batimento, agora, memory_order_relaxed);
+    atomic_fetch_add_explicit(&t->ativacoes, 1, memory_order_relaxed);
+    if (agora > timespec_ns(next)) atomic_fetch_add_explicit(&t->atrasos, 1, memory_order_relaxed);
+    activation_end(t);
+    if (!wait_until(t->sv, next)) return 0;
+    activation_begin(t);
+    return 1;
+}
@@ -0,0 +1,269 @@
+/*
+    FILE: telemetry.c
+    DESCRIPTION:
+        Implementa a gravação assíncrona do registro (telemetry.h). head e
+        tail contam buffers desde a abertura (a diferença é o número de
+        buffers pendentes, mesmo após a volta do contador); o produtor só
+        escreve no buffer head % count quando head - tail < count. As
+        esperas usam futex: o produtor sobre tail, o escritor sobre um
+        contador de sinal que muda a cada entrega e no fechamento.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include "telemetry.h"
+#include "logs.h"
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void futex_wait(atomic_uint *word, unsigned value) {
+    while (atomic_load_explicit(word, memory_order_acquire) == value)
+        syscall(SYS_futex, (void *)word, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+}
+
+static void futex_wake(atomic_uint *word) {
+    syscall(SYS_futex, (void *)word, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+/* Grava os n buffers com writev (repetindo escritas parciais); retorna 0 ou -1 */
+static int write_batch(int fd, struct iovec *iov, int n) {
+    while (n > 0) {
+        ssize_t r = writev(fd, iov, n);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return -1;
+        while (n > 0 && (size_t)r >= iov->iov_len) {
+            r -= (ssize_t)iov->iov_len;
+            iov++;
+            n--;
+        }
+        if (n > 0) {
+            iov->iov_base = (char *)iov->iov_base + r;
+            iov->iov_len -= (size_t)r;
+        }
+    }
+    return 0;
+}
+
+/* Thread escritora: grava de uma vez todos os buffers pendentes */
+static void *writer_main(void *arg) {
+    TelemetryWriter *w = arg;
+    TelemetryStats *st = &w->stats;
+
+    for (;;) {
+        unsigned sinal = atomic_load_explicit(&w->sinal, memory_order_acquire);
+        unsigned tail = atomic_load_explicit(&w->tail, memory_order_relaxed);
+        unsigned head = atomic_load_explicit(&w->head, memory_order_acquire);
+        if (head == tail) {
+            if (atomic_load_explicit(&w->fechar, memory_order_acquire)) break;
+            futex_wait(&w->sinal, sinal);
+            continue;
+        }
+
+        struct iovec iov[TELEMETRY_MAX_BUFFERS];
+        int n = (int)(head - tail);
+        size_t bytes = 0;
+        for (int i = 0; i < n; i++) {
+            unsigned k = (tail + (unsigned)i) % w->count;
+            iov[i].iov_base = w->data[k];
+            iov[i].iov_len = w->used[k];
+            bytes += w->used[k];
+        }
+
+        double t0 = now_s();
+        int status = write_batch(w->fd, iov, n);
+        if (status == 0 && w->io == TELEMETRY_FDATASYNC) status = fdatasync(w->fd);
+        double dt = now_s() - t0;
+
+        st->lotes++;
+        st->escrita_total += dt;
+        if (dt > st->escrita_max) st->escrita_max = dt;
+        if (status == 0) {
+            st->bytes += bytes;
+        } else if (st->erros++ == 0) {
+            LOG_ERROR("Falha ao gravar o registro (%s); os dados seguintes podem faltar\n", strerror(errno));
+        }
+
+        // Libera os buffers gravados para o produtor
+        atomic_store_explicit(&w->tail, head, memory_order_release);
+        futex_wake(&w->tail);
+    }
+    return NULL;
+}
+
+/* Entrega o buffer corrente e garante que o seguinte esteja livre */
+static void handoff(TelemetryWriter *w) {
+    unsigned head = atomic_load_explicit(&w->head, memory_order_relaxed);
+    w->used[head % w->count] = w->fill;
+    atomic_store_explicit(&w->head, head + 1, memory_order_release);
+    atomic_fetch_add_explicit(&w->sinal, 1, memory_order_release);
+    futex_wake(&w->sinal);
+    w->fill = 0;
+    w->stats.entregas++;
+    clock_gettime(CLOCK_MONOTONIC, &w->ultima_entrega);
+
+    unsigned tail = atomic_load_explicit(&w->tail, memory_order_acquire);
+    if (head + 1 - tail < w->count) return;
+
+    // Anel cheio: o disco está atrasado em relação à amostragem
+    double t0 = now_s();
+    while (head + 1 - tail >= w->count) {
+        futex_wait(&w->tail, tail);
+        tail = atomic_load_explicit(&w->tail, memory_order_acquire);
+    }
+    double dt = now_s() - t0;
+    w->stats.esperas++;
+    w->stats.espera_total += dt;
+    if (dt > w->stats.espera_max) w->stats.espera_max = dt;
+}
+
+static void free_buffers(TelemetryWriter *w) {
+    for (unsigned i = 0; i < w->count; i++) {
+        free(w->data[i]);
+        w->data[i] = NULL;
+    }
+}
+
+/* Desfaz uma abertura incompleta (capacity = 0 marca o registro como não aberto) */
+static int open_failed(TelemetryWriter *w) {
+    free_buffers(w);
+    w->capacity = 0;
+    return -1;
+}
+
+int telemetry_open(TelemetryWriter *w, const char *path, const ScenarioConfig *cfg,
+                   const char *header) {
+    memset(w, 0, sizeof(*w));
+    w->count = (unsigned)cfg->telemetry_buffers;
+    w->capacity = ((size_t)cfg->telemetry_buffer_kb * 1024 + TELEMETRY_ALIGN - 1) /
+                  TELEMETRY_ALIGN * TELEMETRY_ALIGN;
+    w->flush_s = cfg->telemetry_flush_ms / 1000.0;
+    w->io = strcmp(cfg->telemetry_io, "direct") == 0      ? TELEMETRY_DIRECT
+            : strcmp(cfg->telemetry_io, "fdatasync") == 0 ? TELEMETRY_FDATASYNC
+                                                          : TELEMETRY_BUFFERED;
+
+    // Buffers alinhados e já tocados: nenhuma falta de página durante a amostragem
+    for (unsigned i = 0; i < w->count; i++) {
+        if (posix_memalign((void **)&w->data[i], TELEMETRY_ALIGN, w->capacity) != 0) {
+            w->data[i] = NULL;
+            LOG_ERROR("Sem memória para os buffers do registro\n");
+            return open_failed(w);
+        }
+        memset(w->data[i], 0, w->capacity);
+    }
+
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+    w->fd = w->io == TELEMETRY_DIRECT ? open(path, flags | O_DIRECT, 0644) : -1;
+    if (w->io == TELEMETRY_DIRECT && w->fd < 0 && errno == EINVAL) {
+        LOG_ERROR("O_DIRECT indisponível para '%s'; usando o cache de páginas\n", path);
+        w->io = TELEMETRY_BUFFERED;
+    }
+    if (w->fd < 0) w->fd = open(path, flags, 0644);
+    if (w->fd < 0) {
+        LOG_ERROR("Não foi possível criar '%s' (%s)\n", path, strerror(errno));
+        return open_failed(w);
+    }
+
+    atomic_init(&w->head, 0);
+    atomic_init(&w->tail, 0);
+    atomic_init(&w->sinal, 0);
+    atomic_init(&w->fechar, 0);
+    clock_gettime(CLOCK_MONOTONIC, &w->ultima_entrega);
+    if (pthread_create(&w->thread, NULL, writer_main, w) != 0) {
+        LOG_ERROR("Falha ao criar a thread escritora do registro\n");
+        close(w->fd);
+        return open_failed(w);
+    }
+
+    if (header) {
+        size_t len = strlen(header);
+        memcpy(w->data[0], header, len < w->capacity ? len : w->capacity);
+        w->fill = len < w->capacity ? len : w->capacity;
+    }
+    return 0;
+}
+
+void telemetry_write(TelemetryWriter *w, const char *data, size_t len) {
+    while (len > 0) {
+        unsigned head = atomic_load_explicit(&w->head, memory_order_relaxed);
+        char *buf = w->data[head % w->count];
+        size_t n = w->capacity - w->fill < len ? w->capacity - w->fill : len;
+        memcpy(buf + w->fill, data, n);
+        w->fill += n;
+        data += n;
+        len -= n;
+        if (w->fill == w->capacity) handoff(w);
+    }
+    w->stats.linhas++;
+
+    // Buffer parcial entregue a cada flush_s (o arquivo acompanha a execução)
+    if (w->flush_s > 0.0 && w->io != TELEMETRY_DIRECT && w->fill > 0) {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        double desde = (ts.tv_sec - w->ultima_entrega.tv_sec) +
+                       (ts.tv_nsec - w->ultima_entrega.tv_nsec) / 1e9;
+        if (desde >= w->flush_s) handoff(w);
+    }
+}
+
+void telemetry_flush(TelemetryWriter *w) {
+    if (w->fill > 0 && w->io != TELEMETRY_DIRECT) handoff(w);
+}
+
+int telemetry_close(TelemetryWriter *w) {
+    if (w->io != TELEMETRY_DIRECT && w->fill > 0) handoff(w);
+    atomic_store_explicit(&w->fechar, 1, memory_order_release);
+    atomic_fetch_add_explicit(&w->sinal, 1, memory_order_release);
+    futex_wake(&w->sinal);
+    pthread_join(w->thread, NULL);
+
+    // Em direct, o final não alinhado vai pelo cache de páginas
+    int status = w->stats.erros == 0 ? 0 : -1;
+    if (w->io == TELEMETRY_DIRECT && w->fill > 0) {
+        unsigned head = atomic_load_explicit(&w->head, memory_order_relaxed);
+        struct iovec iov = { w->data[head % w->count], w->fill };
+        int flags = fcntl(w->fd, F_GETFL);
+        if (flags < 0 || fcntl(w->fd, F_SETFL, flags & ~O_DIRECT) != 0 || write_batch(w->fd, &iov, 1) != 0) {
+            LOG_ERROR("Falha ao gravar o final do registro (%s)\n", strerror(errno));
+            w->stats.erros++;
+            status = -1;
+        } else {
+            w->stats.bytes += w->fill;
+        }
+        w->fill = 0;
+    }
+    if (w->io != TELEMETRY_BUFFERED && fsync(w->fd) != 0) status = -1;
+    if (close(w->fd) != 0) status = -1;
+    w->fd = -1;
+    free_buffers(w);
+    return status;
+}
+
+void telemetry_print(const TelemetryWriter *w, const char *path, FILE *out) {
+    static const char *NOMES[] = { "buffered", "fdatasync", "direct" };
+    const TelemetryStats *s = &w->stats;
+    fprintf(out, "[REGISTRO] %lu linhas, %.1f KiB em %s (%s, %u buffers de %zu KiB)\n", s->linhas,
+            s->bytes / 1024.0, path, NOMES[w->io], w->count, w->capacity / 1024);
+    if (s->lotes > 0) {
+        fprintf(out, "  escritor: %lu lotes (%.2f buffers/lote), média %.2f ms, máx %.2f ms, %lu falhas\n",
+                s->lotes, (double)s->entregas / s->lotes, s->escrita_total / s->lotes * 1e3,
+                s->escrita_max * 1e3, s->erros);
+    }
+    fprintf(out, "  amostragem retida pelo disco: %lu vezes", s->esperas);
+    if (s->esperas > 0)
+        fprintf(out, ", total %.2f ms, máx %.2f ms", s->espera_total * 1e3, s->espera_max * 1e3);
+    fputc('\n', out);
+}
@@ -8,33 +8,42 @@
     LICENSE: CC BY-SA
 */
 
-#include <unistd.h>   // Para usleep (pausa em milissegundos)
+#define _POSIX_C_SOURCE 200112L
+#include <time.h>     // Para a marca de tempo de cada atualização
 #include <stdio.h>    // Para exibição de mensagens
 #include "monitors.h" // Para acessar dados compartilhados entre threads
-
-#define SIM_TIME_SECONDS 20  // Tempo total de simulação em segundos
-#define INTERVAL_MS 100      // Intervalo de atualização do tempo (100 ms)
+#include "threads.h"   // Protótipos das threads e dos corpos das ativações
 
 /* Função da thread de temporização e sincronização */
 void *timer_thread(void *arg) {
-    MonitorTempo *tempo = (MonitorTempo *)arg;  // Acesso à estrutura de tempo compartilhada
+    ArgsTimer *args = (ArgsTimer *)arg;
+    MonitorTempo *tempo = args->t;  // Acesso à estrutura de tempo compartilhada
+    const ScenarioConfig *cfg = args->cfg;  // Duração e intervalo do relógio
+
+    // Tempo de simulação inicial (0, ou o instante de um checkpoint restaurado)
+    pthread_mutex_lock(&tempo->mutex);
+    double t = tempo->tempo_atual;
+    pthread_mutex_unlock(&tempo->mutex);
 
-    double t = 0.0;  // Inicializa o tempo de simulação
-    while (t <= SIM_TIME_SECONDS) {
+    // Aguarda a partida comum liberada pelo supervisor
+    struct timespec next_activation;
+    int ativo = supervisor_start(&next_activation);
+
+    while (ativo && t <= cfg->sim_time_s) {
         // Atualiza o tempo atual da simulação
         pthread_mutex_lock(&tempo->mutex);
         tempo->tempo_atual = t;
+        clock_gettime(CLOCK_MONOTONIC, &tempo->marca);  // Base para o tempo exato dos consumidores
         pthread_mutex_unlock(&tempo->mutex);
 
-        // Pausa a thread por 100 ms antes de atualizar o tempo
-        usleep(INTERVAL_MS * 1000);  // Intervalo de 100 ms
-        t += INTERVAL_MS / 1000.0;  // Incrementa o tempo
+        // Aguarda o intervalo do relógio (prazo absoluto, sem deriva) antes de atualizar o tempo
+        supervisor_advance(&next_activation, cfg->timer_interval_ms);
+        ativo = supervisor_sleep_until(&next_activation);
+        t += cfg->timer_interval_ms / 1000.0;  // Incrementa o tempo
     }
 
-    // Quando o tempo de simulação atingir o limite, sinaliza o encerramento
-    pthread_mutex_lock(&tempo->mutex);
-    tempo->encerrar = 1;  // Define a flag de encerramento
-    pthread_mutex_unlock(&tempo->mutex);
+    // Quando o tempo de simulação atingir o limite, encerra todas as tarefas imediatamente
+    supervisor_shutdown(args->sv);
 
     printf("[INFO] Simulação encerrada após %.2fs\n", t);  // Exibe a mensagem de encerramento
     pthread_exit(NULL);  // Finaliza a thread
@@ -0,0 +1,433 @@
+/*
+    FILE: trajectory.c
+    DESCRIPTION:
+        Implementa a construção, persistência e mapeamento de tabelas de
+        trajetória (trajectory.h). A avaliação analítica dos segmentos só
+        ocorre na construção; em tempo de execução as threads usam apenas
+        trajectory_eval.
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE  // Para madvise
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "trajectory.h"
+#include "control_law.h"
+#include "planner.h"
+#include "logs.h"
+
+#define TRAJ_ALIGN 64          // Alinhamento da tabela (linha de cache)
+#define MAX_SEGMENTS 256
+#define MAX_WAYPOINTS 1024
+#define FIGURE8_FLIP_TIME 10.0 // Instante de inversão do oito original
+
+// ==========================
+// Segmentos paramétricos
+// ==========================
+
+typedef enum { SEG_LINE, SEG_ARC, SEG_LISSAJOUS, SEG_FIGURE8, SEG_SPLINE, SEG_PLAN } SegmentType;
+
+typedef struct {
+    SegmentType type;
+    double T;          // Duração do segmento (s)
+    double p[6];       // Parâmetros (dependem do tipo)
+    int n;             // Waypoints da spline
+    double *wx, *wy;   // Waypoints
+    double *mx, *my;   // Segundas derivadas da spline natural
+    TrajSample *plan;  // Amostras do caminho planejado, em passos de PLAN_DT
+    size_t plan_count;
+} Segment;
+
+/* Resolve as segundas derivadas de uma spline cúbica natural com passo h (Thomas) */
+static void spline_second_derivatives(const double *w, double *m, int n, double h) {
+    double c[MAX_WAYPOINTS], d[MAX_WAYPOINTS];
+    m[0] = m[n - 1] = 0.0;
+    if (n < 3) return;
+
+    // Sistema: m[i-1] + 4 m[i] + m[i+1] = 6 (w[i+1] - 2 w[i] + w[i-1]) / h²
+    c[1] = 1.0 / 4.0;
+    d[1] = 6.0 * (w[2] - 2 * w[1] + w[0]) / (h * h) / 4.0;
+    for (int i = 2; i < n - 1; i++) {
+        double rhs = 6.0 * (w[i + 1] - 2 * w[i] + w[i - 1]) / (h * h);
+        double denom = 4.0 - c[i - 1];
+        c[i] = 1.0 / denom;
+        d[i] = (rhs - d[i - 1]) / denom;
+    }
+    m[n - 2] = d[n - 2];
+    for (int i = n - 3; i >= 1; i--) m[i] = d[i] - c[i] * m[i + 1];
+}
+
+/* Avalia a spline (valor e derivada) no instante local tau */
+static void spline_eval(const double *w, const double *m, int n, double h, double tau,
+                        double *value, double *deriv) {
+    int k = (int)(tau / h);
+    if (k > n - 2) k = n - 2;
+    if (k < 0) k = 0;
+    double a = (k + 1) * h - tau;  // Distância ao nó da direita
+    double b = tau - k * h;        // Distância ao nó da esquerda
+    *value = m[k] * a * a * a / (6 * h) + m[k + 1] * b * b * b / (6 * h)
+           + (w[k] / h - m[k] * h / 6) * a + (w[k + 1] / h - m[k + 1] * h / 6) * b;
+    *deriv = -m[k] * a * a / (2 * h) + m[k + 1] * b * b / (2 * h)
+           - (w[k] / h - m[k] * h / 6) + (w[k + 1] / h - m[k + 1] * h / 6);
+}
+
+/* Avalia um segmento no instante local tau ∈ [0, T] */
+static void segment_eval(const Segment *s, double tau, TrajSample *out) {
+    const double *p = s->p;
+    switch (s->type) {
+    case SEG_LINE: {
+        double vx = (p[2] - p[0]) / s->T, vy = (p[3] - p[1]) / s->T;
+        out->x = p[0] + vx * tau;
+        out->y = p[1] + vy * tau;
+        out->dx = vx;
+        out->dy = vy;
+        break;
+    }
+    case SEG_ARC: {
+        double w = (p[4] - p[3]) / s->T;
+        double th = p[3] + w * tau;
+        out->x = p[0] + p[2] * cos(th);
+        out->y = p[1] + p[2] * sin(th);
+        out->dx = -p[2] * w * sin(th);
+        out->dy = p[2] * w * cos(th);
+        break;
+    }
+    case SEG_LISSAJOUS:
+        out->x = p[0] * sin(p[2] * tau + p[4]);
+        out->y = p[1] * sin(p[3] * tau);
+        out->dx = p[0] * p[2] * cos(p[2] * tau + p[4]);
+        out->dy = p[1] * p[3] * cos(p[3] * tau);
+        break;
+    case SEG_FIGURE8: {
+        const double A = 5.0 / M_PI, w = 0.2 * M_PI;
+        double sign = (tau < FIGURE8_FLIP_TIME) ? 1.0 : -1.0;
+        reference_figure8(tau, &out->x, &out->y);
+        out->dx = -A * w * sin(w * tau);
+        out->dy = sign * A * w * cos(w * tau);
+        break;
+    }
+    case SEG_SPLINE: {
+        double h = s->T / (s->n - 1);
+        spline_eval(s->wx, s->mx, s->n, h, tau, &out->x, &out->dx);
+        spline_eval(s->wy, s->my, s->n, h, tau, &out->y, &out->dy);
+        break;
+    }
+    case SEG_PLAN: {
+        double f = tau / PLAN_DT;
+        size_t i = (size_t)f;
+        if (i + 1 >= s->plan_count) {
+            *out = s->plan[s->plan_count - 1];
+            break;
+        }
+        double a = f - i;
+        const TrajSample *p0 = &s->plan[i], *p1 = &s->plan[i + 1];
+        out->x = p0->x + a * (p1->x - p0->x);
+        out->y = p0->y + a * (p1->y - p0->y);
+        out->dx = p0->dx + a * (p1->dx - p0->dx);
+        out->dy = p0->dy + a * (p1->dy - p0->dy);
+        break;
+    }
+    }
+}
+
+static void segments_free(Segment *segs, int n) {
+    for (int i = 0; i < n; i++) {
+        free(segs[i].wx);
+        free(segs[i].wy);
+        free(segs[i].mx);
+        free(segs[i].my);
+        free(segs[i].plan);
+    }
+}
+
+// ==========================
+// Amostragem
+// ==========================
+
+/* Amostra a sequência de segmentos em passos de dt e preenche traj */
+static int sample_segments(Trajectory *traj, const Segment *segs, int n_segs, double dt) {
+    double total = 0.0;
+    for (int i = 0; i < n_segs; i++) total += segs[i].T;
+    if (total <= 0.0 || dt <= 0.0) {
+        LOG_ERROR("Trajetória vazia ou dt inválido (duração=%f, dt=%f)\n", total, dt);
+        return -1;
+    }
+
+    size_t count = (size_t)(total / dt) + 2;  // Inclui uma amostra além do fim
+    size_t bytes = (count * sizeof(TrajSample) + TRAJ_ALIGN - 1) & ~(size_t)(TRAJ_ALIGN - 1);
+    TrajSample *samples = aligned_alloc(TRAJ_ALIGN, bytes);
+    if (!samples) {
+        LOG_ERROR("Falha ao alocar tabela de trajetória (%zu amostras)\n", count);
+        return -1;
+    }
+
+    int seg = 0;
+    double seg_start = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        double t = i * dt;
+        while (seg < n_segs - 1 && t >= seg_start + segs[seg].T) {
+            seg_start += segs[seg].T;
+            seg++;
+        }
+        double tau = t - seg_start;
+        if (tau > segs[seg].T) tau = segs[seg].T;
+        segment_eval(&segs[seg], tau, &samples[i]);
+    }
+
+    traj->samples = samples;
+    traj->count = count;
+    traj->dt = dt;
+    traj->inv_dt = 1.0 / dt;
+    traj->duration = (count - 1) * dt;
+    traj->owned = samples;
+    traj->map_base = NULL;
+    traj->map_len = 0;
+    return 0;
+}
+
+int trajectory_build_figure8(Trajectory *traj, double duration, double dt) {
+    Segment seg = { .type = SEG_FIGURE8, .T = duration };
+    return sample_segments(traj, &seg, 1, dt);
+}
+
+// ==========================
+// Leitura da especificação
+// ==========================
+
+/* Lê até max números de uma linha; retorna quantos foram lidos */
+static int parse_numbers(const char *s, double *out, int max) {
+    int n = 0;
+    char *end;
+    while (n < max) {
+        double v = strtod(s, &end);
+        if (end == s) break;
+        out[n++] = v;
+        s = end;
+    }
+    return n;
+}
+
+/* Segmento plan: caminho pelo mapa PBM (origem em (0, 0)) com os
+   obstáculos engordados pela folga, suavizado e amostrado em PLAN_DT */
+static int parse_plan(Segment *seg, const char *rest) {
+    PlanSpec spec;
+    if (plan_spec_parse(rest, &spec) != 0) return -1;
+
+    OccupancyGrid grid;
+    if (grid_load_pbm(&grid, spec.map, spec.resolution) != 0) return -1;
+    Planner planner;
+    PlanPath path = { 0 };
+    int sx, sy, gx, gy, status = -1;
+    if (grid_inflate(&grid, (int)ceil(spec.margin / spec.resolution)) != 0 || planner_init(&planner, &grid) != 0) {
+        grid_free(&grid);
+        return -1;
+    }
+    if (grid_cell_of(&grid, spec.x0, spec.y0, &sx, &sy) != 0 ||
+        grid_cell_of(&grid, spec.x1, spec.y1, &gx, &gy) != 0) {
+        LOG_ERROR("Partida ou destino fora do mapa '%s'\n", spec.map);
+    } else if (planner_search(&planner, PLANNER_JPS, sx, sy, gx, gy, &path) != 0) {
+        LOG_ERROR("Sem caminho livre de (%g, %g) a (%g, %g) em '%s'\n", spec.x0, spec.y0, spec.x1, spec.y1,
+                  spec.map);
+    } else if (plan_to_samples(&grid, &path, &spec.profile, &seg->plan, &seg->plan_count) == 0) {
+        seg->type = SEG_PLAN;
+        seg->T = (seg->plan_count - 1) * PLAN_DT;
+        status = 0;
+    }
+    plan_path_free(&path);
+    planner_destroy(&planner);
+    grid_free(&grid);
+    return status;
+}
+
+static int parse_segment(Segment *seg, const char *kind, const char *rest) {
+    if (strcmp(kind, "plan") == 0) {
+        memset(seg, 0, sizeof(*seg));
+        return parse_plan(seg, rest) == 0 && seg->T > 0.0 ? 0 : -1;
+    }
+    double nums[2 * MAX_WAYPOINTS + 1];
+    int n = parse_numbers(rest, nums, 2 * MAX_WAYPOINTS + 1);
+    memset(seg, 0, sizeof(*seg));
+
+    if (strcmp(kind, "line") == 0 && n == 5) {
+        seg->type = SEG_LINE;
+        memcpy(seg->p, nums, 4 * sizeof(double));
+        seg->T = nums[4];
+    } else if (strcmp(kind, "arc") == 0 && n == 6) {
+        seg->type = SEG_ARC;
+        memcpy(seg->p, nums, 5 * sizeof(double));
+        seg->T = nums[5];
+    } else if (strcmp(kind, "lissajous") == 0 && n == 6) {
+        seg->type = SEG_LISSAJOUS;
+        memcpy(seg->p, nums, 5 * sizeof(double));
+        seg->T = nums[5];
+    } else if (strcmp(kind, "figure8") == 0 && n == 1) {
+        seg->type = SEG_FIGURE8;
+        seg->T = nums[0];
+    } else if (strcmp(kind, "spline") == 0 && n >= 5 && (n - 1) % 2 == 0) {
+        seg->type = SEG_SPLINE;
+        seg->T = nums[0];
+        seg->n = (n - 1) / 2;
+        seg->wx = malloc(seg->n * sizeof(double));
+        seg->wy = malloc(seg->n * sizeof(double));
+        seg->mx = malloc(seg->n * sizeof(double));
+        seg->my = malloc(seg->n * sizeof(double));
+        if (!seg->wx || !seg->wy || !seg->mx || !seg->my) return -1;
+        for (int i = 0; i < seg->n; i++) {
+            seg->wx[i] = nums[1 + 2 * i];
+            seg->wy[i] = nums[2 + 2 * i];
+        }
+        double h = seg->T / (seg->n - 1);
+        spline_second_derivatives(seg->wx, seg->mx, seg->n, h);
+        spline_second_derivatives(seg->wy, seg->my, seg->n, h);
+    } else {
+        return -1;
+    }
+    return seg->T > 0.0 ? 0 : -1;
+}
+
+int trajectory_build_from_spec(Trajectory *traj, const char *path, double dt) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        LOG_ERROR("Não foi possível abrir a trajetória '%s'\n", path);
+        return -1;
+    }
+
+    // Sem buffers estáticos: a leitura é reentrante (várias instâncias da biblioteca)
+    Segment *segs = calloc(MAX_SEGMENTS, sizeof(*segs));
+    if (!segs) {
+        fclose(file);
+        LOG_ERROR("Falha de alocação ao ler '%s'\n", path);
+        return -1;
+    }
+    int n_segs = 0, status = 0, line_no = 0;
+    char line[32768];
+    while (fgets(line, sizeof(line), file)) {
+        line_no++;
+        char *comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+
+        char kind[32];
+        int consumed;
+        if (sscanf(line, "%31s%n", kind, &consumed) != 1) continue;
+        // Eventos de mapa: lidos e aplicados em execução pelo gerador (replan.h)
+        if (strcmp(kind, "block") == 0 || strcmp(kind, "clear") == 0) continue;
+
+        if (n_segs == MAX_SEGMENTS || parse_segment(&segs[n_segs], kind, line + consumed) != 0) {
+            // O segmento recusado pode já ter alocado amostras do plano ou waypoints
+            if (n_segs < MAX_SEGMENTS) segments_free(&segs[n_segs], 1);
+            LOG_ERROR("%s:%d: segmento inválido\n", path, line_no);
+            status = -1;
+            break;
+        }
+        n_segs++;
+    }
+    fclose(file);
+
+    if (status == 0) status = sample_segments(traj, segs, n_segs, dt);
+    segments_free(segs, n_segs);
+    free(segs);
+    return status;
+}
+
+// ==========================
+// Persistência e mapeamento
+// ==========================
+
+int trajectory_save(const Trajectory *traj, const char *path) {
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        LOG_ERROR("Não foi possível criar '%s'\n", path);
+        return -1;
+    }
+
+    TrajFileHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = TRAJ_MAGIC;
+    hdr.version = TRAJ_VERSION;
+    hdr.count = traj->count;
+    hdr.dt = traj->dt;
+
+    int ok = fwrite(&hdr, sizeof(hdr), 1, file) == 1 &&
+             fwrite(traj->samples, sizeof(TrajSample), traj->count, file) == traj->count;
+    if (fclose(file) != 0) ok = 0;
+    if (!ok) {
+        LOG_ERROR("Falha ao gravar '%s'\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+int trajectory_map(Trajectory *traj, const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR("Não foi possível abrir '%s'\n", path);
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TrajFileHeader)) {
+        close(fd);
+        LOG_ERROR("Arquivo de trajetória inválido: '%s'\n", path);
+        return -1;
+    }
+
+    size_t len = (size_t)st.st_size;
+    void *base = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // O mapeamento permanece válido após o close
+    if (base == MAP_FAILED) {
+        LOG_ERROR("Falha no mmap de '%s'\n", path);
+        return -1;
+    }
+
+    const TrajFileHeader *hdr = base;
+    // count vem do arquivo: compara pelo quociente para o produto não dar a volta
+    if (hdr->magic != TRAJ_MAGIC || hdr->version != TRAJ_VERSION || hdr->count < 2 ||
+        !(hdr->dt > 0.0 && isfinite(hdr->dt)) ||
+        hdr->count > (len - sizeof(*hdr)) / sizeof(TrajSample)) {
+        munmap(base, len);
+        LOG_ERROR("Cabeçalho de trajetória inválido: '%s'\n", path);
+        return -1;
+    }
+
+    // A consulta avança no tempo: leitura antecipada sequencial pelo kernel
+    madvise(base, len, MADV_SEQUENTIAL);
+
+    traj->samples = (const TrajSample *)((const char *)base + sizeof(*hdr));
+    traj->count = (size_t)hdr->count;
+    traj->dt = hdr->dt;
+    traj->inv_dt = 1.0 / hdr->dt;
+    traj->duration = (traj->count - 1) * hdr->dt;
+    traj->owned = NULL;
+    traj->map_base = base;
+    traj->map_len = len;
+    return 0;
+}
+
+int trajectory_load(Trajectory *traj, const ScenarioConfig *cfg) {
+    const char *name = cfg->trajectory;
+    size_t len = strlen(name);
+
+    if (strcmp(name, "figure8") == 0) {
+        // Margem de 1 s para cobrir o último período do gerador
+        return trajectory_build_figure8(traj, cfg->sim_time_s + 1.0, cfg->trajectory_dt);
+    }
+    if (len > 4 && strcmp(name + len - 4, ".bin") == 0) {
+        return trajectory_map(traj, name);
+    }
+    return trajectory_build_from_spec(traj, name, cfg->trajectory_dt);
+}
+
+void trajectory_free(Trajectory *traj) {
+    if (traj->map_base) munmap(traj->map_base, traj->map_len);
+    free(traj->owned);
+    memset(traj, 0, sizeof(*traj));
+}
@@ -0,0 +1,588 @@
+/*
+    FILE: analyze.c
+    DESCRIPTION:
+        Analisador nativo do registro CSV da simulação. O arquivo é mapeado
+        em memória (mmap) e percorrido em blocos paralelos, alinhados em
+        quebras de linha, que calculam os indicadores de erro e esforço e
+        as médias por intervalo de tempo. As integrais (ISE, IAE, ITAE,
+        esforço e percurso) usam os instantes gravados, com espaçamento
+        livre: cada bloco guarda as colunas derivadas em lotes e os integra
+        pelo trapézio vetorizado de integral.h. Em seguida cada série é reduzida
+        por LTTB (Largest-Triangle-Three-Buckets), que preserva picos e
+        vales, a uma série do tamanho de um gráfico. A memória usada
+        depende apenas do número de pontos de saída, não do tamanho do log.
+        Uso: analyze [data/saida.csv] [--points N] [--threads T] [--out arquivo]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "numfmt.h"
+#include "integral.h"
+
+#define MAX_COLUMNS 32
+#define MAX_THREADS 64
+#define MIN_POINTS 3
+#define RELEASE_BYTES (16u << 20)  // Devolve ao kernel as páginas já lidas a cada 16 MiB
+#define KPI_BLOCK 4096             // Linhas por lote das integrais
+
+// Colunas usadas pela análise (índices no cabeçalho, -1 se ausente)
+enum { COL_T, COL_XREF, COL_YREF, COL_Y1, COL_Y2, COL_X3, COL_V1, COL_V2, COL_U1, COL_U2, N_COLS };
+static const char *COL_NAMES[N_COLS] = { "t", "xref", "yref", "y1", "y2", "x3", "v1", "v2", "u1", "u2" };
+
+// Série decimada: pontos (a, b) extraídos de cada linha
+typedef enum { SERIES_TIME, SERIES_DIFF, SERIES_XY } SeriesKind;
+
+typedef struct {
+    const char *name;
+    SeriesKind kind;
+    int col1, col2;  // TIME: b = col1; DIFF: b = col1 - col2; XY: (a, b) = (col1, col2)
+} SeriesDef;
+
+static const SeriesDef SERIES[] = {
+    { "xref",    SERIES_TIME, COL_XREF, -1 },
+    { "y1",      SERIES_TIME, COL_Y1, -1 },
+    { "yref",    SERIES_TIME, COL_YREF, -1 },
+    { "y2",      SERIES_TIME, COL_Y2, -1 },
+    { "erro_x",  SERIES_DIFF, COL_XREF, COL_Y1 },
+    { "erro_y",  SERIES_DIFF, COL_YREF, COL_Y2 },
+    { "theta",   SERIES_TIME, COL_X3, -1 },
+    { "xy_ref",  SERIES_XY,   COL_XREF, COL_YREF },
+    { "xy_real", SERIES_XY,   COL_Y1, COL_Y2 },
+};
+#define N_SERIES (int)(sizeof(SERIES) / sizeof(SERIES[0]))
+
+// Integrandos dos indicadores, derivados de cada linha
+enum { KPI_E2, KPI_E, KPI_TE, KPI_V2, KPI_U2, KPI_SPEED, N_KPI };
+
+// Lote de colunas derivadas; a primeira linha repete a última do lote anterior
+typedef struct {
+    double t[KPI_BLOCK];
+    double y[N_KPI][KPI_BLOCK];
+    int n;
+} KpiBlock;
+
+// Acumuladores de um bloco (combinados ao final)
+typedef struct {
+    long rows;
+    double max_e;
+    double sum_ex2, sum_ey2, max_ex, max_ey;
+    double integral[N_KPI];              // ∫ dt de cada integrando dentro do bloco
+    double first_t, first[N_KPI];        // Primeira e última linha, para costurar
+    double last_t, last[N_KPI];          // o intervalo entre blocos vizinhos
+    double *bucket_sum;  // [bucket][série][a, b]
+    long *bucket_count;  // [bucket]
+} Partial;
+
+typedef struct {
+    const char *begin, *end;  // Linhas completas do bloco
+    const int *map;           // Índice da coluna no CSV para cada COL_*
+    int n_csv_cols;
+    double t0, t_span;        // Intervalo total de tempo (para os intervalos do LTTB)
+    int n_buckets;
+    Partial acc;
+    KpiBlock *kpi;
+} Chunk;
+
+// ==========================
+// Leitura de números
+// ==========================
+
+static const double POW10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* Lê um número decimal de [p, end); caminho rápido para a notação fixa
+   gravada pelo logger e strtod para os demais casos */
+static double parse_number(const char **pp, const char *end) {
+    const char *p = *pp;
+    int neg = 0;
+    if (p < end && (*p == '-' || *p == '+')) neg = (*p++ == '-');
+
+    unsigned long long mant = 0;
+    int digits = 0, frac = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        mant = mant * 10 + (unsigned)(*p++ - '0');
+        digits++;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && *p >= '0' && *p <= '9') {
+            mant = mant * 10 + (unsigned)(*p++ - '0');
+            digits++;
+            frac++;
+        }
+    }
+
+    if (digits > 0 && digits <= 15 && (p >= end || (*p != 'e' && *p != 'E' && *p != 'n' && *p != 'i'))) {
+        // Mantissa e potência exatas: uma única divisão, corretamente arredondada
+        double v = (double)mant / POW10[frac];
+        *pp = p;
+        return neg ? -v : v;
+    }
+
+    // Caminho geral: copia o campo (o mapeamento não termina em '\0')
+    char buf[64];
+    const char *q = *pp;
+    size_t n = 0;
+    while (q < end && *q != ',' && *q != '\n' && *q != '\r' && n < sizeof(buf) - 1) buf[n++] = *q++;
+    buf[n] = '\0';
+    *pp = q;
+    return strtod(buf, NULL);
+}
+
+/* Lê uma linha; retorna o número de campos lidos e avança *pp para a próxima linha */
+static int parse_row(const char **pp, const char *end, double *fields, int max_fields) {
+    const char *p = *pp;
+    int n = 0;
+    while (p < end && *p != '\n') {
+        if (n < max_fields) fields[n] = parse_number(&p, end);
+        n++;
+        while (p < end && *p != ',' && *p != '\n') p++;  // Descarta o restante do campo
+        if (p < end && *p == ',') p++;
+    }
+    if (p < end) p++;  // '\n'
+    *pp = p;
+    return n;
+}
+
+/* Valores (a, b) de uma série na linha */
+static inline void series_point(const SeriesDef *s, const double *row, double *a, double *b) {
+    switch (s->kind) {
+    case SERIES_DIFF: *a = row[COL_T]; *b = row[s->col1] - row[s->col2]; break;
+    case SERIES_XY:   *a = row[s->col1]; *b = row[s->col2]; break;
+    default:          *a = row[COL_T]; *b = row[s->col1]; break;
+    }
+}
+
+/* Copia os campos do CSV para a ordem COL_* (colunas ausentes valem 0) */
+static inline void select_columns(const double *fields, const int *map, double *row) {
+    for (int c = 0; c < N_COLS; c++) row[c] = map[c] >= 0 ? fields[map[c]] : 0.0;
+}
+
+/* Descarta do mapeamento as páginas inteiras já percorridas em [*mark, p), mantendo a memória
+   residente constante em logs longos (as páginas continuam no cache do sistema) */
+static void release_behind(const char **mark, const char *p) {
+    if ((size_t)(p - *mark) < RELEASE_BYTES) return;
+    static long page;
+    if (!page) page = sysconf(_SC_PAGESIZE);
+    uintptr_t from = ((uintptr_t)*mark + (uintptr_t)page - 1) & ~(uintptr_t)(page - 1);
+    uintptr_t to = (uintptr_t)p & ~(uintptr_t)(page - 1);
+    if (to > from) madvise((void *)from, to - from, MADV_DONTNEED);
+    *mark = p;
+}
+
+static inline int bucket_of(const Chunk *c, double t) {
+    int b = (int)((t - c->t0) / c->t_span * c->n_buckets);
+    if (b < 0) b = 0;
+    if (b >= c->n_buckets) b = c->n_buckets - 1;
+    return b;
+}
+
+// ==========================
+// Passagem paralela: indicadores e médias por intervalo
+// ==========================
+
+/* Integra o lote pelo trapézio e mantém a última linha como início do próximo */
+static void kpi_flush(KpiBlock *b, Partial *acc) {
+    if (b->n < 2) return;
+    for (int k = 0; k < N_KPI; k++) acc->integral[k] += samples_trapezoid(b->t, b->y[k], (size_t)b->n);
+    int last = b->n - 1;
+    b->t[0] = b->t[last];
+    for (int k = 0; k < N_KPI; k++) b->y[k][0] = b->y[k][last];
+    b->n = 1;
+}
+
+static void kpi_push(KpiBlock *b, Partial *acc, double t, const double *v) {
+    if (acc->rows == 0) {
+        acc->first_t = t;
+        memcpy(acc->first, v, sizeof(acc->first));
+    }
+    acc->last_t = t;
+    memcpy(acc->last, v, sizeof(acc->last));
+    b->t[b->n] = t;
+    for (int k = 0; k < N_KPI; k++) b->y[k][b->n] = v[k];
+    if (++b->n == KPI_BLOCK) kpi_flush(b, acc);
+}
+
+static void *chunk_worker(void *arg) {
+    Chunk *c = (Chunk *)arg;
+    Partial *acc = &c->acc;
+    double fields[MAX_COLUMNS], row[N_COLS];
+    const char *p = c->begin, *mark = c->begin;
+
+    while (p < c->end) {
+        release_behind(&mark, p);
+        int n = parse_row(&p, c->end, fields, MAX_COLUMNS);
+        if (n < c->n_csv_cols) continue;  // Linha incompleta (ex.: fim de arquivo truncado)
+        select_columns(fields, c->map, row);
+
+        double ex = row[COL_XREF] - row[COL_Y1];
+        double ey = row[COL_YREF] - row[COL_Y2];
+        double e2 = ex * ex + ey * ey, e = sqrt(e2);
+        if (e > acc->max_e) acc->max_e = e;
+        acc->sum_ex2 += ex * ex;
+        acc->sum_ey2 += ey * ey;
+        if (fabs(ex) > acc->max_ex) acc->max_ex = fabs(ex);
+        if (fabs(ey) > acc->max_ey) acc->max_ey = fabs(ey);
+        const double v[N_KPI] = {
+            e2, e, row[COL_T] * e,
+            row[COL_V1] * row[COL_V1] + row[COL_V2] * row[COL_V2],
+            row[COL_U1] * row[COL_U1] + row[COL_U2] * row[COL_U2],
+            fabs(row[COL_U1]),  // Velocidade linear: ∫ |u1| dt é o percurso
+        };
+        kpi_push(c->kpi, acc, row[COL_T], v);
+        acc->rows++;
+
+        int b = bucket_of(c, row[COL_T]);
+        double *sum = &acc->bucket_sum[(size_t)b * N_SERIES * 2];
+        for (int s = 0; s < N_SERIES; s++) {
+            double a, v;
+            series_point(&SERIES[s], row, &a, &v);
+            sum[2 * s] += a;
+            sum[2 * s + 1] += v;
+        }
+        acc->bucket_count[b]++;
+    }
+    kpi_flush(c->kpi, acc);
+    return NULL;
+}
+
+// ==========================
+// Seleção LTTB (sequencial, uma linha por vez para todas as séries)
+// ==========================
+
+typedef struct {
+    double a, b;
+} Point;
+
+typedef struct {
+    Point *out;        // [série][ponto]
+    int *n_out;        // Pontos já escolhidos por série
+    int capacity;
+} Selection;
+
+static inline void emit(Selection *sel, int s, Point p) {
+    sel->out[(size_t)s * sel->capacity + sel->n_out[s]++] = p;
+}
+
+/*
+ * Para cada intervalo, escolhe por série a linha que forma o triângulo de maior área com o
+ * ponto escolhido no intervalo anterior (A) e a média do próximo intervalo não vazio (C).
+ */
+static void lttb_select(const Chunk *c, const char *begin, const char *end,
+                        const double *avg, const int *next_nonempty, Selection *sel) {
+    double fields[MAX_COLUMNS], row[N_COLS];
+    Point last[N_SERIES], best[N_SERIES];
+    double best_area[N_SERIES];
+    long best_row[N_SERIES], row_index = -1;
+    int have_first = 0, current = -1;
+    const char *p = begin, *mark = begin;
+
+    while (p < end) {
+        release_behind(&mark, p);
+        int n = parse_row(&p, end, fields, MAX_COLUMNS);
+        if (n < c->n_csv_cols) continue;
+        select_columns(fields, c->map, row);
+        row_index++;
+
+        Point pt[N_SERIES];
+        for (int s = 0; s < N_SERIES; s++) series_point(&SERIES[s], row, &pt[s].a, &pt[s].b);
+        for (int s = 0; s < N_SERIES; s++) last[s] = pt[s];
+
+        if (!have_first) {  // O primeiro ponto é sempre mantido
+            for (int s = 0; s < N_SERIES; s++) {
+                emit(sel, s, pt[s]);
+                best[s] = pt[s];
+            }
+            have_first = 1;
+            continue;
+        }
+
+        int b = bucket_of(c, row[COL_T]);
+        if (b != current) {
+            if (current >= 0) {
+                for (int s = 0; s < N_SERIES; s++) emit(sel, s, best[s]);
+            }
+            current = b;
+            for (int s = 0; s < N_SERIES; s++) best_area[s] = -1.0;
+        }
+
+        int nb = next_nonempty[b];
+        for (int s = 0; s < N_SERIES; s++) {
+            // A = último ponto escolhido; C = média do próximo intervalo (ou o próprio ponto)
+            const Point *A = &sel->out[(size_t)s * sel->capacity + sel->n_out[s] - 1];
+            double ca = nb >= 0 ? avg[((size_t)nb * N_SERIES + s) * 2] : pt[s].a;
+            double cb = nb >= 0 ? avg[((size_t)nb * N_SERIES + s) * 2 + 1] : pt[s].b;
+            double area = fabs((A->a - ca) * (pt[s].b - A->b) - (A->a - pt[s].a) * (cb - A->b));
+            if (area > best_area[s]) {
+                best_area[s] = area;
+                best[s] = pt[s];
+                best_row[s] = row_index;
+            }
+        }
+    }
+
+    // Fecha o último intervalo (sem repetir a última linha) e mantém o último ponto
+    if (current >= 0) {
+        for (int s = 0; s < N_SERIES; s++) {
+            if (best_row[s] != row_index) emit(sel, s, best[s]);
+        }
+    }
+    if (have_first) {
+        for (int s = 0; s < N_SERIES; s++) emit(sel, s, last[s]);
+    }
+}
+
+// ==========================
+// Programa principal
+// ==========================
+
+/* Lê o cabeçalho e associa as colunas; retorna o número de colunas ou -1 */
+static int parse_header(const char *p, const char *end, int *map, const char **data) {
+    for (int c = 0; c < N_COLS; c++) map[c] = -1;
+    int n = 0;
+    while (p < end && *p != '\n') {
+        const char *start = p;
+        while (p < end && *p != ',' && *p != '\n' && *p != '\r') p++;
+        size_t len = (size_t)(p - start);
+        for (int c = 0; c < N_COLS; c++) {
+            if (strlen(COL_NAMES[c]) == len && memcmp(COL_NAMES[c], start, len) == 0) map[c] = n;
+        }
+        n++;
+        while (p < end && *p != ',' && *p != '\n') p++;
+        if (p < end && *p == ',') p++;
+    }
+    if (p < end) p++;
+    *data = p;
+    for (int c = COL_T; c <= COL_Y2; c++) {
+        if (map[c] < 0) {
+            fprintf(stderr, "[ERRO] Coluna obrigatória ausente: %s\n", COL_NAMES[c]);
+            return -1;
+        }
+    }
+    return n;
+}
+
+/* Tempo da primeira e da última linha completas */
+static int time_range(const char *data, const char *end, const int *map, int n_cols,
+                      double *t0, double *t1) {
+    double fields[MAX_COLUMNS];
+    const char *p = data;
+    if (parse_row(&p, end, fields, MAX_COLUMNS) < n_cols) return -1;
+    *t0 = fields[map[COL_T]];
+
+    // Recua linha a linha a partir do fim até encontrar uma linha completa
+    const char *line_end = end;
+    while (line_end > data) {
+        while (line_end > data && (line_end[-1] == '\n' || line_end[-1] == '\r')) line_end--;
+        const char *q = line_end;
+        while (q > data && q[-1] != '\n') q--;
+        const char *start = q;
+        if (parse_row(&q, line_end, fields, MAX_COLUMNS) >= n_cols) break;
+        line_end = start;  // Linha truncada: tenta a anterior
+    }
+    if (line_end <= data) return -1;
+    *t1 = fields[map[COL_T]];
+    return *t1 > *t0 ? 0 : -1;
+}
+
+/* Escreve as séries decimadas em formato longo: serie,a,b (omite séries sem colunas no log) */
+static int write_series(const char *path, const Selection *sel, const int *map) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "[ERRO] Não foi possível criar '%s'\n", path);
+        return -1;
+    }
+    fputs("serie,a,b\n", f);
+    char line[2 * NUMFMT_DOUBLE_BUFSZ + 32];
+    for (int s = 0; s < N_SERIES; s++) {
+        if (map[SERIES[s].col1] < 0 || (SERIES[s].col2 >= 0 && map[SERIES[s].col2] < 0)) continue;
+        for (int i = 0; i < sel->n_out[s]; i++) {
+            const Point *pt = &sel->out[(size_t)s * sel->capacity + i];
+            size_t n = strlen(SERIES[s].name);
+            memcpy(line, SERIES[s].name, n);
+            line[n++] = ',';
+            n += numfmt_double_shortest(line + n, pt->a);
+            line[n++] = ',';
+            n += numfmt_double_shortest(line + n, pt->b);
+            line[n++] = '\n';
+            fwrite(line, 1, n, f);
+        }
+    }
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+int main(int argc, char *argv[]) {
+    const char *input = "data/saida.csv";
+    const char *output = "data/analise.csv";
+    int points = 2000;
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--points") == 0 && i + 1 < argc) points = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) output = argv[++i];
+        else if (argv[i][0] != '-') input = argv[i];
+        else {
+            fprintf(stderr, "Uso: %s [log.csv] [--points N] [--threads T] [--out arquivo]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (points < MIN_POINTS) points = MIN_POINTS;
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+
+    // Mapeamento do log (páginas carregadas sob demanda, leitura sequencial)
+    int fd = open(input, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "[ERRO] Não foi possível abrir '%s'\n", input);
+        return EXIT_FAILURE;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        fprintf(stderr, "[ERRO] Log vazio: '%s'\n", input);
+        close(fd);
+        return EXIT_FAILURE;
+    }
+    size_t size = (size_t)st.st_size;
+    const char *base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "[ERRO] mmap falhou para '%s'\n", input);
+        return EXIT_FAILURE;
+    }
+    madvise((void *)base, size, MADV_SEQUENTIAL);
+    const char *end = base + size;
+
+    int map[N_COLS];
+    const char *data;
+    int n_cols = parse_header(base, end, map, &data);
+    double t0, t1;
+    if (n_cols < 0 || n_cols > MAX_COLUMNS || time_range(data, end, map, n_cols, &t0, &t1) != 0) {
+        fprintf(stderr, "[ERRO] Log sem dados válidos: '%s'\n", input);
+        munmap((void *)base, size);
+        return EXIT_FAILURE;
+    }
+
+    // Primeiro e último ponto são fixos; os demais saem de um intervalo cada
+    int n_buckets = points - 2;
+    int status = EXIT_SUCCESS;
+
+    // Blocos paralelos alinhados em quebras de linha
+    Chunk chunks[MAX_THREADS];
+    size_t span = (size_t)(end - data) / (size_t)threads + 1;
+    const char *p = data;
+    for (int k = 0; k < threads; k++) {
+        Chunk *c = &chunks[k];
+        memset(c, 0, sizeof(*c));
+        c->begin = p;
+        const char *q = (k == threads - 1 || (size_t)(end - p) <= span) ? end : p + span;
+        while (q < end && q[-1] != '\n') q++;
+        c->end = q;
+        p = q;
+        c->map = map;
+        c->n_csv_cols = n_cols;
+        c->t0 = t0;
+        c->t_span = t1 - t0;
+        c->n_buckets = n_buckets;
+        c->acc.bucket_sum = calloc((size_t)n_buckets * N_SERIES * 2, sizeof(double));
+        c->acc.bucket_count = calloc((size_t)n_buckets, sizeof(long));
+        c->kpi = malloc(sizeof(KpiBlock));
+        if (!c->acc.bucket_sum || !c->acc.bucket_count || !c->kpi) {
+            fprintf(stderr, "[ERRO] Memória insuficiente\n");
+            return EXIT_FAILURE;
+        }
+        c->kpi->n = 0;
+    }
+
+    pthread_t th[MAX_THREADS];
+    for (int k = 0; k < threads; k++) pthread_create(&th[k], NULL, chunk_worker, &chunks[k]);
+    for (int k = 0; k < threads; k++) pthread_join(th[k], NULL);
+
+    // Combina os blocos; o intervalo entre a última linha de um bloco e a
+    // primeira do seguinte entra como mais um trapézio
+    Partial total = chunks[0].acc;
+    const Partial *prev = total.rows > 0 ? &chunks[0].acc : NULL;
+    for (int k = 1; k < threads; k++) {
+        const Partial *a = &chunks[k].acc;
+        if (a->rows > 0) {
+            for (int i = 0; i < N_KPI; i++) {
+                total.integral[i] += a->integral[i];
+                if (prev) total.integral[i] += 0.5 * (a->first_t - prev->last_t) * (prev->last[i] + a->first[i]);
+            }
+            prev = a;
+        }
+        total.rows += a->rows;
+        total.sum_ex2 += a->sum_ex2;
+        total.sum_ey2 += a->sum_ey2;
+        if (a->max_e > total.max_e) total.max_e = a->max_e;
+        if (a->max_ex > total.max_ex) total.max_ex = a->max_ex;
+        if (a->max_ey > total.max_ey) total.max_ey = a->max_ey;
+        for (size_t i = 0; i < (size_t)n_buckets * N_SERIES * 2; i++) total.bucket_sum[i] += a->bucket_sum[i];
+        for (int b = 0; b < n_buckets; b++) total.bucket_count[b] += a->bucket_count[b];
+    }
+
+    // Médias por intervalo e próximo intervalo não vazio (ponto C do LTTB)
+    double *avg = total.bucket_sum;
+    int *next_nonempty = malloc((size_t)n_buckets * sizeof(int));
+    Selection sel;
+    sel.capacity = points + 2;
+    sel.out = malloc((size_t)N_SERIES * sel.capacity * sizeof(Point));
+    sel.n_out = calloc(N_SERIES, sizeof(int));
+    if (!next_nonempty || !sel.out || !sel.n_out) {
+        fprintf(stderr, "[ERRO] Memória insuficiente\n");
+        return EXIT_FAILURE;
+    }
+    int next = -1;
+    for (int b = n_buckets - 1; b >= 0; b--) {
+        next_nonempty[b] = next;
+        if (total.bucket_count[b] > 0) {
+            for (int i = 0; i < N_SERIES * 2; i++) avg[(size_t)b * N_SERIES * 2 + i] /= total.bucket_count[b];
+            next = b;
+        }
+    }
+
+    lttb_select(&chunks[0], data, end, avg, next_nonempty, &sel);
+
+    // Indicadores: integrais pelo trapézio sobre os instantes gravados
+    double dt = total.rows > 1 ? (t1 - t0) / (double)(total.rows - 1) : 0.0;
+    double T = t1 - t0;
+    const double *I = total.integral;
+    printf("[ANÁLISE] %s: %ld linhas, %.2f s (dt médio = %.4f s), %d threads, integrais %s\n",
+           input, total.rows, T, dt, threads, samples_isa_name(samples_isa()));
+    printf("  |ref - y|: RMS=%.4f  máx=%.4f  ISE=%.4f  IAE=%.4f  ITAE=%.4f\n",
+           T > 0 ? sqrt(I[KPI_E2] / T) : 0.0, total.max_e, I[KPI_E2], I[KPI_E], I[KPI_TE]);
+    printf("  Erro em X: RMS=%.4f  máx=%.4f | Erro em Y: RMS=%.4f  máx=%.4f\n",
+           sqrt(total.sum_ex2 / total.rows), total.max_ex,
+           sqrt(total.sum_ey2 / total.rows), total.max_ey);
+    if (map[COL_V1] >= 0 && map[COL_U1] >= 0)
+        printf("  Esforço: ∫|v|²=%.4f  ∫|u|²=%.4f | Percurso: ∫|u1| dt=%.4f m\n",
+               I[KPI_V2], I[KPI_U2], I[KPI_SPEED]);
+
+    if (write_series(output, &sel, map) != 0) status = EXIT_FAILURE;
+    else printf("  %d pontos por série gravados em %s\n", sel.n_out[0], output);
+
+    for (int k = 0; k < threads; k++) {
+        free(chunks[k].acc.bucket_sum);
+        free(chunks[k].acc.bucket_count);
+        free(chunks[k].kpi);
+    }
+    free(next_nonempty);
+    free(sel.out);
+    free(sel.n_out);
+    munmap((void *)base, size);
+    return status;
+}
@@ -0,0 +1,260 @@
+/*
+    FILE: backends.c
+    DESCRIPTION:
+        Compara os backends numéricos das leis do controlador (double,
+        float32 e Q16.16, control_kernel.h) no mesmo cenário:
+          - precisão: três simulações headless em passo travado, uma por
+            backend (a planta é sempre double), com o desvio máximo da
+            saída y e do comando u em relação ao double e a diferença dos
+            indicadores de rastreamento;
+          - custo: ciclos (TSC em x86) e ns por ativação do controlador
+            (dois modelos de referência, controle e linearização) com os
+            núcleos nativos de cada backend sobre entradas pseudoaleatórias.
+        Uso: backends [cenario.cfg] [chave=valor ...] [--iters N] [--reps R]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+#include <time.h>
+#include "scenario.h"
+#include "headless.h"
+#include "trajectory.h"
+#include "control_kernel.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#else
+#define HAVE_TSC 0
+#endif
+
+#define N_BACKENDS 3
+#define N_INPUTS 1024  // Potência de 2
+
+static const ControlKernel *const BACKENDS[N_BACKENDS] = {
+    &control_kernel_double, &control_kernel_float32, &control_kernel_q16
+};
+
+// Desvios de um backend em relação ao double
+typedef struct {
+    HeadlessResult r;
+    double max_dy;   // max |y - y_double| (m)
+    double max_du;   // max |u - u_double|
+} Accuracy;
+
+// Custo de uma ativação do controlador
+typedef struct {
+    double cycles;   // Ciclos TSC por ativação (0 sem TSC)
+    double ns;       // Tempo de parede por ativação
+} Cost;
+
+// Entradas de uma ativação, em cada tipo nativo
+typedef struct {
+    double d[5];     // refx, refy, y1, y2, theta
+    float f[5];
+    q16_t q[5];
+} Inputs;
+
+static volatile double sink;
+
+static uint64_t cycles_now(void) {
+#if HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// ==========================
+// Precisão (passo travado)
+// ==========================
+
+static void run_accuracy(const ScenarioConfig *cfg, const Trajectory *traj, Accuracy *acc) {
+    static HeadlessSim sims[N_BACKENDS];
+    for (int b = 0; b < N_BACKENDS; b++) {
+        headless_init(&sims[b], cfg, traj);
+        sims[b].model.kernel = BACKENDS[b];
+        acc[b].max_dy = acc[b].max_du = 0.0;
+    }
+
+    for (;;) {
+        int live = 0;
+        for (int b = 0; b < N_BACKENDS; b++) live |= headless_step(&sims[b]);
+        if (!live) break;
+
+        const DiffRobotState *ref = &sims[0].state;
+        for (int b = 1; b < N_BACKENDS; b++) {
+            const DiffRobotState *s = &sims[b].state;
+            double dy = hypot(s->robot.y1 - ref->robot.y1, s->robot.y2 - ref->robot.y2);
+            double du = fmax(fabs(s->u1 - ref->u1), fabs(s->u2 - ref->u2));
+            if (dy > acc[b].max_dy) acc[b].max_dy = dy;
+            if (du > acc[b].max_du) acc[b].max_du = du;
+        }
+    }
+    for (int b = 0; b < N_BACKENDS; b++) {
+        headless_finish(&sims[b]);
+        acc[b].r = sims[b].result;
+    }
+}
+
+// ==========================
+// Custo (núcleos nativos)
+// ==========================
+
+static void make_inputs(Inputs *in) {
+    uint64_t x = 0x9E3779B97F4A7C15ull;
+    static const double SCALE[5] = { 2.0, 2.0, 2.0, 2.0, M_PI };
+    for (int i = 0; i < N_INPUTS; i++) {
+        for (int k = 0; k < 5; k++) {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            double u = (double)(x >> 11) / 9007199254740992.0;  // [0, 1)
+            double v = (2.0 * u - 1.0) * SCALE[k];
+            in[i].d[k] = v;
+            in[i].f[k] = (float)v;
+            in[i].q[k] = q16_from_double(v);
+        }
+    }
+}
+
+/* Executa iters ativações do backend b; acumula as saídas em sink */
+static void activations(int b, const ScenarioConfig *cfg, const Inputs *in, long iters) {
+    double a1 = cfg->alpha1, a2 = cfg->alpha2, dt = cfg->model_period_ms / 1000.0;
+    double acc = 0.0;
+
+    if (b == 0) {
+        double ymx = 0, dymx = 0, ymy = 0, dymy = 0, v1, v2, u1, u2;
+        for (long i = 0; i < iters; i++) {
+            const double *x = in[i & (N_INPUTS - 1)].d;
+            model_ref_step_f64(x[0], a1, dt, &ymx, &dymx);
+            model_ref_step_f64(x[1], a2, dt, &ymy, &dymy);
+            control_law_f64(cfg, ymx, dymx, ymy, dymy, x[2], x[3], a1, a2, &v1, &v2);
+            linearization_law_f64(cfg, x[4], v1, v2, &u1, &u2);
+            acc += u1 + u2;
+        }
+    } else if (b == 1) {
+        KernelParamsF32 p;
+        kernel_f32_params(cfg, &p);
+        float fa1 = (float)a1, fa2 = (float)a2, fdt = (float)dt;
+        float ymx = 0, dymx = 0, ymy = 0, dymy = 0, v1, v2, u1, u2, facc = 0;
+        for (long i = 0; i < iters; i++) {
+            const float *x = in[i & (N_INPUTS - 1)].f;
+            kernel_f32_model_ref(x[0], fa1, fdt, &ymx, &dymx);
+            kernel_f32_model_ref(x[1], fa2, fdt, &ymy, &dymy);
+            kernel_f32_control(&p, ymx, dymx, ymy, dymy, x[2], x[3], fa1, fa2, &v1, &v2);
+            kernel_f32_linearization(&p, x[4], v1, v2, &u1, &u2);
+            facc += u1 + u2;
+        }
+        acc = facc;
+    } else {
+        KernelParamsQ16 p;
+        kernel_q16_params(cfg, &p);
+        q16_t qa1 = q16_from_double(a1), qa2 = q16_from_double(a2), qdt = q16_from_double(dt);
+        q16_t ymx = 0, dymx = 0, ymy = 0, dymy = 0, v1, v2, u1, u2;
+        int64_t qacc = 0;
+        for (long i = 0; i < iters; i++) {
+            const q16_t *x = in[i & (N_INPUTS - 1)].q;
+            kernel_q16_model_ref(x[0], qa1, qdt, &ymx, &dymx);
+            kernel_q16_model_ref(x[1], qa2, qdt, &ymy, &dymy);
+            kernel_q16_control(&p, ymx, dymx, ymy, dymy, x[2], x[3], qa1, qa2, &v1, &v2);
+            kernel_q16_linearization(&p, x[4], v1, v2, &u1, &u2);
+            qacc += (int64_t)u1 + u2;
+        }
+        acc = (double)qacc;
+    }
+    sink += acc;
+}
+
+/* Melhor de reps medições de iters ativações */
+static void run_cost(int b, const ScenarioConfig *cfg, const Inputs *in, long iters, int reps, Cost *c) {
+    activations(b, cfg, in, iters / 10 + 1);  // Aquecimento
+    c->cycles = c->ns = INFINITY;
+    for (int r = 0; r < reps; r++) {
+        double t0 = now_ns();
+        uint64_t c0 = cycles_now();
+        activations(b, cfg, in, iters);
+        uint64_t c1 = cycles_now();
+        double t1 = now_ns();
+        c->cycles = fmin(c->cycles, (double)(c1 - c0) / iters);
+        c->ns = fmin(c->ns, (t1 - t0) / iters);
+    }
+}
+
+static void usage(void) {
+    fprintf(stderr, "Uso: backends [cenario.cfg] [chave=valor ...] [--iters N] [--reps R]\n");
+}
+
+int main(int argc, char **argv) {
+    ScenarioConfig cfg;
+    scenario_set_defaults(&cfg);
+    long iters = 1000000;
+    int reps = 5;
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        int has_value = i + 1 < argc;
+        if (strcmp(a, "--iters") == 0 && has_value) {
+            iters = atol(argv[++i]);
+        } else if (strcmp(a, "--reps") == 0 && has_value) {
+            reps = atoi(argv[++i]);
+        } else if (a[0] == '-') {
+            usage();
+            return EXIT_FAILURE;
+        } else if ((strchr(a, '=') ? scenario_apply(&cfg, a) : scenario_load_file(&cfg, a)) != 0) {
+            fprintf(stderr, "[ERRO] Cenário inválido: %s\n", a);
+            return EXIT_FAILURE;
+        }
+    }
+    if (scenario_validate(&cfg) != 0) return EXIT_FAILURE;
+    if (iters < 1) iters = 1;
+    if (reps < 1) reps = 1;
+
+    Trajectory traj;
+    if (trajectory_load(&traj, &cfg) != 0) {
+        fprintf(stderr, "[ERRO] Trajetória inválida: %s\n", cfg.trajectory);
+        return EXIT_FAILURE;
+    }
+
+    Accuracy acc[N_BACKENDS];
+    run_accuracy(&cfg, &traj, acc);
+
+    static Inputs in[N_INPUTS];
+    Cost cost[N_BACKENDS];
+    make_inputs(in);
+    for (int b = 0; b < N_BACKENDS; b++) run_cost(b, &cfg, in, iters, reps, &cost[b]);
+
+    printf("[BACKENDS] %.2f s simulados (%s), %ld ativações por medição, melhor de %d\n",
+           cfg.sim_time_s, cfg.trajectory, iters, reps);
+    printf("  backend   ciclos/ativ   ns/ativ  vs double    RMS erro     Δ RMS  Δ ISE rel"
+           "   máx|Δy| (m)    máx|Δu|\n");
+    const HeadlessResult *r0 = &acc[0].r;
+    for (int b = 0; b < N_BACKENDS; b++) {
+        const HeadlessResult *r = &acc[b].r;
+        char cyc[32];
+        if (HAVE_TSC) snprintf(cyc, sizeof(cyc), "%11.1f", cost[b].cycles);
+        else snprintf(cyc, sizeof(cyc), "%11s", "-");
+        printf("  %-8s %s %9.2f %9.2fx  %10.3e %+9.2e %+10.2e   %11.3e %10.3e\n",
+               BACKENDS[b]->nome, cyc, cost[b].ns, cost[0].ns / cost[b].ns,
+               r->rms_error, r->rms_error - r0->rms_error,
+               r0->ise > 0 ? (r->ise - r0->ise) / r0->ise : 0.0,
+               acc[b].max_dy, acc[b].max_du);
+    }
+    printf("  Compilado com o backend: %s\n", control_kernel_compiled->nome);
+
+    trajectory_free(&traj);
+    return EXIT_SUCCESS;
+}
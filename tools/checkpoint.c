@@ -0,0 +1,45 @@
+/*
+    FILE: checkpoint.c
+    DESCRIPTION:
+        Mostra o conteúdo de um checkpoint (checkpoint.h): instante,
+        estado do robô, referência, modelos de referência, comandos,
+        estimador e os indicadores acumulados até ali, para escolher de
+        onde partir um ramo com "restore_file".
+        Uso: checkpoint <arquivo>
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "checkpoint.h"
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fprintf(stderr, "Uso: checkpoint <arquivo>\n");
+        return EXIT_FAILURE;
+    }
+
+    static SystemCheckpoint ck;
+    if (checkpoint_load(&ck, argv[1]) != 0) {
+        fprintf(stderr, "[ERRO] Checkpoint inválido: %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    printf("[CHECKPOINT] %s: t=%.3f s, %zu bytes de estado\n", argv[1], ck.tempo, sizeof(ck));
+    printf("  robô:       x=(%.4f, %.4f, %.4f)  y=(%.4f, %.4f)\n", ck.x1, ck.x2, ck.x3, ck.y1, ck.y2);
+    printf("  visto:      θ=%.4f  y=(%.4f, %.4f)\n", ck.xe3, ck.ye1, ck.ye2);
+    printf("  referência: (%.4f, %.4f), velocidade (%.4f, %.4f)\n", ck.xref, ck.yref, ck.dxref, ck.dyref);
+    printf("  modelos:    ymx=%.4f (%.4f)  ymy=%.4f (%.4f)\n", ck.ymx, ck.dymx, ck.ymy, ck.dymy);
+    printf("  comandos:   v=(%.4f, %.4f)  u=(%.4f, %.4f)  α=(%.2f, %.2f)\n",
+           ck.v1, ck.v2, ck.u1, ck.u2, ck.alpha1, ck.alpha2);
+    printf("  estimador:  x=(%.4f, %.4f, %.4f)  gerador=%016llx\n", ck.estimador.ekf.x[0],
+           ck.estimador.ekf.x[1], ck.estimador.ekf.x[2], (unsigned long long)ck.estimador.rng);
+    printf("  ação integral: %ld amostras\n", ck.integral.ex.samples);
+
+    MetricsSummary resumo;
+    metrics_summary(&ck.metricas, &resumo);
+    metrics_print(&resumo, stdout);
+    return EXIT_SUCCESS;
+}
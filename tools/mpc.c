@@ -0,0 +1,84 @@
+/*
+    FILE: mpc.c
+    DESCRIPTION:
+        Compara o controlador preditivo (mpc.h) com a lei por modelo de
+        referência no mesmo cenário, em simulação headless: indicadores de
+        rastreamento, esforço e fração de saturação de cada controlador e o
+        histograma dos tempos de resolução do QP em relação ao período do
+        controle.
+        Uso: mpc [cenario.cfg] [chave=valor ...]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "scenario.h"
+#include "headless.h"
+#include "trajectory.h"
+#include "mpc.h"
+
+static void usage(void) {
+    fprintf(stderr, "Uso: mpc [cenario.cfg] [chave=valor ...]\n");
+}
+
+static void print_row(const char *name, const HeadlessResult *r) {
+    printf("  %-6s %10.4f %10.4f %10.4f %10.3f %9.1f%%\n",
+           name, r->rms_error, r->max_error, r->ise, r->effort, 100.0 * r->sat_ratio);
+}
+
+int main(int argc, char **argv) {
+    ScenarioConfig cfg;
+    scenario_set_defaults(&cfg);
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        if (a[0] == '-') {
+            usage();
+            return EXIT_FAILURE;
+        } else if ((strchr(a, '=') ? scenario_apply(&cfg, a) : scenario_load_file(&cfg, a)) != 0) {
+            fprintf(stderr, "[ERRO] Cenário inválido: %s\n", a);
+            return EXIT_FAILURE;
+        }
+    }
+    if (scenario_validate(&cfg) != 0) return EXIT_FAILURE;
+
+    Trajectory traj;
+    if (trajectory_load(&traj, &cfg) != 0) {
+        fprintf(stderr, "[ERRO] Trajetória inválida: %s\n", cfg.trajectory);
+        return EXIT_FAILURE;
+    }
+
+    // Referência: lei por modelo de referência
+    static HeadlessSim sim;
+    headless_init(&sim, &cfg, &traj);
+    while (headless_step(&sim)) {
+    }
+    headless_finish(&sim);
+    HeadlessResult mrac = sim.result;
+
+    // Preditivo no mesmo cenário
+    static Mpc mpc;
+    if (mpc_init(&mpc, &cfg) != 0) {
+        trajectory_free(&traj);
+        return EXIT_FAILURE;
+    }
+    headless_init(&sim, &cfg, &traj);
+    sim.model.mpc = &mpc;
+    while (headless_step(&sim)) {
+    }
+    headless_finish(&sim);
+
+    printf("[MPC] %.2f s simulados (%s), horizonte %d x %d ms, q=%g r=%g\n",
+           cfg.sim_time_s, cfg.trajectory, cfg.mpc_horizon, cfg.ctrl_period_ms, cfg.mpc_q, cfg.mpc_r);
+    printf("  lei     RMS erro   máx erro        ISE    esforço  saturação\n");
+    print_row("mrac", &mrac);
+    print_row("mpc", &sim.result);
+    mpc_timing_print(&mpc.timing, cfg.ctrl_period_ms / 1000.0, stdout);
+
+    mpc_destroy(&mpc);
+    trajectory_free(&traj);
+    return EXIT_SUCCESS;
+}
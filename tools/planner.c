@@ -0,0 +1,202 @@
+/*
+    FILE: planner.c
+    DESCRIPTION:
+        Compara as buscas de planner.h num mapa PBM ou numa grade aleatória
+        de retângulos: custo do caminho, nós expandidos e tempo do A*, do
+        JPS e do planejamento inicial do D* Lite. Em seguida simula o robô
+        avançando pelo caminho enquanto obstáculos surgem à sua frente e,
+        a cada mudança, compara o replanejamento incremental do D* Lite com
+        um A* refeito do zero (os custos devem coincidir).
+        Uso: planner [--map mapa.pbm --from x y --to x y] [--size n] [--seed s]
+                     [--res m] [--margin m] [--events n]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "planner.h"
+
+#define BLOCK 6        // Lado dos obstáculos que surgem no caminho (células)
+#define AHEAD 40       // Distância à frente do robô em que surgem (células do caminho)
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void usage(void) {
+    fprintf(stderr, "Uso: planner [--map mapa.pbm --from x y --to x y] [--size n] [--seed s]\n"
+                    "               [--res m] [--margin m] [--events n]\n");
+}
+
+/* Grade n x n com retângulos aleatórios (~10% ocupada) e os cantos de
+   partida e destino livres */
+static int random_grid(OccupancyGrid *g, int n, double res, unsigned seed) {
+    if (grid_init(g, n, n, res) != 0) return -1;
+    srand(seed);
+    int span = n / 32 > 2 ? n / 32 : 2;
+    for (long k = 0; k < (long)n * n / (span * span * 3); k++) {
+        int x = rand() % n, y = rand() % n;
+        grid_fill_rect(g, x, y, x + 1 + rand() % span, y + 1 + rand() % span, 1);
+    }
+    grid_fill_rect(g, 0, 0, n / 16, n / 16, 0);
+    grid_fill_rect(g, n - 1 - n / 16, n - 1 - n / 16, n - 1, n - 1, 0);
+    return 0;
+}
+
+static double occupancy(const OccupancyGrid *g) {
+    long occ = 0;
+    for (int y = 0; y < g->height; y++)
+        for (int x = 0; x < g->width; x++) occ += grid_occupied(g, x, y);
+    return (double)occ / ((double)g->width * g->height);
+}
+
+static void print_row(const char *name, int status, const PlanPath *p, double ms, double res) {
+    if (status != 0) {
+        printf("  %-8s %10s\n", name, "sem caminho");
+        return;
+    }
+    printf("  %-8s %10.3f %8d %12ld %10.3f\n", name, p->cost * res, p->count, p->expanded, ms);
+}
+
+int main(int argc, char **argv) {
+    const char *map = NULL;
+    int size = 1024, events = 20, has_from = 0, has_to = 0;
+    unsigned seed = 1;
+    double res = 0.1, margin = 0.0, from[2] = { 0 }, to[2] = { 0 };
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        int left = argc - 1 - i;
+        if (strcmp(a, "--map") == 0 && left >= 1) {
+            map = argv[++i];
+        } else if (strcmp(a, "--from") == 0 && left >= 2) {
+            from[0] = atof(argv[++i]);
+            from[1] = atof(argv[++i]);
+            has_from = 1;
+        } else if (strcmp(a, "--to") == 0 && left >= 2) {
+            to[0] = atof(argv[++i]);
+            to[1] = atof(argv[++i]);
+            has_to = 1;
+        } else if (strcmp(a, "--size") == 0 && left >= 1) {
+            size = atoi(argv[++i]);
+        } else if (strcmp(a, "--seed") == 0 && left >= 1) {
+            seed = (unsigned)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(a, "--res") == 0 && left >= 1) {
+            res = atof(argv[++i]);
+        } else if (strcmp(a, "--margin") == 0 && left >= 1) {
+            margin = atof(argv[++i]);
+        } else if (strcmp(a, "--events") == 0 && left >= 1) {
+            events = atoi(argv[++i]);
+        } else {
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+    if ((map && (!has_from || !has_to)) || size < 64 || !(res > 0.0) || margin < 0.0 || events < 0) {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    static OccupancyGrid grid;
+    if ((map ? grid_load_pbm(&grid, map, res) : random_grid(&grid, size, res, seed)) != 0) {
+        fprintf(stderr, "[ERRO] Não foi possível montar a grade\n");
+        return EXIT_FAILURE;
+    }
+    if (!map) {
+        from[0] = from[1] = 2.5 * res;
+        to[0] = to[1] = (size - 2.5) * res;
+    }
+    int cells = (int)ceil(margin / res), sx, sy, gx, gy;
+    if (grid_inflate(&grid, cells) != 0 || grid_cell_of(&grid, from[0], from[1], &sx, &sy) != 0 ||
+        grid_cell_of(&grid, to[0], to[1], &gx, &gy) != 0) {
+        fprintf(stderr, "[ERRO] Partida ou destino fora da grade\n");
+        grid_free(&grid);
+        return EXIT_FAILURE;
+    }
+
+    static Planner planner;
+    static DStarLite dstar;
+    if (planner_init(&planner, &grid) != 0 || dstar_init(&dstar, &grid) != 0) {
+        grid_free(&grid);
+        return EXIT_FAILURE;
+    }
+
+    printf("[PLANNER] grade %d x %d (%s), células de %g m, %.1f%% ocupada, folga de %d células\n",
+           grid.width, grid.height, map ? map : "aleatória", res, 100.0 * occupancy(&grid), cells);
+    printf("  de (%g, %g) a (%g, %g)\n", from[0], from[1], to[0], to[1]);
+    printf("  busca      custo(m)  células   expandidos   tempo(ms)\n");
+
+    PlanPath path = { 0 };
+    double t0 = now_s();
+    int st = planner_search(&planner, PLANNER_ASTAR, sx, sy, gx, gy, &path);
+    print_row("astar", st, &path, (now_s() - t0) * 1e3, res);
+    t0 = now_s();
+    st = planner_search(&planner, PLANNER_JPS, sx, sy, gx, gy, &path);
+    print_row("jps", st, &path, (now_s() - t0) * 1e3, res);
+    t0 = now_s();
+    dstar_reset(&dstar, sx, sy, gx, gy);
+    st = dstar_replan(&dstar, &path);
+    print_row("dstar", st, &path, (now_s() - t0) * 1e3, res);
+
+    // Robô avança pelo caminho do D* Lite; a cada evento um bloco surge
+    // AHEAD células à frente e os dois planejadores refazem o caminho
+    PlanPath ref = { 0 };
+    int32_t changed[BLOCK * BLOCK];
+    double t_dstar = 0.0, t_astar = 0.0;
+    long x_dstar = 0, x_astar = 0;
+    int done = 0, mismatches = 0, pos = sy * grid.width + sx;
+    for (int e = 0; e < events && st == 0 && path.count > AHEAD + BLOCK; e++) {
+        pos = path.cells[AHEAD / 2];
+        int32_t c = path.cells[AHEAD];
+        int bx = c % grid.width - BLOCK / 2, by = c / grid.width - BLOCK / 2, n = 0;
+        for (int y = by; y < by + BLOCK; y++) {
+            for (int x = bx; x < bx + BLOCK; x++) {
+                int cell = y * grid.width + x;
+                if (x < 0 || y < 0 || x >= grid.width || y >= grid.height || cell == pos ||
+                    cell == dstar.goal || grid_occupied(&grid, x, y)) continue;
+                grid_set(&grid, x, y, 1);
+                changed[n++] = cell;
+            }
+        }
+
+        t0 = now_s();
+        dstar_move_start(&dstar, pos % grid.width, pos / grid.width);
+        dstar_cells_changed(&dstar, changed, n);
+        st = dstar_replan(&dstar, &path);
+        t_dstar += now_s() - t0;
+        x_dstar += dstar.expanded;
+
+        t0 = now_s();
+        int sa = planner_search(&planner, PLANNER_ASTAR, pos % grid.width, pos / grid.width, gx, gy, &ref);
+        t_astar += now_s() - t0;
+        x_astar += ref.expanded;
+
+        if (sa != st || (st == 0 && fabs(ref.cost - path.cost) > 1e-9)) mismatches++;
+        done++;
+    }
+
+    if (done > 0) {
+        printf("  replanejamento com obstáculos novos (%d eventos, blocos de %d x %d células):\n",
+               done, BLOCK, BLOCK);
+        printf("    dstar incremental: %10.3f ms/evento, %10.0f expandidos/evento\n",
+               t_dstar / done * 1e3, (double)x_dstar / done);
+        printf("    astar do zero:     %10.3f ms/evento, %10.0f expandidos/evento\n",
+               t_astar / done * 1e3, (double)x_astar / done);
+        printf("    custos divergentes: %d\n", mismatches);
+    }
+
+    plan_path_free(&ref);
+    plan_path_free(&path);
+    dstar_destroy(&dstar);
+    planner_destroy(&planner);
+    grid_free(&grid);
+    return mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,259 @@
+/*
+    FILE: replay.c
+    DESCRIPTION:
+        Reprodução determinística das leis de controle e de linearização a
+        partir de uma gravação (record_file, ver replay.h). Cada ativação
+        gravada é reexecutada com as leis atuais, o mais rápido possível,
+        e as saídas v1/v2/u1/u2 são comparadas às gravadas dentro de
+        tolerâncias; o código de saída indica divergência (portão de
+        regressão para mudanças no controlador).
+        Com --generate, produz uma gravação de referência pela simulação
+        headless (sem relógio de parede).
+        Uso: replay <gravacao> [cenario.cfg] [chave=valor ...] [--tol-v x] [--tol-u x] [--report N]
+             replay --generate <gravacao> [cenario.cfg] [chave=valor ...]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "scenario.h"
+#include "control_law.h"
+#include "headless.h"
+#include "trajectory.h"
+#include "replay.h"
+
+#define LINE_MAX_LEN 2048
+
+// Gravação carregada em memória
+typedef struct {
+    ReplayCtrl *ctrl;
+    size_t n_ctrl, cap_ctrl;
+    ReplayLin *lin;
+    size_t n_lin, cap_lin;
+} Recording;
+
+// Divergências de um canal
+typedef struct {
+    double max_diff;
+    size_t max_index;
+    size_t failures;
+} Diff;
+
+static double elapsed_s(const struct timespec *a, const struct timespec *b) {
+    return (b->tv_sec - a->tv_sec) + (b->tv_nsec - a->tv_nsec) / 1e9;
+}
+
+/* Lê até max valores separados por vírgula; retorna quantos foram lidos */
+static int parse_fields(const char *s, double *out, int max) {
+    int n = 0;
+    char *end;
+    while (n < max) {
+        out[n] = strtod(s, &end);
+        if (end == s) break;
+        n++;
+        if (*end != ',') break;
+        s = end + 1;
+    }
+    return n;
+}
+
+static int grow(void **buf, size_t *cap, size_t elem) {
+    size_t new_cap = *cap ? *cap * 2 : 4096;
+    void *p = realloc(*buf, new_cap * elem);
+    if (!p) return -1;
+    *buf = p;
+    *cap = new_cap;
+    return 0;
+}
+
+/* Carrega a gravação; os parâmetros do cabeçalho são aplicados ao cenário */
+static int load_recording(const char *path, Recording *rec, ScenarioConfig *cfg) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "[ERRO] Não foi possível abrir '%s'\n", path);
+        return -1;
+    }
+
+    char line[LINE_MAX_LEN];
+    double v[REPLAY_CTRL_FIELDS];
+    size_t line_no = 0;
+    int status = 0;
+    while (fgets(line, sizeof(line), f)) {
+        line_no++;
+        if (line[0] == '#') {
+            char *assignment = line + 1;
+            while (*assignment == ' ') assignment++;
+            assignment[strcspn(assignment, "\r\n")] = '\0';
+            if (scenario_apply(cfg, assignment) != 0) status = -1;
+        } else if (line[0] == 'c' && line[1] == ',') {
+            if (parse_fields(line + 2, v, REPLAY_CTRL_FIELDS) != REPLAY_CTRL_FIELDS) {
+                fprintf(stderr, "[ERRO] %s:%zu: registro de controle incompleto\n", path, line_no);
+                status = -1;
+                continue;
+            }
+            if (rec->n_ctrl == rec->cap_ctrl &&
+                grow((void **)&rec->ctrl, &rec->cap_ctrl, sizeof(ReplayCtrl)) != 0) {
+                status = -1;
+                break;
+            }
+            ReplayCtrl *c = &rec->ctrl[rec->n_ctrl++];
+            *c = (ReplayCtrl){ v[0], v[1], v[2], v[3], v[4], v[5], v[6],
+                               v[7], v[8], v[9], v[10], v[11], v[12] };
+        } else if (line[0] == 'l' && line[1] == ',') {
+            if (parse_fields(line + 2, v, REPLAY_LIN_FIELDS) != REPLAY_LIN_FIELDS) {
+                fprintf(stderr, "[ERRO] %s:%zu: registro de linearização incompleto\n", path, line_no);
+                status = -1;
+                continue;
+            }
+            if (rec->n_lin == rec->cap_lin &&
+                grow((void **)&rec->lin, &rec->cap_lin, sizeof(ReplayLin)) != 0) {
+                status = -1;
+                break;
+            }
+            rec->lin[rec->n_lin++] = (ReplayLin){ v[0], v[1], v[2], v[3], v[4], v[5] };
+        }
+    }
+    fclose(f);
+    return status;
+}
+
+static void diff_update(Diff *d, double expected, double actual, double tol, size_t index) {
+    double diff = fabs(actual - expected);
+    if (diff > d->max_diff || isnan(diff)) {
+        d->max_diff = diff;
+        d->max_index = index;
+    }
+    if (!(diff <= tol)) d->failures++;
+}
+
+static void diff_print(const char *name, const Diff *d, double tol, const double *t) {
+    printf("  %-3s máx |Δ| = %.3e (t = %.3f s)  fora da tolerância %.1e: %zu\n",
+           name, d->max_diff, d->max_diff > 0 ? t[0] : 0.0, tol, d->failures);
+}
+
+/* Produz uma gravação de referência pela simulação headless */
+static int generate(const char *path, const ScenarioConfig *cfg) {
+    Trajectory traj;
+    if (trajectory_load(&traj, cfg) != 0) {
+        fprintf(stderr, "[ERRO] Trajetória inválida: %s\n", cfg->trajectory);
+        return EXIT_FAILURE;
+    }
+    ReplayRecorder rec;
+    if (replay_recorder_open(&rec, path, cfg) != 0) {
+        trajectory_free(&traj);
+        return EXIT_FAILURE;
+    }
+
+    static HeadlessSim sim;
+    headless_init(&sim, cfg, &traj);
+    sim.rec = &rec;
+    while (headless_step(&sim)) {
+    }
+    replay_recorder_close(&rec);
+    trajectory_free(&traj);
+    printf("[REPLAY] Gravação de referência (%.2f s simulados) em %s\n", cfg->sim_time_s, path);
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+    const char *path = NULL;
+    int generate_mode = 0;
+    double tol_v = 1e-9, tol_u = 1e-9;
+    size_t report = 5;
+
+    ScenarioConfig cfg;
+    scenario_set_defaults(&cfg);
+
+    // Primeiro localiza a gravação (o cabeçalho precede as sobrescritas da linha de comando)
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--generate") == 0) generate_mode = 1;
+        else if ((strcmp(argv[i], "--tol-v") == 0 || strcmp(argv[i], "--tol-u") == 0 ||
+                  strcmp(argv[i], "--report") == 0) && i + 1 < argc) i++;
+        else if (!path && argv[i][0] != '-' && !strchr(argv[i], '=')) path = argv[i];
+    }
+    if (!path) {
+        fprintf(stderr, "Uso: %s <gravacao> [cenario.cfg] [chave=valor ...] [--tol-v x] [--tol-u x] [--report N]\n"
+                        "     %s --generate <gravacao> [cenario.cfg] [chave=valor ...]\n", argv[0], argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Recording rec = { 0 };
+    if (!generate_mode && load_recording(path, &rec, &cfg) != 0) return EXIT_FAILURE;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--generate") == 0 || argv[i] == path) continue;
+        if (strcmp(argv[i], "--tol-v") == 0 && i + 1 < argc) tol_v = atof(argv[++i]);
+        else if (strcmp(argv[i], "--tol-u") == 0 && i + 1 < argc) tol_u = atof(argv[++i]);
+        else if (strcmp(argv[i], "--report") == 0 && i + 1 < argc) report = (size_t)atol(argv[++i]);
+        else if ((strchr(argv[i], '=') ? scenario_apply(&cfg, argv[i]) : scenario_load_file(&cfg, argv[i])) != 0) {
+            fprintf(stderr, "[ERRO] Cenário inválido: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (scenario_validate(&cfg) != 0) return EXIT_FAILURE;
+
+    if (generate_mode) return generate(path, &cfg);
+
+    // Reexecuta as leis sobre as entradas gravadas
+    double *out = malloc((rec.n_ctrl * 2 + rec.n_lin * 2 + 1) * sizeof(double));
+    if (!out) return EXIT_FAILURE;
+    double *v_out = out, *u_out = out + rec.n_ctrl * 2;
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (size_t i = 0; i < rec.n_ctrl; i++) {
+        const ReplayCtrl *c = &rec.ctrl[i];
+        control_law(&cfg, c->ymx, c->dymx, c->ymy, c->dymy, c->y1, c->y2,
+                    c->alpha1, c->alpha2, &v_out[2 * i], &v_out[2 * i + 1]);
+    }
+    for (size_t i = 0; i < rec.n_lin; i++) {
+        const ReplayLin *l = &rec.lin[i];
+        linearization_law(&cfg, l->x3, l->v1, l->v2, &u_out[2 * i], &u_out[2 * i + 1]);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    // Compara com as saídas gravadas
+    Diff dv1 = { 0 }, dv2 = { 0 }, du1 = { 0 }, du2 = { 0 };
+    size_t reported = 0;
+    for (size_t i = 0; i < rec.n_ctrl; i++) {
+        const ReplayCtrl *c = &rec.ctrl[i];
+        size_t before = dv1.failures + dv2.failures;
+        diff_update(&dv1, c->v1, v_out[2 * i], tol_v, i);
+        diff_update(&dv2, c->v2, v_out[2 * i + 1], tol_v, i);
+        if (dv1.failures + dv2.failures > before && reported++ < report)
+            printf("  [controle t=%.3f] v gravado=(%.17g, %.17g) reproduzido=(%.17g, %.17g)\n",
+                   c->t, c->v1, c->v2, v_out[2 * i], v_out[2 * i + 1]);
+    }
+    for (size_t i = 0; i < rec.n_lin; i++) {
+        const ReplayLin *l = &rec.lin[i];
+        size_t before = du1.failures + du2.failures;
+        diff_update(&du1, l->u1, u_out[2 * i], tol_u, i);
+        diff_update(&du2, l->u2, u_out[2 * i + 1], tol_u, i);
+        if (du1.failures + du2.failures > before && reported++ < report)
+            printf("  [linearização t=%.3f] u gravado=(%.17g, %.17g) reproduzido=(%.17g, %.17g)\n",
+                   l->t, l->u1, l->u2, u_out[2 * i], u_out[2 * i + 1]);
+    }
+
+    double secs = elapsed_s(&t0, &t1);
+    size_t total = rec.n_ctrl + rec.n_lin;
+    printf("[REPLAY] %s: %zu ativações do controle, %zu da linearização em %.3f ms (%.1f M ativações/s)\n",
+           path, rec.n_ctrl, rec.n_lin, secs * 1e3, secs > 0 ? total / secs / 1e6 : 0.0);
+    diff_print("v1", &dv1, tol_v, rec.n_ctrl ? &rec.ctrl[dv1.max_index].t : NULL);
+    diff_print("v2", &dv2, tol_v, rec.n_ctrl ? &rec.ctrl[dv2.max_index].t : NULL);
+    diff_print("u1", &du1, tol_u, rec.n_lin ? &rec.lin[du1.max_index].t : NULL);
+    diff_print("u2", &du2, tol_u, rec.n_lin ? &rec.lin[du2.max_index].t : NULL);
+
+    size_t failures = dv1.failures + dv2.failures + du1.failures + du2.failures;
+    printf("[REPLAY] %s\n", failures ? "DIVERGENTE" : "OK");
+
+    free(out);
+    free(rec.ctrl);
+    free(rec.lin);
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
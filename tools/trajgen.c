@@ -0,0 +1,49 @@
+/*
+    FILE: trajgen.c
+    DESCRIPTION:
+        Gera uma tabela binária de trajetória a partir de um arquivo de
+        especificação (ou do oito original), para ser mapeada em memória
+        pela simulação com "trajectory = arquivo.bin".
+        Uso: trajgen <spec|figure8> <saida.bin> [dt] [duracao_figure8]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trajectory.h"
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "Uso: %s <spec|figure8> <saida.bin> [dt] [duracao_figure8]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    double dt = argc > 3 ? atof(argv[3]) : 0.01;
+    double duration = argc > 4 ? atof(argv[4]) : 21.0;
+    if (dt <= 0 || duration <= 0) {
+        fprintf(stderr, "[ERRO] dt e duração devem ser positivos\n");
+        return EXIT_FAILURE;
+    }
+
+    Trajectory traj;
+    int status = strcmp(argv[1], "figure8") == 0
+        ? trajectory_build_figure8(&traj, duration, dt)
+        : trajectory_build_from_spec(&traj, argv[1], dt);
+    if (status != 0) {
+        fprintf(stderr, "[ERRO] Não foi possível construir a trajetória '%s'\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    status = trajectory_save(&traj, argv[2]);
+    if (status == 0)
+        printf("%zu amostras (dt = %g s, %.2f s) gravadas em %s\n",
+               traj.count, traj.dt, traj.duration, argv[2]);
+    else
+        fprintf(stderr, "[ERRO] Falha ao gravar '%s'\n", argv[2]);
+
+    trajectory_free(&traj);
+    return status == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,470 @@
+/*
+    FILE: tuner.c
+    DESCRIPTION:
+        Ferramenta de sintonia dos ganhos α1/α2 (e, opcionalmente, das
+        saturações) por simulações headless em paralelo. Faz uma varredura
+        em grade, refina os melhores pontos com Nelder–Mead (as partidas
+        dividem as mesmas --threads da grade) e imprime a fronteira de Pareto entre erro de rastreamento
+        (ISE) e esforço de controle, sobre todas as avaliações (grade e
+        Nelder–Mead). Parâmetros inteiros do cenário são arredondados, e
+        candidatos que o cenário recusa (scenario_validate) são marcados
+        como inviáveis, sem simulação.
+        Uso: tuner [cenario.cfg] [chave=valor ...] [--param nome:min:max]...
+                   [--grid N] [--threads T] [--starts K] [--weight w] [--csv arquivo]
+    AUTHOR: Darlysson Lima
+    LAST UPDATE: Outubro, 2026
+    LICENSE: CC BY-SA
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include "scenario.h"
+#include "headless.h"
+#include "trajectory.h"
+#include "numfmt.h"
+
+#define MAX_PARAMS 6
+#define NM_MAX_ITER 200
+#define NM_TOL 1e-6
+
+// Parâmetro sintonizável: qualquer campo numérico do cenário
+typedef struct {
+    char name[64];
+    double min, max;
+    int inteiro;              // Campo int: o candidato é arredondado antes de simular
+} TuneParam;
+
+// Candidato avaliado
+typedef struct {
+    double x[MAX_PARAMS];
+    HeadlessResult r;
+    double cost;              // INFINITY se inviável
+    int viavel;               // 0 se o cenário recusou os valores (não simulado)
+    int fase;                 // 0 = grade, 1 = Nelder–Mead
+} Candidate;
+
+typedef struct {
+    ScenarioConfig base;
+    Trajectory traj;          // Referência compartilhada (somente leitura) entre as threads
+    TuneParam params[MAX_PARAMS];
+    int n_params;
+    double weight;            // Peso do esforço no custo escalar
+} Problem;
+
+// ==========================
+// Avaliação de candidatos
+// ==========================
+
+/* Simula o cenário base com os parâmetros de x e calcula o custo. x é
+   arredondado nos campos inteiros (o candidato reporta o que foi simulado);
+   valores que o cenário recusa tornam o candidato inviável. */
+static void evaluate(const Problem *pb, Candidate *c) {
+    ScenarioConfig cfg = pb->base;
+    c->viavel = 1;
+    for (int i = 0; i < pb->n_params; i++) {
+        const TuneParam *tp = &pb->params[i];
+        char assignment[128];
+        size_t n = strlen(tp->name);
+        memcpy(assignment, tp->name, n);
+        assignment[n++] = '=';
+        if (tp->inteiro) {
+            c->x[i] = round(c->x[i]);
+            numfmt_long(assignment + n, (long)c->x[i]);
+        } else {
+            numfmt_double_shortest(assignment + n, c->x[i]);
+        }
+        if (scenario_apply(&cfg, assignment) != 0) c->viavel = 0;
+    }
+    if (c->viavel && scenario_validate(&cfg) != 0) c->viavel = 0;
+    if (!c->viavel) {
+        memset(&c->r, 0, sizeof(c->r));
+        c->cost = INFINITY;
+        return;
+    }
+    headless_run(&cfg, &pb->traj, &c->r);
+    c->cost = c->r.ise + pb->weight * c->r.effort;
+}
+
+// ==========================
+// Varredura em grade paralela
+// ==========================
+
+typedef struct {
+    const Problem *pb;
+    Candidate *cands;
+    long count;
+    atomic_long next;  // Próximo candidato a avaliar
+} GridJob;
+
+static void *grid_worker(void *arg) {
+    GridJob *job = (GridJob *)arg;
+    long i;
+    while ((i = atomic_fetch_add(&job->next, 1)) < job->count) {
+        evaluate(job->pb, &job->cands[i]);
+    }
+    return NULL;
+}
+
+/* Enumera a grade N^P (índice em base mista) e avalia em paralelo */
+static Candidate *grid_search(const Problem *pb, int n, int threads, long *count) {
+    long total = 1;
+    for (int p = 0; p < pb->n_params; p++) total *= n;
+
+    Candidate *cands = calloc((size_t)total, sizeof(Candidate));
+    if (!cands) return NULL;
+
+    for (long i = 0; i < total; i++) {
+        long idx = i;
+        for (int p = 0; p < pb->n_params; p++) {
+            int k = (int)(idx % n);
+            idx /= n;
+            double frac = (n > 1) ? (double)k / (n - 1) : 0.5;
+            cands[i].x[p] = pb->params[p].min + frac * (pb->params[p].max - pb->params[p].min);
+        }
+    }
+
+    GridJob job = { pb, cands, total, 0 };
+    pthread_t th[threads];
+    for (int t = 0; t < threads; t++) pthread_create(&th[t], NULL, grid_worker, &job);
+    for (int t = 0; t < threads; t++) pthread_join(th[t], NULL);
+
+    *count = total;
+    return cands;
+}
+
+// ==========================
+// Nelder–Mead (espaço normalizado [0,1]^P)
+// ==========================
+
+typedef struct {
+    const Problem *pb;
+    Candidate start;
+    Candidate best;
+    int evaluations;
+    Candidate *avaliados;     // Todas as avaliações (para a fronteira de Pareto)
+    int capacidade;
+} NmJob;
+
+static void nm_eval(NmJob *job, const double *u, Candidate *c) {
+    const Problem *pb = job->pb;
+    for (int i = 0; i < pb->n_params; i++) {
+        double ui = u[i] < 0 ? 0 : (u[i] > 1 ? 1 : u[i]);  // Restringe aos limites
+        c->x[i] = pb->params[i].min + ui * (pb->params[i].max - pb->params[i].min);
+    }
+    evaluate(pb, c);
+    c->fase = 1;
+    if (job->evaluations == job->capacidade) {
+        int cap = job->capacidade ? 2 * job->capacidade : 64;
+        Candidate *mais = realloc(job->avaliados, (size_t)cap * sizeof(Candidate));
+        if (!mais) {
+            fprintf(stderr, "[ERRO] Memória insuficiente para as avaliações\n");
+            exit(EXIT_FAILURE);
+        }
+        job->avaliados = mais;
+        job->capacidade = cap;
+    }
+    job->avaliados[job->evaluations++] = *c;
+}
+
+/* Refina uma partida até convergir */
+static void nm_run(NmJob *job) {
+    const Problem *pb = job->pb;
+    const int n = pb->n_params;
+
+    double u[MAX_PARAMS + 1][MAX_PARAMS] = {{0}};
+    Candidate c[MAX_PARAMS + 1];
+
+    // Simplex inicial: ponto de partida + passos de 10% em cada eixo
+    for (int i = 0; i <= n; i++) {
+        for (int j = 0; j < n; j++) {
+            const TuneParam *tp = &pb->params[j];
+            u[i][j] = (job->start.x[j] - tp->min) / (tp->max - tp->min);
+        }
+        if (i > 0) u[i][i - 1] += (u[i][i - 1] > 0.5) ? -0.1 : 0.1;
+        nm_eval(job, u[i], &c[i]);
+    }
+
+    for (int iter = 0; iter < NM_MAX_ITER; iter++) {
+        // Ordena vértices por custo (inserção: n <= MAX_PARAMS)
+        for (int i = 1; i <= n; i++) {
+            for (int k = i; k > 0 && c[k].cost < c[k - 1].cost; k--) {
+                Candidate tc = c[k]; c[k] = c[k - 1]; c[k - 1] = tc;
+                for (int j = 0; j < n; j++) {
+                    double tu = u[k][j]; u[k][j] = u[k - 1][j]; u[k - 1][j] = tu;
+                }
+            }
+        }
+        if (fabs(c[n].cost - c[0].cost) <= NM_TOL * (1.0 + fabs(c[0].cost))) break;
+
+        double centroid[MAX_PARAMS] = {0};
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++) centroid[j] += u[i][j] / n;
+
+        double ur[MAX_PARAMS], ue[MAX_PARAMS], uc[MAX_PARAMS];
+        Candidate cr, ce, cc;
+        for (int j = 0; j < n; j++) ur[j] = centroid[j] + (centroid[j] - u[n][j]);
+        nm_eval(job, ur, &cr);
+
+        if (cr.cost < c[0].cost) {
+            for (int j = 0; j < n; j++) ue[j] = centroid[j] + 2.0 * (centroid[j] - u[n][j]);
+            nm_eval(job, ue, &ce);
+            if (ce.cost < cr.cost) {
+                memcpy(u[n], ue, sizeof(ue)); c[n] = ce;
+            } else {
+                memcpy(u[n], ur, sizeof(ur)); c[n] = cr;
+            }
+        } else if (cr.cost < c[n - 1].cost) {
+            memcpy(u[n], ur, sizeof(ur)); c[n] = cr;
+        } else {
+            for (int j = 0; j < n; j++) uc[j] = centroid[j] + 0.5 * (u[n][j] - centroid[j]);
+            nm_eval(job, uc, &cc);
+            if (cc.cost < c[n].cost) {
+                memcpy(u[n], uc, sizeof(uc)); c[n] = cc;
+            } else {
+                // Encolhe o simplex em direção ao melhor vértice
+                for (int i = 1; i <= n; i++) {
+                    for (int j = 0; j < n; j++) u[i][j] = u[0][j] + 0.5 * (u[i][j] - u[0][j]);
+                    nm_eval(job, u[i], &c[i]);
+                }
+            }
+        }
+    }
+
+    job->best = c[0];
+    for (int i = 1; i <= n; i++)
+        if (c[i].cost < job->best.cost) job->best = c[i];
+}
+
+// Partidas distribuídas entre as threads (o mesmo limite --threads da grade)
+typedef struct {
+    NmJob *jobs;
+    int count;
+    atomic_int next;  // Próxima partida a refinar
+} NmPool;
+
+static void *nm_worker(void *arg) {
+    NmPool *pool = (NmPool *)arg;
+    int k;
+    while ((k = atomic_fetch_add(&pool->next, 1)) < pool->count) nm_run(&pool->jobs[k]);
+    return NULL;
+}
+
+// ==========================
+// Relatórios
+// ==========================
+
+static int cmp_cost(const void *a, const void *b) {
+    double x = ((const Candidate *)a)->cost, y = ((const Candidate *)b)->cost;
+    return (x > y) - (x < y);
+}
+
+static int cmp_ise(const void *a, const void *b) {
+    double x = ((const Candidate *)a)->r.ise, y = ((const Candidate *)b)->r.ise;
+    return (x > y) - (x < y);
+}
+
+static void print_header(const Problem *pb) {
+    for (int i = 0; i < pb->n_params; i++) printf("%10s ", pb->params[i].name);
+    printf("%10s %10s %10s %10s %8s\n", "ISE", "RMS", "max|e|", "esforço", "sat");
+}
+
+static void print_candidate(const Problem *pb, const Candidate *c) {
+    for (int i = 0; i < pb->n_params; i++) printf("%10.4f ", c->x[i]);
+    printf("%10.4f %10.4f %10.4f %10.4f %7.1f%%\n",
+           c->r.ise, c->r.rms_error, c->r.max_error, c->r.effort, 100.0 * c->r.sat_ratio);
+}
+
+/* Fronteira de Pareto (ISE x esforço) dos candidatos viáveis; reordena cands por ISE */
+static void print_pareto(const Problem *pb, Candidate *cands, long count) {
+    qsort(cands, (size_t)count, sizeof(Candidate), cmp_ise);
+    printf("\nFronteira de Pareto (ISE x esforço):\n");
+    print_header(pb);
+    double best_effort = INFINITY;
+    for (long i = 0; i < count; i++) {
+        if (cands[i].viavel && cands[i].r.effort < best_effort) {
+            best_effort = cands[i].r.effort;
+            print_candidate(pb, &cands[i]);
+        }
+    }
+}
+
+static int write_csv(const Problem *pb, const Candidate *cands, long count, const char *path) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    for (int i = 0; i < pb->n_params; i++) fprintf(f, "%s,", pb->params[i].name);
+    fprintf(f, "ise,iae,itae,rms,max_error,effort,sat_ratio,viavel,fase\n");
+    for (long k = 0; k < count; k++) {
+        const Candidate *c = &cands[k];
+        for (int i = 0; i < pb->n_params; i++) fprintf(f, "%.6f,", c->x[i]);
+        fprintf(f, "%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%d,%s\n", c->r.ise, c->r.iae, c->r.itae,
+                c->r.rms_error, c->r.max_error, c->r.effort, c->r.sat_ratio, c->viavel,
+                c->fase ? "nm" : "grade");
+    }
+    fclose(f);
+    return 0;
+}
+
+static int parse_param(TuneParam *tp, const char *spec) {
+    const char *c1 = strchr(spec, ':');
+    if (!c1 || (size_t)(c1 - spec) >= sizeof(tp->name)) return -1;
+    memcpy(tp->name, spec, (size_t)(c1 - spec));
+    tp->name[c1 - spec] = '\0';
+    if (sscanf(c1 + 1, "%lf:%lf", &tp->min, &tp->max) != 2 || tp->max <= tp->min) return -1;
+    return 0;
+}
+
+static void usage(void) {
+    fprintf(stderr,
+            "Uso: tuner [cenario.cfg] [chave=valor ...] [--param nome:min:max]...\n"
+            "           [--grid N] [--threads T] [--starts K] [--weight w] [--csv arquivo]\n");
+}
+
+int main(int argc, char **argv) {
+    Problem pb;
+    memset(&pb, 0, sizeof(pb));
+    scenario_set_defaults(&pb.base);
+    pb.weight = 0.01;
+
+    int grid = 12;
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int starts = 4;
+    const char *csv = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        int has_value = i + 1 < argc;
+        if (strcmp(a, "--param") == 0 && has_value) {
+            if (pb.n_params == MAX_PARAMS || parse_param(&pb.params[pb.n_params++], argv[++i]) != 0) {
+                usage();
+                return EXIT_FAILURE;
+            }
+        } else if (strcmp(a, "--grid") == 0 && has_value) {
+            grid = atoi(argv[++i]);
+        } else if (strcmp(a, "--threads") == 0 && has_value) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(a, "--starts") == 0 && has_value) {
+            starts = atoi(argv[++i]);
+        } else if (strcmp(a, "--weight") == 0 && has_value) {
+            pb.weight = atof(argv[++i]);
+        } else if (strcmp(a, "--csv") == 0 && has_value) {
+            csv = argv[++i];
+        } else if (a[0] == '-') {
+            usage();
+            return EXIT_FAILURE;
+        } else if ((strchr(a, '=') ? scenario_apply(&pb.base, a)
+                                   : scenario_load_file(&pb.base, a)) != 0) {
+            fprintf(stderr, "[ERRO] Cenário inválido: %s\n", a);
+            return EXIT_FAILURE;
+        }
+    }
+    if (scenario_validate(&pb.base) != 0) return EXIT_FAILURE;
+
+    if (pb.n_params == 0) {
+        parse_param(&pb.params[pb.n_params++], "alpha1:0.5:10");
+        parse_param(&pb.params[pb.n_params++], "alpha2:0.5:10");
+    }
+    if (grid < 1) grid = 1;
+    if (threads < 1) threads = 1;
+    if (starts < 1) starts = 1;
+
+    // Valida os nomes dos parâmetros (só campos numéricos) antes de lançar as threads
+    for (int i = 0; i < pb.n_params; i++) {
+        ScenarioConfig probe = pb.base;
+        char assignment[128];
+        int inteiro = scenario_key_is_int(pb.params[i].name);
+        snprintf(assignment, sizeof(assignment), "%s=%.17g", pb.params[i].name,
+                 inteiro == 1 ? round(pb.params[i].min) : pb.params[i].min);
+        if (inteiro < 0 || scenario_apply(&probe, assignment) != 0) {
+            fprintf(stderr, "[ERRO] Parâmetro inválido: %s\n", pb.params[i].name);
+            return EXIT_FAILURE;
+        }
+        pb.params[i].inteiro = inteiro;
+    }
+
+    if (trajectory_load(&pb.traj, &pb.base) != 0) {
+        fprintf(stderr, "[ERRO] Trajetória inválida: %s\n", pb.base.trajectory);
+        return EXIT_FAILURE;
+    }
+
+    // 1) Varredura em grade
+    long count;
+    Candidate *cands = grid_search(&pb, grid, threads, &count);
+    if (!cands) {
+        fprintf(stderr, "[ERRO] Memória insuficiente para a grade\n");
+        return EXIT_FAILURE;
+    }
+    qsort(cands, (size_t)count, sizeof(Candidate), cmp_cost);
+    long inviaveis = 0;
+    for (long i = 0; i < count; i++) inviaveis += !cands[i].viavel;
+    printf("Grade: %ld candidatos (%ld inviáveis) em %d threads (custo = ISE + %.4g * esforço)\n",
+           count, inviaveis, threads, pb.weight);
+    if (inviaveis == count) {
+        fprintf(stderr, "[ERRO] Nenhum candidato da grade é aceito pelo cenário\n");
+        free(cands);
+        trajectory_free(&pb.traj);
+        return EXIT_FAILURE;
+    }
+    printf("Melhores pontos da grade:\n");
+    print_header(&pb);
+    for (long i = 0; i < count && i < 5 && cands[i].viavel; i++) print_candidate(&pb, &cands[i]);
+
+    // 2) Refinamento com Nelder–Mead a partir dos K melhores pontos
+    if (starts > count - inviaveis) starts = (int)(count - inviaveis);
+    NmJob *jobs = calloc((size_t)starts, sizeof(NmJob));
+    if (!jobs) {
+        fprintf(stderr, "[ERRO] Memória insuficiente\n");
+        return EXIT_FAILURE;
+    }
+    for (int k = 0; k < starts; k++) {
+        jobs[k].pb = &pb;
+        jobs[k].start = cands[k];
+    }
+    NmPool pool = { jobs, starts, 0 };
+    int nm_threads = threads < starts ? threads : starts;
+    pthread_t th[nm_threads];
+    for (int t = 0; t < nm_threads; t++) pthread_create(&th[t], NULL, nm_worker, &pool);
+    for (int t = 0; t < nm_threads; t++) pthread_join(th[t], NULL);
+
+    Candidate best = cands[0];
+    int nm_evals = 0;
+    for (int k = 0; k < starts; k++) {
+        nm_evals += jobs[k].evaluations;
+        if (jobs[k].best.cost < best.cost) best = jobs[k].best;
+    }
+    printf("\nNelder–Mead (%d partidas em %d threads, %d simulações) - melhor candidato:\n", starts,
+           nm_threads, nm_evals);
+    print_header(&pb);
+    print_candidate(&pb, &best);
+
+    // 3) Fronteira de Pareto sobre todas as avaliações (grade e Nelder–Mead)
+    long total = count + nm_evals;
+    Candidate *todos = realloc(cands, (size_t)total * sizeof(Candidate));
+    if (!todos) {
+        fprintf(stderr, "[ERRO] Memória insuficiente\n");
+        return EXIT_FAILURE;
+    }
+    cands = todos;
+    for (int k = 0; k < starts; k++) {
+        memcpy(cands + count, jobs[k].avaliados, (size_t)jobs[k].evaluations * sizeof(Candidate));
+        count += jobs[k].evaluations;
+        free(jobs[k].avaliados);
+    }
+    print_pareto(&pb, cands, count);
+
+    int status = EXIT_SUCCESS;
+    if (csv && write_csv(&pb, cands, count, csv) != 0) status = EXIT_FAILURE;
+
+    free(jobs);
+    free(cands);
+    trajectory_free(&pb.traj);
+    return status;
+}